@@ -166,7 +166,16 @@ function(ez_set_build_flags TARGET_NAME)
 
 	ez_pull_compiler_vars()
 
-	set_property(TARGET ${TARGET_NAME} PROPERTY CXX_STANDARD 17)
+	if (EZ_ENABLE_CPP20)
+		set_property(TARGET ${TARGET_NAME} PROPERTY CXX_STANDARD 20)
+
+		# GCC 10 only supports coroutines with an additional flag
+		if (EZ_CMAKE_COMPILER_GCC)
+			target_compile_options(${TARGET_NAME} PRIVATE -fcoroutines)
+		endif()
+	else()
+		set_property(TARGET ${TARGET_NAME} PROPERTY CXX_STANDARD 17)
+	endif()
 
 	if (EZ_CMAKE_COMPILER_MSVC)
 
@@ -19,6 +19,14 @@ set (EZ_OUTPUT_DIRECTORY_DLL "${CMAKE_SOURCE_DIR}/Output/Bin" CACHE PATH "Where
 mark_as_advanced(FORCE EZ_OUTPUT_DIRECTORY_LIB)
 mark_as_advanced(FORCE EZ_OUTPUT_DIRECTORY_DLL)
 
+######################################
+### C++ standard
+######################################
+
+set (EZ_ENABLE_CPP20 OFF CACHE BOOL "Whether to compile the code as C++20, which enables coroutine support (ezCoTask).")
+
+mark_as_advanced(FORCE EZ_ENABLE_CPP20)
+
 ######################################
 ### PCH support
 ######################################
@@ -375,6 +375,10 @@ void ezQtFileserveWidget::FileserverEventHandler(const ezFileserverEvent& e)
     }
     break;
 
+    case ezFileserverEvent::Type::FilePrefetchRequest:
+      LogActivity(ezFmt("[PREFETCH] {0} files checked, {1} changed", e.m_uiSizeTotal, e.m_uiSentTotal), ezFileserveActivityType::ReadFile);
+      break;
+
     case ezFileserverEvent::Type::FileDeleteRequest:
       LogActivity(e.m_szPath, ezFileserveActivityType::DeleteFile);
       break;
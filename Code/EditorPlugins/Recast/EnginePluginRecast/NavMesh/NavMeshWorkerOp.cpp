@@ -4,6 +4,7 @@
 
 #include <Core/Assets/AssetFileHeader.h>
 #include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Utilities/Progress.h>
 #include <ToolsFoundation/Document/DocumentManager.h>
@@ -44,7 +45,24 @@ ezResult ezLongOpWorker_BuildNavMesh::Execute(ezProgress& progress, ezStreamWrit
   if (!pgRange.BeginNextStep("Building NavMesh"))
     return EZ_FAILURE;
 
-  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress));
+  // for tiled navmeshes, the previous result is used as a cache, so that only tiles with modified geometry need to be rebuilt
+  ezRecastNavMeshResourceDescriptor previousDesc;
+  if (m_NavMeshConfig.m_fTileSize > 0.0f)
+  {
+    ezFileReader previousFile;
+    if (previousFile.Open(m_sOutputPath).Succeeded())
+    {
+      // an unreadable previous result just means that all tiles are built from scratch
+      ezAssetFileHeader header;
+      if (header.Read(previousFile).Failed() || previousDesc.Deserialize(previousFile).Failed())
+      {
+        previousDesc.Clear();
+      }
+    }
+  }
+
+  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(
+    m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress, previousDesc.IsTiled() ? &previousDesc : nullptr));
 
   if (!pgRange.BeginNextStep("Writing Result"))
     return EZ_FAILURE;
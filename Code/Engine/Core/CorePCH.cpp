@@ -35,7 +35,9 @@ EZ_STATICLINK_LIBRARY(Core)
   EZ_STATICLINK_REFERENCE(Core_Utils_Implementation_WorldGeoExtractionUtil);
   EZ_STATICLINK_REFERENCE(Core_WorldSerializer_Implementation_ResourceHandleReader);
   EZ_STATICLINK_REFERENCE(Core_WorldSerializer_Implementation_ResourceHandleWriter);
+  EZ_STATICLINK_REFERENCE(Core_WorldSerializer_Implementation_WorldCellWriter);
   EZ_STATICLINK_REFERENCE(Core_WorldSerializer_Implementation_WorldReader);
+  EZ_STATICLINK_REFERENCE(Core_WorldSerializer_Implementation_WorldStreamer);
   EZ_STATICLINK_REFERENCE(Core_WorldSerializer_Implementation_WorldWriter);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_Component);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_ComponentManager);
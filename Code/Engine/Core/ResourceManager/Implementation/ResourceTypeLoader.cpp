@@ -8,6 +8,13 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+ezCoTask<ezResourceLoadData> ezResourceTypeLoader::OpenDataStreamAsync(const ezResource* pResource)
+{
+  co_return OpenDataStream(pResource);
+}
+#endif
+
 struct FileResourceLoadData
 {
   ezBlob m_Storage;
@@ -54,8 +54,39 @@ void ezResourceManagerWorkerDataLoad::DoWork(bool bCalledExternally)
   EZ_ASSERT_DEV(
     pLoader != nullptr, "No Loader function available for Resource Type '{0}'", pResourceToLoad->GetDynamicRTTI()->GetTypeName());
 
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  ezCoTask<void> loading = LoadDataAsync(pResourceToLoad, pLoader, std::move(pCustomLoader), bCalledExternally);
+
+  if (bCalledExternally)
+  {
+    // the caller needs the resource to be loaded when this function returns
+    loading.WaitForResult();
+  }
+  else
+  {
+    // the file access thread does not wait for the loader, the next resource is started when this one is done
+    loading.StartDetached();
+  }
+#else
   ezResourceLoadData LoaderData = pLoader->OpenDataStream(pResourceToLoad);
 
+  FinishLoading(pResourceToLoad, pLoader, std::move(pCustomLoader), LoaderData, bCalledExternally);
+#endif
+}
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+ezCoTask<void> ezResourceManagerWorkerDataLoad::LoadDataAsync(
+  ezResource* pResourceToLoad, ezResourceTypeLoader* pLoader, ezUniquePtr<ezResourceTypeLoader> pCustomLoader, bool bCalledExternally)
+{
+  ezResourceLoadData LoaderData = co_await pLoader->OpenDataStreamAsync(pResourceToLoad);
+
+  FinishLoading(pResourceToLoad, pLoader, std::move(pCustomLoader), LoaderData, bCalledExternally);
+}
+#endif
+
+void ezResourceManagerWorkerDataLoad::FinishLoading(ezResource* pResourceToLoad, ezResourceTypeLoader* pLoader,
+  ezUniquePtr<ezResourceTypeLoader> pCustomLoader, const ezResourceLoadData& LoaderData, bool bCalledExternally)
+{
   // we need this info later to do some work in a lock, all the directly following code is outside the lock
   const bool bResourceIsLoadedOnMainThread = pResourceToLoad->GetBaseResourceFlags().IsAnySet(ezResourceFlags::UpdateOnMainThread);
 
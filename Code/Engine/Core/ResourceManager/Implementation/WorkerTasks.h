@@ -17,6 +17,15 @@ private:
 
   static void DoWork(bool bCalledExternally);
 
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  static ezCoTask<void> LoadDataAsync(
+    ezResource* pResourceToLoad, ezResourceTypeLoader* pLoader, ezUniquePtr<ezResourceTypeLoader> pCustomLoader, bool bCalledExternally);
+#endif
+
+  // Hands the loaded data over to an update content task and starts loading the next resource.
+  static void FinishLoading(ezResource* pResourceToLoad, ezResourceTypeLoader* pLoader, ezUniquePtr<ezResourceTypeLoader> pCustomLoader,
+    const ezResourceLoadData& LoaderData, bool bCalledExternally);
+
   virtual void Execute() override;
 };
 
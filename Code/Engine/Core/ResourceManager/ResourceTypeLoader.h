@@ -3,6 +3,7 @@
 #include <Core/ResourceManager/Implementation/Declarations.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Threading/CoTask.h>
 #include <Foundation/Time/Timestamp.h>
 
 /// \brief Data returned by ezResourceTypeLoader implementations.
@@ -40,6 +41,19 @@ public:
   /// \sa ezResourceLoadData
   virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) = 0;
 
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  /// \brief Override this function to implement the resource loading as a coroutine.
+  ///
+  /// The resource manager starts this function on the file access thread instead of calling OpenDataStream(). Contrary to
+  /// OpenDataStream(), the loader does not need to block that thread while it waits for other work. It can co_await file reads
+  /// (ezCoReadFile), decoding work that runs in task groups (ezCoWaitForGroup) or switch to a thread for a different kind of work
+  /// (ezCoSwitchTo), while the file access thread continues with other tasks.
+  ///
+  /// The default implementation just calls OpenDataStream(). Loaders that implement this function can implement OpenDataStream() as
+  /// 'return OpenDataStreamAsync(pResource).WaitForResult();'.
+  virtual ezCoTask<ezResourceLoadData> OpenDataStreamAsync(const ezResource* pResource);
+#endif
+
   /// \brief This function is called when the resource has been updated with the data from the resource loader and the loader can deallocate
   /// any temporary memory.
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) = 0;
@@ -45,12 +45,24 @@ public:
   template <typename ComponentType>
   ezComponentHandle CreateComponent(ezGameObject* pOwnerObject, ComponentType*& out_pComponent);
 
+  /// \brief Creates one component for each of the given owner objects and appends pointers to them to out_Components.
+  ///
+  /// The storage for all components is allocated at once, which is a lot faster than creating the components one by one when spawning many
+  /// of them, e.g. during level loading.
+  void CreateComponents(ezArrayPtr<ezGameObject* const> ownerObjects, ezDynamicArray<ezComponent*>& out_Components);
+
   /// \brief Deletes the given component. Note that the component will be invalidated first and the actual deletion is postponed.
   void DeleteComponent(const ezComponentHandle& component);
 
   /// \brief Deletes the given component. Note that the component will be invalidated first and the actual deletion is postponed.
   void DeleteComponent(ezComponent* pComponent);
 
+  /// \brief Deletes all given components. Like DeleteComponent() the actual deletion is postponed.
+  ///
+  /// All components that are deleted within one frame are removed from their storage in a single pass at the end of the world update,
+  /// so deleting many components at once does not move the remaining components around more than once.
+  void DeleteComponents(ezArrayPtr<const ezComponentHandle> components);
+
   /// \brief Adds all components that this manager handles to the given array (array is not cleared).
   /// Prefer to use more efficient methods on derived classes, only use this if you need to go through a ezComponentManagerBase pointer.
   virtual void CollectAllComponents(ezDynamicArray<ezComponentHandle>& out_AllComponents, bool bOnlyActive) = 0;
@@ -72,8 +84,18 @@ protected:
   void DeinitializeComponent(ezComponent* pComponent);
   void PatchIdTable(ezComponent* pComponent);
 
+  struct MovedComponent
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezComponent* m_pOldLocation;
+    ezComponent* m_pNewLocation;
+  };
+
   virtual ezComponent* CreateComponentStorage() = 0;
+  virtual void CreateComponentStorage(ezArrayPtr<ezComponent*> out_Components) = 0;
   virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) = 0;
+  virtual void DeleteComponentStorage(ezArrayPtr<ezComponent* const> components, ezDynamicArrayBase<MovedComponent>& out_MovedComponents) = 0;
 
   /// \endcond
 
@@ -113,7 +135,9 @@ protected:
   friend class ezComponentManagerFactory;
 
   virtual ezComponent* CreateComponentStorage() override;
+  virtual void CreateComponentStorage(ezArrayPtr<ezComponent*> out_Components) override;
   virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) override;
+  virtual void DeleteComponentStorage(ezArrayPtr<ezComponent* const> components, ezDynamicArrayBase<MovedComponent>& out_MovedComponents) override;
 
   void RegisterUpdateFunction(UpdateFunctionDesc& desc);
 
@@ -403,6 +403,10 @@ private:
 
   void UpdateGlobalTransformAndBoundsRecursive();
 
+  /// \brief Makes sure the world recomputes the global transform and bounds of a dynamic object and its children in the next update.
+  void MarkTransformDirty();
+  void MarkTransformDirtyInternal();
+
   void OnMsgDeleteGameObject(ezMsgDeleteGameObject& msg);
 
   void AddComponent(ezComponent* pComponent);
@@ -411,6 +415,27 @@ private:
 
   void SendNotificationMessage(ezMessage& msg);
 
+  /// \brief Data that is not needed to propagate transforms through the hierarchy: velocity, bounds and spatial system bookkeeping.
+  ///
+  /// It is stored separately from TransformationData, so the hierarchy update only streams through the transforms. The storage is
+  /// owned by the world and does not move while the object is alive.
+  struct EZ_CORE_DLL EZ_ALIGN_16(ColdTransformationData)
+  {
+    EZ_DECLARE_POD_TYPE();
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+    ezSimdVec4f m_lastGlobalPosition;
+    ezSimdVec4f m_velocity; // w != 0 indicates custom velocity
+#endif
+
+    ezSimdBBoxSphere m_localBounds; // m_BoxHalfExtents.w != 0 indicates that the object should be always visible
+    ezSimdBBoxSphere m_globalBounds;
+
+    ezSpatialDataHandle m_hSpatialData;
+    ezUInt32 m_uiSpatialDataCategoryBitmask;
+  };
+
+  /// \brief The hot part of the transformation data, stored per hierarchy level and touched by every transform update.
   struct EZ_CORE_DLL EZ_ALIGN_16(TransformationData)
   {
     EZ_DECLARE_POD_TYPE();
@@ -428,18 +453,14 @@ private:
 
     ezSimdTransform m_globalTransform;
 
-#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
-    ezSimdVec4f m_lastGlobalPosition;
-    ezSimdVec4f m_velocity; // w != 0 indicates custom velocity
-#endif
+    ColdTransformationData* m_pColdData;
+    ezUInt32 m_uiDirtyIndex; // index + 1 in the dirty list of the hierarchy level, 0 if the transform is up to date
 
-    ezSimdBBoxSphere m_localBounds; // m_BoxHalfExtents.w != 0 indicates that the object should be always visible
-    ezSimdBBoxSphere m_globalBounds;
-
-    ezSpatialDataHandle m_hSpatialData;
-    ezUInt32 m_uiSpatialDataCategoryBitmask;
-
-    ezUInt32 m_uiPadding2[2];
+#if EZ_ENABLED(EZ_PLATFORM_32BIT)
+    ezUInt64 m_uiPadding2;
+#else
+    ezUInt32 m_uiPadding2;
+#endif
 
     void UpdateLocalTransform();
 
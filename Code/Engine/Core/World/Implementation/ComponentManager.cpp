@@ -21,6 +21,35 @@ ezComponentHandle ezComponentManagerBase::CreateComponent(ezGameObject* pOwnerOb
   return CreateComponent(pOwnerObject, pDummy);
 }
 
+void ezComponentManagerBase::CreateComponents(ezArrayPtr<ezGameObject* const> ownerObjects, ezDynamicArray<ezComponent*>& out_Components)
+{
+  const ezUInt32 uiNumComponents = ownerObjects.GetCount();
+  if (uiNumComponents == 0)
+    return;
+
+  const ezUInt32 uiFirstComponent = out_Components.GetCount();
+  out_Components.SetCountUninitialized(uiFirstComponent + uiNumComponents);
+
+  ezArrayPtr<ezComponent*> newComponents = out_Components.GetArrayPtr().GetSubArray(uiFirstComponent, uiNumComponents);
+  CreateComponentStorage(newComponents);
+
+  m_Components.Reserve(m_Components.GetCount() + uiNumComponents);
+  GetWorld()->m_Data.m_ComponentsToInitialize.Reserve(GetWorld()->m_Data.m_ComponentsToInitialize.GetCount() + uiNumComponents);
+
+  for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+  {
+    ezComponent* pComponent = newComponents[i];
+
+    ezGenericComponentId newId = m_Components.Insert(pComponent);
+
+    pComponent->m_pManager = this;
+    pComponent->m_InternalId = newId;
+    pComponent->m_ComponentFlags.AddOrRemove(ezObjectFlags::Dynamic, pComponent->GetMode() == ezComponentMode::Dynamic);
+
+    InitializeComponent(ownerObjects[i], pComponent);
+  }
+}
+
 void ezComponentManagerBase::DeleteComponent(const ezComponentHandle& component)
 {
   ezComponent* pComponent = nullptr;
@@ -30,9 +59,20 @@ void ezComponentManagerBase::DeleteComponent(const ezComponentHandle& component)
   DeleteComponent(pComponent);
 }
 
+void ezComponentManagerBase::DeleteComponents(ezArrayPtr<const ezComponentHandle> components)
+{
+  GetWorld()->m_Data.m_DeadComponents.Reserve(GetWorld()->m_Data.m_DeadComponents.GetCount() + components.GetCount());
+
+  for (const ezComponentHandle& hComponent : components)
+  {
+    DeleteComponent(hComponent);
+  }
+}
+
 void ezComponentManagerBase::DeleteComponent(ezComponent* pComponent)
 {
-  if (pComponent == nullptr)
+  // already deleted components have an invalid id
+  if (pComponent == nullptr || pComponent->m_InternalId.IsInvalidated())
     return;
 
   DeinitializeComponent(pComponent);
@@ -42,7 +82,7 @@ void ezComponentManagerBase::DeleteComponent(ezComponent* pComponent)
   pComponent->m_InternalId.Invalidate();
   pComponent->m_ComponentFlags.Remove(ezObjectFlags::Active);
 
-  GetWorld()->m_Data.m_DeadComponents.Insert(pComponent);
+  GetWorld()->m_Data.m_DeadComponents.PushBack(pComponent);
 }
 
 void ezComponentManagerBase::DeinitializeInternal()
@@ -146,6 +146,20 @@ EZ_ALWAYS_INLINE ezComponent* ezComponentManager<T, StorageType>::CreateComponen
   return m_ComponentStorage.Create();
 }
 
+template <typename T, ezBlockStorageType::Enum StorageType>
+void ezComponentManager<T, StorageType>::CreateComponentStorage(ezArrayPtr<ezComponent*> out_Components)
+{
+  ezHybridArray<T*, 64> components;
+  components.SetCountUninitialized(out_Components.GetCount());
+
+  m_ComponentStorage.Create(components);
+
+  for (ezUInt32 i = 0; i < components.GetCount(); ++i)
+  {
+    out_Components[i] = components[i];
+  }
+}
+
 template <typename T, ezBlockStorageType::Enum StorageType>
 EZ_FORCE_INLINE void ezComponentManager<T, StorageType>::DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent)
 {
@@ -154,6 +168,31 @@ EZ_FORCE_INLINE void ezComponentManager<T, StorageType>::DeleteComponentStorage(
   out_pMovedComponent = pMovedComponent;
 }
 
+template <typename T, ezBlockStorageType::Enum StorageType>
+void ezComponentManager<T, StorageType>::DeleteComponentStorage(
+  ezArrayPtr<ezComponent* const> components, ezDynamicArrayBase<MovedComponent>& out_MovedComponents)
+{
+  ezHybridArray<T*, 64> componentsToDelete;
+  componentsToDelete.SetCountUninitialized(components.GetCount());
+
+  for (ezUInt32 i = 0; i < components.GetCount(); ++i)
+  {
+    componentsToDelete[i] = static_cast<T*>(components[i]);
+  }
+
+  typedef typename ezBlockStorage<T, ezInternal::DEFAULT_BLOCK_SIZE, StorageType>::MovedObject MovedObject;
+  ezHybridArray<MovedObject, 64> movedComponents;
+
+  m_ComponentStorage.Delete(componentsToDelete.GetArrayPtr(), movedComponents);
+
+  for (const MovedObject& movedComponent : movedComponents)
+  {
+    auto& moved = out_MovedComponents.ExpandAndGetRef();
+    moved.m_pOldLocation = movedComponent.m_pOldLocation;
+    moved.m_pNewLocation = movedComponent.m_pNewLocation;
+  }
+}
+
 template <typename T, ezBlockStorageType::Enum StorageType>
 EZ_FORCE_INLINE void ezComponentManager<T, StorageType>::RegisterUpdateFunction(UpdateFunctionDesc& desc)
 {
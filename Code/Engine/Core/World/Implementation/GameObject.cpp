@@ -195,6 +195,11 @@ void ezGameObject::SetTeamID(ezUInt16 id)
   }
 }
 
+void ezGameObject::MarkTransformDirtyInternal()
+{
+  m_pWorld->m_Data.MarkTransformationDataDirty(m_pTransformationData, m_uiHierarchyLevel);
+}
+
 void ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
 {
   if (IsStatic() && GetWorld()->ReportErrorWhenStaticObjectMoves())
@@ -264,10 +269,11 @@ void ezGameObject::operator=(const ezGameObject& other)
   m_pTransformationData = other.m_pTransformationData;
   m_pTransformationData->m_pObject = this;
 
-  if (!m_pTransformationData->m_hSpatialData.IsInvalidated() && m_pWorld->GetSpatialSystem() != nullptr)
+  const ColdTransformationData* pColdData = m_pTransformationData->m_pColdData;
+  if (!pColdData->m_hSpatialData.IsInvalidated() && m_pWorld->GetSpatialSystem() != nullptr)
   {
-    m_pWorld->GetSpatialSystem()->UpdateSpatialData(m_pTransformationData->m_hSpatialData, m_pTransformationData->m_globalBounds, this,
-      m_pTransformationData->m_uiSpatialDataCategoryBitmask);
+    m_pWorld->GetSpatialSystem()->UpdateSpatialData(
+      pColdData->m_hSpatialData, pColdData->m_globalBounds, this, pColdData->m_uiSpatialDataCategoryBitmask);
   }
 
   m_Components = other.m_Components;
@@ -577,14 +583,14 @@ void ezGameObject::UpdateLocalBounds()
 
   SendMessage(msg);
 
-  if (m_pTransformationData->m_uiSpatialDataCategoryBitmask != msg.m_uiSpatialDataCategoryBitmask)
+  if (m_pTransformationData->m_pColdData->m_uiSpatialDataCategoryBitmask != msg.m_uiSpatialDataCategoryBitmask)
   {
-    m_pTransformationData->m_globalBounds.SetInvalid(); // force spatial data update
+    m_pTransformationData->m_pColdData->m_globalBounds.SetInvalid(); // force spatial data update
   }
 
-  m_pTransformationData->m_localBounds = ezSimdConversion::ToBBoxSphere(msg.m_ResultingLocalBounds);
-  m_pTransformationData->m_localBounds.m_BoxHalfExtents.SetW(msg.m_bAlwaysVisible ? 1.0f : 0.0f);
-  m_pTransformationData->m_uiSpatialDataCategoryBitmask = msg.m_uiSpatialDataCategoryBitmask;
+  m_pTransformationData->m_pColdData->m_localBounds = ezSimdConversion::ToBBoxSphere(msg.m_ResultingLocalBounds);
+  m_pTransformationData->m_pColdData->m_localBounds.m_BoxHalfExtents.SetW(msg.m_bAlwaysVisible ? 1.0f : 0.0f);
+  m_pTransformationData->m_pColdData->m_uiSpatialDataCategoryBitmask = msg.m_uiSpatialDataCategoryBitmask;
 
   if (IsStatic())
   {
@@ -597,6 +603,10 @@ void ezGameObject::UpdateLocalBounds()
       m_pTransformationData->UpdateGlobalBoundsAndSpatialData();
     }
   }
+  else
+  {
+    MarkTransformDirty();
+  }
 }
 
 bool ezGameObject::TryGetComponentOfBaseType(const ezRTTI* pType, ezComponent*& out_pComponent)
@@ -891,42 +901,45 @@ void ezGameObject::TransformationData::ConditionalUpdateGlobalBounds()
 void ezGameObject::TransformationData::UpdateSpatialData(bool bWasAlwaysVisible, bool bIsAlwaysVisible)
 {
   ezSpatialSystem& spatialSystem = *m_pObject->GetWorld()->GetSpatialSystem();
+  ColdTransformationData& coldData = *m_pColdData;
 
   if (bWasAlwaysVisible != bIsAlwaysVisible)
   {
-    if (!m_hSpatialData.IsInvalidated())
+    if (!coldData.m_hSpatialData.IsInvalidated())
     {
-      spatialSystem.DeleteSpatialData(m_hSpatialData);
-      m_hSpatialData.Invalidate();
+      spatialSystem.DeleteSpatialData(coldData.m_hSpatialData);
+      coldData.m_hSpatialData.Invalidate();
     }
   }
 
   if (bIsAlwaysVisible)
   {
-    if (m_hSpatialData.IsInvalidated())
+    if (coldData.m_hSpatialData.IsInvalidated())
     {
-      m_hSpatialData = spatialSystem.CreateSpatialDataAlwaysVisible(m_pObject, m_uiSpatialDataCategoryBitmask);
+      coldData.m_hSpatialData = spatialSystem.CreateSpatialDataAlwaysVisible(m_pObject, coldData.m_uiSpatialDataCategoryBitmask);
     }
   }
   else
   {
-    if (m_globalBounds.IsValid())
+    if (coldData.m_globalBounds.IsValid())
     {
-      if (m_hSpatialData.IsInvalidated())
+      if (coldData.m_hSpatialData.IsInvalidated())
       {
-        m_hSpatialData = spatialSystem.CreateSpatialData(m_globalBounds, m_pObject, m_uiSpatialDataCategoryBitmask);
+        coldData.m_hSpatialData =
+          spatialSystem.CreateSpatialData(coldData.m_globalBounds, m_pObject, coldData.m_uiSpatialDataCategoryBitmask);
       }
       else
       {
-        spatialSystem.UpdateSpatialData(m_hSpatialData, m_globalBounds, m_pObject, m_uiSpatialDataCategoryBitmask);
+        spatialSystem.UpdateSpatialData(
+          coldData.m_hSpatialData, coldData.m_globalBounds, m_pObject, coldData.m_uiSpatialDataCategoryBitmask);
       }
     }
     else
     {
-      if (!m_hSpatialData.IsInvalidated())
+      if (!coldData.m_hSpatialData.IsInvalidated())
       {
-        spatialSystem.DeleteSpatialData(m_hSpatialData);
-        m_hSpatialData.Invalidate();
+        spatialSystem.DeleteSpatialData(coldData.m_hSpatialData);
+        coldData.m_hSpatialData.Invalidate();
       }
     }
   }
@@ -264,6 +264,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalPosition(const ezSimdVec4f& position
 {
   m_pTransformationData->m_localPosition = position;
 
+  MarkTransformDirty();
+
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -280,6 +282,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalRotation(const ezSimdQuat& rotation,
 {
   m_pTransformationData->m_localRotation = rotation;
 
+  MarkTransformDirty();
+
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -298,6 +302,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalScaling(const ezSimdVec4f& scaling,
   m_pTransformationData->m_localScaling = scaling;
   m_pTransformationData->m_localScaling.SetW(uniformScale);
 
+  MarkTransformDirty();
+
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -314,6 +320,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalUniformScaling(const ezSimdFloat& sc
 {
   m_pTransformationData->m_localScaling.SetW(scaling);
 
+  MarkTransformDirty();
+
   if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -338,6 +346,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalPosition(const ezSimdVec4f& positio
 
   m_pTransformationData->UpdateLocalTransform();
 
+  MarkTransformDirty();
+
   if (IsStatic())
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -356,6 +366,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalRotation(const ezSimdQuat& rotation
 
   m_pTransformationData->UpdateLocalTransform();
 
+  MarkTransformDirty();
+
   if (IsStatic())
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -374,6 +386,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalScaling(const ezSimdVec4f& scaling)
 
   m_pTransformationData->UpdateLocalTransform();
 
+  MarkTransformDirty();
+
   if (IsStatic())
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -392,6 +406,8 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalTransform(const ezSimdTransform& tr
 
   m_pTransformationData->UpdateLocalTransform();
 
+  MarkTransformDirty();
+
   if (IsStatic())
   {
     UpdateGlobalTransformAndBoundsRecursive();
@@ -406,12 +422,14 @@ EZ_ALWAYS_INLINE const ezSimdTransform& ezGameObject::GetGlobalTransformSimd() c
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
 EZ_ALWAYS_INLINE void ezGameObject::SetVelocity(const ezVec3& vVelocity)
 {
-  m_pTransformationData->m_velocity = ezSimdVec4f(vVelocity.x, vVelocity.y, vVelocity.z, 1.0f);
+  m_pTransformationData->m_pColdData->m_velocity = ezSimdVec4f(vVelocity.x, vVelocity.y, vVelocity.z, 1.0f);
+
+  MarkTransformDirty();
 }
 
 EZ_ALWAYS_INLINE ezVec3 ezGameObject::GetVelocity() const
 {
-  return ezSimdConversion::ToVec3(m_pTransformationData->m_velocity);
+  return ezSimdConversion::ToVec3(m_pTransformationData->m_pColdData->m_velocity);
 }
 #endif
 
@@ -420,6 +438,14 @@ EZ_ALWAYS_INLINE void ezGameObject::UpdateGlobalTransform()
   m_pTransformationData->ConditionalUpdateGlobalTransform();
 }
 
+EZ_ALWAYS_INLINE void ezGameObject::MarkTransformDirty()
+{
+  if (m_pTransformationData->m_uiDirtyIndex == 0 && IsDynamic())
+  {
+    MarkTransformDirtyInternal();
+  }
+}
+
 EZ_ALWAYS_INLINE void ezGameObject::EnableStaticTransformChangesNotifications()
 {
   m_Flags.Add(ezObjectFlags::StaticTransformChangesNotifications);
@@ -432,22 +458,22 @@ EZ_ALWAYS_INLINE void ezGameObject::DisableStaticTransformChangesNotifications()
 
 EZ_ALWAYS_INLINE ezBoundingBoxSphere ezGameObject::GetLocalBounds() const
 {
-  return ezSimdConversion::ToBBoxSphere(m_pTransformationData->m_localBounds);
+  return ezSimdConversion::ToBBoxSphere(m_pTransformationData->m_pColdData->m_localBounds);
 }
 
 EZ_ALWAYS_INLINE ezBoundingBoxSphere ezGameObject::GetGlobalBounds() const
 {
-  return ezSimdConversion::ToBBoxSphere(m_pTransformationData->m_globalBounds);
+  return ezSimdConversion::ToBBoxSphere(m_pTransformationData->m_pColdData->m_globalBounds);
 }
 
 EZ_ALWAYS_INLINE const ezSimdBBoxSphere& ezGameObject::GetLocalBoundsSimd() const
 {
-  return m_pTransformationData->m_localBounds;
+  return m_pTransformationData->m_pColdData->m_localBounds;
 }
 
 EZ_ALWAYS_INLINE const ezSimdBBoxSphere& ezGameObject::GetGlobalBoundsSimd() const
 {
-  return m_pTransformationData->m_globalBounds;
+  return m_pTransformationData->m_pColdData->m_globalBounds;
 }
 
 EZ_ALWAYS_INLINE void ezGameObject::UpdateGlobalTransformAndBounds()
@@ -457,7 +483,7 @@ EZ_ALWAYS_INLINE void ezGameObject::UpdateGlobalTransformAndBounds()
 
 EZ_ALWAYS_INLINE ezSpatialDataHandle ezGameObject::GetSpatialData() const
 {
-  return m_pTransformationData->m_hSpatialData;
+  return m_pTransformationData->m_pColdData->m_hSpatialData;
 }
 
 EZ_ALWAYS_INLINE void ezGameObject::EnableComponentChangesNotifications()
@@ -550,26 +576,26 @@ EZ_ALWAYS_INLINE void ezGameObject::TransformationData::UpdateGlobalTransformWit
 
 EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBounds()
 {
-  m_globalBounds = m_localBounds;
-  m_globalBounds.Transform(m_globalTransform);
+  m_pColdData->m_globalBounds = m_pColdData->m_localBounds;
+  m_pColdData->m_globalBounds.Transform(m_globalTransform);
 
-  m_globalBounds.m_BoxHalfExtents.SetW(m_localBounds.m_BoxHalfExtents.w());
+  m_pColdData->m_globalBounds.m_BoxHalfExtents.SetW(m_pColdData->m_localBounds.m_BoxHalfExtents.w());
 }
 
 EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData()
 {
-  ezSimdBBoxSphere oldGlobalBounds = m_globalBounds;
+  ezSimdBBoxSphere oldGlobalBounds = m_pColdData->m_globalBounds;
 
   UpdateGlobalBounds();
 
   ///\todo find a better place for this
   // Can't use ezSimdBBoxSphere::operator != because we want to include the w component of m_BoxHalfExtents
-  if ((m_globalBounds.m_CenterAndRadius != oldGlobalBounds.m_CenterAndRadius ||
-       m_globalBounds.m_BoxHalfExtents != oldGlobalBounds.m_BoxHalfExtents)
+  if ((m_pColdData->m_globalBounds.m_CenterAndRadius != oldGlobalBounds.m_CenterAndRadius ||
+       m_pColdData->m_globalBounds.m_BoxHalfExtents != oldGlobalBounds.m_BoxHalfExtents)
           .AnySet<4>())
   {
     bool bWasAlwaysVisible = oldGlobalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
-    bool bIsAlwaysVisible = m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+    bool bIsAlwaysVisible = m_pColdData->m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
 
     UpdateSpatialData(bWasAlwaysVisible, bIsAlwaysVisible);
   }
@@ -579,11 +605,11 @@ EZ_ALWAYS_INLINE void ezGameObject::TransformationData::UpdateVelocity(const ezS
 {
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
   // A w value != 0 indicates a custom velocity, don't overwrite it.
-  ezSimdVec4b customVel = (m_velocity.Get<ezSwizzle::WWWW>() != ezSimdVec4f::ZeroVector());
-  ezSimdVec4f newVel = (m_globalTransform.m_Position - m_lastGlobalPosition) * fInvDeltaSeconds;
-  m_velocity = ezSimdVec4f::Select(customVel, m_velocity, newVel);
+  ezSimdVec4b customVel = (m_pColdData->m_velocity.Get<ezSwizzle::WWWW>() != ezSimdVec4f::ZeroVector());
+  ezSimdVec4f newVel = (m_globalTransform.m_Position - m_pColdData->m_lastGlobalPosition) * fInvDeltaSeconds;
+  m_pColdData->m_velocity = ezSimdVec4f::Select(customVel, m_pColdData->m_velocity, newVel);
 
-  m_lastGlobalPosition = m_globalTransform.m_Position;
-  m_velocity.SetW(ezSimdFloat::Zero());
+  m_pColdData->m_lastGlobalPosition = m_globalTransform.m_Position;
+  m_pColdData->m_velocity.SetW(ezSimdFloat::Zero());
 #endif
 }
@@ -80,6 +80,27 @@ ezComponent* ezSettingsComponentManager<ComponentType>::CreateComponentStorage()
   return m_Components.PeekBack().Borrow();
 }
 
+template <typename ComponentType>
+void ezSettingsComponentManager<ComponentType>::CreateComponentStorage(ezArrayPtr<ezComponent*> out_Components)
+{
+  for (ezComponent*& pComponent : out_Components)
+  {
+    pComponent = CreateComponentStorage();
+  }
+}
+
+template <typename ComponentType>
+void ezSettingsComponentManager<ComponentType>::DeleteComponentStorage(
+  ezArrayPtr<ezComponent* const> components, ezDynamicArrayBase<MovedComponent>& out_MovedComponents)
+{
+  // the components are individually allocated, nothing is moved
+  for (ezComponent* pComponent : components)
+  {
+    ezComponent* pDummy;
+    DeleteComponentStorage(pComponent, pDummy);
+  }
+}
+
 template <typename ComponentType>
 void ezSettingsComponentManager<ComponentType>::DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent)
 {
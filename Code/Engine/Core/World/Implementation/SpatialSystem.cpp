@@ -116,13 +116,25 @@ void ezSpatialSystem::UpdateSpatialData(const ezSpatialDataHandle& hData, const
 void ezSpatialSystem::FindObjectsInSphere(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, ezDynamicArray<ezGameObject*>& out_Objects,
   QueryStats* pStats /*= nullptr*/) const
 {
-  FindObjectsInSphere(sphere, uiCategoryBitmask,
-    [&](ezGameObject* pObject) {
-      out_Objects.PushBack(pObject);
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (pStats != nullptr)
+  {
+    pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    pStats->m_uiNumObjectsTested += m_DataAlwaysVisible.GetCount();
+    pStats->m_uiNumObjectsPassed += m_DataAlwaysVisible.GetCount();
+  }
+#endif
 
-      return ezVisitorExecution::Continue;
-    },
-    pStats);
+  // write directly into the array instead of going through a delegate for every object that was found
+  FindObjectsInSphereInternal(sphere, uiCategoryBitmask, out_Objects, pStats);
+
+  for (auto pData : m_DataAlwaysVisible)
+  {
+    if ((pData->m_uiCategoryBitmask & uiCategoryBitmask) != 0)
+    {
+      out_Objects.PushBack(pData->m_pObject);
+    }
+  }
 }
 
 void ezSpatialSystem::FindObjectsInSphere(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats /*= nullptr*/) const
@@ -348,13 +348,19 @@ void ezSpatialSystem_RegularGrid::GetAllCellBoxes(ezHybridArray<ezBoundingBox, 1
   }
 }
 
-void ezSpatialSystem_RegularGrid::FindObjectsInSphereInternal(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback,
-  QueryStats* pStats) const
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_RegularGrid::ForEachObjectInSphere(
+  const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, Functor func, QueryStats* pStats) const
 {
   ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
   ezSimdBBox simdBox;
   simdBox.SetCenterAndHalfExtents(simdSphere.m_CenterAndRadius, simdSphere.m_CenterAndRadius.Get<ezSwizzle::WWWW>());
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+#endif
+
   ForEachCellInBox(simdBox, uiCategoryBitmask, [&](const ezSimdVec4i& cellIndex, ezUInt64 cellKey, const Cell& cell, ezUInt32 uiFilteredCategoryBitmask) {
     ezSimdBBox cellBox = cell.m_Bounds.GetBox();
     if (!cellBox.Overlaps(simdSphere))
@@ -372,33 +378,51 @@ void ezSpatialSystem_RegularGrid::FindObjectsInSphereInternal(const ezBoundingSp
       const ezUInt32 numSpheres = boundingSpheres.GetCount();
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-      if (pStats != nullptr)
-      {
-        pStats->m_uiNumObjectsTested += numSpheres;
-      }
+      uiNumObjectsTested += numSpheres;
 #endif
 
       for (ezUInt32 i = 0; i < numSpheres; ++i)
       {
-        auto& objectSphere = boundingSpheres[i];
-        if (!simdSphere.Overlaps(objectSphere))
+        if (!simdSphere.Overlaps(boundingSpheres[i]))
           continue;
 
-        const ezSpatialData* pData = dataPointers[i];
-
         // TODO: The return value has to have more control
-        if (callback(pData->m_pObject) == ezVisitorExecution::Stop)
+        if (func(dataPointers[i]->m_pObject) == ezVisitorExecution::Stop)
           return;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-        if (pStats != nullptr)
-        {
-          pStats->m_uiNumObjectsPassed++;
-        }
+        uiNumObjectsPassed++;
 #endif
       }
     }
   });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (pStats != nullptr)
+  {
+    pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
+  }
+#endif
+}
+
+void ezSpatialSystem_RegularGrid::FindObjectsInSphereInternal(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback,
+  QueryStats* pStats) const
+{
+  ForEachObjectInSphere(sphere, uiCategoryBitmask, callback, pStats);
+}
+
+void ezSpatialSystem_RegularGrid::FindObjectsInSphereInternal(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, ezDynamicArray<ezGameObject*>& out_Objects,
+  QueryStats* pStats) const
+{
+  // the lambda is inlined into the loop, unlike a delegate
+  ForEachObjectInSphere(
+    sphere, uiCategoryBitmask,
+    [&](ezGameObject* pObject) {
+      out_Objects.PushBack(pObject);
+      return ezVisitorExecution::Continue;
+    },
+    pStats);
 }
 
 void ezSpatialSystem_RegularGrid::FindObjectsInBoxInternal(const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const
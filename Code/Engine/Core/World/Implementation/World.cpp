@@ -180,14 +180,18 @@ ezGameObjectHandle ezWorld::CreateObject(const ezGameObjectDesc& desc, ezGameObj
   pTransformationData->m_localRotation = ezSimdConversion::ToQuat(desc.m_LocalRotation);
   pTransformationData->m_localScaling = ezSimdConversion::ToVec4(desc.m_LocalScaling.GetAsVec4(desc.m_LocalUniformScaling));
   pTransformationData->m_globalTransform.SetIdentity();
+  pTransformationData->m_uiDirtyIndex = 0;
+
+  ezGameObject::ColdTransformationData* pColdData = m_Data.m_ColdTransformationStorage.Create();
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
-  pTransformationData->m_velocity.SetZero();
+  pColdData->m_velocity.SetZero();
 #endif
-  pTransformationData->m_localBounds.SetInvalid();
-  pTransformationData->m_localBounds.m_BoxHalfExtents.SetW(ezSimdFloat::Zero());
-  pTransformationData->m_globalBounds = pTransformationData->m_localBounds;
-  pTransformationData->m_hSpatialData.Invalidate();
-  pTransformationData->m_uiSpatialDataCategoryBitmask = 0;
+  pColdData->m_localBounds.SetInvalid();
+  pColdData->m_localBounds.m_BoxHalfExtents.SetW(ezSimdFloat::Zero());
+  pColdData->m_globalBounds = pColdData->m_localBounds;
+  pColdData->m_hSpatialData.Invalidate();
+  pColdData->m_uiSpatialDataCategoryBitmask = 0;
+  pTransformationData->m_pColdData = pColdData;
 
   if (pParentData != nullptr)
   {
@@ -199,7 +203,7 @@ ezGameObjectHandle ezWorld::CreateObject(const ezGameObjectDesc& desc, ezGameObj
   }
 
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
-  pTransformationData->m_lastGlobalPosition = pTransformationData->m_globalTransform.m_Position;
+  pColdData->m_lastGlobalPosition = pTransformationData->m_globalTransform.m_Position;
 #endif
 
   // link the transformation data to the game object
@@ -208,6 +212,8 @@ ezGameObjectHandle ezWorld::CreateObject(const ezGameObjectDesc& desc, ezGameObj
   // fix links
   LinkToParent(pNewObject);
 
+  pNewObject->MarkTransformDirty();
+
   out_pObject = pNewObject;
   return ezGameObjectHandle(newId);
 }
@@ -265,19 +271,7 @@ void ezWorld::PostMessage(
   metaData.m_uiReceiverIsComponent = false;
   metaData.m_uiRecursive = bRecursive;
 
-  ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
-  if (delay.GetSeconds() > 0.0)
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
-
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
-  else
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
+  EnqueueMessage(msg, queueType, delay, metaData);
 }
 
 void ezWorld::PostMessage(
@@ -292,19 +286,37 @@ void ezWorld::PostMessage(
   metaData.m_uiReceiverIsComponent = true;
   metaData.m_uiRecursive = false;
 
+  EnqueueMessage(msg, queueType, delay, metaData);
+}
+
+void ezWorld::EnqueueMessage(const ezMessage& msg, ezObjectMsgQueueType::Enum queueType, ezTime delay, QueuedMsgMetaData& metaData) const
+{
+  // the virtual sorting key and the hash are evaluated once here, sorting the queues only looks at the meta data
+  const ezUInt32 uiSortingKey = static_cast<ezUInt32>(msg.GetSortingKey()) ^ 0x80000000u;
+  metaData.m_uiSortKey = (static_cast<ezUInt64>(uiSortingKey) << 32) | msg.GetId();
+  metaData.m_uiMessageHash = msg.GetHash();
+  metaData.m_uiQueueType = static_cast<ezUInt16>(queueType);
+
+  ezInternal::WorldData::QueuedMsg queuedMsg;
+  queuedMsg.m_MetaData = metaData;
+
   ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
   if (delay.GetSeconds() > 0.0)
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
-
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    queuedMsg.m_pMessage = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
+    queuedMsg.m_MetaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
+    queuedMsg.m_MetaData.m_uiIsTimed = 1;
   }
   else
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    queuedMsg.m_pMessage = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
+    queuedMsg.m_MetaData.m_uiIsTimed = 0;
   }
+
+  // every thread has its own buffer, the lock is only contended while the buffers are merged at a phase boundary
+  ezInternal::WorldData::PostBuffer& postBuffer = m_Data.GetPostBuffer();
+  EZ_LOCK(postBuffer.m_Mutex);
+  postBuffer.m_Messages.PushBack(queuedMsg);
 }
 
 void ezWorld::Update()
@@ -312,6 +324,9 @@ void ezWorld::Update()
   CheckForWriteAccess();
 
   EZ_LOG_BLOCK(m_Data.m_sName.GetData());
+  EZ_PROFILE_SCOPE(m_Data.m_sName.GetData());
+
+  const ezTime tStart = ezTime::Now();
 
   {
     ezStringBuilder sStatName;
@@ -337,7 +352,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Pre-Async Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::NextFrame);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync);
   }
 
   // async phase
@@ -356,7 +371,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Post-Async Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::PostAsync);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync);
   }
 
   // delete dead objects and update the object hierarchy
@@ -383,7 +398,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Post-Transform Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::PostTransform);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform);
   }
 
   // Process again so new component can receive render messages, otherwise we introduce a frame delay.
@@ -396,6 +411,76 @@ void ezWorld::Update()
 
   // Swap our double buffered stack allocator
   m_Data.m_StackAllocator.Swap();
+
+  m_Data.m_LastUpdateDuration = ezTime::Now() - tStart;
+
+  {
+    ezStringBuilder sStatName;
+    sStatName.Format("World Update/{0}/Update Time", m_Data.m_sName);
+
+    ezStats::SetStat(sStatName, m_Data.m_LastUpdateDuration);
+  }
+}
+
+void ezWorld::GetUpdateSchedule(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase, ezDynamicArray<ezDynamicArray<ezHashedString>>& out_Batches)
+{
+  CheckForWriteAccess();
+  EZ_ASSERT_DEV(phase != ezWorldModule::UpdateFunctionDesc::Phase::Async, "The async phase is not scheduled in batches");
+
+  if (m_Data.m_bUpdateScheduleDirty[phase])
+  {
+    m_Data.BuildUpdateSchedule(phase);
+  }
+
+  const ezDynamicArrayBase<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[phase];
+  const ezDynamicArrayBase<ezInternal::WorldData::UpdateBatch>& batches = m_Data.m_UpdateBatches[phase];
+
+  out_Batches.Clear();
+  out_Batches.SetCount(batches.GetCount());
+
+  for (ezUInt32 i = 0; i < batches.GetCount(); ++i)
+  {
+    const ezArrayPtr<const ezUInt32> functionIndices =
+      m_Data.m_UpdateSchedule[phase].GetArrayPtr().GetSubArray(batches[i].m_uiFirstFunction, batches[i].m_uiNumFunctions);
+
+    for (ezUInt32 uiFunctionIndex : functionIndices)
+    {
+      out_Batches[i].PushBack(updateFunctions[uiFunctionIndex].m_sFunctionName);
+    }
+  }
+}
+
+// static
+void ezWorld::UpdateWorlds(ezArrayPtr<ezWorld*> worlds)
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  for (ezUInt32 i = 0; i < worlds.GetCount(); ++i)
+  {
+    for (ezUInt32 j = i + 1; j < worlds.GetCount(); ++j)
+    {
+      EZ_ASSERT_DEV(worlds[i] != worlds[j], "World '{0}' must only be updated once", worlds[i]->GetName());
+    }
+  }
+#endif
+
+  if (worlds.IsEmpty())
+    return;
+
+  // no need to go through the task system for a single world
+  if (worlds.GetCount() == 1)
+  {
+    worlds[0]->UpdateFromThread();
+    return;
+  }
+
+  ezTaskGroupID updateWorldsTaskID = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+  for (ezWorld* pWorld : worlds)
+  {
+    ezTaskSystem::AddTaskToGroup(updateWorldsTaskID, pWorld->GetUpdateTask());
+  }
+
+  ezTaskSystem::StartTaskGroup(updateWorldsTaskID);
+  ezTaskSystem::WaitForGroup(updateWorldsTaskID);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -445,9 +530,8 @@ void ezWorld::DeleteModule(const ezRTTI* pRtti)
 
 ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti)
 {
-  CheckForWriteAccess();
-
   const ezUInt16 uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+  CheckForModuleAccess(uiTypeId, true);
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return m_Data.m_Modules[uiTypeId];
@@ -461,6 +545,7 @@ const ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti) const
   CheckForReadAccess();
 
   const ezUInt16 uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+  CheckForModuleAccess(uiTypeId, false);
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return m_Data.m_Modules[uiTypeId];
@@ -469,6 +554,22 @@ const ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti) const
   return nullptr;
 }
 
+void ezWorld::CheckForDeclaredModuleAccess(ezUInt16 uiTypeId, bool bWrite) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  const ezInternal::WorldData::RegisteredUpdateFunction* pFunction = ezInternal::WorldData::CurrentParallelUpdateFunction();
+  if (pFunction == nullptr)
+  {
+    EZ_ASSERT_DEV(!bWrite, "Trying to write to World '{0}', but it is not marked for writing.", GetName());
+    return;
+  }
+
+  EZ_ASSERT_DEV(pFunction->CanAccessModule(uiTypeId, bWrite),
+    "Update function '{0}' accesses a world module for {1} that it has not declared in its update function description.",
+    pFunction->m_sFunctionName, bWrite ? "writing" : "reading");
+#endif
+}
+
 void ezWorld::SetParent(ezGameObject* pObject, ezGameObject* pNewParent, ezGameObject::TransformPreservation preserve)
 {
   EZ_ASSERT_DEV(pObject != pNewParent, "Object can't be its own parent!");
@@ -612,7 +713,7 @@ const char* ezWorld::GetObjectGlobalKey(const ezGameObject* pObject) const
   return "";
 }
 
-void ezWorld::ProcessQueuedMessage(const ezInternal::WorldData::MessageQueue::Entry& entry)
+void ezWorld::ProcessQueuedMessage(const ezInternal::WorldData::QueuedMsg& entry)
 {
   if (entry.m_MetaData.m_uiReceiverIsComponent)
   {
@@ -670,61 +771,60 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
 
   struct MessageComparer
   {
-    EZ_FORCE_INLINE bool Less(
-      const ezInternal::WorldData::MessageQueue::Entry& a, const ezInternal::WorldData::MessageQueue::Entry& b) const
+    EZ_FORCE_INLINE bool Less(const ezInternal::WorldData::QueuedMsg& a, const ezInternal::WorldData::QueuedMsg& b) const
     {
       if (a.m_MetaData.m_Due != b.m_MetaData.m_Due)
         return a.m_MetaData.m_Due < b.m_MetaData.m_Due;
 
-      const ezInt32 iKeyA = a.m_pMessage->GetSortingKey();
-      const ezInt32 iKeyB = b.m_pMessage->GetSortingKey();
-      if (iKeyA != iKeyB)
-        return iKeyA < iKeyB;
-
-      if (a.m_pMessage->GetId() != b.m_pMessage->GetId())
-        return a.m_pMessage->GetId() < b.m_pMessage->GetId();
+      if (a.m_MetaData.m_uiSortKey != b.m_MetaData.m_uiSortKey)
+        return a.m_MetaData.m_uiSortKey < b.m_MetaData.m_uiSortKey;
 
       if (a.m_MetaData.m_uiReceiverComponent != b.m_MetaData.m_uiReceiverComponent)
         return a.m_MetaData.m_uiReceiverComponent < b.m_MetaData.m_uiReceiverComponent;
 
-      return a.m_pMessage->GetHash() < b.m_pMessage->GetHash();
+      return a.m_MetaData.m_uiMessageHash < b.m_MetaData.m_uiMessageHash;
     }
   };
 
   // regular messages
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
-    queue.Sort(MessageComparer());
 
-    for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
+    // messages that are posted while the queue is processed are handled in the same phase
+    m_Data.MergePostBuffers();
+
+    while (!queue.IsEmpty())
     {
-      ProcessQueuedMessage(queue[i]);
+      queue.Sort(MessageComparer());
 
-      // no need to deallocate these messages, they are allocated through a frame allocator
-    }
+      for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
+      {
+        ProcessQueuedMessage(queue[i]);
 
-    queue.Clear();
+        // no need to deallocate these messages, they are allocated through a frame allocator
+      }
+
+      queue.Clear();
+
+      m_Data.MergePostBuffers();
+    }
   }
 
   // timed messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
-    queue.Sort(MessageComparer());
+    ezInternal::WorldData::MessageQueue& dueMessages = m_Data.m_DueMessages;
+    m_Data.m_TimedMessageWheels[queueType].CollectDueMessages(m_Data.m_Clock.GetAccumulatedTime(), dueMessages);
 
-    const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
+    dueMessages.Sort(MessageComparer());
 
-    while (!queue.IsEmpty())
+    for (ezUInt32 i = 0; i < dueMessages.GetCount(); ++i)
     {
-      auto& entry = queue.Peek();
-      if (entry.m_MetaData.m_Due > now)
-        break;
-
-      ProcessQueuedMessage(entry);
-
-      EZ_DELETE(&m_Data.m_Allocator, entry.m_pMessage);
+      ProcessQueuedMessage(dueMessages[i]);
 
-      queue.Dequeue();
+      EZ_DELETE(&m_Data.m_Allocator, dueMessages[i].m_pMessage);
     }
+
+    dueMessages.Clear();
   }
 }
 
@@ -754,6 +854,7 @@ void ezWorld::DeregisterUpdateFunction(const ezComponentManagerBase::UpdateFunct
     if (updateFunctions[i].m_Function.IsEqualIfComparable(desc.m_Function))
     {
       updateFunctions.RemoveAtAndCopy(i);
+      m_Data.m_bUpdateScheduleDirty[desc.m_Phase.GetValue()] = true;
     }
   }
 }
@@ -772,13 +873,42 @@ void ezWorld::DeregisterUpdateFunctions(ezWorldModule* pModule)
       if (updateFunctions[i].m_Function.GetClassInstance() == pModule)
       {
         updateFunctions.RemoveAtAndCopy(i);
+        m_Data.m_bUpdateScheduleDirty[phase] = true;
       }
     }
   }
 }
 
+void ezWorld::BeginDeferringComponentInitialization(ezDynamicArrayBase<ezComponentHandle>& ref_Components)
+{
+  CheckForWriteAccess();
+  EZ_ASSERT_DEV(m_Data.m_pDeferredComponentsToInitialize == nullptr, "Component initialization is already deferred");
+
+  m_Data.m_pDeferredComponentsToInitialize = &ref_Components;
+}
+
+void ezWorld::EndDeferringComponentInitialization()
+{
+  CheckForWriteAccess();
+
+  m_Data.m_pDeferredComponentsToInitialize = nullptr;
+}
+
+void ezWorld::QueueComponentsForInitialization(ezArrayPtr<const ezComponentHandle> components)
+{
+  CheckForWriteAccess();
+
+  m_Data.m_ComponentsToInitialize.PushBackRange(components);
+}
+
 void ezWorld::AddComponentToInitialize(ezComponentHandle hComponent)
 {
+  if (m_Data.m_pDeferredComponentsToInitialize != nullptr)
+  {
+    m_Data.m_pDeferredComponentsToInitialize->PushBack(hComponent);
+    return;
+  }
+
   m_Data.m_ComponentsToInitialize.PushBack(hComponent);
 }
 
@@ -789,22 +919,95 @@ void ezWorld::UpdateFromThread()
   Update();
 }
 
-void ezWorld::UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions)
+void ezWorld::UpdateSynchronous(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase)
 {
-  ezWorldModule::UpdateContext context;
-  context.m_uiFirstComponentIndex = 0;
-  context.m_uiComponentCount = ezInvalidIndex;
+  if (m_Data.m_bUpdateScheduleDirty[phase])
+  {
+    m_Data.BuildUpdateSchedule(phase);
+  }
 
-  for (auto& updateFunction : updateFunctions)
+  for (const auto& batch : m_Data.m_UpdateBatches[phase])
   {
-    if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
-      continue;
+    UpdateSynchronousBatch(phase, batch);
+  }
+}
+
+void ezWorld::UpdateSynchronousBatch(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase, const ezInternal::WorldData::UpdateBatch& batch)
+{
+  ezDynamicArrayBase<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[phase];
+  const ezArrayPtr<const ezUInt32> functionIndices =
+    m_Data.m_UpdateSchedule[phase].GetArrayPtr().GetSubArray(batch.m_uiFirstFunction, batch.m_uiNumFunctions);
+
+  ezUInt32 uiNumFunctionsToUpdate = 0;
+  for (ezUInt32 uiFunctionIndex : functionIndices)
+  {
+    if (!updateFunctions[uiFunctionIndex].m_bOnlyUpdateWhenSimulating || m_Data.m_bSimulateWorld)
+      ++uiNumFunctionsToUpdate;
+  }
+
+  if (uiNumFunctionsToUpdate == 0)
+    return;
+
+  // a single function is called directly, with the world still marked for writing
+  if (uiNumFunctionsToUpdate == 1)
+  {
+    ezWorldModule::UpdateContext context;
+    context.m_uiFirstComponentIndex = 0;
+    context.m_uiComponentCount = ezInvalidIndex;
 
+    for (ezUInt32 uiFunctionIndex : functionIndices)
     {
+      auto& updateFunction = updateFunctions[uiFunctionIndex];
+      if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
+        continue;
+
       EZ_PROFILE_SCOPE(updateFunction.m_sFunctionName);
       updateFunction.m_Function(context);
     }
+
+    return;
   }
+
+  // remove the write marker like in the async phase, the functions may only access the modules they have declared
+  m_Data.m_WriteThreadID = (ezThreadID)0;
+
+  ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
+  // the async phase is done at this point, so its tasks can be reused
+  ezUInt32 uiCurrentTaskIndex = 0;
+
+  for (ezUInt32 uiFunctionIndex : functionIndices)
+  {
+    auto& updateFunction = updateFunctions[uiFunctionIndex];
+    if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
+      continue;
+
+    ezInternal::WorldData::UpdateTask* pTask;
+    if (uiCurrentTaskIndex < m_Data.m_UpdateTasks.GetCount())
+    {
+      pTask = m_Data.m_UpdateTasks[uiCurrentTaskIndex];
+    }
+    else
+    {
+      pTask = EZ_NEW(&m_Data.m_Allocator, ezInternal::WorldData::UpdateTask);
+      m_Data.m_UpdateTasks.PushBack(pTask);
+    }
+
+    pTask->SetTaskName(updateFunction.m_sFunctionName);
+    pTask->m_Function = updateFunction.m_Function;
+    pTask->m_pParallelFunction = &updateFunction;
+    pTask->m_uiStartIndex = 0;
+    pTask->m_uiCount = ezInvalidIndex;
+    ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
+
+    ++uiCurrentTaskIndex;
+  }
+
+  ezTaskSystem::StartTaskGroup(taskGroupId);
+  ezTaskSystem::WaitForGroup(taskGroupId);
+
+  // restore write marker
+  m_Data.m_WriteThreadID = ezThreadUtils::GetCurrentThreadID();
 }
 
 void ezWorld::UpdateAsynchronous()
@@ -842,6 +1045,7 @@ void ezWorld::UpdateAsynchronous()
 
       pTask->SetTaskName(updateFunction.m_sFunctionName);
       pTask->m_Function = updateFunction.m_Function;
+      pTask->m_pParallelFunction = nullptr;
       pTask->m_uiStartIndex = uiStartIndex;
       pTask->m_uiCount = (uiStartIndex + uiGranularity < uiTotalCount) ? uiGranularity : ezInvalidIndex;
       ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
@@ -976,6 +1180,16 @@ ezResult ezWorld::RegisterUpdateFunctionInternal(const ezWorldModule::UpdateFunc
   ezInternal::WorldData::RegisteredUpdateFunction newFunction;
   newFunction.FillFromDesc(desc);
 
+  // the function always writes to the module it belongs to
+  for (ezUInt32 uiTypeId = 0; uiTypeId < m_Data.m_Modules.GetCount(); ++uiTypeId)
+  {
+    if (m_Data.m_Modules[uiTypeId] == desc.m_Function.GetClassInstance())
+    {
+      newFunction.m_WritesTo.PushBack(static_cast<ezUInt16>(uiTypeId));
+      break;
+    }
+  }
+
   while (uiInsertionIndex < updateFunctions.GetCount())
   {
     const auto& existingFunction = updateFunctions[uiInsertionIndex];
@@ -988,6 +1202,7 @@ ezResult ezWorld::RegisterUpdateFunctionInternal(const ezWorldModule::UpdateFunc
   }
 
   updateFunctions.Insert(newFunction, uiInsertionIndex);
+  m_Data.m_bUpdateScheduleDirty[desc.m_Phase.GetValue()] = true;
 
   return EZ_SUCCESS;
 }
@@ -998,11 +1213,13 @@ void ezWorld::DeleteDeadObjects()
   {
     ezGameObject* pObject = m_Data.m_DeadObjects.GetIterator().Key();
 
-    if (!pObject->m_pTransformationData->m_hSpatialData.IsInvalidated())
+    ezGameObject::ColdTransformationData* pColdData = pObject->m_pTransformationData->m_pColdData;
+    if (!pColdData->m_hSpatialData.IsInvalidated())
     {
-      m_Data.m_pSpatialSystem->DeleteSpatialData(pObject->m_pTransformationData->m_hSpatialData);
+      m_Data.m_pSpatialSystem->DeleteSpatialData(pColdData->m_hSpatialData);
     }
 
+    m_Data.m_ColdTransformationStorage.Delete(pColdData);
     m_Data.DeleteTransformationData(pObject->IsDynamic(), pObject->m_uiHierarchyLevel, pObject->m_pTransformationData);
 
     ezGameObject* pMovedObject = nullptr;
@@ -1030,34 +1247,45 @@ void ezWorld::DeleteDeadObjects()
 
 void ezWorld::DeleteDeadComponents()
 {
-  while (!m_Data.m_DeadComponents.IsEmpty())
-  {
-    ezComponent* pComponent = m_Data.m_DeadComponents.GetIterator().Key();
+  const ezUInt32 uiNumDeadComponents = m_Data.m_DeadComponents.GetCount();
+  if (uiNumDeadComponents == 0)
+    return;
+
+  // delete all dead components of a manager at once, so its storage is compacted in a single pass
+  m_Data.m_DeadComponents.Sort([](const ezComponent* a, const ezComponent* b) { return a->GetOwningManager() < b->GetOwningManager(); });
+
+  ezHybridArray<ezComponentManagerBase::MovedComponent, 64> movedComponents;
 
-    ezComponentManagerBase* pManager = pComponent->GetOwningManager();
-    ezComponent* pMovedComponent = nullptr;
-    pManager->DeleteComponentStorage(pComponent, pMovedComponent);
+  ezUInt32 uiFirstComponent = 0;
+  while (uiFirstComponent < uiNumDeadComponents)
+  {
+    ezComponentManagerBase* pManager = m_Data.m_DeadComponents[uiFirstComponent]->GetOwningManager();
 
-    // another component has been moved to the deleted component location
-    if (pComponent != pMovedComponent)
+    ezUInt32 uiEndComponent = uiFirstComponent + 1;
+    while (uiEndComponent < uiNumDeadComponents && m_Data.m_DeadComponents[uiEndComponent]->GetOwningManager() == pManager)
     {
-      pManager->PatchIdTable(pComponent);
+      ++uiEndComponent;
+    }
 
-      if (ezGameObject* pOwner = pComponent->GetOwner())
-      {
-        pOwner->FixComponentPointer(pMovedComponent, pComponent);
-      }
+    movedComponents.Clear();
+    pManager->DeleteComponentStorage(
+      m_Data.m_DeadComponents.GetArrayPtr().GetSubArray(uiFirstComponent, uiEndComponent - uiFirstComponent), movedComponents);
+
+    // other components have been moved to the locations of deleted components
+    for (const auto& movedComponent : movedComponents)
+    {
+      pManager->PatchIdTable(movedComponent.m_pNewLocation);
 
-      // The moved component might be deleted as well so we remove it from the dead components set instead.
-      // If that is not the case we remove the original component from the set.
-      if (m_Data.m_DeadComponents.Remove(pMovedComponent))
+      if (ezGameObject* pOwner = movedComponent.m_pNewLocation->GetOwner())
       {
-        continue;
+        pOwner->FixComponentPointer(movedComponent.m_pOldLocation, movedComponent.m_pNewLocation);
       }
     }
 
-    m_Data.m_DeadComponents.Remove(pComponent);
+    uiFirstComponent = uiEndComponent;
   }
+
+  m_Data.m_DeadComponents.Clear();
 }
 
 void ezWorld::PatchHierarchyData(ezGameObject* pObject, ezGameObject::TransformPreservation preserve)
@@ -1077,6 +1305,8 @@ void ezWorld::PatchHierarchyData(ezGameObject* pObject, ezGameObject::TransformP
     pObject->UpdateGlobalTransform();
   }
 
+  pObject->MarkTransformDirty();
+
   for (auto it = pObject->GetChildren(); it.IsValid(); ++it)
   {
     PatchHierarchyData(it, preserve);
@@ -1099,6 +1329,7 @@ void ezWorld::RecreateHierarchyData(ezGameObject* pObject, bool bWasDynamic)
 
     ezGameObject::TransformationData* pNewTransformationData = m_Data.CreateTransformationData(bIsDynamic, uiNewHierarchyLevel);
     ezMemoryUtils::Copy(pNewTransformationData, pOldTransformationData, 1);
+    pNewTransformationData->m_uiDirtyIndex = 0;
 
     pObject->m_uiHierarchyLevel = uiNewHierarchyLevel;
     pObject->m_pTransformationData = pNewTransformationData;
@@ -1111,6 +1342,8 @@ void ezWorld::RecreateHierarchyData(ezGameObject* pObject, bool bWasDynamic)
     }
 
     m_Data.DeleteTransformationData(bWasDynamic, uiOldHierarchyLevel, pOldTransformationData);
+
+    pObject->MarkTransformDirty();
   }
 }
 
@@ -25,13 +25,28 @@ namespace ezInternal
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+  // static
+  const WorldData::RegisteredUpdateFunction*& WorldData::CurrentParallelUpdateFunction()
+  {
+    static thread_local const RegisteredUpdateFunction* s_pFunction = nullptr;
+    return s_pFunction;
+  }
+
   void WorldData::UpdateTask::Execute()
   {
     ezWorldModule::UpdateContext context;
     context.m_uiFirstComponentIndex = m_uiStartIndex;
     context.m_uiComponentCount = m_uiCount;
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    // a thread that waits for other tasks might run this task while it is in the middle of another one
+    const RegisteredUpdateFunction* pPrevFunction = CurrentParallelUpdateFunction();
+    CurrentParallelUpdateFunction() = m_pParallelFunction;
     m_Function(context);
+    CurrentParallelUpdateFunction() = pPrevFunction;
+#else
+    m_Function(context);
+#endif
   }
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +58,7 @@ namespace ezInternal
       , m_BlockAllocator(desc.m_sName, &m_Allocator)
       , m_StackAllocator(ezFoundation::GetAlignedAllocator())
       , m_ObjectStorage(&m_BlockAllocator, &m_Allocator)
+      , m_ColdTransformationStorage(&m_BlockAllocator, &m_Allocator)
       , m_Clock(desc.m_sName)
       , m_WriteThreadID((ezThreadID)0)
       , m_iWriteCounter(0)
@@ -66,14 +82,25 @@ namespace ezInternal
     // insert dummy entry to save some checks
     m_Objects.Insert(nullptr);
 
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::TransformationData) == 128);
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
-    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::TransformationData) == 224);
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::ColdTransformationData) == 112);
 #else
-    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::TransformationData) == 192);
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::ColdTransformationData) == 80);
 #endif
 
     // EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject) == 128); /// \todo get game object size back to 128
-    EZ_CHECK_AT_COMPILETIME(sizeof(QueuedMsgMetaData) == 16);
+    EZ_CHECK_AT_COMPILETIME(sizeof(QueuedMsgMetaData) == 32);
+
+    for (ezUInt32 i = 0; i < MAX_POST_BUFFERS; ++i)
+    {
+      m_PostBuffers[i] = nullptr;
+    }
+
+    for (ezUInt32 i = 0; i < ezWorldModule::UpdateFunctionDesc::Phase::COUNT; ++i)
+    {
+      m_bUpdateScheduleDirty[i] = true;
+    }
 
     m_pSpatialSystem = std::move(desc.m_pSpatialSystem);
     m_pCoordinateSystemProvider = desc.m_pCoordinateSystemProvider;
@@ -116,6 +143,11 @@ namespace ezInternal
       }
     }
 
+    for (DirtyTransformationList* pDirtyList : m_DirtyTransformations)
+    {
+      EZ_DELETE(&m_Allocator, pDirtyList);
+    }
+
     // delete task storage
     for (ezUInt32 i = 0; i < m_UpdateTasks.GetCount(); ++i)
     {
@@ -123,26 +155,88 @@ namespace ezInternal
     }
 
     // delete queued messages
-    for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
+    // The messages in the regular queues are allocated through a frame allocator and thus mustn't (and don't need to be) deallocated
     {
+      MergePostBuffers();
+
+      for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
       {
-        MessageQueue& queue = m_MessageQueues[i];
+        m_TimedMessageWheels[i].CollectAllMessages(m_DueMessages);
+      }
 
-        // The messages in this queue are allocated through a frame allocator and thus mustn't (and don't need to be) deallocated
-        queue.Clear();
+      for (QueuedMsg& msg : m_DueMessages)
+      {
+        EZ_DELETE(&m_Allocator, msg.m_pMessage);
       }
 
+      for (ezUInt32 i = 0; i < MAX_POST_BUFFERS; ++i)
       {
-        MessageQueue& queue = m_TimedMessageQueues[i];
-        while (!queue.IsEmpty())
-        {
-          MessageQueue::Entry& entry = queue.Peek();
-          EZ_DELETE(&m_Allocator, entry.m_pMessage);
+        PostBuffer* pBuffer = m_PostBuffers[i];
+        EZ_DELETE(&m_Allocator, pBuffer);
+      }
+    }
+  }
+
+  void WorldData::BuildUpdateSchedule(ezUInt32 uiPhase)
+  {
+    const ezDynamicArrayBase<RegisteredUpdateFunction>& updateFunctions = m_UpdateFunctions[uiPhase];
+    const ezUInt32 uiNumFunctions = updateFunctions.GetCount();
 
-          queue.Dequeue();
+    // The registered order respects dependencies and priorities, so a function only needs to wait for earlier functions it conflicts with.
+    // Each function goes into the first batch after all of those.
+    ezHybridArray<ezUInt32, 64> batchIndices;
+    batchIndices.SetCountUninitialized(uiNumFunctions);
+
+    ezUInt32 uiNumBatches = 0;
+    for (ezUInt32 i = 0; i < uiNumFunctions; ++i)
+    {
+      ezUInt32 uiBatch = 0;
+      for (ezUInt32 j = 0; j < i; ++j)
+      {
+        if (batchIndices[j] >= uiBatch && updateFunctions[i].ConflictsWith(updateFunctions[j]))
+        {
+          uiBatch = batchIndices[j] + 1;
         }
       }
+
+      batchIndices[i] = uiBatch;
+      uiNumBatches = ezMath::Max(uiNumBatches, uiBatch + 1);
+    }
+
+    ezDynamicArrayBase<UpdateBatch>& batches = m_UpdateBatches[uiPhase];
+    batches.SetCount(uiNumBatches);
+
+    for (ezUInt32 i = 0; i < uiNumBatches; ++i)
+    {
+      batches[i].m_uiFirstFunction = 0;
+      batches[i].m_uiNumFunctions = 0;
+    }
+
+    for (ezUInt32 i = 0; i < uiNumFunctions; ++i)
+    {
+      batches[batchIndices[i]].m_uiNumFunctions++;
     }
+
+    ezUInt32 uiFirstFunction = 0;
+    for (UpdateBatch& batch : batches)
+    {
+      batch.m_uiFirstFunction = uiFirstFunction;
+      uiFirstFunction += batch.m_uiNumFunctions;
+      batch.m_uiNumFunctions = 0;
+    }
+
+    // within a batch the functions keep their registered order, so they are started deterministically
+    ezDynamicArrayBase<ezUInt32>& schedule = m_UpdateSchedule[uiPhase];
+    schedule.SetCountUninitialized(uiNumFunctions);
+
+    for (ezUInt32 i = 0; i < uiNumFunctions; ++i)
+    {
+      UpdateBatch& batch = batches[batchIndices[i]];
+      schedule[batch.m_uiFirstFunction + batch.m_uiNumFunctions] = i;
+      batch.m_uiNumFunctions++;
+    }
+
+    m_bUpdateScheduleDirty[uiPhase] = false;
   }
 
   ezGameObject::TransformationData* WorldData::CreateTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel)
@@ -179,11 +273,22 @@ namespace ezInternal
     Hierarchy::DataBlock& lastBlock = blocks.PeekBack();
     const ezGameObject::TransformationData* pLast = lastBlock.PopBack();
 
+    if (bDynamic)
+    {
+      RemoveDirtyTransformationData(pData, uiHierarchyLevel);
+    }
+
     if (pData != pLast)
     {
       ezMemoryUtils::Copy(pData, pLast, 1);
       pData->m_pObject->m_pTransformationData = pData;
 
+      // the dirty list still points to the old location
+      if (pData->m_uiDirtyIndex != 0)
+      {
+        (*m_DirtyTransformations[uiHierarchyLevel])[pData->m_uiDirtyIndex - 1] = pData;
+      }
+
       // fix parent transform data for children as well
       auto it = pData->m_pObject->GetChildren();
       while (it.IsValid())
@@ -310,32 +415,377 @@ namespace ezInternal
 
     ezSimdFloat fInvDt = fInvDeltaSeconds;
 
-    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
-    if (!hierarchy.m_Data.IsEmpty())
+    // Only objects that have been marked dirty and their children are updated. Levels are processed top down, so a child always sees the
+    // final transform of its parent.
+    for (ezUInt32 uiLevel = 0; uiLevel < m_DirtyTransformations.GetCount(); ++uiLevel)
     {
-      auto dataPtr = hierarchy.m_Data.GetData();
+      DirtyTransformationList& dirtyList = *m_DirtyTransformations[uiLevel];
+      if (dirtyList.IsEmpty())
+        continue;
 
       // If we have no spatial system, we perform multi-threaded update as we do not
       // have to acquire a write lock in the process.
       if (m_pSpatialSystem == nullptr)
       {
-        TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &fInvDt);
+        if (uiLevel == 0)
+          TraverseDirtyListMultiThreaded<RootLevel>(dirtyList, &fInvDt);
+        else
+          TraverseDirtyListMultiThreaded<WithParent>(dirtyList, &fInvDt);
+      }
+      else
+      {
+        if (uiLevel == 0)
+          TraverseDirtyList<RootLevelWithSpatialData>(dirtyList, &fInvDt);
+        else
+          TraverseDirtyList<WithParentWithSpatialData>(dirtyList, &fInvDt);
+      }
 
-        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
+      PropagateDirtyTransformations(uiLevel);
+    }
+  }
+
+  void WorldData::MarkTransformationDataDirty(ezGameObject::TransformationData* pData, ezUInt32 uiHierarchyLevel)
+  {
+    // components may move their owners during the async phase
+    EZ_LOCK(m_DirtyTransformationsMutex);
+
+    MarkTransformationDataDirtyUnlocked(pData, uiHierarchyLevel);
+  }
+
+  void WorldData::MarkTransformationDataDirtyUnlocked(ezGameObject::TransformationData* pData, ezUInt32 uiHierarchyLevel)
+  {
+    if (pData->m_uiDirtyIndex != 0)
+      return;
+
+    while (uiHierarchyLevel >= m_DirtyTransformations.GetCount())
+    {
+      m_DirtyTransformations.PushBack(EZ_NEW(&m_Allocator, DirtyTransformationList, &m_Allocator));
+    }
+
+    DirtyTransformationList& dirtyList = *m_DirtyTransformations[uiHierarchyLevel];
+    dirtyList.PushBack(pData);
+    pData->m_uiDirtyIndex = dirtyList.GetCount();
+  }
+
+  void WorldData::RemoveDirtyTransformationData(ezGameObject::TransformationData* pData, ezUInt32 uiHierarchyLevel)
+  {
+    if (pData->m_uiDirtyIndex == 0)
+      return;
+
+    DirtyTransformationList& dirtyList = *m_DirtyTransformations[uiHierarchyLevel];
+    const ezUInt32 uiIndex = pData->m_uiDirtyIndex - 1;
+
+    dirtyList.RemoveAtAndSwap(uiIndex);
+    if (uiIndex < dirtyList.GetCount())
+    {
+      dirtyList[uiIndex]->m_uiDirtyIndex = uiIndex + 1;
+    }
+
+    pData->m_uiDirtyIndex = 0;
+  }
+
+  void WorldData::PropagateDirtyTransformations(ezUInt32 uiHierarchyLevel)
+  {
+    DirtyTransformationList& dirtyList = *m_DirtyTransformations[uiHierarchyLevel];
+
+    ezUInt32 uiStillDirtyCount = 0;
+    for (ezUInt32 i = 0; i < dirtyList.GetCount(); ++i)
+    {
+      ezGameObject::TransformationData* pData = dirtyList[i];
+
+      // children of dynamic objects are always dynamic
+      ezGameObject* pObject = pData->m_pObject;
+      if (pObject->GetChildCount() > 0)
+      {
+        for (auto it = pObject->GetChildren(); it.IsValid(); ++it)
         {
-          TraverseHierarchyLevelMultiThreaded<WithParent>(*dataPtr[i], &fInvDt);
+          MarkTransformationDataDirtyUnlocked(it->m_pTransformationData, uiHierarchyLevel + 1);
         }
       }
-      else
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+      // an object that moved needs one more update once it stops, otherwise its velocity would never drop to zero
+      if (!pData->m_pColdData->m_velocity.IsZero<3>())
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &fInvDt);
+        dirtyList[uiStillDirtyCount] = pData;
+        pData->m_uiDirtyIndex = ++uiStillDirtyCount;
+        continue;
+      }
+#endif
+
+      pData->m_uiDirtyIndex = 0;
+    }
+
+    dirtyList.SetCountUninitialized(uiStillDirtyCount);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  WorldData::PostBuffer::PostBuffer(ezAllocatorBase* pAllocator)
+      : m_Messages(pAllocator)
+  {
+  }
+
+  // bit i is set while a thread owns post buffer index i
+  static ezAtomicInteger64 s_iUsedPostBufferIndices;
 
-        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
+  // Claims a post buffer index for the current thread and hands it back once the thread exits, so that threads which come and go
+  // do not use up the indices.
+  struct WorldData::ThreadPostBufferIndex
+  {
+    EZ_CHECK_AT_COMPILETIME_MSG(MAX_POST_BUFFERS <= 64, "Post buffer indices are tracked in a 64 bit mask");
+
+    ~ThreadPostBufferIndex()
+    {
+      // messages that are still in the buffers are merged as usual, the next thread with this index just appends to them
+      if (m_bOwned)
+      {
+        s_iUsedPostBufferIndices.And(~(ezInt64(1) << m_uiIndex));
+      }
+    }
+
+    void Claim()
+    {
+      for (ezUInt32 i = 0; i < MAX_POST_BUFFERS;)
+      {
+        const ezInt64 iUsed = s_iUsedPostBufferIndices;
+        const ezInt64 iBit = ezInt64(1) << i;
+
+        if ((iUsed & iBit) != 0)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &fInvDt);
+          ++i;
+          continue;
         }
+
+        // if another thread changed the mask in the meantime, look at this index again
+        if (s_iUsedPostBufferIndices.TestAndSet(iUsed, iUsed | iBit))
+        {
+          m_uiIndex = i;
+          m_bOwned = true;
+          return;
+        }
+      }
+
+      // all indices are taken, threads beyond the limit share the last buffer without owning it
+      m_uiIndex = MAX_POST_BUFFERS - 1;
+    }
+
+    ezUInt32 m_uiIndex = ezInvalidIndex;
+    bool m_bOwned = false;
+  };
+
+  // static
+  ezUInt32 WorldData::GetPostBufferIndex()
+  {
+    static thread_local ThreadPostBufferIndex s_PostBufferIndex;
+
+    if (s_PostBufferIndex.m_uiIndex == ezInvalidIndex)
+    {
+      // the index is shared by all worlds
+      s_PostBufferIndex.Claim();
+    }
+
+    return s_PostBufferIndex.m_uiIndex;
+  }
+
+  // static
+  ezUInt64 WorldData::GetUsedPostBufferIndices()
+  {
+    const ezInt64 iUsed = s_iUsedPostBufferIndices;
+    return static_cast<ezUInt64>(iUsed);
+  }
+
+  WorldData::PostBuffer& WorldData::GetPostBuffer() const
+  {
+    PostBuffer*& pBuffer = m_PostBuffers[GetPostBufferIndex()];
+
+    if (pBuffer == nullptr)
+    {
+      PostBuffer* pNewBuffer = EZ_NEW(&m_Allocator, PostBuffer, &m_Allocator);
+
+      // only the shared buffer of the last index can be created by two threads at the same time
+      if (!ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&pBuffer), nullptr, pNewBuffer))
+      {
+        EZ_DELETE(&m_Allocator, pNewBuffer);
       }
     }
+
+    return *pBuffer;
+  }
+
+  void WorldData::MergePostBuffers()
+  {
+    for (ezUInt32 i = 0; i < MAX_POST_BUFFERS; ++i)
+    {
+      PostBuffer* pBuffer = m_PostBuffers[i];
+      if (pBuffer == nullptr)
+        continue;
+
+      {
+        EZ_LOCK(pBuffer->m_Mutex);
+
+        if (pBuffer->m_Messages.IsEmpty())
+          continue;
+
+        // keep the lock short, the posting thread gets the empty scratch array in exchange
+        pBuffer->m_Messages.Swap(m_PostBufferScratch);
+      }
+
+      for (const QueuedMsg& msg : m_PostBufferScratch)
+      {
+        if (msg.m_MetaData.m_uiIsTimed)
+        {
+          m_TimedMessageWheels[msg.m_MetaData.m_uiQueueType].Insert(msg);
+        }
+        else
+        {
+          m_MessageQueues[msg.m_MetaData.m_uiQueueType].PushBack(msg);
+        }
+      }
+
+      m_PostBufferScratch.Clear();
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  WorldData::TimedMessageWheel::TimedMessageWheel()
+      : m_uiCurrentTick(0)
+      , m_uiCount(0)
+  {
+  }
+
+  // static
+  ezUInt64 WorldData::TimedMessageWheel::GetTick(ezTime time)
+  {
+    return static_cast<ezUInt64>(ezMath::Max(time.GetSeconds(), 0.0) * TICKS_PER_SECOND);
+  }
+
+  void WorldData::TimedMessageWheel::Insert(const QueuedMsg& msg)
+  {
+    InsertAtTick(msg, GetTick(msg.m_MetaData.m_Due));
+    ++m_uiCount;
+  }
+
+  void WorldData::TimedMessageWheel::InsertAtTick(const QueuedMsg& msg, ezUInt64 uiTick)
+  {
+    // messages that are already due go into the current slot
+    uiTick = ezMath::Max(uiTick, m_uiCurrentTick);
+
+    // find the lowest level on which the tick shares its parent slot with the current tick
+    for (ezUInt32 uiLevel = 0; uiLevel < LEVEL_COUNT; ++uiLevel)
+    {
+      const ezUInt32 uiParentShift = (uiLevel + 1) * SLOT_BITS;
+      if ((uiTick >> uiParentShift) == (m_uiCurrentTick >> uiParentShift))
+      {
+        const ezUInt32 uiSlot = (uiTick >> (uiLevel * SLOT_BITS)) & (SLOT_COUNT - 1);
+        m_Slots[uiLevel][uiSlot].PushBack(msg);
+        return;
+      }
+    }
+
+    m_Overflow.PushBack(msg);
+  }
+
+  void WorldData::TimedMessageWheel::Cascade(MessageQueue& slot)
+  {
+    if (slot.IsEmpty())
+      return;
+
+    // messages in the overflow may end up in the overflow again and are appended to the same array
+    const ezUInt32 uiCount = slot.GetCount();
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const QueuedMsg msg = slot[i];
+      InsertAtTick(msg, GetTick(msg.m_MetaData.m_Due));
+    }
+
+    slot.RemoveAtAndCopy(0, uiCount);
+  }
+
+  void WorldData::TimedMessageWheel::CollectDueMessages(ezTime now, ezDynamicArrayBase<QueuedMsg>& out_DueMessages)
+  {
+    const ezUInt64 uiNowTick = GetTick(now);
+
+    if (uiNowTick < m_uiCurrentTick && m_uiCount > 0)
+    {
+      // the clock has been set back, re-insert everything relative to the new time
+      ezDynamicArray<QueuedMsg> allMessages;
+      CollectAllMessages(allMessages);
+
+      m_uiCurrentTick = uiNowTick;
+      for (const QueuedMsg& msg : allMessages)
+      {
+        Insert(msg);
+      }
+    }
+
+    while (m_uiCount > 0)
+    {
+      MessageQueue& slot = m_Slots[0][m_uiCurrentTick & (SLOT_COUNT - 1)];
+
+      if (m_uiCurrentTick == uiNowTick)
+      {
+        // the current slot is only partially due
+        for (ezUInt32 i = 0; i < slot.GetCount();)
+        {
+          if (slot[i].m_MetaData.m_Due <= now)
+          {
+            out_DueMessages.PushBack(slot[i]);
+            slot.RemoveAtAndSwap(i);
+            --m_uiCount;
+          }
+          else
+          {
+            ++i;
+          }
+        }
+
+        return;
+      }
+
+      // the whole slot lies before the current time
+      out_DueMessages.PushBackRange(slot);
+      m_uiCount -= slot.GetCount();
+      slot.Clear();
+
+      ++m_uiCurrentTick;
+
+      // entering a new slot on a higher level, move its messages down, highest level first
+      if ((m_uiCurrentTick & ((1ull << (LEVEL_COUNT * SLOT_BITS)) - 1)) == 0)
+      {
+        Cascade(m_Overflow);
+      }
+
+      for (ezUInt32 uiLevel = LEVEL_COUNT - 1; uiLevel > 0; --uiLevel)
+      {
+        const ezUInt32 uiShift = uiLevel * SLOT_BITS;
+        if ((m_uiCurrentTick & ((1ull << uiShift) - 1)) == 0)
+        {
+          Cascade(m_Slots[uiLevel][(m_uiCurrentTick >> uiShift) & (SLOT_COUNT - 1)]);
+        }
+      }
+    }
+
+    // nothing left, skip the empty slots
+    m_uiCurrentTick = uiNowTick;
+  }
+
+  void WorldData::TimedMessageWheel::CollectAllMessages(ezDynamicArrayBase<QueuedMsg>& out_Messages)
+  {
+    for (ezUInt32 uiLevel = 0; uiLevel < LEVEL_COUNT; ++uiLevel)
+    {
+      for (ezUInt32 uiSlot = 0; uiSlot < SLOT_COUNT; ++uiSlot)
+      {
+        out_Messages.PushBackRange(m_Slots[uiLevel][uiSlot]);
+        m_Slots[uiLevel][uiSlot].Clear();
+      }
+    }
+
+    out_Messages.PushBackRange(m_Overflow);
+    m_Overflow.Clear();
+
+    m_uiCount = 0;
   }
 } // namespace ezInternal
 
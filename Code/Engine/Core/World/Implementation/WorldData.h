@@ -17,6 +17,7 @@ namespace ezInternal
   {
     friend class ::ezWorld;
     friend class ::ezComponentManagerBase;
+    friend class ::ezGameObject;
 
     WorldData(ezWorldDesc& desc);
     ~WorldData();
@@ -38,6 +39,11 @@ namespace ezInternal
     ezIdTable<ezGameObjectId, ezGameObject*, ezLocalAllocatorWrapper> m_Objects;
     ObjectStorage m_ObjectStorage;
 
+    // velocity, bounds and spatial data of all objects, split off from the hierarchy transformation data
+    typedef ezBlockStorage<ezGameObject::ColdTransformationData, ezInternal::DEFAULT_BLOCK_SIZE, ezBlockStorageType::FreeList>
+      ColdTransformationStorage;
+    ColdTransformationStorage m_ColdTransformationStorage;
+
     ezSet<ezGameObject*, ezCompareHelper<ezGameObject*>, ezLocalAllocatorWrapper> m_DeadObjects;
 
     // hierarchy structures
@@ -67,10 +73,24 @@ namespace ezInternal
 
     void DeleteTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel, ezGameObject::TransformationData* pData);
 
+    // dirty tracking for the dynamic hierarchy, only objects in these lists are updated in UpdateGlobalTransforms
+    typedef ezDynamicArray<ezGameObject::TransformationData*> DirtyTransformationList;
+    ezHybridArray<DirtyTransformationList*, 8, ezLocalAllocatorWrapper> m_DirtyTransformations;
+    ezMutex m_DirtyTransformationsMutex;
+
+    /// \brief Adds the transformation data to the dirty list of its hierarchy level. Thread safe.
+    void MarkTransformationDataDirty(ezGameObject::TransformationData* pData, ezUInt32 uiHierarchyLevel);
+    void MarkTransformationDataDirtyUnlocked(ezGameObject::TransformationData* pData, ezUInt32 uiHierarchyLevel);
+    void RemoveDirtyTransformationData(ezGameObject::TransformationData* pData, ezUInt32 uiHierarchyLevel);
+    void PropagateDirtyTransformations(ezUInt32 uiHierarchyLevel);
+
     template <typename VISITOR>
     static ezVisitorExecution::Enum TraverseHierarchyLevel(Hierarchy::DataBlockArray& blocks, void* pUserData = nullptr);
+
+    template <typename VISITOR>
+    static void TraverseDirtyList(DirtyTransformationList& dirtyList, void* pUserData = nullptr);
     template <typename VISITOR>
-    static ezVisitorExecution::Enum TraverseHierarchyLevelMultiThreaded(Hierarchy::DataBlockArray& blocks, void* pUserData = nullptr);
+    static void TraverseDirtyListMultiThreaded(DirtyTransformationList& dirtyList, void* pUserData = nullptr);
 
     typedef ezDelegate<ezVisitorExecution::Enum(ezGameObject*)> VisitorFunc;
     void TraverseBreadthFirst(VisitorFunc& func);
@@ -94,21 +114,32 @@ namespace ezInternal
     ezDynamicArray<ezWorldModule*, ezLocalAllocatorWrapper> m_ModulesToStartSimulation;
 
     // component management
-    ezSet<ezComponent*, ezCompareHelper<ezComponent*>, ezLocalAllocatorWrapper> m_DeadComponents;
+    ezDynamicArray<ezComponent*, ezLocalAllocatorWrapper> m_DeadComponents;
 
     ezDynamicArray<ezComponentHandle, ezLocalAllocatorWrapper> m_ComponentsToInitialize;
     ezDynamicArray<ezComponentHandle, ezLocalAllocatorWrapper> m_ComponentsToStartSimulation;
+    ezDynamicArrayBase<ezComponentHandle>* m_pDeferredComponentsToInitialize = nullptr;
 
     struct RegisteredUpdateFunction
     {
       ezWorldModule::UpdateFunction m_Function;
       ezHashedString m_sFunctionName;
+      ezHybridArray<ezHashedString, 4> m_DependsOn;
+      ezHybridArray<ezUInt16, 4> m_ReadsFrom; ///< Module type ids.
+      ezHybridArray<ezUInt16, 4> m_WritesTo;  ///< Module type ids, including the module that owns the function.
       float m_fPriority;
       ezUInt16 m_uiGranularity;
       bool m_bOnlyUpdateWhenSimulating;
+      bool m_bCanRunInParallel;
 
       void FillFromDesc(const ezWorldModule::UpdateFunctionDesc& desc);
       bool operator<(const RegisteredUpdateFunction& other) const;
+
+      /// \brief Returns whether this function has to run before or after the other one, i.e. they can't run in parallel.
+      bool ConflictsWith(const RegisteredUpdateFunction& other) const;
+
+      /// \brief Returns whether the function has declared access to the module with the given type id.
+      bool CanAccessModule(ezUInt16 uiTypeId, bool bWrite) const;
     };
 
     struct UpdateTask : public ezTask
@@ -116,11 +147,31 @@ namespace ezInternal
       virtual void Execute() override;
 
       ezWorldModule::UpdateFunction m_Function;
+      const RegisteredUpdateFunction* m_pParallelFunction; ///< Set for synchronous functions that run in parallel, to validate their access.
       ezUInt32 m_uiStartIndex;
       ezUInt32 m_uiCount;
     };
 
+    /// \brief A range in m_UpdateSchedule of synchronous update functions that don't conflict with each other.
+    struct UpdateBatch
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt32 m_uiFirstFunction;
+      ezUInt32 m_uiNumFunctions;
+    };
+
+    void BuildUpdateSchedule(ezUInt32 uiPhase);
+
+    /// \brief The synchronous update function that the current thread runs in parallel to others, used to validate its module accesses.
+    static const RegisteredUpdateFunction*& CurrentParallelUpdateFunction();
+
     ezDynamicArray<RegisteredUpdateFunction, ezLocalAllocatorWrapper> m_UpdateFunctions[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
+
+    // Indices into m_UpdateFunctions, sorted by batch. Rebuilt on the next update when the update functions of a phase have changed.
+    ezDynamicArray<ezUInt32, ezLocalAllocatorWrapper> m_UpdateSchedule[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
+    ezDynamicArray<UpdateBatch, ezLocalAllocatorWrapper> m_UpdateBatches[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
+    bool m_bUpdateScheduleDirty[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
     ezDynamicArray<ezWorldModule::UpdateFunctionDesc, ezLocalAllocatorWrapper> m_UpdateFunctionsToRegister;
 
     ezDynamicArray<UpdateTask*, ezLocalAllocatorWrapper> m_UpdateTasks;
@@ -132,6 +183,8 @@ namespace ezInternal
     ezClock m_Clock;
     ezRandom m_Random;
 
+    ezTime m_LastUpdateDuration;
+
     struct QueuedMsgMetaData
     {
       EZ_DECLARE_POD_TYPE();
@@ -155,11 +208,84 @@ namespace ezInternal
       };
 
       ezTime m_Due;
+
+      /// Sorting key and message id, computed when the message is posted so sorting does not need to touch the message.
+      ezUInt64 m_uiSortKey;
+      ezUInt32 m_uiMessageHash;
+
+      ezUInt16 m_uiQueueType;
+      ezUInt16 m_uiIsTimed;
+    };
+
+    typedef ezMessageQueueBase<QueuedMsgMetaData>::Entry QueuedMsg;
+    typedef ezDynamicArray<QueuedMsg, ezLocalAllocatorWrapper> MessageQueue;
+
+    /// \brief Messages posted by one thread. Only the posting thread and the merge at a phase boundary lock the mutex.
+    struct PostBuffer
+    {
+      PostBuffer(ezAllocatorBase* pAllocator);
+
+      ezMutex m_Mutex;
+      ezDynamicArray<QueuedMsg> m_Messages;
     };
 
-    typedef ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper> MessageQueue;
-    mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
-    mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
+    enum
+    {
+      MAX_POST_BUFFERS = 64
+    };
+
+    /// \brief Hierarchical timing wheel for delayed messages.
+    ///
+    /// Every level has 64 slots, a slot on level n covers 64^n ticks. Messages are inserted into the slot of their due tick and are moved
+    /// down a level once the current tick reaches their slot, so per update only the due slots are touched instead of the whole queue.
+    struct TimedMessageWheel
+    {
+      enum
+      {
+        SLOT_BITS = 6,
+        SLOT_COUNT = 1 << SLOT_BITS,
+        LEVEL_COUNT = 3,
+        TICKS_PER_SECOND = 100
+      };
+
+      TimedMessageWheel();
+
+      void Insert(const QueuedMsg& msg);
+
+      /// \brief Moves all messages that are due at the given time to out_DueMessages. They are not sorted.
+      void CollectDueMessages(ezTime now, ezDynamicArrayBase<QueuedMsg>& out_DueMessages);
+
+      /// \brief Moves all messages to out_Messages and resets the wheel.
+      void CollectAllMessages(ezDynamicArrayBase<QueuedMsg>& out_Messages);
+
+      ezUInt32 GetCount() const { return m_uiCount; }
+
+    private:
+      static ezUInt64 GetTick(ezTime time);
+      void InsertAtTick(const QueuedMsg& msg, ezUInt64 uiTick);
+      void Cascade(MessageQueue& slot);
+
+      MessageQueue m_Slots[LEVEL_COUNT][SLOT_COUNT];
+      MessageQueue m_Overflow;
+      ezUInt64 m_uiCurrentTick;
+      ezUInt32 m_uiCount;
+    };
+
+    /// \brief Post buffer index of a thread, which is handed back when the thread exits.
+    struct ThreadPostBufferIndex;
+
+    static ezUInt32 GetPostBufferIndex();
+    PostBuffer& GetPostBuffer() const;
+
+    /// \brief Moves the messages of all post buffers into the message queues and timing wheels. Must be called from the update thread.
+    void MergePostBuffers();
+
+    mutable PostBuffer* m_PostBuffers[MAX_POST_BUFFERS];
+    MessageQueue m_PostBufferScratch;
+
+    MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
+    TimedMessageWheel m_TimedMessageWheels[ezObjectMsgQueueType::COUNT];
+    MessageQueue m_DueMessages;
 
     ezThreadID m_WriteThreadID;
     ezInt32 m_iWriteCounter;
@@ -198,6 +324,9 @@ namespace ezInternal
       WorldData& m_Data;
     };
 
+    /// \brief Returns a mask in which bit i is set while a thread owns post buffer index i. Only meant for testing.
+    static ezUInt64 GetUsedPostBufferIndices();
+
   private:
     mutable ReadMarker m_ReadMarker;
     WriteMarker m_WriteMarker;
@@ -32,30 +32,30 @@ namespace ezInternal
 
   // static
   template <typename VISITOR>
-  EZ_FORCE_INLINE ezVisitorExecution::Enum WorldData::TraverseHierarchyLevelMultiThreaded(Hierarchy::DataBlockArray& blocks,
-    void* pUserData /* = nullptr*/)
+  EZ_FORCE_INLINE void WorldData::TraverseDirtyList(DirtyTransformationList& dirtyList, void* pUserData /* = nullptr*/)
+  {
+    for (ezGameObject::TransformationData* pData : dirtyList)
+    {
+      VISITOR::Visit(pData, pUserData);
+    }
+  }
+
+  // static
+  template <typename VISITOR>
+  EZ_FORCE_INLINE void WorldData::TraverseDirtyListMultiThreaded(DirtyTransformationList& dirtyList, void* pUserData /* = nullptr*/)
   {
     ezTaskSystem::ParallelForParams parallelForParams;
-    parallelForParams.uiBinSize = 100;
+    parallelForParams.uiBinSize = 1000;
     parallelForParams.uiMaxTasksPerThread = 2;
 
-    ezTaskSystem::ParallelFor(blocks.GetArrayPtr(),
-      [pUserData](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice) {
-        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
+    ezTaskSystem::ParallelFor(dirtyList.GetArrayPtr(),
+      [pUserData](ezArrayPtr<ezGameObject::TransformationData*> dataSlice) {
+        for (ezGameObject::TransformationData* pData : dataSlice)
         {
-          ezGameObject::TransformationData* pCurrentData = block.m_pData;
-          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
-
-          while (pCurrentData < pEndData)
-          {
-            VISITOR::Visit(pCurrentData, pUserData);
-            ++pCurrentData;
-          }
+          VISITOR::Visit(pData, pUserData);
         }
       },
-      "World DataBlock Traversal Task", parallelForParams);
-
-    return ezVisitorExecution::Continue;
+      "World Dirty Transforms Task", parallelForParams);
   }
 
   // static
@@ -94,13 +94,34 @@ namespace ezInternal
 
   ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-  EZ_FORCE_INLINE void WorldData::RegisteredUpdateFunction::FillFromDesc(const ezWorldModule::UpdateFunctionDesc& desc)
+  inline void WorldData::RegisteredUpdateFunction::FillFromDesc(const ezWorldModule::UpdateFunctionDesc& desc)
   {
     m_Function = desc.m_Function;
     m_sFunctionName = desc.m_sFunctionName;
+    m_DependsOn = desc.m_DependsOn;
     m_fPriority = desc.m_fPriority;
     m_uiGranularity = desc.m_uiGranularity;
     m_bOnlyUpdateWhenSimulating = desc.m_bOnlyUpdateWhenSimulating;
+    m_bCanRunInParallel = desc.m_bCanRunInParallel;
+
+    m_ReadsFrom.Clear();
+    m_WritesTo.Clear();
+
+    for (const ezRTTI* pRtti : desc.m_ReadsFrom)
+    {
+      const ezUInt16 uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+      EZ_ASSERT_DEV(uiTypeId != 0xFFFF, "Update function '{0}' reads from '{1}', which is not a component or world module type",
+        desc.m_sFunctionName, pRtti->GetTypeName());
+      m_ReadsFrom.PushBack(uiTypeId);
+    }
+
+    for (const ezRTTI* pRtti : desc.m_WritesTo)
+    {
+      const ezUInt16 uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+      EZ_ASSERT_DEV(uiTypeId != 0xFFFF, "Update function '{0}' writes to '{1}', which is not a component or world module type",
+        desc.m_sFunctionName, pRtti->GetTypeName());
+      m_WritesTo.PushBack(uiTypeId);
+    }
   }
 
   EZ_FORCE_INLINE bool WorldData::RegisteredUpdateFunction::operator<(const RegisteredUpdateFunction& other) const
@@ -116,6 +137,36 @@ namespace ezInternal
     return iNameComp < 0;
   }
 
+  inline bool WorldData::RegisteredUpdateFunction::ConflictsWith(const RegisteredUpdateFunction& other) const
+  {
+    // functions that don't declare their access might touch anything
+    if (!m_bCanRunInParallel || !other.m_bCanRunInParallel)
+      return true;
+
+    if (m_DependsOn.Contains(other.m_sFunctionName) || other.m_DependsOn.Contains(m_sFunctionName))
+      return true;
+
+    // reading the same module is fine, writing it is not
+    for (ezUInt16 uiTypeId : m_WritesTo)
+    {
+      if (other.m_WritesTo.Contains(uiTypeId) || other.m_ReadsFrom.Contains(uiTypeId))
+        return true;
+    }
+
+    for (ezUInt16 uiTypeId : m_ReadsFrom)
+    {
+      if (other.m_WritesTo.Contains(uiTypeId))
+        return true;
+    }
+
+    return false;
+  }
+
+  EZ_FORCE_INLINE bool WorldData::RegisteredUpdateFunction::CanAccessModule(ezUInt16 uiTypeId, bool bWrite) const
+  {
+    return m_WritesTo.Contains(uiTypeId) || (!bWrite && m_ReadsFrom.Contains(uiTypeId));
+  }
+
   ///////////////////////////////////////////////////////////////////////////////////////////////////
 
   EZ_ALWAYS_INLINE WorldData::ReadMarker::ReadMarker(const WorldData& data)
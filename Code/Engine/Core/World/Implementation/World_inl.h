@@ -191,9 +191,9 @@ EZ_FORCE_INLINE ManagerType* ezWorld::GetComponentManager()
 {
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponentManagerBase, ManagerType), "Not a valid component manager type");
 
-  CheckForWriteAccess();
-
   const ezUInt16 uiTypeId = ManagerType::TypeId();
+  CheckForModuleAccess(uiTypeId, true);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return ezStaticCast<ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -210,6 +210,8 @@ EZ_FORCE_INLINE const ManagerType* ezWorld::GetComponentManager() const
   CheckForReadAccess();
 
   const ezUInt16 uiTypeId = ManagerType::TypeId();
+  CheckForModuleAccess(uiTypeId, false);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return ezStaticCast<const ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -251,10 +253,10 @@ inline bool ezWorld::IsValidComponent(const ezComponentHandle& component) const
 template <typename ComponentType>
 inline bool ezWorld::TryGetComponent(const ezComponentHandle& component, ComponentType*& out_pComponent)
 {
-  CheckForWriteAccess();
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponent, ComponentType), "Not a valid component type");
 
   const ezUInt16 uiTypeId = component.m_InternalId.m_TypeId;
+  CheckForModuleAccess(uiTypeId, true);
 
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
@@ -277,6 +279,7 @@ inline bool ezWorld::TryGetComponent(const ezComponentHandle& component, const C
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponent, ComponentType), "Not a valid component type");
 
   const ezUInt16 uiTypeId = component.m_InternalId.m_TypeId;
+  CheckForModuleAccess(uiTypeId, false);
 
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
@@ -464,6 +467,11 @@ EZ_FORCE_INLINE void* ezWorld::GetUserData() const
   return m_Data.m_pUserData;
 }
 
+EZ_ALWAYS_INLINE ezTime ezWorld::GetLastUpdateDuration() const
+{
+  return m_Data.m_LastUpdateDuration;
+}
+
 // static
 EZ_ALWAYS_INLINE ezUInt32 ezWorld::GetWorldCount()
 {
@@ -487,6 +495,17 @@ EZ_ALWAYS_INLINE void ezWorld::CheckForWriteAccess() const
                 "Trying to write to World '{0}', but it is not marked for writing.", GetName());
 }
 
+EZ_ALWAYS_INLINE void ezWorld::CheckForModuleAccess(ezUInt16 uiTypeId, bool bWrite) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // synchronous update functions that run in parallel only have access to the modules they have declared
+  if (m_Data.m_WriteThreadID != ezThreadUtils::GetCurrentThreadID())
+  {
+    CheckForDeclaredModuleAccess(uiTypeId, bWrite);
+  }
+#endif
+}
+
 EZ_ALWAYS_INLINE ezGameObject* ezWorld::GetObjectUnchecked(ezUInt32 uiIndex) const
 {
   return m_Data.m_Objects.GetValueUnchecked(uiIndex);
@@ -30,7 +30,9 @@ private:
   friend class ezComponentManagerFactory;
 
   virtual ezComponent* CreateComponentStorage() override;
+  virtual void CreateComponentStorage(ezArrayPtr<ezComponent*> out_Components) override;
   virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) override;
+  virtual void DeleteComponentStorage(ezArrayPtr<ezComponent* const> components, ezDynamicArrayBase<MovedComponent>& out_MovedComponents) override;
 
   ezHybridArray<ezUniquePtr<ComponentType>, 2> m_Components;
 };
@@ -22,6 +22,8 @@ private:
   // ezSpatialSystem implementation
   virtual void FindObjectsInSphereInternal(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback,
     QueryStats* pStats = nullptr) const override;
+  virtual void FindObjectsInSphereInternal(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, ezDynamicArray<ezGameObject*>& out_Objects,
+    QueryStats* pStats = nullptr) const override;
   virtual void FindObjectsInBoxInternal(const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats = nullptr) const override;
 
   virtual void FindVisibleObjectsInternal(const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects,
@@ -47,5 +49,8 @@ private:
   template <typename Functor>
   void ForEachCellInBox(const ezSimdBBox& box, ezUInt32 uiCategoryBitmask, Functor func) const;
 
+  template <typename Functor>
+  void ForEachObjectInSphere(const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, Functor func, QueryStats* pStats) const;
+
   Cell* GetOrCreateCell(const ezSimdBBoxSphere& bounds);
 };
@@ -15,6 +15,12 @@
 /// * Actual deletion of dead objects and components are done now.
 /// * Transform update: The world transformation of all dynamic objects is updated.
 /// * Post-transform phase: Another synchronous phase like the pre-async phase after the transformation has been updated.
+///
+/// Synchronous update functions that set ezWorldModule::UpdateFunctionDesc::m_bCanRunInParallel are run in parallel with each other on the
+/// task system, as long as they don't write to a module that the other one reads from or writes to and don't depend on each other.
+/// While they run, the world is not marked for writing, so they have the same restrictions as asynchronous update functions, except that
+/// they may also access the modules they have declared. Messages have to be posted instead of sent. In development builds, accessing a
+/// module through the world that was not declared triggers an assert.
 class EZ_CORE_DLL ezWorld
 {
 public:
@@ -150,6 +156,19 @@ public:
   template <typename ComponentType>
   bool TryGetComponent(const ezComponentHandle& component, const ComponentType*& out_pComponent) const;
 
+  /// \brief Until EndDeferringComponentInitialization() is called, new components are collected in \a ref_Components instead of being
+  /// initialized during the next update.
+  ///
+  /// This is used when components are created over multiple frames and must not be initialized before all of them are complete, e.g. by
+  /// ezWorldReader::InstantiateWorldIncremental(). Pass the collected components to QueueComponentsForInitialization() afterwards.
+  void BeginDeferringComponentInitialization(ezDynamicArrayBase<ezComponentHandle>& ref_Components);
+
+  /// \brief Stops collecting new components, see BeginDeferringComponentInitialization().
+  void EndDeferringComponentInitialization();
+
+  /// \brief Queues components that were collected with BeginDeferringComponentInitialization() for initialization during the next update.
+  void QueueComponentsForInitialization(ezArrayPtr<const ezComponentHandle> components);
+
   ///@}
   /// \name Message Functions
   ///@{
@@ -193,6 +212,15 @@ public:
   /// \brief Returns a task implementation that calls Update on this world.
   ezTask* GetUpdateTask();
 
+  /// \brief Returns the names of the registered update functions of the given synchronous phase, grouped into the batches they are run in.
+  ///
+  /// The batches run one after the other, the functions within a batch may run in parallel. Useful to check the module accesses that the
+  /// update functions have declared.
+  void GetUpdateSchedule(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase, ezDynamicArray<ezDynamicArray<ezHashedString>>& out_Batches);
+
+  /// \brief Returns how long the last call to Update() took. Also reported as the 'World Update/<name>/Update Time' stat.
+  ezTime GetLastUpdateDuration() const;
+
 
   /// \brief Returns the spatial system that is associated with this world.
   ezSpatialSystem* GetSpatialSystem();
@@ -267,6 +295,13 @@ public:
   /// \brief Returns the world with the given index.
   static ezWorld* GetWorld(ezUInt32 uiIndex);
 
+  /// \brief Updates all given worlds in parallel, one task per world, and returns once all of them are updated.
+  ///
+  /// Each world still runs all its update phases in order on one thread, which marks the world for writing during its update.
+  /// Therefore none of the worlds may be marked for reading or writing by any other thread, including the calling one.
+  /// Worlds don't share any data, but components must not access other worlds in their update functions either.
+  static void UpdateWorlds(ezArrayPtr<ezWorld*> worlds);
+
 private:
   friend class ezGameObject;
   friend class ezWorldModule;
@@ -275,6 +310,8 @@ private:
 
   void CheckForReadAccess() const;
   void CheckForWriteAccess() const;
+  void CheckForModuleAccess(ezUInt16 uiTypeId, bool bWrite) const;
+  void CheckForDeclaredModuleAccess(ezUInt16 uiTypeId, bool bWrite) const;
 
   ezGameObject* GetObjectUnchecked(ezUInt32 uiIndex) const;
 
@@ -291,9 +328,12 @@ private:
   void SetObjectGlobalKey(ezGameObject* pObject, const ezHashedString& sGlobalKey);
   const char* GetObjectGlobalKey(const ezGameObject* pObject) const;
 
+  typedef ezInternal::WorldData::QueuedMsgMetaData QueuedMsgMetaData;
+
   void PostMessage(const ezGameObjectHandle& receiverObject, const ezMessage& msg, ezObjectMsgQueueType::Enum queueType, ezTime delay,
     bool bRecursive) const;
-  void ProcessQueuedMessage(const ezInternal::WorldData::MessageQueue::Entry& entry);
+  void EnqueueMessage(const ezMessage& msg, ezObjectMsgQueueType::Enum queueType, ezTime delay, QueuedMsgMetaData& metaData) const;
+  void ProcessQueuedMessage(const ezInternal::WorldData::QueuedMsg& entry);
   void ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType);
 
   void RegisterUpdateFunction(const ezWorldModule::UpdateFunctionDesc& desc);
@@ -304,7 +344,8 @@ private:
   void AddComponentToInitialize(ezComponentHandle hComponent);
 
   void UpdateFromThread();
-  void UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions);
+  void UpdateSynchronous(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase);
+  void UpdateSynchronousBatch(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase, const ezInternal::WorldData::UpdateBatch& batch);
   void UpdateAsynchronous();
 
   void ProcessComponentsToInitialize();
@@ -323,8 +364,6 @@ private:
 
   ezInternal::WorldData m_Data;
 
-  typedef ezInternal::WorldData::QueuedMsgMetaData QueuedMsgMetaData;
-
   ezUInt16 m_uiIndex;
   static ezStaticArray<ezWorld*, 64> s_Worlds;
 };
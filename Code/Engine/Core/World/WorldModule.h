@@ -63,6 +63,7 @@ protected:
       m_sFunctionName.Assign(szFunctionName);
       m_Phase = Phase::PreAsync;
       m_bOnlyUpdateWhenSimulating = false;
+      m_bCanRunInParallel = false;
       m_uiGranularity = 0;
       m_fPriority = 0.0f;
     }
@@ -74,7 +75,12 @@ protected:
                                                   ///< called after all its dependencies have been called.
     ezEnum<Phase> m_Phase; ///< The update phase in which this update function should be called. See ezWorld for a description on the
                            ///< different phases.
+    ezHybridArray<const ezRTTI*, 4> m_ReadsFrom; ///< Component or world module types that this function reads from. Only needed if
+                                                 ///< m_bCanRunInParallel is set. The module that owns the function is always accessed.
+    ezHybridArray<const ezRTTI*, 4> m_WritesTo; ///< Component or world module types that this function writes to, see m_ReadsFrom.
     bool m_bOnlyUpdateWhenSimulating; ///< The update function is only called when the world simulation is enabled.
+    bool m_bCanRunInParallel; ///< The function has declared all modules it accesses in m_ReadsFrom and m_WritesTo and may run in parallel
+                              ///< with other such functions of the same synchronous phase. See ezWorld for the restrictions that apply.
     ezUInt16 m_uiGranularity; ///< The granularity in which batch updates should happen during the asynchronous phase. Has to be 0 for
                               ///< synchronous functions.
     float m_fPriority; ///< Higher priority (higher number) means that this function is called earlier than a function with lower priority.
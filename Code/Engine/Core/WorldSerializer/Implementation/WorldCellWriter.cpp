@@ -0,0 +1,140 @@
+#include <CorePCH.h>
+
+#include <Core/WorldSerializer/WorldCellWriter.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+
+void ezWorldCellWriter::PartitionWorld(ezWorld& world, float fCellSize)
+{
+  EZ_ASSERT_DEV(fCellSize > 0.0f, "Invalid cell size {0}", fCellSize);
+
+  m_fCellSize = fCellSize;
+  m_Cells.Clear();
+
+  ezHashTable<ezUInt64, ezUInt32> cellIndices;
+
+  EZ_LOCK(world.GetReadMarker());
+
+  for (auto it = world.GetObjects(); it.IsValid(); ++it)
+  {
+    const ezGameObject* pObject = &(*it);
+    if (pObject->GetParent() != nullptr)
+      continue;
+
+    const ezVec2I32 vCell = ComputeCellCoordinates(pObject->GetGlobalPosition(), fCellSize);
+    const ezUInt64 uiKey = (static_cast<ezUInt64>(static_cast<ezUInt32>(vCell.x)) << 32) | static_cast<ezUInt32>(vCell.y);
+
+    ezUInt32 uiCellIndex = 0;
+    if (!cellIndices.TryGetValue(uiKey, uiCellIndex))
+    {
+      uiCellIndex = m_Cells.GetCount();
+      cellIndices.Insert(uiKey, uiCellIndex);
+
+      m_Cells.ExpandAndGetRef().m_vCoordinates = vCell;
+    }
+
+    m_Cells[uiCellIndex].m_RootObjects.PushBack(pObject);
+  }
+}
+
+ezResult ezWorldCellWriter::WriteToDirectory(const char* szDirectory) const
+{
+  ezStringBuilder sFile;
+
+  {
+    GetCellTableFile(szDirectory, sFile);
+
+    ezFileWriter file;
+    if (file.Open(sFile).Failed())
+    {
+      ezLog::Error("Failed to open file for writing: '{0}'", sFile);
+      return EZ_FAILURE;
+    }
+
+    WriteCellTable(file);
+  }
+
+  for (ezUInt32 i = 0; i < m_Cells.GetCount(); ++i)
+  {
+    GetCellFile(szDirectory, m_Cells[i].m_vCoordinates, sFile);
+
+    ezFileWriter file;
+    if (file.Open(sFile).Failed())
+    {
+      ezLog::Error("Failed to open file for writing: '{0}'", sFile);
+      return EZ_FAILURE;
+    }
+
+    WriteCell(file, i);
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezWorldCellWriter::WriteCellTable(ezStreamWriter& stream) const
+{
+  const ezUInt8 uiVersion = 1;
+  stream << uiVersion;
+
+  stream << m_fCellSize;
+  stream << m_Cells.GetCount();
+
+  for (const Cell& cell : m_Cells)
+  {
+    stream << cell.m_vCoordinates.x;
+    stream << cell.m_vCoordinates.y;
+  }
+}
+
+void ezWorldCellWriter::WriteCell(ezStreamWriter& stream, ezUInt32 uiCell) const
+{
+  ezWorldWriter writer;
+  writer.WriteObjects(stream, m_Cells[uiCell].m_RootObjects);
+}
+
+ezResult ezWorldCellWriter::ReadCellTable(ezStreamReader& stream, float& out_fCellSize, ezDynamicArray<ezVec2I32>& out_Cells)
+{
+  ezUInt8 uiVersion = 0;
+  stream >> uiVersion;
+
+  if (uiVersion != 1)
+  {
+    ezLog::Error("Invalid world cell table version {0}", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  ezUInt32 uiNumCells = 0;
+  stream >> out_fCellSize;
+  stream >> uiNumCells;
+
+  out_Cells.SetCountUninitialized(uiNumCells);
+  for (ezVec2I32& vCell : out_Cells)
+  {
+    stream >> vCell.x;
+    stream >> vCell.y;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezVec2I32 ezWorldCellWriter::ComputeCellCoordinates(const ezVec3& vPosition, float fCellSize)
+{
+  return ezVec2I32(static_cast<ezInt32>(ezMath::Floor(vPosition.x / fCellSize)), static_cast<ezInt32>(ezMath::Floor(vPosition.y / fCellSize)));
+}
+
+void ezWorldCellWriter::GetCellTableFile(const char* szDirectory, ezStringBuilder& out_sFile)
+{
+  out_sFile = szDirectory;
+  out_sFile.AppendPath("Cells.ezWorldCells");
+}
+
+void ezWorldCellWriter::GetCellFile(const char* szDirectory, const ezVec2I32& vCell, ezStringBuilder& out_sFile)
+{
+  ezStringBuilder sName;
+  sName.Format("Cell_{0}_{1}.ezWorldCell", vCell.x, vCell.y);
+
+  out_sFile = szDirectory;
+  out_sFile.AppendPath(sName);
+}
+
+EZ_STATICLINK_FILE(Core, Core_WorldSerializer_Implementation_WorldCellWriter);
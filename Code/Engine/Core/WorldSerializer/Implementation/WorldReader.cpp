@@ -2,6 +2,12 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 
+namespace
+{
+  // the time budget of incremental instantiation is only checked after each batch of objects or components
+  constexpr ezUInt32 s_uiIncrementalBatchSize = 32;
+} // namespace
+
 ezWorldReader::ezWorldReader()
 {
   m_pStream = nullptr;
@@ -14,6 +20,10 @@ void ezWorldReader::ReadWorldDescription(ezStreamReader& stream)
 {
   m_HandleReadContext.Reset();
 
+  m_bComponentTemplateValid = false;
+  m_ComponentsToCreate.Clear();
+  m_ComponentTypesToCreate.Clear();
+
   m_pStream = &stream;
 
   m_uiVersion = 0;
@@ -102,17 +112,69 @@ void ezWorldReader::InstantiatePrefab(ezWorld& world, const ezTransform& rootTra
   Instantiate(world, true, rootTransform, hParent, out_CreatedRootObjects, out_CreatedChildObjects, pOverrideTeamID, bForceDynamic);
 }
 
-void ezWorldReader::Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, ezGameObjectHandle hParent,
-                                ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects,
-                                ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+void ezWorldReader::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+                                       ezDynamicArray<ezGameObject*>* out_CreatedRootObjects,
+                                       ezDynamicArray<ezGameObject*>* out_CreatedChildObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
 {
+  if (rootTransforms.IsEmpty())
+    return;
+
+  EZ_LOCK(world.GetWriteMarker());
+
+  ezUInt32 uiFirstInstance = 0;
+  if (!m_bComponentTemplateValid)
+  {
+    // the first instance parses the component stream and records the template for all others
+    Instantiate(world, true, rootTransforms[0], hParent, out_CreatedRootObjects, out_CreatedChildObjects, pOverrideTeamID, bForceDynamic);
+    uiFirstInstance = 1;
+  }
+
+  const ezUInt32 uiNumInstances = rootTransforms.GetCount() - uiFirstInstance;
+
+  if (out_CreatedRootObjects)
+    out_CreatedRootObjects->Reserve(out_CreatedRootObjects->GetCount() + uiNumInstances * m_RootObjectsToCreate.GetCount());
+
+  if (out_CreatedChildObjects)
+    out_CreatedChildObjects->Reserve(out_CreatedChildObjects->GetCount() + uiNumInstances * m_ChildObjectsToCreate.GetCount());
+
   m_pWorld = &world;
 
-  m_IndexToGameObjectHandle.Clear();
-  m_IndexToComponentHandle.Clear();
+  ezHybridArray<ezComponentManagerBase*, 16> managers;
+  GetComponentManagers(managers);
 
-  m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
-  m_IndexToComponentHandle.SetCount(m_uiMaxComponents + 1); // initialize with 'invalid' handles to be able to skip unknown components
+  ezMemoryStreamReader memReader(&m_ComponentStream);
+  ezStreamReader* pPrevReader = m_pStream;
+  m_pStream = &memReader;
+
+  for (ezUInt32 i = uiFirstInstance; i < rootTransforms.GetCount(); ++i)
+  {
+    ResetIndexTables();
+
+    CreateGameObjects(m_RootObjectsToCreate, rootTransforms[i], hParent, out_CreatedRootObjects, pOverrideTeamID, bForceDynamic);
+    CreateGameObjects(m_ChildObjectsToCreate, ezGameObjectHandle(), out_CreatedChildObjects, pOverrideTeamID, bForceDynamic);
+
+    if (!m_ComponentTypesToCreate.IsEmpty())
+    {
+      m_HandleReadContext.BeginRestoringHandles(m_pStream);
+
+      CreateComponentsFromTemplate(managers, memReader);
+
+      m_HandleReadContext.EndRestoringHandles();
+    }
+
+    FulfillComponentHandleRequets();
+  }
+
+  m_pStream = pPrevReader;
+}
+
+void ezWorldReader::Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, ezGameObjectHandle hParent,
+                                ezDynamicArray<ezGameObject*>* out_CreatedRootObjects,
+                                ezDynamicArray<ezGameObject*>* out_CreatedChildObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+{
+  m_pWorld = &world;
+
+  ResetIndexTables();
 
   EZ_LOCK(m_pWorld->GetWriteMarker());
 
@@ -136,9 +198,23 @@ void ezWorldReader::Instantiate(ezWorld& world, bool bUseTransform, const ezTran
 
     m_HandleReadContext.BeginRestoringHandles(m_pStream);
 
-    for (ezUInt32 i = 0; i < m_ComponentTypes.GetCount(); ++i)
+    if (m_bComponentTemplateValid)
     {
-      ReadComponentsOfType(i);
+      ezHybridArray<ezComponentManagerBase*, 16> managers;
+      GetComponentManagers(managers);
+
+      CreateComponentsFromTemplate(managers, memReader);
+    }
+    else
+    {
+      // may contain parts of a template from a canceled incremental instantiation
+      m_ComponentsToCreate.Clear();
+      m_ComponentTypesToCreate.Clear();
+
+      for (ezUInt32 i = 0; i < m_ComponentTypes.GetCount(); ++i)
+      {
+        ReadComponentsOfType(i, memReader);
+      }
     }
 
     m_HandleReadContext.EndRestoringHandles();
@@ -146,9 +222,129 @@ void ezWorldReader::Instantiate(ezWorld& world, bool bUseTransform, const ezTran
     m_pStream = pPrevReader;
   }
 
+  m_bComponentTemplateValid = true;
+
   FulfillComponentHandleRequets();
 }
 
+void ezWorldReader::BeginInstantiateWorldIncremental(ezWorld& world, const ezUInt16* pOverrideTeamID)
+{
+  m_pWorld = &world;
+
+  ResetIndexTables();
+  m_ComponentHandleRequests.Clear();
+
+  // the template is recorded again while the component stream is read step by step
+  m_bComponentTemplateValid = false;
+  m_ComponentsToCreate.Clear();
+  m_ComponentTypesToCreate.Clear();
+
+  IncrementalState& inc = m_Incremental;
+  inc.m_bActive = true;
+  inc.m_bOverrideTeamID = pOverrideTeamID != nullptr;
+  inc.m_uiTeamID = pOverrideTeamID != nullptr ? *pOverrideTeamID : 0;
+  inc.m_uiNextObject = 0;
+  inc.m_uiNextComponentType = 0;
+  inc.m_uiComponentsLeftInType = 0;
+  inc.m_pComponentManager = nullptr;
+  inc.m_ComponentReader.SetStorage(&m_ComponentStream);
+  inc.m_ComponentsToInitialize.Clear();
+}
+
+bool ezWorldReader::InstantiateWorldIncremental(ezTime maxDuration)
+{
+  IncrementalState& inc = m_Incremental;
+  EZ_ASSERT_DEV(inc.m_bActive, "BeginInstantiateWorldIncremental() has not been called");
+
+  const ezTime tEnd = ezTime::Now() + maxDuration;
+  const ezUInt16* pOverrideTeamID = inc.m_bOverrideTeamID ? &inc.m_uiTeamID : nullptr;
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  // all root objects come before the child objects, so every parent exists before its children are created
+  const ezUInt32 uiNumRootObjects = m_RootObjectsToCreate.GetCount();
+  const ezUInt32 uiNumObjects = uiNumRootObjects + m_ChildObjectsToCreate.GetCount();
+
+  while (inc.m_uiNextObject < uiNumObjects)
+  {
+    const bool bRoot = inc.m_uiNextObject < uiNumRootObjects;
+    const ezDynamicArray<GameObjectToCreate>& objects = bRoot ? m_RootObjectsToCreate : m_ChildObjectsToCreate;
+    const ezUInt32 uiFirst = bRoot ? inc.m_uiNextObject : inc.m_uiNextObject - uiNumRootObjects;
+    const ezUInt32 uiCount = ezMath::Min(objects.GetCount() - uiFirst, s_uiIncrementalBatchSize);
+
+    CreateGameObjects(objects.GetArrayPtr().GetSubArray(uiFirst, uiCount), ezGameObjectHandle(), nullptr, pOverrideTeamID, false);
+    inc.m_uiNextObject += uiCount;
+
+    if (ezTime::Now() >= tEnd)
+      return false;
+  }
+
+  if (m_ComponentStream.GetStorageSize() > 0)
+  {
+    ezStreamReader* pPrevReader = m_pStream;
+    m_pStream = &inc.m_ComponentReader;
+
+    m_HandleReadContext.BeginRestoringHandles(m_pStream);
+
+    // the world may be updated between the steps, but the components must not be initialized before their handles are resolved
+    m_pWorld->BeginDeferringComponentInitialization(inc.m_ComponentsToInitialize);
+
+    bool bTimeUp = false;
+    while (!bTimeUp)
+    {
+      if (inc.m_uiComponentsLeftInType == 0)
+      {
+        if (inc.m_uiNextComponentType == m_ComponentTypes.GetCount())
+          break;
+
+        inc.m_uiComponentsLeftInType = ReadComponentTypeHeader(inc.m_uiNextComponentType, inc.m_ComponentReader, inc.m_pComponentManager);
+        ++inc.m_uiNextComponentType;
+        continue;
+      }
+
+      const ezUInt32 uiCount = ezMath::Min(inc.m_uiComponentsLeftInType, s_uiIncrementalBatchSize);
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        ReadComponent(inc.m_pComponentManager, inc.m_ComponentReader);
+      }
+
+      inc.m_uiComponentsLeftInType -= uiCount;
+
+      bTimeUp = ezTime::Now() >= tEnd;
+    }
+
+    // resource handles are restored for every step, the components that were created so far are complete afterwards
+    m_HandleReadContext.EndRestoringHandles();
+
+    m_pWorld->EndDeferringComponentInitialization();
+
+    m_pStream = pPrevReader;
+
+    if (bTimeUp)
+      return false;
+  }
+
+  inc.m_bActive = false;
+  inc.m_ComponentReader.SetStorage(nullptr);
+
+  m_bComponentTemplateValid = true;
+
+  FulfillComponentHandleRequets();
+
+  m_pWorld->QueueComponentsForInitialization(inc.m_ComponentsToInitialize);
+  inc.m_ComponentsToInitialize.Clear();
+  return true;
+}
+
+ezArrayPtr<const ezGameObjectHandle> ezWorldReader::GetCreatedRootObjects() const
+{
+  // the root objects are always created first, index 0 is the invalid handle
+  if (m_IndexToGameObjectHandle.IsEmpty())
+    return ezArrayPtr<const ezGameObjectHandle>();
+
+  const ezUInt32 uiNumCreated = ezMath::Min(m_IndexToGameObjectHandle.GetCount() - 1, m_RootObjectsToCreate.GetCount());
+  return m_IndexToGameObjectHandle.GetArrayPtr().GetSubArray(1, uiNumCreated);
+}
 
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
@@ -205,6 +401,19 @@ void ezWorldReader::ClearAndCompact()
 
   m_ComponentStream.Clear();
   m_ComponentStream.Compact();
+
+  m_Incremental.m_bActive = false;
+  m_Incremental.m_ComponentReader.SetStorage(nullptr);
+  m_Incremental.m_ComponentsToInitialize.Clear();
+  m_Incremental.m_ComponentsToInitialize.Compact();
+
+  m_bComponentTemplateValid = false;
+
+  m_ComponentsToCreate.Clear();
+  m_ComponentsToCreate.Compact();
+
+  m_ComponentTypesToCreate.Clear();
+  m_ComponentTypesToCreate.Compact();
 }
 
 
@@ -213,7 +422,9 @@ ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
   return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_IndexToComponentHandle.GetHeapMemoryUsage() +
          m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() +
          m_ComponentHandleRequests.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() +
-         m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentStream.GetHeapMemoryUsage();
+         m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentStream.GetHeapMemoryUsage() +
+         m_ComponentsToCreate.GetHeapMemoryUsage() + m_ComponentTypesToCreate.GetHeapMemoryUsage() +
+         m_Incremental.m_ComponentsToInitialize.GetHeapMemoryUsage();
 }
 
 void ezWorldReader::ReadGameObjectDesc(GameObjectToCreate& godesc)
@@ -271,78 +482,151 @@ void ezWorldReader::ReadComponentInfo(ezUInt32 uiComponentTypeIdx)
   m_ComponentTypeVersions[pRtti] = uiRttiVersion;
 }
 
-void ezWorldReader::ReadComponentsOfType(ezUInt32 uiComponentTypeIdx)
+void ezWorldReader::ReadComponentsOfType(ezUInt32 uiComponentTypeIdx, ezMemoryStreamReader& memReader)
 {
-  ezStreamReader& s = *m_pStream;
+  ezComponentManagerBase* pManager = nullptr;
+  const ezUInt32 uiNumComponents = ReadComponentTypeHeader(uiComponentTypeIdx, memReader, pManager);
+
+  for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+  {
+    ReadComponent(pManager, memReader);
+  }
+}
+
+ezUInt32 ezWorldReader::ReadComponentTypeHeader(
+  ezUInt32 uiComponentTypeIdx, ezMemoryStreamReader& memReader, ezComponentManagerBase*& out_pManager)
+{
+  ezStreamReader& s = memReader;
 
   ezUInt32 uiAllComponentsSize = 0;
   s >> uiAllComponentsSize;
 
-  bool bSkip = false;
-
-  ezComponentManagerBase* pManager = nullptr;
+  out_pManager = nullptr;
   const ezRTTI* pRtti = m_ComponentTypes[uiComponentTypeIdx];
 
   if (pRtti == nullptr)
   {
-    bSkip = true;
     ezLog::Warning("Skipping components of unknown type");
+
+    s.SkipBytes(uiAllComponentsSize);
+    return 0;
   }
-  else
+
+  out_pManager = m_pWorld->GetOrCreateManagerForComponentType(pRtti);
+
+  ezUInt32 uiNumComponents = 0;
+  s >> uiNumComponents;
+
+  // will be the case for all abstract component types
+  if (uiNumComponents == 0)
+    return 0;
+
+  // only check this after we know that we actually need to create any of this type
+  EZ_ASSERT_DEV(out_pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", pRtti->GetTypeName());
+
+  auto& typeToCreate = m_ComponentTypesToCreate.ExpandAndGetRef();
+  typeToCreate.m_pRtti = pRtti;
+  typeToCreate.m_uiFirstComponent = m_ComponentsToCreate.GetCount();
+  typeToCreate.m_uiNumComponents = uiNumComponents;
+
+  return uiNumComponents;
+}
+
+void ezWorldReader::ReadComponent(ezComponentManagerBase* pManager, ezMemoryStreamReader& memReader)
+{
+  ezStreamReader& s = memReader;
+
+  ezUInt32 uiOwnerIdx = 0;
+  s >> uiOwnerIdx;
+
+  const ezGameObjectHandle hOwner = m_IndexToGameObjectHandle[uiOwnerIdx];
+
+  ezUInt32 uiComponentIdx = 0;
+  s >> uiComponentIdx;
+
+  bool bActive = true;
+  s >> bActive;
+
+  if (m_uiVersion <= 4)
   {
-    pManager = m_pWorld->GetOrCreateManagerForComponentType(pRtti);
+    bool bDynamic = true;
+    s >> bDynamic;
   }
 
-  if (bSkip)
+  ezUInt8 userFlags = 0;
+  if (m_uiVersion >= 7)
   {
-    m_pStream->SkipBytes(uiAllComponentsSize);
+    s >> userFlags;
   }
-  else
-  {
-    ezUInt32 uiNumComponents = 0;
-    s >> uiNumComponents;
 
-    // will be the case for all abstract component types
-    if (uiNumComponents == 0)
-      return;
+  auto& compToCreate = m_ComponentsToCreate.ExpandAndGetRef();
+  compToCreate.m_uiOwnerIndex = uiOwnerIdx;
+  compToCreate.m_uiComponentIndex = uiComponentIdx;
+  compToCreate.m_uiDataOffset = memReader.GetReadPosition();
+  compToCreate.m_bActive = bActive;
+  compToCreate.m_uiUserFlags = userFlags;
 
-    // only check this after we know that we actually need to create any of this type
-    EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", pRtti->GetTypeName());
+  ezGameObject* pParentObject = nullptr;
+  m_pWorld->TryGetObject(hOwner, pParentObject);
 
-    for (ezUInt32 i = 0; i < uiNumComponents; ++i)
-    {
-      const ezGameObjectHandle hOwner = ReadGameObjectHandle();
+  ezComponent* pComponent = nullptr;
+  auto hComponent = pManager->CreateComponent(pParentObject, pComponent);
+  m_IndexToComponentHandle[uiComponentIdx] = hComponent;
 
-      ezUInt32 uiComponentIdx = 0;
-      *m_pStream >> uiComponentIdx;
+  pComponent->SetActive(bActive);
 
-      bool bActive = true;
-      *m_pStream >> bActive;
+  for (ezUInt8 j = 0; j < 8; ++j)
+  {
+    pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
+  }
 
-      if (m_uiVersion <= 4)
-      {
-        bool bDynamic = true;
-        *m_pStream >> bDynamic;
-      }
+  pComponent->DeserializeComponent(*this);
+}
 
-      ezUInt8 userFlags = 0;
-      if (m_uiVersion >= 7)
-      {
-        *m_pStream >> userFlags;
-      }
+void ezWorldReader::GetComponentManagers(ezDynamicArray<ezComponentManagerBase*>& out_Managers) const
+{
+  out_Managers.SetCountUninitialized(m_ComponentTypesToCreate.GetCount());
+
+  for (ezUInt32 i = 0; i < m_ComponentTypesToCreate.GetCount(); ++i)
+  {
+    const ezRTTI* pRtti = m_ComponentTypesToCreate[i].m_pRtti;
+
+    out_Managers[i] = m_pWorld->GetOrCreateManagerForComponentType(pRtti);
+    EZ_ASSERT_DEV(out_Managers[i] != nullptr, "Cannot create components of type '{0}', manager is not available.", pRtti->GetTypeName());
+  }
+}
+
+void ezWorldReader::CreateComponentsFromTemplate(ezArrayPtr<ezComponentManagerBase*> managers, ezMemoryStreamReader& memReader)
+{
+  for (ezUInt32 t = 0; t < m_ComponentTypesToCreate.GetCount(); ++t)
+  {
+    const ComponentTypeToCreate& typeToCreate = m_ComponentTypesToCreate[t];
+    ezComponentManagerBase* pManager = managers[t];
+
+    for (ezUInt32 i = 0; i < typeToCreate.m_uiNumComponents; ++i)
+    {
+      const ComponentToCreate& compToCreate = m_ComponentsToCreate[typeToCreate.m_uiFirstComponent + i];
 
       ezGameObject* pParentObject = nullptr;
-      m_pWorld->TryGetObject(hOwner, pParentObject);
+      m_pWorld->TryGetObject(m_IndexToGameObjectHandle[compToCreate.m_uiOwnerIndex], pParentObject);
 
       ezComponent* pComponent = nullptr;
-      auto hComponent = pManager->CreateComponent(pParentObject, pComponent);
-      m_IndexToComponentHandle[uiComponentIdx] = hComponent;
+      m_IndexToComponentHandle[compToCreate.m_uiComponentIndex] = pManager->CreateComponent(pParentObject, pComponent);
 
-      pComponent->SetActive(bActive);
+      pComponent->SetActive(compToCreate.m_bActive);
 
       for (ezUInt8 j = 0; j < 8; ++j)
       {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
+        pComponent->SetUserFlag(j, (compToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
+      }
+
+      // the component data is stored in the same order as the template, so this only skips the headers in between
+      const ezUInt32 uiReadPosition = memReader.GetReadPosition();
+      if (compToCreate.m_uiDataOffset != uiReadPosition)
+      {
+        // SetReadPosition() can't be used here, components without any data can end exactly at the end of the stream
+        EZ_ASSERT_DEBUG(compToCreate.m_uiDataOffset > uiReadPosition, "Component data is not read in order");
+        memReader.SkipBytes(compToCreate.m_uiDataOffset - uiReadPosition);
       }
 
       pComponent->DeserializeComponent(*this);
@@ -360,8 +644,17 @@ void ezWorldReader::FulfillComponentHandleRequets()
   m_ComponentHandleRequests.Clear();
 }
 
-void ezWorldReader::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezGameObjectHandle hParent,
-                                      ezHybridArray<ezGameObject*, 8>* out_CreatedObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+void ezWorldReader::ResetIndexTables()
+{
+  m_IndexToGameObjectHandle.Clear();
+  m_IndexToComponentHandle.Clear();
+
+  m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
+  m_IndexToComponentHandle.SetCount(m_uiMaxComponents + 1); // initialize with 'invalid' handles to be able to skip unknown components
+}
+
+void ezWorldReader::CreateGameObjects(ezArrayPtr<const GameObjectToCreate> objects, ezGameObjectHandle hParent,
+                                      ezDynamicArray<ezGameObject*>* out_CreatedObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
 {
   if (hParent.IsInvalidated())
   {
@@ -409,8 +702,8 @@ void ezWorldReader::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>&
 }
 
 
-void ezWorldReader::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, const ezTransform& rootTransform,
-                                      ezGameObjectHandle hParent, ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects,
+void ezWorldReader::CreateGameObjects(ezArrayPtr<const GameObjectToCreate> objects, const ezTransform& rootTransform,
+                                      ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects,
                                       const ezUInt16* pOverrideTeamID, bool bForceDynamic)
 {
   for (const auto& godesc : objects)
@@ -0,0 +1,236 @@
+#include <CorePCH.h>
+
+#include <Core/WorldSerializer/WorldCellWriter.h>
+#include <Core/WorldSerializer/WorldStreamer.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+
+void ezWorldStreamer::LoadTask::Execute()
+{
+  ezFileReader file;
+  if (file.Open(m_sFile).Failed())
+  {
+    ezLog::Error("Failed to open world cell '{0}'", m_sFile);
+    return;
+  }
+
+  m_pReader = EZ_DEFAULT_NEW(ezWorldReader);
+  m_pReader->ReadWorldDescription(file);
+}
+
+ezWorldStreamer::ezWorldStreamer(ezWorld& world)
+  : m_World(world)
+{
+}
+
+ezWorldStreamer::~ezWorldStreamer()
+{
+  for (Cell& cell : m_Cells)
+  {
+    CancelLoading(cell);
+  }
+}
+
+ezResult ezWorldStreamer::Initialize(const char* szDirectory)
+{
+  EZ_ASSERT_DEV(m_Cells.IsEmpty(), "The world streamer has already been initialized");
+
+  ezStringBuilder sFile;
+  ezWorldCellWriter::GetCellTableFile(szDirectory, sFile);
+
+  ezFileReader file;
+  if (file.Open(sFile).Failed())
+  {
+    ezLog::Error("Failed to open world cell table '{0}'", sFile);
+    return EZ_FAILURE;
+  }
+
+  ezDynamicArray<ezVec2I32> cells;
+  EZ_SUCCEED_OR_RETURN(ezWorldCellWriter::ReadCellTable(file, m_fCellSize, cells));
+
+  m_sDirectory = szDirectory;
+
+  m_Cells.SetCount(cells.GetCount());
+  for (ezUInt32 i = 0; i < cells.GetCount(); ++i)
+  {
+    m_Cells[i].m_vCoordinates = cells[i];
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezWorldStreamer::SetStreamingRadius(float fLoadRadius, float fUnloadRadius)
+{
+  EZ_ASSERT_DEV(fLoadRadius <= fUnloadRadius, "The unload radius must not be smaller than the load radius");
+
+  m_fLoadRadius = fLoadRadius;
+  m_fUnloadRadius = fUnloadRadius;
+}
+
+void ezWorldStreamer::Update(const ezVec3& vPointOfInterest, ezTime maxDuration)
+{
+  const ezTime tEnd = ezTime::Now() + maxDuration;
+
+  // decide which cells to load and unload, pick up finished loads
+  for (Cell& cell : m_Cells)
+  {
+    const float fDistance = GetDistanceToCell(cell, vPointOfInterest);
+
+    if (cell.m_State == CellState::Loading && cell.m_pLoadTask->IsTaskFinished())
+    {
+      cell.m_pReader = std::move(cell.m_pLoadTask->m_pReader);
+      cell.m_pLoadTask.Clear();
+      cell.m_State = CellState::Loaded;
+    }
+
+    if (fDistance <= m_fLoadRadius)
+    {
+      // a cell that is still being unloaded is loaded again once it is completely gone
+      if (cell.m_State == CellState::Unloaded)
+      {
+        StartLoading(cell);
+      }
+    }
+    else if (fDistance > m_fUnloadRadius)
+    {
+      StartUnloading(cell);
+    }
+  }
+
+  EZ_LOCK(m_World.GetWriteMarker());
+
+  // free memory first, then create objects, each step makes some progress even if the time is already up
+  for (Cell& cell : m_Cells)
+  {
+    if (cell.m_State != CellState::Unloading)
+      continue;
+
+    while (!cell.m_RootObjects.IsEmpty())
+    {
+      m_World.DeleteObjectNow(cell.m_RootObjects.PeekBack());
+      cell.m_RootObjects.PopBack();
+
+      if (ezTime::Now() >= tEnd)
+        return;
+    }
+
+    cell.m_State = CellState::Unloaded;
+  }
+
+  for (Cell& cell : m_Cells)
+  {
+    if (cell.m_State == CellState::Loaded)
+    {
+      // the cell could not be read, keep it as an empty cell to not try again every frame
+      if (cell.m_pReader == nullptr)
+      {
+        cell.m_State = CellState::Instantiated;
+        continue;
+      }
+
+      cell.m_pReader->BeginInstantiateWorldIncremental(m_World);
+      cell.m_State = CellState::Instantiating;
+    }
+
+    if (cell.m_State != CellState::Instantiating)
+      continue;
+
+    if (cell.m_pReader->InstantiateWorldIncremental(tEnd - ezTime::Now()))
+    {
+      cell.m_RootObjects = cell.m_pReader->GetCreatedRootObjects();
+      cell.m_pReader.Clear();
+      cell.m_State = CellState::Instantiated;
+    }
+
+    if (ezTime::Now() >= tEnd)
+      return;
+  }
+}
+
+void ezWorldStreamer::UnloadAll()
+{
+  EZ_LOCK(m_World.GetWriteMarker());
+
+  for (Cell& cell : m_Cells)
+  {
+    if (cell.m_State == CellState::Loading)
+    {
+      CancelLoading(cell);
+      cell.m_State = CellState::Unloaded;
+    }
+
+    StartUnloading(cell);
+
+    for (const ezGameObjectHandle& hObject : cell.m_RootObjects)
+    {
+      m_World.DeleteObjectNow(hObject);
+    }
+
+    cell.m_RootObjects.Clear();
+    cell.m_State = CellState::Unloaded;
+  }
+}
+
+float ezWorldStreamer::GetDistanceToCell(const Cell& cell, const ezVec3& vPosition) const
+{
+  const ezVec2 vMin = ezVec2(static_cast<float>(cell.m_vCoordinates.x), static_cast<float>(cell.m_vCoordinates.y)) * m_fCellSize;
+  const ezVec2 vMax = vMin + ezVec2(m_fCellSize);
+
+  const ezVec2 vPos = vPosition.GetAsVec2();
+  const ezVec2 vClosest = vPos.CompMax(vMin).CompMin(vMax);
+
+  return (vClosest - vPos).GetLength();
+}
+
+void ezWorldStreamer::StartLoading(Cell& cell)
+{
+  cell.m_pLoadTask = EZ_DEFAULT_NEW(LoadTask);
+  cell.m_pLoadTask->SetTaskName("Load World Cell");
+
+  ezStringBuilder sFile;
+  ezWorldCellWriter::GetCellFile(m_sDirectory, cell.m_vCoordinates, sFile);
+  cell.m_pLoadTask->m_sFile = sFile;
+
+  ezTaskSystem::StartSingleTask(cell.m_pLoadTask.Borrow(), ezTaskPriority::LongRunning);
+  cell.m_State = CellState::Loading;
+}
+
+void ezWorldStreamer::StartUnloading(Cell& cell)
+{
+  switch (cell.m_State)
+  {
+    case CellState::Loading:
+      // canceling would block if the task is already running, the cell is dropped once it is loaded instead
+      break;
+
+    case CellState::Loaded:
+      cell.m_pReader.Clear();
+      cell.m_State = CellState::Unloaded;
+      break;
+
+    case CellState::Instantiating:
+      // the objects that were created so far
+      cell.m_RootObjects = cell.m_pReader->GetCreatedRootObjects();
+      cell.m_pReader.Clear();
+      cell.m_State = CellState::Unloading;
+      break;
+
+    case CellState::Instantiated:
+      cell.m_State = CellState::Unloading;
+      break;
+
+    default:
+      break;
+  }
+}
+
+void ezWorldStreamer::CancelLoading(Cell& cell)
+{
+  if (cell.m_pLoadTask == nullptr)
+    return;
+
+  // waits if the task is already running
+  ezTaskSystem::CancelTask(cell.m_pLoadTask.Borrow());
+  cell.m_pLoadTask.Clear();
+}
+
+EZ_STATICLINK_FILE(Core, Core_WorldSerializer_Implementation_WorldStreamer);
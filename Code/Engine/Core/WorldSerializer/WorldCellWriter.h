@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Core/World/World.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/IO/Stream.h>
+
+/// \brief Splits a world into cells on a regular grid in the XY plane, which ezWorldStreamer can load and unload separately.
+///
+/// Every root object is put into the cell that contains its global position, together with all its children and components.
+/// Each cell is written in the same format as ezWorldWriter::WriteObjects(), so it can also be read with ezWorldReader directly.
+///
+/// \note Cells are written and loaded independently of each other, so references between them are not supported. A component that stores
+/// a handle to an object or component in a different cell is written with an invalid handle, which also triggers an assert in debug builds.
+/// Objects that reference each other have to be placed below a common root object, which keeps them in the same cell.
+class EZ_CORE_DLL ezWorldCellWriter
+{
+public:
+  /// \brief Sorts all root objects of the world into cells of the given size.
+  ///
+  /// The cells only store pointers to the objects, so the world must not be modified until all cells are written.
+  void PartitionWorld(ezWorld& world, float fCellSize);
+
+  /// \brief Writes the cell table and one file per cell into the given directory, as expected by ezWorldStreamer.
+  ezResult WriteToDirectory(const char* szDirectory) const;
+
+  /// \brief Writes the cell size and the coordinates of all cells.
+  void WriteCellTable(ezStreamWriter& stream) const;
+
+  /// \brief Writes all objects of the given cell.
+  void WriteCell(ezStreamWriter& stream, ezUInt32 uiCell) const;
+
+  /// \brief Reads a cell table that was written with WriteCellTable().
+  static ezResult ReadCellTable(ezStreamReader& stream, float& out_fCellSize, ezDynamicArray<ezVec2I32>& out_Cells);
+
+  ezUInt32 GetCellCount() const { return m_Cells.GetCount(); }
+
+  const ezVec2I32& GetCellCoordinates(ezUInt32 uiCell) const { return m_Cells[uiCell].m_vCoordinates; }
+
+  /// \brief Returns the coordinates of the cell that contains the given position.
+  static ezVec2I32 ComputeCellCoordinates(const ezVec3& vPosition, float fCellSize);
+
+  static void GetCellTableFile(const char* szDirectory, ezStringBuilder& out_sFile);
+  static void GetCellFile(const char* szDirectory, const ezVec2I32& vCell, ezStringBuilder& out_sFile);
+
+private:
+  struct Cell
+  {
+    ezVec2I32 m_vCoordinates;
+    ezDeque<const ezGameObject*> m_RootObjects;
+  };
+
+  float m_fCellSize = 0.0f;
+  ezDynamicArray<Cell> m_Cells;
+};
@@ -43,6 +43,45 @@ public:
                          ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
                          const ezUInt16* pOverrideTeamID, bool bForceDynamic);
 
+  /// \brief Creates one instance of the world per given root transform, all attached to \a hParent.
+  ///
+  /// This is faster than calling InstantiatePrefab() in a loop, the world is only locked once, the component managers are only looked up
+  /// once and the output arrays only grow once. The created objects of all instances are appended to the output arrays, instance after
+  /// instance, with GetRootObjectCount() and GetChildObjectCount() objects per instance.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+                          ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, ezDynamicArray<ezGameObject*>* out_CreatedChildObjects,
+                          const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+
+  /// \brief Starts creating one instance of the world over multiple calls to InstantiateWorldIncremental().
+  ///
+  /// This is meant for streaming in large worlds without stalling a frame. The world may be updated in between the steps, but the objects that
+  /// were created so far must not be deleted before the instantiation is finished. To abort, just stop calling InstantiateWorldIncremental()
+  /// and delete the root objects that were created so far, see GetCreatedRootObjects().
+  void BeginInstantiateWorldIncremental(ezWorld& world, const ezUInt16* pOverrideTeamID = nullptr);
+
+  /// \brief Continues the instantiation started with BeginInstantiateWorldIncremental(). Returns true once everything is created.
+  ///
+  /// Stops as soon as \a maxDuration has passed, which is only checked after each batch of objects or components, so it can take slightly
+  /// longer. Every call makes some progress, even with a zero duration. All game objects are created first, then the components.
+  /// Handles to other components are only set on the components at the very end, so none of the components are initialized before
+  /// that either.
+  bool InstantiateWorldIncremental(ezTime maxDuration);
+
+  /// \brief Returns whether an incremental instantiation was started and is not finished yet.
+  bool IsInstantiatingIncrementally() const { return m_Incremental.m_bActive; }
+
+  /// \brief Returns the handles of the root objects that were created by the last instantiation.
+  ///
+  /// During an incremental instantiation this is only the root objects that were created so far.
+  /// For prefab instantiation with a parent object, these are the objects that were attached to the parent.
+  ezArrayPtr<const ezGameObjectHandle> GetCreatedRootObjects() const;
+
+  /// \brief Returns the number of root objects that are created per instance.
+  ezUInt32 GetRootObjectCount() const { return m_RootObjectsToCreate.GetCount(); }
+
+  /// \brief Returns the number of child objects that are created per instance.
+  ezUInt32 GetChildObjectCount() const { return m_ChildObjectsToCreate.GetCount(); }
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const { return *m_pStream; }
 
@@ -77,16 +116,21 @@ private:
 
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentInfo(ezUInt32 uiComponentTypeIdx);
-  void ReadComponentsOfType(ezUInt32 uiComponentTypeIdx);
+  void ReadComponentsOfType(ezUInt32 uiComponentTypeIdx, ezMemoryStreamReader& memReader);
+  ezUInt32 ReadComponentTypeHeader(ezUInt32 uiComponentTypeIdx, ezMemoryStreamReader& memReader, ezComponentManagerBase*& out_pManager);
+  void ReadComponent(ezComponentManagerBase* pManager, ezMemoryStreamReader& memReader);
+  void GetComponentManagers(ezDynamicArray<ezComponentManagerBase*>& out_Managers) const;
+  void CreateComponentsFromTemplate(ezArrayPtr<ezComponentManagerBase*> managers, ezMemoryStreamReader& memReader);
   void FulfillComponentHandleRequets();
+  void ResetIndexTables();
   void Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, ezGameObjectHandle hParent,
-                   ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
+                   ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, ezDynamicArray<ezGameObject*>* out_CreatedChildObjects,
                    const ezUInt16* pOverrideTeamID, bool bForceDynamic);
 
-  void CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezGameObjectHandle hParent,
-                         ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
-  void CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, const ezTransform& rootTransform, ezGameObjectHandle hParent,
-                         ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+  void CreateGameObjects(ezArrayPtr<const GameObjectToCreate> objects, ezGameObjectHandle hParent,
+                         ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+  void CreateGameObjects(ezArrayPtr<const GameObjectToCreate> objects, const ezTransform& rootTransform, ezGameObjectHandle hParent,
+                         ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
 
   ezStreamReader* m_pStream;
   ezWorld* m_pWorld;
@@ -108,7 +152,48 @@ private:
   ezDynamicArray<GameObjectToCreate> m_RootObjectsToCreate;
   ezDynamicArray<GameObjectToCreate> m_ChildObjectsToCreate;
 
+  /// The component stream is only parsed during the first instantiation. What to create is recorded in this template, all further
+  /// instantiations only deserialize the components' own data, starting at the recorded offsets.
+  struct ComponentToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOwnerIndex;
+    ezUInt32 m_uiComponentIndex;
+    ezUInt32 m_uiDataOffset; ///< Read position of the component data in m_ComponentStream
+    bool m_bActive;
+    ezUInt8 m_uiUserFlags;
+  };
+
+  struct ComponentTypeToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezRTTI* m_pRtti;
+    ezUInt32 m_uiFirstComponent;
+    ezUInt32 m_uiNumComponents;
+  };
+
+  bool m_bComponentTemplateValid = false;
+  ezDynamicArray<ComponentToCreate> m_ComponentsToCreate;
+  ezDynamicArray<ComponentTypeToCreate> m_ComponentTypesToCreate;
+
   ezHybridArray<CompRequest, 64> m_ComponentHandleRequests;
+
+  struct IncrementalState
+  {
+    bool m_bActive = false;
+    bool m_bOverrideTeamID = false;
+    ezUInt16 m_uiTeamID = 0;
+    ezUInt32 m_uiNextObject = 0;
+    ezUInt32 m_uiNextComponentType = 0;
+    ezUInt32 m_uiComponentsLeftInType = 0;
+    ezComponentManagerBase* m_pComponentManager = nullptr;
+    ezMemoryStreamReader m_ComponentReader;
+    ezDynamicArray<ezComponentHandle> m_ComponentsToInitialize;
+  };
+
+  IncrementalState m_Incremental;
   ezDynamicArray<const ezRTTI*> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
   ezMemoryStreamStorage m_ComponentStream;
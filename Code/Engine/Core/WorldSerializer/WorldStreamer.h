@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief Loads and unloads the cells of a world that was split up with ezWorldCellWriter, depending on their distance to a point of
+/// interest.
+///
+/// Cells are read and decoded on worker threads. The objects of a decoded cell are then created in Update(), which only spends a given
+/// amount of time per call on creating and deleting objects, so that streaming a large world does not stall any frame.
+/// Unloading works the other way round, the objects of a cell are deleted over multiple calls to Update().
+class EZ_CORE_DLL ezWorldStreamer
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezWorldStreamer);
+
+public:
+  struct CellState
+  {
+    enum Enum
+    {
+      Unloaded,
+      Loading,       ///< The cell is read and decoded on a worker thread.
+      Loaded,        ///< The cell is decoded, its objects are created next.
+      Instantiating, ///< Some of the objects of the cell are created.
+      Instantiated,  ///< All objects of the cell are created.
+      Unloading,     ///< The objects of the cell are being deleted.
+    };
+  };
+
+  ezWorldStreamer(ezWorld& world);
+
+  /// \brief Cancels all pending loads. Objects that were already created stay in the world, use UnloadAll() to delete them.
+  ~ezWorldStreamer();
+
+  /// \brief Reads the cell table from a directory that was written with ezWorldCellWriter::WriteToDirectory().
+  ezResult Initialize(const char* szDirectory);
+
+  /// \brief Cells that are closer to the point of interest than fLoadRadius are loaded, cells farther away than fUnloadRadius are unloaded.
+  ///
+  /// The unload radius should be larger than the load radius, so that cells are not loaded and unloaded over and over again while the
+  /// point of interest moves along a cell border.
+  void SetStreamingRadius(float fLoadRadius, float fUnloadRadius);
+
+  /// \brief Starts loading and unloading cells depending on the given point of interest and creates and deletes objects for at most
+  /// roughly \a maxDuration.
+  ///
+  /// Has to be called on the thread that updates the world, but not during the world update.
+  void Update(const ezVec3& vPointOfInterest, ezTime maxDuration);
+
+  /// \brief Waits for all pending loads and deletes the objects of all cells right away.
+  void UnloadAll();
+
+  ezUInt32 GetCellCount() const { return m_Cells.GetCount(); }
+
+  const ezVec2I32& GetCellCoordinates(ezUInt32 uiCell) const { return m_Cells[uiCell].m_vCoordinates; }
+
+  CellState::Enum GetCellState(ezUInt32 uiCell) const { return m_Cells[uiCell].m_State; }
+
+private:
+  class LoadTask : public ezTask
+  {
+  public:
+    virtual void Execute() override;
+
+    ezString m_sFile;
+    ezUniquePtr<ezWorldReader> m_pReader;
+  };
+
+  struct Cell
+  {
+    ezVec2I32 m_vCoordinates;
+    CellState::Enum m_State = CellState::Unloaded;
+    ezUniquePtr<LoadTask> m_pLoadTask;
+    ezUniquePtr<ezWorldReader> m_pReader;
+    ezDynamicArray<ezGameObjectHandle> m_RootObjects; ///< Only used for unloading.
+  };
+
+  float GetDistanceToCell(const Cell& cell, const ezVec3& vPosition) const;
+  void StartLoading(Cell& cell);
+  void StartUnloading(Cell& cell);
+  void CancelLoading(Cell& cell);
+
+  ezWorld& m_World;
+  ezString m_sDirectory;
+  float m_fCellSize = 1.0f;
+  float m_fLoadRadius = 100.0f;
+  float m_fUnloadRadius = 150.0f;
+  ezDynamicArray<Cell> m_Cells;
+};
@@ -62,6 +62,7 @@
 #define EZ_SUPPORTS_UNRESTRICTED_FILE_ACCESS EZ_OFF
 #define EZ_SUPPORTS_CASE_INSENSITIVE_PATHS EZ_OFF
 #define EZ_SUPPORTS_CRASH_DUMPS EZ_OFF
+#define EZ_SUPPORTS_COROUTINES EZ_OFF
 
 // Allocators
 #define EZ_USE_ALLOCATION_TRACKING EZ_OFF
@@ -12,6 +12,12 @@
 #error "Undefined platform!"
 #endif
 
+// coroutines are a language feature, they are available on all platforms when compiling as C++20 (see EZ_ENABLE_CPP20)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#undef EZ_SUPPORTS_COROUTINES
+#define EZ_SUPPORTS_COROUTINES EZ_ON
+#endif
+
 
 // now check that the defines for each feature are set (either to 1 or 0, but they must be defined)
 
@@ -47,3 +53,7 @@
 #error "EZ_SUPPORTS_CASE_INSENSITIVE_PATHS is not defined."
 #endif
 
+#ifndef EZ_SUPPORTS_COROUTINES
+#error "EZ_SUPPORTS_COROUTINES is not defined."
+#endif
+
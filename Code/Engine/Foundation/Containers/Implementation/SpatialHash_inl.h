@@ -0,0 +1,499 @@
+#pragma once
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Math/Constants.h>
+
+namespace ezInternal
+{
+  enum
+  {
+    SPATIAL_HASH_CELL_INDEX_BITS = 21,
+    SPATIAL_HASH_MAX_CELL_INDEX = (1 << (SPATIAL_HASH_CELL_INDEX_BITS - 1)) - 1,
+    SPATIAL_HASH_CELL_INDEX_MASK = (1 << SPATIAL_HASH_CELL_INDEX_BITS) - 1
+  };
+} // namespace ezInternal
+
+template <typename T>
+ezSpatialHash<T>::ezSpatialHash() = default;
+
+template <typename T>
+void ezSpatialHash<T>::Initialize(float fCellSize)
+{
+  EZ_ASSERT_DEV(fCellSize > 0.0f, "Invalid cell size {0}", fCellSize);
+
+  Clear();
+
+  m_fCellSize = fCellSize;
+  m_fInvCellSize = 1.0f / fCellSize;
+}
+
+template <typename T>
+void ezSpatialHash<T>::Clear()
+{
+  m_uiCount = 0;
+  m_uiFreeChunks = ezInvalidIndex;
+
+  m_Cells.Clear();
+  m_Chunks.Clear();
+  m_Values.Clear();
+}
+
+template <typename T>
+void ezSpatialHash<T>::Insert(const ezVec3& vPosition, const T& value)
+{
+  const ezUInt64 uiCellKey = GetCellKey(vPosition);
+
+  ezUInt32* pFirstChunk = m_Cells.GetValue(uiCellKey);
+  if (pFirstChunk == nullptr || m_Chunks[*pFirstChunk].m_uiCount == CHUNK_SIZE)
+  {
+    // the new chunk is put in front, so only the first chunk of a cell is ever partially filled
+    const ezUInt32 uiNewChunk = AllocateChunk();
+    m_Chunks[uiNewChunk].m_uiNextChunk = pFirstChunk != nullptr ? *pFirstChunk : ezInvalidIndex;
+
+    m_Cells[uiCellKey] = uiNewChunk;
+    pFirstChunk = m_Cells.GetValue(uiCellKey);
+  }
+
+  Chunk& chunk = m_Chunks[*pFirstChunk];
+  const ezUInt32 i = chunk.m_uiCount;
+
+  chunk.m_fX[i] = vPosition.x;
+  chunk.m_fY[i] = vPosition.y;
+  chunk.m_fZ[i] = vPosition.z;
+  m_Values[*pFirstChunk * CHUNK_SIZE + i] = value;
+
+  ++chunk.m_uiCount;
+  ++m_uiCount;
+}
+
+template <typename T>
+bool ezSpatialHash<T>::Remove(const ezVec3& vPosition, const T& value)
+{
+  const ezUInt64 uiCellKey = GetCellKey(vPosition);
+
+  ezUInt32 uiFirstChunk = ezInvalidIndex;
+  if (!m_Cells.TryGetValue(uiCellKey, uiFirstChunk))
+    return false;
+
+  for (ezUInt32 uiChunk = uiFirstChunk; uiChunk != ezInvalidIndex; uiChunk = m_Chunks[uiChunk].m_uiNextChunk)
+  {
+    Chunk& chunk = m_Chunks[uiChunk];
+
+    for (ezUInt32 i = 0; i < chunk.m_uiCount; ++i)
+    {
+      const ezUInt32 uiValueIndex = uiChunk * CHUNK_SIZE + i;
+
+      if (chunk.m_fX[i] != vPosition.x || chunk.m_fY[i] != vPosition.y || chunk.m_fZ[i] != vPosition.z || !(m_Values[uiValueIndex] == value))
+        continue;
+
+      // fill the gap with the last point of the cell, which is always in the first chunk
+      Chunk& firstChunk = m_Chunks[uiFirstChunk];
+      const ezUInt32 uiLast = firstChunk.m_uiCount - 1;
+
+      chunk.m_fX[i] = firstChunk.m_fX[uiLast];
+      chunk.m_fY[i] = firstChunk.m_fY[uiLast];
+      chunk.m_fZ[i] = firstChunk.m_fZ[uiLast];
+      m_Values[uiValueIndex] = m_Values[uiFirstChunk * CHUNK_SIZE + uiLast];
+
+      // unused slots are skipped by the queries, they are kept far away so that no stale point is left in the chunk
+      firstChunk.m_fX[uiLast] = ezMath::MaxValue<float>();
+      firstChunk.m_fY[uiLast] = ezMath::MaxValue<float>();
+      firstChunk.m_fZ[uiLast] = ezMath::MaxValue<float>();
+      m_Values[uiFirstChunk * CHUNK_SIZE + uiLast] = T();
+
+      --firstChunk.m_uiCount;
+      --m_uiCount;
+
+      if (firstChunk.m_uiCount == 0)
+      {
+        const ezUInt32 uiNextChunk = firstChunk.m_uiNextChunk;
+
+        firstChunk.m_uiNextChunk = m_uiFreeChunks;
+        m_uiFreeChunks = uiFirstChunk;
+
+        if (uiNextChunk != ezInvalidIndex)
+        {
+          m_Cells[uiCellKey] = uiNextChunk;
+        }
+        else
+        {
+          m_Cells.Remove(uiCellKey);
+        }
+      }
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <typename T>
+void ezSpatialHash<T>::FindInRadius(const ezVec3& vCenter, float fRadius, ezDynamicArrayBase<T>& out_Values) const
+{
+  ForEachPointInRadius(vCenter, fRadius, [&](ezUInt32 uiValueIndex, float /*fDistanceSquared*/) { out_Values.PushBack(m_Values[uiValueIndex]); });
+}
+
+template <typename T>
+void ezSpatialHash<T>::FindInRadius(ezArrayPtr<const ezVec3> centers, float fRadius, ezDynamicArrayBase<T>& out_Values, ezDynamicArrayBase<ezUInt32>& out_QueryStarts) const
+{
+  out_Values.Clear();
+  out_QueryStarts.SetCountUninitialized(centers.GetCount());
+
+  for (ezUInt32 i = 0; i < centers.GetCount(); ++i)
+  {
+    out_QueryStarts[i] = out_Values.GetCount();
+
+    FindInRadius(centers[i], fRadius, out_Values);
+  }
+}
+
+template <typename T>
+void ezSpatialHash<T>::FindNearest(const ezVec3& vCenter, ezUInt32 uiMaxCount, float fMaxRadius, ezDynamicArrayBase<T>& out_Values) const
+{
+  ezHybridArray<Candidate, 64> candidates;
+  FindNearest(vCenter, uiMaxCount, fMaxRadius, out_Values, candidates);
+}
+
+template <typename T>
+void ezSpatialHash<T>::FindNearest(ezArrayPtr<const ezVec3> centers, ezUInt32 uiMaxCount, float fMaxRadius, ezDynamicArrayBase<T>& out_Values,
+  ezDynamicArrayBase<ezUInt32>& out_QueryStarts) const
+{
+  out_Values.Clear();
+  out_QueryStarts.SetCountUninitialized(centers.GetCount());
+
+  // the candidates array is shared by all queries, so it only grows once
+  ezHybridArray<Candidate, 64> candidates;
+
+  for (ezUInt32 i = 0; i < centers.GetCount(); ++i)
+  {
+    out_QueryStarts[i] = out_Values.GetCount();
+
+    FindNearest(centers[i], uiMaxCount, fMaxRadius, out_Values, candidates);
+  }
+}
+
+template <typename T>
+ezUInt64 ezSpatialHash<T>::GetHeapMemoryUsage() const
+{
+  return m_Cells.GetHeapMemoryUsage() + m_Chunks.GetHeapMemoryUsage() + m_Values.GetHeapMemoryUsage();
+}
+
+template <typename T>
+EZ_ALWAYS_INLINE ezUInt64 ezSpatialHash<T>::GetCellKey(ezInt32 x, ezInt32 y, ezInt32 z)
+{
+  // cell indices outside of the representable range wrap around, which only makes the affected cells more crowded
+  const ezUInt64 sx = (x + ezInternal::SPATIAL_HASH_MAX_CELL_INDEX) & ezInternal::SPATIAL_HASH_CELL_INDEX_MASK;
+  const ezUInt64 sy = (y + ezInternal::SPATIAL_HASH_MAX_CELL_INDEX) & ezInternal::SPATIAL_HASH_CELL_INDEX_MASK;
+  const ezUInt64 sz = (z + ezInternal::SPATIAL_HASH_MAX_CELL_INDEX) & ezInternal::SPATIAL_HASH_CELL_INDEX_MASK;
+
+  return (sx << (ezInternal::SPATIAL_HASH_CELL_INDEX_BITS * 2)) | (sy << ezInternal::SPATIAL_HASH_CELL_INDEX_BITS) | sz;
+}
+
+template <typename T>
+EZ_ALWAYS_INLINE ezUInt64 ezSpatialHash<T>::GetCellKey(const ezVec3& vPosition) const
+{
+  return GetCellKey(static_cast<ezInt32>(ezMath::Floor(vPosition.x * m_fInvCellSize)), static_cast<ezInt32>(ezMath::Floor(vPosition.y * m_fInvCellSize)),
+    static_cast<ezInt32>(ezMath::Floor(vPosition.z * m_fInvCellSize)));
+}
+
+template <typename T>
+template <typename Callback>
+void ezSpatialHash<T>::ForEachPointInRadius(const ezVec3& vCenter, float fRadius, Callback callback) const
+{
+  if (IsEmpty())
+    return;
+
+  const ezSimdVec4f vCenterX(vCenter.x);
+  const ezSimdVec4f vCenterY(vCenter.y);
+  const ezSimdVec4f vCenterZ(vCenter.z);
+  const ezSimdVec4f vRadiusSquared(fRadius * fRadius);
+
+  const float fMinX = ezMath::Floor((vCenter.x - fRadius) * m_fInvCellSize);
+  const float fMinY = ezMath::Floor((vCenter.y - fRadius) * m_fInvCellSize);
+  const float fMinZ = ezMath::Floor((vCenter.z - fRadius) * m_fInvCellSize);
+  const float fMaxX = ezMath::Floor((vCenter.x + fRadius) * m_fInvCellSize);
+  const float fMaxY = ezMath::Floor((vCenter.y + fRadius) * m_fInvCellSize);
+  const float fMaxZ = ezMath::Floor((vCenter.z + fRadius) * m_fInvCellSize);
+
+  const float fNumCellsInRange = (fMaxX - fMinX + 1.0f) * (fMaxY - fMinY + 1.0f) * (fMaxZ - fMinZ + 1.0f);
+
+  // for large radii it is cheaper to look at every existing cell than to look up all cells in range
+  if (fNumCellsInRange > static_cast<float>(m_Cells.GetCount()))
+  {
+    for (auto it = m_Cells.GetIterator(); it.IsValid(); ++it)
+    {
+      ForEachPointInChunkList(it.Value(), vCenterX, vCenterY, vCenterZ, vRadiusSquared, callback);
+    }
+
+    return;
+  }
+
+  const ezInt32 iMinX = static_cast<ezInt32>(fMinX);
+  const ezInt32 iMinY = static_cast<ezInt32>(fMinY);
+  const ezInt32 iMinZ = static_cast<ezInt32>(fMinZ);
+  const ezInt32 iMaxX = static_cast<ezInt32>(fMaxX);
+  const ezInt32 iMaxY = static_cast<ezInt32>(fMaxY);
+  const ezInt32 iMaxZ = static_cast<ezInt32>(fMaxZ);
+
+  for (ezInt32 z = iMinZ; z <= iMaxZ; ++z)
+  {
+    for (ezInt32 y = iMinY; y <= iMaxY; ++y)
+    {
+      for (ezInt32 x = iMinX; x <= iMaxX; ++x)
+      {
+        if (const ezUInt32* pFirstChunk = m_Cells.GetValue(GetCellKey(x, y, z)))
+        {
+          ForEachPointInChunkList(*pFirstChunk, vCenterX, vCenterY, vCenterZ, vRadiusSquared, callback);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+template <typename Callback>
+EZ_FORCE_INLINE void ezSpatialHash<T>::ForEachPointInChunkList(ezUInt32 uiFirstChunk, const ezSimdVec4f& vCenterX, const ezSimdVec4f& vCenterY,
+  const ezSimdVec4f& vCenterZ, const ezSimdVec4f& vRadiusSquared, Callback& callback) const
+{
+  const ezSimdVec4f vLaneIndices(0.0f, 1.0f, 2.0f, 3.0f);
+
+  for (ezUInt32 uiChunk = uiFirstChunk; uiChunk != ezInvalidIndex; uiChunk = m_Chunks[uiChunk].m_uiNextChunk)
+  {
+    const Chunk& chunk = m_Chunks[uiChunk];
+
+    for (ezUInt32 i = 0; i < chunk.m_uiCount; i += 4)
+    {
+      ezSimdVec4f vDiffX, vDiffY, vDiffZ;
+      vDiffX.Load<4>(chunk.m_fX + i);
+      vDiffY.Load<4>(chunk.m_fY + i);
+      vDiffZ.Load<4>(chunk.m_fZ + i);
+
+      vDiffX -= vCenterX;
+      vDiffY -= vCenterY;
+      vDiffZ -= vCenterZ;
+
+      const ezSimdVec4f vDistanceSquared = vDiffX.CompMul(vDiffX) + vDiffY.CompMul(vDiffY) + vDiffZ.CompMul(vDiffZ);
+      // the unused slots at the end are far away, but an infinite radius would still include them
+      const ezSimdVec4f vNumUsed(static_cast<float>(chunk.m_uiCount - i));
+      const ezSimdVec4b inside = (vDistanceSquared <= vRadiusSquared) && (vLaneIndices < vNumUsed);
+
+      if (!inside.AnySet())
+        continue;
+
+      float fDistanceSquared[4];
+      vDistanceSquared.Store<4>(fDistanceSquared);
+
+      const ezUInt32 uiValueIndex = uiChunk * CHUNK_SIZE + i;
+
+      if (inside.x())
+        callback(uiValueIndex + 0, fDistanceSquared[0]);
+      if (inside.y())
+        callback(uiValueIndex + 1, fDistanceSquared[1]);
+      if (inside.z())
+        callback(uiValueIndex + 2, fDistanceSquared[2]);
+      if (inside.w())
+        callback(uiValueIndex + 3, fDistanceSquared[3]);
+    }
+  }
+}
+
+template <typename T>
+void ezSpatialHash<T>::FindNearest(const ezVec3& vCenter, ezUInt32 uiMaxCount, float fMaxRadius, ezDynamicArrayBase<T>& out_Values,
+  ezDynamicArrayBase<Candidate>& candidates) const
+{
+  if (uiMaxCount == 0 || IsEmpty())
+    return;
+
+  candidates.Clear();
+
+  const ezSimdVec4f vCenterX(vCenter.x);
+  const ezSimdVec4f vCenterY(vCenter.y);
+  const ezSimdVec4f vCenterZ(vCenter.z);
+  const float fMaxRadiusSquared = fMaxRadius * fMaxRadius;
+
+  // candidates is a max-heap of the closest points found so far, once it is full only closer points are taken
+  auto addCandidate = [&](ezUInt32 uiValueIndex, float fDistanceSquared) {
+    if (candidates.GetCount() < uiMaxCount)
+    {
+      PushCandidate(candidates, fDistanceSquared, uiValueIndex);
+    }
+    else if (fDistanceSquared < candidates[0].m_fDistanceSquared)
+    {
+      ReplaceFarthestCandidate(candidates, fDistanceSquared, uiValueIndex);
+    }
+  };
+
+  auto getRadiusSquared = [&]() {
+    return ezSimdVec4f(candidates.GetCount() == uiMaxCount ? candidates[0].m_fDistanceSquared : fMaxRadiusSquared);
+  };
+
+  const ezInt32 iCenterX = static_cast<ezInt32>(ezMath::Floor(vCenter.x * m_fInvCellSize));
+  const ezInt32 iCenterY = static_cast<ezInt32>(ezMath::Floor(vCenter.y * m_fInvCellSize));
+  const ezInt32 iCenterZ = static_cast<ezInt32>(ezMath::Floor(vCenter.z * m_fInvCellSize));
+
+  // distance from the center to the closest face of its own cell
+  const float fDistanceToCellBorder = ezMath::Min(vCenter.x - iCenterX * m_fCellSize, (iCenterX + 1) * m_fCellSize - vCenter.x,
+    vCenter.y - iCenterY * m_fCellSize, (iCenterY + 1) * m_fCellSize - vCenter.y, vCenter.z - iCenterZ * m_fCellSize,
+    (iCenterZ + 1) * m_fCellSize - vCenter.z);
+
+  const ezUInt32 uiNumCells = m_Cells.GetCount();
+  ezUInt32 uiNumVisitedCells = 0;
+
+  // search outwards one ring of cells at a time, ring r are all cells that are r cells away from the center cell along the farthest axis
+  for (ezInt32 r = 0;; ++r)
+  {
+    const float fRingWidth = static_cast<float>(2 * r + 1);
+    const float fInnerWidth = static_cast<float>(ezMath::Max(2 * r - 1, 0));
+    const float fNumCellsInRing = fRingWidth * fRingWidth * fRingWidth - fInnerWidth * fInnerWidth * fInnerWidth;
+
+    // far out rings are larger than the whole hash, go through the remaining cells instead
+    if (fNumCellsInRing > static_cast<float>(uiNumCells))
+    {
+      for (auto it = m_Cells.GetIterator(); it.IsValid(); ++it)
+      {
+        if (GetCellDistance(it.Key(), iCenterX, iCenterY, iCenterZ) >= r)
+        {
+          ForEachPointInChunkList(it.Value(), vCenterX, vCenterY, vCenterZ, getRadiusSquared(), addCandidate);
+        }
+      }
+
+      break;
+    }
+
+    for (ezInt32 z = -r; z <= r; ++z)
+    {
+      for (ezInt32 y = -r; y <= r; ++y)
+      {
+        // inside the ring only the first and the last cell of a row belong to it
+        const bool bFullRow = z == -r || z == r || y == -r || y == r;
+        const ezInt32 iStepX = bFullRow ? 1 : 2 * r;
+
+        for (ezInt32 x = -r; x <= r; x += iStepX)
+        {
+          if (const ezUInt32* pFirstChunk = m_Cells.GetValue(GetCellKey(iCenterX + x, iCenterY + y, iCenterZ + z)))
+          {
+            ForEachPointInChunkList(*pFirstChunk, vCenterX, vCenterY, vCenterZ, getRadiusSquared(), addCandidate);
+            ++uiNumVisitedCells;
+          }
+        }
+      }
+    }
+
+    if (uiNumVisitedCells == uiNumCells)
+      break;
+
+    // every point that was not visited yet is at least this far away
+    const float fSearchedRadius = fDistanceToCellBorder + r * m_fCellSize;
+
+    if (fSearchedRadius > fMaxRadius)
+      break;
+
+    if (candidates.GetCount() == uiMaxCount && candidates[0].m_fDistanceSquared <= fSearchedRadius * fSearchedRadius)
+      break;
+  }
+
+  candidates.Sort();
+
+  for (const Candidate& candidate : candidates)
+  {
+    out_Values.PushBack(m_Values[candidate.m_uiValueIndex]);
+  }
+}
+
+template <typename T>
+ezInt32 ezSpatialHash<T>::GetCellDistance(ezUInt64 uiCellKey, ezInt32 x, ezInt32 y, ezInt32 z)
+{
+  // compares in the wrapped around index space of the keys
+  const ezUInt64 uiOtherKey = GetCellKey(x, y, z);
+
+  ezInt32 iDistance = 0;
+  for (ezUInt32 uiShift = 0; uiShift < ezInternal::SPATIAL_HASH_CELL_INDEX_BITS * 3; uiShift += ezInternal::SPATIAL_HASH_CELL_INDEX_BITS)
+  {
+    const ezInt32 a = static_cast<ezInt32>((uiCellKey >> uiShift) & ezInternal::SPATIAL_HASH_CELL_INDEX_MASK);
+    const ezInt32 b = static_cast<ezInt32>((uiOtherKey >> uiShift) & ezInternal::SPATIAL_HASH_CELL_INDEX_MASK);
+    const ezInt32 iDiff = ((a - b + ezInternal::SPATIAL_HASH_MAX_CELL_INDEX) & ezInternal::SPATIAL_HASH_CELL_INDEX_MASK) - ezInternal::SPATIAL_HASH_MAX_CELL_INDEX;
+
+    iDistance = ezMath::Max(iDistance, ezMath::Abs(iDiff));
+  }
+
+  return iDistance;
+}
+
+template <typename T>
+void ezSpatialHash<T>::PushCandidate(ezDynamicArrayBase<Candidate>& candidates, float fDistanceSquared, ezUInt32 uiValueIndex)
+{
+  ezUInt32 i = candidates.GetCount();
+  candidates.ExpandAndGetRef();
+
+  // move the farther parents down until the new candidate fits
+  while (i > 0)
+  {
+    const ezUInt32 uiParent = (i - 1) / 2;
+    if (candidates[uiParent].m_fDistanceSquared >= fDistanceSquared)
+      break;
+
+    candidates[i] = candidates[uiParent];
+    i = uiParent;
+  }
+
+  candidates[i].m_fDistanceSquared = fDistanceSquared;
+  candidates[i].m_uiValueIndex = uiValueIndex;
+}
+
+template <typename T>
+void ezSpatialHash<T>::ReplaceFarthestCandidate(ezDynamicArrayBase<Candidate>& candidates, float fDistanceSquared, ezUInt32 uiValueIndex)
+{
+  const ezUInt32 uiCount = candidates.GetCount();
+  ezUInt32 i = 0;
+
+  // move the farther children up until the new candidate fits
+  while (true)
+  {
+    ezUInt32 uiChild = i * 2 + 1;
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && candidates[uiChild + 1].m_fDistanceSquared > candidates[uiChild].m_fDistanceSquared)
+      ++uiChild;
+
+    if (candidates[uiChild].m_fDistanceSquared <= fDistanceSquared)
+      break;
+
+    candidates[i] = candidates[uiChild];
+    i = uiChild;
+  }
+
+  candidates[i].m_fDistanceSquared = fDistanceSquared;
+  candidates[i].m_uiValueIndex = uiValueIndex;
+}
+
+template <typename T>
+ezUInt32 ezSpatialHash<T>::AllocateChunk()
+{
+  ezUInt32 uiChunk = m_uiFreeChunks;
+
+  if (uiChunk != ezInvalidIndex)
+  {
+    m_uiFreeChunks = m_Chunks[uiChunk].m_uiNextChunk;
+  }
+  else
+  {
+    uiChunk = m_Chunks.GetCount();
+    m_Chunks.ExpandAndGetRef();
+    m_Values.SetCount(m_Chunks.GetCount() * CHUNK_SIZE);
+  }
+
+  Chunk& chunk = m_Chunks[uiChunk];
+  chunk.m_uiCount = 0;
+  chunk.m_uiNextChunk = ezInvalidIndex;
+
+  for (ezUInt32 i = 0; i < CHUNK_SIZE; ++i)
+  {
+    chunk.m_fX[i] = ezMath::MaxValue<float>();
+    chunk.m_fY[i] = ezMath::MaxValue<float>();
+    chunk.m_fZ[i] = ezMath::MaxValue<float>();
+  }
+
+  return uiChunk;
+}
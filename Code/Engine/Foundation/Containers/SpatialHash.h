@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+
+/// \brief Stores values at points in space and finds them again with radius and k-nearest queries.
+///
+/// Space is divided into cubic cells of a fixed size. Only cells that contain points are stored, so there is no limit on the area that
+/// is covered. The positions inside a cell are stored in chunks of structure-of-arrays data, so that the distance tests check four points
+/// at once. Choose a cell size in the range of the typical query radius.
+///
+/// All queries append to caller provided arrays and never allocate anything else on the heap, unless a k-nearest query asks for many
+/// points. k-nearest queries search outwards from the center cell and stop as soon as no unvisited cell can contain a closer point. Queries are const and can be executed from multiple threads at the same time, as long as the hash is not modified.
+/// The batched query functions should be preferred when many queries are executed in one go.
+///
+/// T is usually a small index or handle. It must be default constructible and comparable with operator==.
+template <typename T>
+class ezSpatialHash
+{
+public:
+  ezSpatialHash();
+
+  /// \brief Removes all points and sets the edge length of the cells.
+  void Initialize(float fCellSize); // [tested]
+
+  /// \brief Removes all points, but keeps the allocated memory.
+  void Clear(); // [tested]
+
+  /// \brief Returns the number of stored points.
+  ezUInt32 GetCount() const { return m_uiCount; } // [tested]
+
+  /// \brief Returns whether no points are stored.
+  bool IsEmpty() const { return m_uiCount == 0; } // [tested]
+
+  /// \brief Returns the edge length of the cells.
+  float GetCellSize() const { return m_fCellSize; }
+
+  /// \brief Stores the given value at the given position. A value may be inserted multiple times.
+  void Insert(const ezVec3& vPosition, const T& value); // [tested]
+
+  /// \brief Removes the given value, which must have been inserted at exactly the given position.
+  ///
+  /// Returns false if no such point exists. Moving a point is done by removing and inserting it again.
+  bool Remove(const ezVec3& vPosition, const T& value); // [tested]
+
+  /// \brief Appends the values of all points within fRadius around vCenter to out_Values, in no particular order.
+  void FindInRadius(const ezVec3& vCenter, float fRadius, ezDynamicArrayBase<T>& out_Values) const; // [tested]
+
+  /// \brief Executes one radius query for each entry in centers.
+  ///
+  /// Both output arrays are cleared first. out_QueryStarts gets one entry per query, which is the index of the first result of that query
+  /// in out_Values. The results of the last query end at the end of out_Values.
+  void FindInRadius(ezArrayPtr<const ezVec3> centers, float fRadius, ezDynamicArrayBase<T>& out_Values, ezDynamicArrayBase<ezUInt32>& out_QueryStarts) const; // [tested]
+
+  /// \brief Appends the values of up to uiMaxCount points that are closest to vCenter and not farther away than fMaxRadius to out_Values,
+  /// sorted by distance.
+  void FindNearest(const ezVec3& vCenter, ezUInt32 uiMaxCount, float fMaxRadius, ezDynamicArrayBase<T>& out_Values) const; // [tested]
+
+  /// \brief Executes one k-nearest query for each entry in centers. The output arrays are filled like in the batched FindInRadius().
+  void FindNearest(ezArrayPtr<const ezVec3> centers, ezUInt32 uiMaxCount, float fMaxRadius, ezDynamicArrayBase<T>& out_Values,
+    ezDynamicArrayBase<ezUInt32>& out_QueryStarts) const; // [tested]
+
+  /// \brief Returns the amount of heap memory used by this container.
+  ezUInt64 GetHeapMemoryUsage() const;
+
+private:
+  enum
+  {
+    CHUNK_SIZE = 8
+  };
+
+  struct Chunk
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fX[CHUNK_SIZE];
+    float m_fY[CHUNK_SIZE];
+    float m_fZ[CHUNK_SIZE];
+
+    ezUInt32 m_uiCount;
+    ezUInt32 m_uiNextChunk;
+  };
+
+  struct Candidate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fDistanceSquared;
+    ezUInt32 m_uiValueIndex;
+
+    EZ_ALWAYS_INLINE bool operator<(const Candidate& other) const { return m_fDistanceSquared < other.m_fDistanceSquared; }
+  };
+
+  static ezUInt64 GetCellKey(ezInt32 x, ezInt32 y, ezInt32 z);
+  ezUInt64 GetCellKey(const ezVec3& vPosition) const;
+
+  /// \brief Returns by how many cells the cell with the given key is away from the given cell along the farthest axis.
+  static ezInt32 GetCellDistance(ezUInt64 uiCellKey, ezInt32 x, ezInt32 y, ezInt32 z);
+
+  static void PushCandidate(ezDynamicArrayBase<Candidate>& candidates, float fDistanceSquared, ezUInt32 uiValueIndex);
+  static void ReplaceFarthestCandidate(ezDynamicArrayBase<Candidate>& candidates, float fDistanceSquared, ezUInt32 uiValueIndex);
+
+  template <typename Callback>
+  void ForEachPointInRadius(const ezVec3& vCenter, float fRadius, Callback callback) const;
+
+  template <typename Callback>
+  void ForEachPointInChunkList(ezUInt32 uiFirstChunk, const ezSimdVec4f& vCenterX, const ezSimdVec4f& vCenterY, const ezSimdVec4f& vCenterZ,
+    const ezSimdVec4f& vRadiusSquared, Callback& callback) const;
+
+  void FindNearest(const ezVec3& vCenter, ezUInt32 uiMaxCount, float fMaxRadius, ezDynamicArrayBase<T>& out_Values,
+    ezDynamicArrayBase<Candidate>& candidates) const;
+
+  ezUInt32 AllocateChunk();
+
+  float m_fCellSize = 1.0f;
+  float m_fInvCellSize = 1.0f;
+  ezUInt32 m_uiCount = 0;
+  ezUInt32 m_uiFreeChunks = ezInvalidIndex;
+
+  // maps a cell key to the first chunk of the cell, which is the only chunk that might not be full
+  ezHashTable<ezUInt64, ezUInt32> m_Cells;
+
+  ezDynamicArray<Chunk> m_Chunks;
+  ezDynamicArray<T> m_Values;
+};
+
+#include <Foundation/Containers/Implementation/SpatialHash_inl.h>
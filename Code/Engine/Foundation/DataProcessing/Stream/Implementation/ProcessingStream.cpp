@@ -31,19 +31,26 @@ void ezProcessingStream::SetSize(ezUInt64 uiNumElements)
     return;
   }
 
+  const ezUInt64 uiNumPaddedElements = GetPaddedElementCount(uiNumElements);
+
   /// \todo Allow to reuse memory from a pool ?
   if (m_uiAlignment > 0)
   {
-    m_pData = ezFoundation::GetAlignedAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)),
+    m_pData = ezFoundation::GetAlignedAllocator()->Allocate(static_cast<size_t>(uiNumPaddedElements * GetDataTypeSize(m_Type)),
                                                             static_cast<size_t>(m_uiAlignment));
   }
   else
   {
-    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), 0);
+    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumPaddedElements * GetDataTypeSize(m_Type)), 0);
   }
 
   EZ_ASSERT_DEV(m_pData != nullptr, "Allocating {0} elements of {1} bytes each, with {2} bytes alignment, failed", uiNumElements,
                 ((ezUInt32)GetDataTypeSize(m_Type)), m_uiAlignment);
+
+  // SIMD code may read and write the padding elements, make sure they never contain NaNs or denormals
+  ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(m_pData) + uiNumElements * GetDataTypeSize(m_Type),
+                          static_cast<size_t>((uiNumPaddedElements - uiNumElements) * GetDataTypeSize(m_Type)));
+
   m_uiNumElements = uiNumElements;
 }
 
@@ -4,9 +4,18 @@
 #include <Foundation/Strings/HashedString.h>
 
 /// \brief A single stream in a stream group holding contiguous data of a given type.
+///
+/// The memory of a stream is always allocated for a multiple of ElementPadding elements. Code that processes the stream with SIMD
+/// instructions can therefore work on full blocks of up to ElementPadding elements and does not need to handle the last elements
+/// separately. The padding elements are zero initialized, but their content is otherwise undefined.
 class EZ_FOUNDATION_DLL ezProcessingStream
 {
 public:
+  enum
+  {
+    ElementPadding = 8
+  };
+
   /// \brief Destructor.
   ~ezProcessingStream();
 
@@ -83,6 +92,9 @@ public:
 
   static size_t GetDataTypeSize(DataType Type);
 
+  /// \brief Returns the number of elements for which memory is allocated when a stream is resized to \a uiNumElements.
+  static ezUInt64 GetPaddedElementCount(ezUInt64 uiNumElements) { return (uiNumElements + ElementPadding - 1) & ~static_cast<ezUInt64>(ElementPadding - 1); }
+
 protected:
   friend class ezProcessingStreamGroup;
 
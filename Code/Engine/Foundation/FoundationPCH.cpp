@@ -133,8 +133,10 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_ProcessGroup);
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_SystemInformation);
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_UuidGenerator);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_CoTask);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_OSThread);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskGroups);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskStatistics);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystem);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskWorkers);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_Tasks);
@@ -159,6 +161,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_DGMLWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_ExceptionHandler);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_GraphicsUtils);
+  EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Metrics);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Node);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Progress);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_StackTracer);
@@ -55,13 +55,34 @@ public:
     Iterator(const ezBlockStorage<T, BlockSizeInByte, StorageType>& storage, ezUInt32 uiStartIndex, ezUInt32 uiCount);
   };
 
+  /// \brief Describes an object that has been moved to fill a gap in a compact storage.
+  struct MovedObject
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    T* m_pOldLocation;
+    T* m_pNewLocation;
+  };
+
   ezBlockStorage(ezLargeBlockAllocator<BlockSizeInByte>* pBlockAllocator, ezAllocatorBase* pAllocator);
   ~ezBlockStorage();
 
   T* Create();
+
+  /// \brief Creates out_Objects.GetCount() objects at once. All needed blocks are allocated up front and the objects are constructed in
+  /// consecutive ranges.
+  void Create(ezArrayPtr<T*> out_Objects);
+
   void Delete(T* pObject);
   void Delete(T* pObject, T*& out_pMovedObject);
 
+  /// \brief Deletes all given objects at once.
+  ///
+  /// In a compact storage the gaps are filled with the remaining objects from the end of the storage. Each of those is moved at most once
+  /// and its old and new location is appended to out_MovedObjects. Deleted objects are never moved. A free list storage doesn't move
+  /// anything.
+  void Delete(ezArrayPtr<T* const> objects, ezDynamicArrayBase<MovedObject>& out_MovedObjects);
+
   ezUInt32 GetCount() const;
   Iterator GetIterator(ezUInt32 uiStartIndex = 0, ezUInt32 uiCount = ezInvalidIndex);
   ConstIterator GetIterator(ezUInt32 uiStartIndex = 0, ezUInt32 uiCount = ezInvalidIndex) const;
@@ -69,6 +90,27 @@ public:
 private:
   void Delete(T* pObject, T*& out_pMovedObject, ezTraitInt<ezBlockStorageType::Compact>);
   void Delete(T* pObject, T*& out_pMovedObject, ezTraitInt<ezBlockStorageType::FreeList>);
+  void Delete(ezArrayPtr<T* const> objects, ezDynamicArrayBase<MovedObject>& out_MovedObjects, ezTraitInt<ezBlockStorageType::Compact>);
+  void Delete(ezArrayPtr<T* const> objects, ezDynamicArrayBase<MovedObject>& out_MovedObjects, ezTraitInt<ezBlockStorageType::FreeList>);
+
+  ezUInt32 GetIndex(const T* pObject) const;
+
+  /// \brief The start of a block and its index, used to look up the indices of many objects at once.
+  struct SortedBlock
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const T* m_pData;
+    ezUInt32 m_uiBlockIndex;
+
+    bool operator<(const SortedBlock& other) const { return m_pData < other.m_pData; }
+  };
+
+  /// \brief Fills out_SortedBlocks with all blocks, sorted by their address.
+  void GetSortedBlocks(ezDynamicArrayBase<SortedBlock>& out_SortedBlocks) const;
+
+  /// \brief Same as GetIndex(), but finds the block with a binary search in the result of GetSortedBlocks().
+  ezUInt32 GetIndex(const T* pObject, ezArrayPtr<const SortedBlock> sortedBlocks) const;
 
   ezLargeBlockAllocator<BlockSizeInByte>* m_pBlockAllocator;
 
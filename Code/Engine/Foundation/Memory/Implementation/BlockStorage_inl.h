@@ -184,6 +184,69 @@ T* ezBlockStorage<T, BlockSize, StorageType>::Create()
   return pNewObject;
 }
 
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::Create(ezArrayPtr<T*> out_Objects)
+{
+  const ezUInt32 uiNumObjects = out_Objects.GetCount();
+  ezUInt32 uiObject = 0;
+
+  if (StorageType == ezBlockStorageType::FreeList)
+  {
+    while (uiObject < uiNumObjects && m_uiFreelistStart != ezInvalidIndex)
+    {
+      const ezUInt32 uiNewIndex = m_uiFreelistStart;
+
+      const ezUInt32 uiBlockIndex = uiNewIndex / ezDataBlock<T, BlockSize>::CAPACITY;
+      const ezUInt32 uiInnerIndex = uiNewIndex - uiBlockIndex * ezDataBlock<T, BlockSize>::CAPACITY;
+
+      T* pNewObject = &(m_Blocks[uiBlockIndex][uiInnerIndex]);
+      m_uiFreelistStart = *reinterpret_cast<ezUInt32*>(pNewObject);
+
+      ezMemoryUtils::Construct(pNewObject, 1);
+      m_UsedEntries.SetBit(uiNewIndex);
+
+      out_Objects[uiObject++] = pNewObject;
+    }
+  }
+
+  if (uiObject == uiNumObjects)
+    return;
+
+  const ezUInt32 uiFirstNewIndex = m_uiCount;
+  const ezUInt32 uiNewCount = m_uiCount + (uiNumObjects - uiObject);
+  const ezUInt32 uiNumBlocks = (uiNewCount + ezDataBlock<T, BlockSize>::CAPACITY - 1) / ezDataBlock<T, BlockSize>::CAPACITY;
+
+  m_Blocks.Reserve(uiNumBlocks);
+  while (m_Blocks.GetCount() < uiNumBlocks)
+  {
+    m_Blocks.PushBack(m_pBlockAllocator->template AllocateBlock<T>());
+  }
+
+  while (m_uiCount < uiNewCount)
+  {
+    ezDataBlock<T, BlockSize>& block = m_Blocks[m_uiCount / ezDataBlock<T, BlockSize>::CAPACITY];
+
+    const ezUInt32 uiCount = ezMath::Min<ezUInt32>(ezDataBlock<T, BlockSize>::CAPACITY - block.m_uiCount, uiNewCount - m_uiCount);
+    T* pNewObjects = block.m_pData + block.m_uiCount;
+
+    ezMemoryUtils::Construct(pNewObjects, uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      out_Objects[uiObject++] = pNewObjects + i;
+    }
+
+    block.m_uiCount += uiCount;
+    m_uiCount += uiCount;
+  }
+
+  if (StorageType == ezBlockStorageType::FreeList)
+  {
+    m_UsedEntries.SetCount(m_uiCount);
+    m_UsedEntries.SetBitRange(uiFirstNewIndex, m_uiCount - uiFirstNewIndex);
+  }
+}
+
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 EZ_FORCE_INLINE void ezBlockStorage<T, BlockSize, StorageType>::Delete(T* pObject)
 {
@@ -197,6 +260,12 @@ void ezBlockStorage<T, BlockSize, StorageType>::Delete(T* pObject, T*& out_pMove
   Delete(pObject, out_pMovedObject, ezTraitInt<StorageType>());
 }
 
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::Delete(ezArrayPtr<T* const> objects, ezDynamicArrayBase<MovedObject>& out_MovedObjects)
+{
+  Delete(objects, out_MovedObjects, ezTraitInt<StorageType>());
+}
+
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 EZ_ALWAYS_INLINE ezUInt32 ezBlockStorage<T, BlockSize, StorageType>::GetCount() const
 {
@@ -243,25 +312,165 @@ EZ_FORCE_INLINE void ezBlockStorage<T, BlockSize, StorageType>::Delete(T* pObjec
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 EZ_FORCE_INLINE void ezBlockStorage<T, BlockSize, StorageType>::Delete(T* pObject, T*& out_pMovedObject, ezTraitInt<ezBlockStorageType::FreeList>)
 {
-  ezUInt32 uiIndex = ezInvalidIndex;
+  const ezUInt32 uiIndex = GetIndex(pObject);
+
+  m_UsedEntries.ClearBit(uiIndex);
+
+  out_pMovedObject = pObject;
+  ezMemoryUtils::Destruct(pObject, 1);
+
+  *reinterpret_cast<ezUInt32*>(pObject) = m_uiFreelistStart;
+  m_uiFreelistStart = uiIndex;
+}
+
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::Delete(ezArrayPtr<T* const> objects, ezDynamicArrayBase<MovedObject>& out_MovedObjects, ezTraitInt<ezBlockStorageType::Compact>)
+{
+  const ezUInt32 uiNumObjects = objects.GetCount();
+  if (uiNumObjects == 0)
+    return;
+
+  ezHybridArray<SortedBlock, 64> sortedBlocks;
+  GetSortedBlocks(sortedBlocks);
+
+  ezHybridArray<ezUInt32, 64> deletedIndices;
+  deletedIndices.SetCountUninitialized(uiNumObjects);
+
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    deletedIndices[i] = GetIndex(objects[i], sortedBlocks);
+  }
+
+  deletedIndices.Sort();
+
+  for (ezUInt32 i = 1; i < uiNumObjects; ++i)
+  {
+    EZ_ASSERT_DEV(deletedIndices[i - 1] != deletedIndices[i], "The object at index {0} is deleted twice.", deletedIndices[i]);
+  }
+
+  for (T* pObject : objects)
+  {
+    ezMemoryUtils::Destruct(pObject, 1);
+  }
+
+  const ezUInt32 uiNewCount = m_uiCount - uiNumObjects;
+
+  // Every gap below the new count is filled with the last remaining object above it. There are exactly as many of those as gaps.
+  ezUInt32 uiSourceIndex = m_uiCount;
+  ezUInt32 uiLastDeleted = uiNumObjects;
+
+  for (ezUInt32 i = 0; i < uiNumObjects && deletedIndices[i] < uiNewCount; ++i)
+  {
+    --uiSourceIndex;
+    while (uiLastDeleted > i && deletedIndices[uiLastDeleted - 1] == uiSourceIndex)
+    {
+      --uiLastDeleted;
+      --uiSourceIndex;
+    }
+
+    const ezUInt32 uiTargetIndex = deletedIndices[i];
+
+    T* pSource = m_Blocks[uiSourceIndex / ezDataBlock<T, BlockSize>::CAPACITY].m_pData + uiSourceIndex % ezDataBlock<T, BlockSize>::CAPACITY;
+    T* pTarget = m_Blocks[uiTargetIndex / ezDataBlock<T, BlockSize>::CAPACITY].m_pData + uiTargetIndex % ezDataBlock<T, BlockSize>::CAPACITY;
+
+    ezMemoryUtils::RelocateConstruct(pTarget, pSource, 1);
+
+    auto& movedObject = out_MovedObjects.ExpandAndGetRef();
+    movedObject.m_pOldLocation = pSource;
+    movedObject.m_pNewLocation = pTarget;
+  }
+
+  m_uiCount = uiNewCount;
+
+  const ezUInt32 uiNumBlocks = (uiNewCount + ezDataBlock<T, BlockSize>::CAPACITY - 1) / ezDataBlock<T, BlockSize>::CAPACITY;
+  while (m_Blocks.GetCount() > uiNumBlocks)
+  {
+    m_pBlockAllocator->DeallocateBlock(m_Blocks.PeekBack());
+    m_Blocks.PopBack();
+  }
+
+  if (uiNumBlocks > 0)
+  {
+    m_Blocks.PeekBack().m_uiCount = uiNewCount - (uiNumBlocks - 1) * ezDataBlock<T, BlockSize>::CAPACITY;
+  }
+}
+
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::Delete(ezArrayPtr<T* const> objects, ezDynamicArrayBase<MovedObject>& out_MovedObjects, ezTraitInt<ezBlockStorageType::FreeList>)
+{
+  ezHybridArray<SortedBlock, 64> sortedBlocks;
+  GetSortedBlocks(sortedBlocks);
+
+  for (T* pObject : objects)
+  {
+    const ezUInt32 uiIndex = GetIndex(pObject, sortedBlocks);
+
+    m_UsedEntries.ClearBit(uiIndex);
+
+    ezMemoryUtils::Destruct(pObject, 1);
+
+    *reinterpret_cast<ezUInt32*>(pObject) = m_uiFreelistStart;
+    m_uiFreelistStart = uiIndex;
+  }
+}
+
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+ezUInt32 ezBlockStorage<T, BlockSize, StorageType>::GetIndex(const T* pObject) const
+{
   for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < m_Blocks.GetCount(); ++uiBlockIndex)
   {
     ptrdiff_t diff = pObject - m_Blocks[uiBlockIndex].m_pData;
     if (diff >= 0 && diff < ezDataBlock<T, BlockSize>::CAPACITY)
     {
-      uiIndex = uiBlockIndex * ezDataBlock<T, BlockSize>::CAPACITY + (ezInt32)diff;
-      break;
+      return uiBlockIndex * ezDataBlock<T, BlockSize>::CAPACITY + (ezInt32)diff;
     }
   }
 
-  EZ_ASSERT_DEV(uiIndex != ezInvalidIndex, "Invalid object {0} was not found in block storage.", ezArgP(pObject));
+  EZ_ASSERT_DEV(false, "Invalid object {0} was not found in block storage.", ezArgP(pObject));
+  return ezInvalidIndex;
+}
 
-  m_UsedEntries.ClearBit(uiIndex);
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::GetSortedBlocks(ezDynamicArrayBase<SortedBlock>& out_SortedBlocks) const
+{
+  out_SortedBlocks.SetCountUninitialized(m_Blocks.GetCount());
 
-  out_pMovedObject = pObject;
-  ezMemoryUtils::Destruct(pObject, 1);
+  for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < m_Blocks.GetCount(); ++uiBlockIndex)
+  {
+    out_SortedBlocks[uiBlockIndex].m_pData = m_Blocks[uiBlockIndex].m_pData;
+    out_SortedBlocks[uiBlockIndex].m_uiBlockIndex = uiBlockIndex;
+  }
 
-  *reinterpret_cast<ezUInt32*>(pObject) = m_uiFreelistStart;
-  m_uiFreelistStart = uiIndex;
+  out_SortedBlocks.Sort();
 }
 
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+ezUInt32 ezBlockStorage<T, BlockSize, StorageType>::GetIndex(const T* pObject, ezArrayPtr<const SortedBlock> sortedBlocks) const
+{
+  // find the last block that starts at or before the object
+  ezUInt32 uiLow = 0;
+  ezUInt32 uiHigh = sortedBlocks.GetCount();
+
+  while (uiLow < uiHigh)
+  {
+    const ezUInt32 uiMid = uiLow + (uiHigh - uiLow) / 2;
+    if (pObject < sortedBlocks[uiMid].m_pData)
+      uiHigh = uiMid;
+    else
+      uiLow = uiMid + 1;
+  }
+
+  if (uiLow > 0)
+  {
+    const SortedBlock& block = sortedBlocks[uiLow - 1];
+
+    ptrdiff_t diff = pObject - block.m_pData;
+    if (diff < ezDataBlock<T, BlockSize>::CAPACITY)
+    {
+      return block.m_uiBlockIndex * ezDataBlock<T, BlockSize>::CAPACITY + (ezInt32)diff;
+    }
+  }
+
+  EZ_ASSERT_DEV(false, "Invalid object {0} was not found in block storage.", ezArgP(pObject));
+  return ezInvalidIndex;
+}
@@ -0,0 +1,190 @@
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <cerrno>
+#include <csignal>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+namespace
+{
+  static struct sigaction s_PreviousSigProfAction;
+
+  /// \brief Walks the frame pointer chain of the interrupted code. Unlike backtrace(), this is async-signal-safe.
+  ///
+  /// Code compiled without frame pointers ends the walk early, so its callers are missing from the stack.
+  ezUInt32 WalkFramePointers(void* pContext, const ::EventBuffer* pEventBuffer, void** out_pFrames, ezUInt32 uiMaxFrames)
+  {
+    const ucontext_t* pUContext = static_cast<const ucontext_t*>(pContext);
+
+#  if defined(__x86_64__)
+    void* pPC = reinterpret_cast<void*>(pUContext->uc_mcontext.gregs[REG_RIP]);
+    const ezUInt64 uiFP = static_cast<ezUInt64>(pUContext->uc_mcontext.gregs[REG_RBP]);
+#  elif defined(__aarch64__)
+    void* pPC = reinterpret_cast<void*>(pUContext->uc_mcontext.pc);
+    const ezUInt64 uiFP = static_cast<ezUInt64>(pUContext->uc_mcontext.regs[29]);
+#  else
+    // other architectures are not walked, their samples have no call stack
+    EZ_IGNORE_UNUSED(pUContext);
+    void* pPC = nullptr;
+    const ezUInt64 uiFP = 0;
+#  endif
+
+    if (pPC == nullptr || uiMaxFrames == 0)
+      return 0;
+
+    ezUInt32 uiNumFrames = 0;
+    out_pFrames[uiNumFrames++] = pPC;
+
+    // without known stack bounds a garbage frame pointer could not be told apart from a valid one
+    const ezUInt64 uiStackLow = reinterpret_cast<ezUInt64>(pEventBuffer->m_pStackLow);
+    const ezUInt64 uiStackHigh = reinterpret_cast<ezUInt64>(pEventBuffer->m_pStackHigh);
+    if (uiStackLow == 0 || uiStackHigh == 0)
+      return uiNumFrames;
+
+    // every frame record holds the frame pointer of the caller and the return address, the stack grows downwards
+    ezUInt64 uiFrame = uiFP;
+    while (uiNumFrames < uiMaxFrames)
+    {
+      if ((uiFrame & (sizeof(void*) - 1)) != 0 || uiFrame < uiStackLow || uiFrame + 2 * sizeof(void*) > uiStackHigh)
+        break;
+
+      void* const* pRecord = reinterpret_cast<void* const*>(uiFrame);
+      const ezUInt64 uiCallerFrame = reinterpret_cast<ezUInt64>(pRecord[0]);
+      void* pReturnAddress = pRecord[1];
+
+      if (pReturnAddress == nullptr)
+        break;
+
+      out_pFrames[uiNumFrames++] = pReturnAddress;
+
+      if (uiCallerFrame <= uiFrame)
+        break;
+
+      uiFrame = uiCallerFrame;
+    }
+
+    return uiNumFrames;
+  }
+
+  void SampleSignalHandler(int iSignal, siginfo_t* pInfo, void* pContext)
+  {
+    const int iPreviousErrno = errno;
+
+    // s_EventBuffers is in the static TLS block of this module, so reading it in a signal handler does not allocate
+    ::EventBuffer* pEventBuffer = s_EventBuffers;
+    SampleBuffer* pSampleBuffer = pEventBuffer != nullptr ? pEventBuffer->m_pSampleBuffer : nullptr;
+
+    if (pSampleBuffer != nullptr)
+    {
+      const ezInt64 iWritePos = pSampleBuffer->m_iWritePos;
+      const ezUInt32 uiSlot = static_cast<ezUInt32>(iWritePos & (SampleBuffer::CAPACITY - 1));
+      SampleBuffer::Sample& sample = pSampleBuffer->m_Samples[uiSlot];
+
+      // an odd sequence number tells readers that the slot is being written
+      pSampleBuffer->m_Sequence[uiSlot].Set(2 * iWritePos + 1);
+
+      sample.m_TimeStamp = ezTime::Now();
+      sample.m_uiNumFrames = WalkFramePointers(pContext, pEventBuffer, sample.m_Frames, SampleBuffer::MAX_FRAMES);
+
+      pSampleBuffer->m_Sequence[uiSlot].Set(2 * (iWritePos + 1));
+      pSampleBuffer->m_iWritePos.Set(iWritePos + 1);
+    }
+
+    errno = iPreviousErrno;
+  }
+
+  ezResult StartSamplingTimer(ezTime interval)
+  {
+    struct sigaction action = {};
+    action.sa_sigaction = &SampleSignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    if (sigaction(SIGPROF, &action, &s_PreviousSigProfAction) != 0)
+    {
+      ezLog::Error("Failed to install the SIGPROF handler for CPU sampling: errno {0}", errno);
+      return EZ_FAILURE;
+    }
+
+    const ezInt64 iMicroseconds = ezMath::Max<ezInt64>(static_cast<ezInt64>(interval.GetMicroseconds()), 100);
+
+    struct itimerval timer = {};
+    timer.it_interval.tv_sec = static_cast<time_t>(iMicroseconds / 1000000);
+    timer.it_interval.tv_usec = static_cast<suseconds_t>(iMicroseconds % 1000000);
+    timer.it_value = timer.it_interval;
+
+    // ITIMER_PROF counts the CPU time of the whole process and signals whichever thread is running
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+    {
+      ezLog::Error("Failed to start the CPU sampling timer: errno {0}", errno);
+      sigaction(SIGPROF, &s_PreviousSigProfAction, nullptr);
+      return EZ_FAILURE;
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  void StopSamplingTimer()
+  {
+    struct itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+
+    // a signal may still be pending, the default action for SIGPROF would terminate the process
+    if (s_PreviousSigProfAction.sa_handler == SIG_DFL)
+    {
+      s_PreviousSigProfAction.sa_handler = SIG_IGN;
+    }
+
+    sigaction(SIGPROF, &s_PreviousSigProfAction, nullptr);
+  }
+
+  void GetCurrentThreadStackRange(const void*& out_pLow, const void*& out_pHigh)
+  {
+    out_pLow = nullptr;
+    out_pHigh = nullptr;
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0)
+      return;
+
+    void* pStackAddr = nullptr;
+    size_t uiStackSize = 0;
+    if (pthread_attr_getstack(&attr, &pStackAddr, &uiStackSize) == 0)
+    {
+      out_pLow = pStackAddr;
+      out_pHigh = static_cast<const ezUInt8*>(pStackAddr) + uiStackSize;
+    }
+
+    pthread_attr_destroy(&attr);
+  }
+
+  void ResolveSymbol(void* pAddress, ezStringBuilder& out_sName)
+  {
+    Dl_info info;
+    if (dladdr(pAddress, &info) == 0)
+    {
+      out_sName.Format("0x{0}", ezArgU(reinterpret_cast<ezUInt64>(pAddress), 16, true, 16));
+      return;
+    }
+
+    if (info.dli_sname != nullptr)
+    {
+      int iStatus = 0;
+      char* szDemangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &iStatus);
+
+      out_sName = (iStatus == 0 && szDemangled != nullptr) ? szDemangled : info.dli_sname;
+      free(szDemangled);
+      return;
+    }
+
+    // not an exported symbol, at least tell which module it is in
+    const ezUInt64 uiOffset = reinterpret_cast<ezUInt64>(pAddress) - reinterpret_cast<ezUInt64>(info.dli_fbase);
+
+    out_sName = ezPathUtils::GetFileNameAndExtension(info.dli_fname != nullptr ? info.dli_fname : "unknown");
+    out_sName.AppendFormat("+0x{0}", ezArgU(uiOffset, 1, false, 16));
+  }
+} // namespace
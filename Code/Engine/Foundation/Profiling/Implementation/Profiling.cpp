@@ -1,16 +1,30 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/DataTransfer.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/IdTable.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/JSONWriter.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Profiling/Implementation/ProtobufWriter.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/System/Process.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Utilities/Stats.h>
 
 #if EZ_ENABLED(EZ_USE_PROFILING)
 
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#  endif
+
 class ezProfileCaptureDataTransfer : public ezDataTransfer
 {
 private:
@@ -28,6 +42,21 @@ private:
 
 static ezProfileCaptureDataTransfer s_ProfileCaptureDataTransfer;
 
+ezCVarInt CVarProfilingSampleInterval("prof_SampleInterval", 0, ezCVarFlags::Default, "Samples the call stacks of all profiled threads every this many milliseconds, 0 disables sampling");
+
+static void ProfilingSampleIntervalChanged(const ezCVarEvent& e)
+{
+  if (e.m_EventType != ezCVarEvent::ValueChanged)
+    return;
+
+  ezProfilingSystem::StopSampling();
+
+  if (CVarProfilingSampleInterval > 0)
+  {
+    ezProfilingSystem::StartSampling(ezTime::Milliseconds(CVarProfilingSampleInterval));
+  }
+}
+
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
 
@@ -37,9 +66,13 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   {
     ezProfilingSystem::Initialize();
     s_ProfileCaptureDataTransfer.EnableDataTransfer("Profiling Capture");
+    CVarProfilingSampleInterval.m_CVarEvents.AddEventHandler(ProfilingSampleIntervalChanged);
   }
   ON_CORESYSTEMS_SHUTDOWN
   {
+    CVarProfilingSampleInterval.m_CVarEvents.RemoveEventHandler(ProfilingSampleIntervalChanged);
+    ezProfilingSystem::StopStreaming();
+    ezProfilingSystem::StopSampling();
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
     ezProfilingSystem::Reset();
   }
@@ -61,10 +94,91 @@ namespace
 
   typedef ezStaticRingBuffer<ezProfilingSystem::GPUData, RING_BUFFER_SIZE_PER_THREAD / sizeof(ezProfilingSystem::GPUData)> GPUDataRingBuffer;
 
+  /// \brief Single producer, single consumer queue that the owning thread fills and the streaming thread drains.
+  struct StreamBuffer
+  {
+    enum
+    {
+      CAPACITY = 16 * 1024
+    };
+
+    ezProfilingSystem::Event m_Events[CAPACITY];
+    ezAtomicInteger64 m_iWritePos; // only modified by the owning thread
+    ezAtomicInteger64 m_iReadPos;  // only modified by the streaming thread
+    ezAtomicInteger32 m_iDroppedEvents;
+
+    // only used by the owning thread, to stream or drop scopes as a whole
+    ezUInt32 m_uiOpenScopes = 0;
+    ezUInt32 m_uiDroppedScopes = 0;
+    ezInt32 m_iStreamGeneration = 0;
+  };
+
+  EZ_CHECK_AT_COMPILETIME_MSG(ezMath::IsPowerOf2(StreamBuffer::CAPACITY), "Positions are mapped to events with a bit mask");
+
+  /// \brief Ring buffer of raw call stacks, only written by the signal handler on the owning thread.
+  ///
+  /// Every slot has a sequence number, which is odd while the slot is written and 2 * (position + 1) afterwards. Readers copy a sample
+  /// and only keep it if the sequence number was the expected one before and after, so they never see a half written or overwritten one.
+  struct SampleBuffer
+  {
+    enum
+    {
+      MAX_FRAMES = 30,
+    };
+
+    struct Sample
+    {
+      ezTime m_TimeStamp;
+      ezUInt32 m_uiNumFrames;
+      void* m_Frames[MAX_FRAMES];
+    };
+
+    enum
+    {
+      CAPACITY = RING_BUFFER_SIZE_PER_THREAD / sizeof(Sample)
+    };
+
+    Sample m_Samples[CAPACITY];
+    ezAtomicInteger64 m_Sequence[CAPACITY];
+    ezAtomicInteger64 m_iWritePos;
+  };
+
+  EZ_CHECK_AT_COMPILETIME_MSG(ezMath::IsPowerOf2(SampleBuffer::CAPACITY), "Positions are mapped to samples with a bit mask");
+
   struct EventBuffer
   {
+    ~EventBuffer()
+    {
+      if (m_pStreamBuffer != nullptr)
+      {
+        EZ_DEFAULT_DELETE(m_pStreamBuffer);
+      }
+
+      if (m_pSampleBuffer != nullptr)
+      {
+        EZ_DEFAULT_DELETE(m_pSampleBuffer);
+      }
+    }
+
     ezStaticRingBuffer<ezProfilingSystem::Event, RING_BUFFER_SIZE_PER_THREAD / sizeof(ezProfilingSystem::Event)> m_Data;
     ezUInt64 m_uiThreadId = 0;
+    ezUInt32 m_uiSystemThreadId = 0;
+
+    // the stack of the owning thread, which bounds the call stack walk when sampling
+    const void* m_pStackLow = nullptr;
+    const void* m_pStackHigh = nullptr;
+
+    // only allocated once streaming was used, protected by s_AllEventBuffersMutex
+    StreamBuffer* m_pStreamBuffer = nullptr;
+
+    // only allocated once sampling was used, set before the sampling timer starts or by the owning thread itself
+    SampleBuffer* m_pSampleBuffer = nullptr;
+  };
+
+  // only used for the 'Frames' track in the stream
+  enum
+  {
+    STREAM_EVENT_FRAME_START = ezProfilingSystem::Event::End + 1
   };
 
   ezStaticRingBuffer<ezTime, RING_BUFFER_SIZE_FRAMES> s_FrameStartTimes;
@@ -85,7 +199,28 @@ namespace
 
   static GPUDataRingBuffer* s_GPUData;
 
-  ezProfilingSystem::Event& AllocateEvent(const char* szName, ezUInt32 uiNameLength, ezProfilingSystem::Event::Type type)
+  static ezAtomicInteger32 s_iStreaming;
+  static ezAtomicInteger32 s_iStreamGeneration;
+  static ezAtomicInteger32 s_iSampling;
+
+  /// \brief The id that the OS, and thus trace viewers, use for the current thread. Posix thread ids are addresses instead.
+  ezUInt32 GetSystemThreadID()
+  {
+#  if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
+    return static_cast<ezUInt32>(ezThreadUtils::GetCurrentThreadID());
+#  elif EZ_ENABLED(EZ_PLATFORM_LINUX)
+    return static_cast<ezUInt32>(syscall(SYS_gettid));
+#  else
+    // no such id available, at least keep the threads apart
+    const ezUInt64 uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+    return static_cast<ezUInt32>(uiThreadId ^ (uiThreadId >> 32));
+#  endif
+  }
+
+  // implemented per platform below
+  void GetCurrentThreadStackRange(const void*& out_pLow, const void*& out_pHigh);
+
+  ::EventBuffer* GetEventBuffer()
   {
     ::EventBuffer* pEventBuffer = s_EventBuffers;
 
@@ -93,13 +228,92 @@ namespace
     {
       pEventBuffer = EZ_DEFAULT_NEW(::EventBuffer);
       pEventBuffer->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+      pEventBuffer->m_uiSystemThreadId = GetSystemThreadID();
+      GetCurrentThreadStackRange(pEventBuffer->m_pStackLow, pEventBuffer->m_pStackHigh);
       s_EventBuffers = pEventBuffer;
 
       {
         EZ_LOCK(s_AllEventBuffersMutex);
         s_AllEventBuffers.PushBack(pEventBuffer);
+
+        if (s_iSampling)
+        {
+          pEventBuffer->m_pSampleBuffer = EZ_DEFAULT_NEW(SampleBuffer);
+        }
+      }
+    }
+
+    return pEventBuffer;
+  }
+
+  void StreamEvent(::EventBuffer* pEventBuffer, const ezProfilingSystem::Event& e)
+  {
+    StreamBuffer* pStreamBuffer = pEventBuffer->m_pStreamBuffer;
+
+    if (pStreamBuffer == nullptr)
+    {
+      pStreamBuffer = EZ_DEFAULT_NEW(StreamBuffer);
+
+      EZ_LOCK(s_AllEventBuffersMutex);
+      pEventBuffer->m_pStreamBuffer = pStreamBuffer;
+    }
+
+    // scopes that were opened or closed while nothing was streamed are unknown to this stream
+    const ezInt32 iStreamGeneration = s_iStreamGeneration;
+    if (pStreamBuffer->m_iStreamGeneration != iStreamGeneration)
+    {
+      pStreamBuffer->m_iStreamGeneration = iStreamGeneration;
+      pStreamBuffer->m_uiOpenScopes = 0;
+      pStreamBuffer->m_uiDroppedScopes = 0;
+    }
+
+    const ezInt64 iWritePos = pStreamBuffer->m_iWritePos;
+
+    if (e.m_Type == ezProfilingSystem::Event::End)
+    {
+      // scopes are nested, so this closes the innermost one, which is either dropped or streamed
+      if (pStreamBuffer->m_uiDroppedScopes > 0)
+      {
+        --pStreamBuffer->m_uiDroppedScopes;
+        pStreamBuffer->m_iDroppedEvents.Increment();
+        return;
       }
+
+      // the scope was opened before streaming started
+      if (pStreamBuffer->m_uiOpenScopes == 0)
+        return;
+
+      // room for this was reserved when the scope was opened
+      --pStreamBuffer->m_uiOpenScopes;
     }
+    else
+    {
+      const bool bBegin = e.m_Type == ezProfilingSystem::Event::Begin;
+
+      // never wait for the streaming thread, rather lose the event. A scope is only streamed when there is also room for its end and
+      // the ends of all open scopes, and everything inside a dropped scope is dropped as well, so every begin in the stream has its end.
+      const ezInt64 iNeeded = 1 + pStreamBuffer->m_uiOpenScopes + (bBegin ? 1 : 0);
+
+      if ((bBegin && pStreamBuffer->m_uiDroppedScopes > 0) || iWritePos - pStreamBuffer->m_iReadPos + iNeeded > StreamBuffer::CAPACITY)
+      {
+        if (bBegin)
+          ++pStreamBuffer->m_uiDroppedScopes;
+
+        pStreamBuffer->m_iDroppedEvents.Increment();
+        return;
+      }
+
+      if (bBegin)
+        ++pStreamBuffer->m_uiOpenScopes;
+    }
+
+    pStreamBuffer->m_Events[iWritePos & (StreamBuffer::CAPACITY - 1)] = e;
+    pStreamBuffer->m_iWritePos.Set(iWritePos + 1);
+  }
+
+  void AllocateEvent(const char* szName, ezUInt32 uiNameLength, ezProfilingSystem::Event::Type type, const char* szFunctionName)
+  {
+    ::EventBuffer* pEventBuffer = GetEventBuffer();
 
     if (!pEventBuffer->m_Data.CanAppend())
     {
@@ -107,17 +321,78 @@ namespace
     }
 
     ezProfilingSystem::Event e;
-    e.m_szFunctionName = nullptr;
+    e.m_szFunctionName = szFunctionName;
     e.m_TimeStamp = ezTime::Now();
     e.m_Type = type;
     ezStringUtils::CopyN(e.m_szName, EZ_ARRAY_SIZE(e.m_szName), szName, uiNameLength);
 
     pEventBuffer->m_Data.PushBack(e);
 
-    return pEventBuffer->m_Data.PeekBack();
+    if (s_iStreaming)
+    {
+      StreamEvent(pEventBuffer, e);
+    }
+  }
+
+  struct RawSamples
+  {
+    ezUInt64 m_uiThreadId = 0;
+    ezDynamicArray<SampleBuffer::Sample> m_Samples;
+  };
+
+  ezUInt32 GetOrAddStackFrame(ezProfilingSystem::ProfilingData& profilingData, ezHashTable<ezUInt64, ezUInt32>& stackFrameLookup,
+    ezHashTable<ezString, ezUInt32>& nameLookup, const char* szName, ezUInt32 uiParent)
+  {
+    ezUInt32 uiNameIndex = 0;
+    if (!nameLookup.TryGetValue(szName, uiNameIndex))
+    {
+      uiNameIndex = nameLookup.GetCount();
+      nameLookup.Insert(szName, uiNameIndex);
+    }
+
+    const ezUInt64 uiKey = (static_cast<ezUInt64>(uiParent) << 32) | uiNameIndex;
+
+    ezUInt32 uiFrame = 0;
+    if (!stackFrameLookup.TryGetValue(uiKey, uiFrame))
+    {
+      uiFrame = profilingData.m_StackFrames.GetCount();
+      stackFrameLookup.Insert(uiKey, uiFrame);
+
+      auto& frame = profilingData.m_StackFrames.ExpandAndGetRef();
+      frame.m_sName = szName;
+      frame.m_uiParent = uiParent;
+    }
+
+    return uiFrame;
   }
 } // namespace
 
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#    include <Foundation/Profiling/Implementation/Posix/Sampling_posix.h>
+#  else
+namespace
+{
+  ezResult StartSamplingTimer(ezTime interval)
+  {
+    ezLog::Error("CPU sampling is not supported on this platform");
+    return EZ_FAILURE;
+  }
+
+  void StopSamplingTimer() {}
+
+  void GetCurrentThreadStackRange(const void*& out_pLow, const void*& out_pHigh)
+  {
+    out_pLow = nullptr;
+    out_pHigh = nullptr;
+  }
+
+  void ResolveSymbol(void* pAddress, ezStringBuilder& out_sName)
+  {
+    out_sName.Format("0x{0}", ezArgU(reinterpret_cast<ezUInt64>(pAddress), 16, true, 16));
+  }
+} // namespace
+#  endif
+
 ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) const
 {
   ezStandardJSONWriter writer;
@@ -317,6 +592,61 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
     writer.EndArray();
   }
 
+  // CPU samples, in the trace event format the call stacks are a tree of stack frames that the samples refer to
+  if (!m_CPUSamples.IsEmpty())
+  {
+    ezStringBuilder sFrameID;
+
+    writer.BeginObject("stackFrames");
+    for (ezUInt32 i = 0; i < m_StackFrames.GetCount(); ++i)
+    {
+      const StackFrame& frame = m_StackFrames[i];
+
+      sFrameID.Format("{}", i);
+      writer.BeginObject(sFrameID);
+      writer.AddVariableString("name", frame.m_sName);
+
+      if (frame.m_uiParent != ezInvalidIndex)
+      {
+        sFrameID.Format("{}", frame.m_uiParent);
+        writer.AddVariableString("parent", sFrameID);
+      }
+      else
+      {
+        writer.AddVariableString("category", "scope");
+      }
+
+      writer.EndObject();
+    }
+    writer.EndObject();
+
+    writer.BeginArray("samples");
+    for (const auto& samples : m_CPUSamples)
+    {
+      const ezUInt64 uiThreadId = samples.m_uiThreadId + 2;
+
+      for (const CPUSample& sample : samples.m_Samples)
+      {
+        sFrameID.Format("{}", sample.m_uiStackFrame);
+
+        writer.BeginObject();
+        writer.AddVariableString("name", "cpu");
+        writer.AddVariableUInt32("pid", m_uiProcessID);
+        writer.AddVariableUInt64("tid", uiThreadId);
+        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(sample.m_TimeStamp.GetMicroseconds()));
+        writer.AddVariableString("sf", sFrameID);
+        writer.AddVariableUInt32("weight", 1);
+        writer.EndObject();
+      }
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+    writer.EndArray();
+  }
+
   writer.EndObject();
 
   return writer.HadWriteError() ? EZ_FAILURE : EZ_SUCCESS;
@@ -340,6 +670,8 @@ ezProfilingSystem::ProfilingData ezProfilingSystem::Capture()
     profilingData.m_ThreadInfos = s_ThreadInfos;
   }
 
+  ezDynamicArray<RawSamples> allRawSamples;
+
   {
     EZ_LOCK(s_AllEventBuffersMutex);
 
@@ -366,6 +698,104 @@ ezProfilingSystem::ProfilingData ezProfilingSystem::Capture()
       }
 
       profilingData.m_AllEventBuffers.PushBack(std::move(targetEventBuffer));
+
+      if (const SampleBuffer* pSampleBuffer = sourceEventBuffer->m_pSampleBuffer)
+      {
+        RawSamples& rawSamples = allRawSamples.ExpandAndGetRef();
+        rawSamples.m_uiThreadId = sourceEventBuffer->m_uiThreadId;
+
+        const ezInt64 iEnd = pSampleBuffer->m_iWritePos;
+        const ezInt64 iStart = ezMath::Max<ezInt64>(0, iEnd - SampleBuffer::CAPACITY);
+
+        rawSamples.m_Samples.Reserve(static_cast<ezUInt32>(iEnd - iStart));
+        for (ezInt64 j = iStart; j < iEnd; ++j)
+        {
+          const ezUInt32 uiSlot = static_cast<ezUInt32>(j & (SampleBuffer::CAPACITY - 1));
+          const ezInt64 iSequence = 2 * (j + 1);
+
+          // the thread keeps sampling while we copy, skip samples that are being written or were overwritten in the meantime
+          if (pSampleBuffer->m_Sequence[uiSlot] != iSequence)
+            continue;
+
+          const SampleBuffer::Sample sample = pSampleBuffer->m_Samples[uiSlot];
+
+          if (pSampleBuffer->m_Sequence[uiSlot] != iSequence)
+            continue;
+
+          rawSamples.m_Samples.PushBack(sample);
+        }
+      }
+    }
+  }
+
+  // attribute the samples to the innermost open scope and symbolize them
+  if (!allRawSamples.IsEmpty())
+  {
+    ezHashTable<void*, ezString> symbolCache;
+    ezHashTable<ezString, ezUInt32> nameLookup;
+    ezHashTable<ezUInt64, ezUInt32> stackFrameLookup;
+    ezHybridArray<const char*, 32> scopeStack;
+    ezStringBuilder sSymbol;
+
+    for (const RawSamples& rawSamples : allRawSamples)
+    {
+      const EventBufferFlat* pEvents = nullptr;
+      for (const EventBufferFlat& eventBuffer : profilingData.m_AllEventBuffers)
+      {
+        if (eventBuffer.m_uiThreadId == rawSamples.m_uiThreadId)
+          pEvents = &eventBuffer;
+      }
+
+      CPUSamplesFlat& samples = profilingData.m_CPUSamples.ExpandAndGetRef();
+      samples.m_uiThreadId = rawSamples.m_uiThreadId;
+      samples.m_Samples.Reserve(rawSamples.m_Samples.GetCount());
+
+      scopeStack.Clear();
+      ezUInt32 uiNextEvent = 0;
+
+      for (const SampleBuffer::Sample& rawSample : rawSamples.m_Samples)
+      {
+        // both are sorted by time, so the scope stack can be advanced along with the samples
+        while (pEvents != nullptr && uiNextEvent < pEvents->m_Data.GetCount())
+        {
+          const Event& e = pEvents->m_Data[uiNextEvent];
+          if (e.m_TimeStamp > rawSample.m_TimeStamp)
+            break;
+
+          ++uiNextEvent;
+
+          if (e.m_Type == Event::Begin)
+          {
+            scopeStack.PushBack(e.m_szName);
+          }
+          else if (!scopeStack.IsEmpty()) // the begin event may already have been overwritten in the ring buffer
+          {
+            scopeStack.PopBack();
+          }
+        }
+
+        const char* szScope = scopeStack.IsEmpty() ? "<no scope>" : scopeStack.PeekBack();
+        ezUInt32 uiFrame = GetOrAddStackFrame(profilingData, stackFrameLookup, nameLookup, szScope, ezInvalidIndex);
+
+        for (ezUInt32 f = rawSample.m_uiNumFrames; f > 0; --f)
+        {
+          void* pAddress = rawSample.m_Frames[f - 1];
+
+          ezString* pSymbol = nullptr;
+          if (!symbolCache.TryGetValue(pAddress, pSymbol))
+          {
+            ResolveSymbol(pAddress, sSymbol);
+            symbolCache.Insert(pAddress, sSymbol);
+            symbolCache.TryGetValue(pAddress, pSymbol);
+          }
+
+          uiFrame = GetOrAddStackFrame(profilingData, stackFrameLookup, nameLookup, *pSymbol, uiFrame);
+        }
+
+        CPUSample& sample = samples.m_Samples.ExpandAndGetRef();
+        sample.m_TimeStamp = rawSample.m_TimeStamp;
+        sample.m_uiStackFrame = uiFrame;
+      }
     }
   }
 
@@ -466,6 +896,518 @@ ezProfilingSystem::GPUData& ezProfilingSystem::AllocateGPUData()
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+  // field numbers from perfetto/protos/perfetto/trace/trace_packet.proto and the files it includes
+  namespace Perfetto
+  {
+    enum
+    {
+      Trace_Packet = 1,
+
+      TracePacket_Timestamp = 8,
+      TracePacket_TrustedPacketSequenceId = 10,
+      TracePacket_TrackEvent = 11,
+      TracePacket_InternedData = 12,
+      TracePacket_SequenceFlags = 13,
+      TracePacket_TrackDescriptor = 60,
+
+      SequenceFlags_IncrementalStateCleared = 1,
+      SequenceFlags_NeedsIncrementalState = 2,
+
+      TrackDescriptor_Uuid = 1,
+      TrackDescriptor_Name = 2,
+      TrackDescriptor_Process = 3,
+      TrackDescriptor_Thread = 4,
+      TrackDescriptor_ParentUuid = 5,
+      TrackDescriptor_Counter = 8,
+
+      ProcessDescriptor_Pid = 1,
+
+      ThreadDescriptor_Pid = 1,
+      ThreadDescriptor_Tid = 2,
+      ThreadDescriptor_ThreadName = 5,
+
+      TrackEvent_Type = 9,
+      TrackEvent_NameIid = 10,
+      TrackEvent_TrackUuid = 11,
+      TrackEvent_Name = 23,
+      TrackEvent_DoubleCounterValue = 44,
+
+      TrackEventType_SliceBegin = 1,
+      TrackEventType_SliceEnd = 2,
+      TrackEventType_Counter = 4,
+
+      InternedData_EventNames = 2,
+      EventName_Iid = 1,
+      EventName_Name = 2,
+    };
+  } // namespace Perfetto
+
+  struct StreamedCounter
+  {
+    ezString m_sName;
+    double m_fValue = 0.0;
+    bool m_bChanged = false;
+  };
+
+  static ezMutex s_StreamedCountersMutex;
+  static ezHashTable<ezUInt64, StreamedCounter> s_StreamedCounters;
+
+  void StreamStatsEventHandler(const ezStats::StatsEventData& e)
+  {
+    if (e.m_EventType == ezStats::StatsEventData::Remove || !e.m_NewStatValue.IsNumber())
+      return;
+
+    const ezUInt64 uiKey = ezHashingUtils::xxHash64(e.m_szStatName, ezStringUtils::GetStringElementCount(e.m_szStatName));
+
+    EZ_LOCK(s_StreamedCountersMutex);
+
+    StreamedCounter& counter = s_StreamedCounters[uiKey];
+    if (counter.m_sName.IsEmpty())
+    {
+      counter.m_sName = e.m_szStatName;
+    }
+
+    counter.m_fValue = e.m_NewStatValue.ConvertTo<double>();
+    counter.m_bChanged = true;
+  }
+
+  /// \brief Periodically drains the stream buffers of all threads and appends them to the trace file.
+  class StreamWriterThread : public ezThread
+  {
+  public:
+    StreamWriterThread()
+      : ezThread("Profiling Stream")
+    {
+    }
+
+    ezOSFile m_File;
+    ezTime m_FlushInterval;
+    ezAtomicInteger32 m_iStop;
+
+  private:
+    enum : ezUInt64
+    {
+      PROCESS_TRACK_UUID = 1,
+      FRAMES_TRACK_UUID = 2,
+      SEQUENCE_ID = 1,
+    };
+
+    virtual ezUInt32 Run() override
+    {
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+      m_uiProcessID = ezProcess::GetCurrentProcessID();
+#  endif
+
+      WriteTrackDescriptor(PROCESS_TRACK_UUID, nullptr, 0, nullptr, 0, false);
+      WriteTrackDescriptor(FRAMES_TRACK_UUID, "Frames", PROCESS_TRACK_UUID, nullptr, 0, false);
+
+      while (!m_iStop)
+      {
+        ezThreadUtils::Sleep(m_FlushInterval);
+        Drain();
+      }
+
+      Drain();
+      return 0;
+    }
+
+    static ezUInt64 GetThreadTrackUuid(ezUInt64 uiThreadId) { return ezHashingUtils::xxHash64(&uiThreadId, sizeof(uiThreadId), 0x54485244); }
+
+    void BeginPacket(ezTime timestamp)
+    {
+      m_uiPacketStart = m_Proto.BeginNested(Perfetto::Trace_Packet);
+      m_Proto.UInt(Perfetto::TracePacket_TrustedPacketSequenceId, SEQUENCE_ID);
+
+      if (timestamp.IsPositive())
+      {
+        m_Proto.UInt(Perfetto::TracePacket_Timestamp, static_cast<ezUInt64>(timestamp.GetNanoseconds()));
+      }
+
+      // interned names are only valid within the sequence, the first packet starts it
+      m_Proto.UInt(Perfetto::TracePacket_SequenceFlags, m_bSequenceStarted ? Perfetto::SequenceFlags_NeedsIncrementalState
+                                                                             : Perfetto::SequenceFlags_IncrementalStateCleared | Perfetto::SequenceFlags_NeedsIncrementalState);
+      m_bSequenceStarted = true;
+    }
+
+    void EndPacket() { m_Proto.EndNested(m_uiPacketStart); }
+
+    void WriteTrackDescriptor(ezUInt64 uiUuid, const char* szName, ezUInt64 uiParentUuid, const char* szThreadName, ezUInt32 uiSystemThreadId, bool bCounter)
+    {
+      BeginPacket(ezTime::Zero());
+      const ezUInt32 uiTrack = m_Proto.BeginNested(Perfetto::TracePacket_TrackDescriptor);
+      m_Proto.UInt(Perfetto::TrackDescriptor_Uuid, uiUuid);
+
+      if (szName != nullptr)
+        m_Proto.String(Perfetto::TrackDescriptor_Name, szName);
+
+      if (uiParentUuid != 0)
+        m_Proto.UInt(Perfetto::TrackDescriptor_ParentUuid, uiParentUuid);
+
+      if (uiUuid == PROCESS_TRACK_UUID)
+      {
+        const ezUInt32 uiProcess = m_Proto.BeginNested(Perfetto::TrackDescriptor_Process);
+        m_Proto.UInt(Perfetto::ProcessDescriptor_Pid, m_uiProcessID);
+        m_Proto.EndNested(uiProcess);
+      }
+
+      if (szThreadName != nullptr)
+      {
+        const ezUInt32 uiThread = m_Proto.BeginNested(Perfetto::TrackDescriptor_Thread);
+        m_Proto.UInt(Perfetto::ThreadDescriptor_Pid, m_uiProcessID);
+        m_Proto.UInt(Perfetto::ThreadDescriptor_Tid, uiSystemThreadId);
+        m_Proto.String(Perfetto::ThreadDescriptor_ThreadName, szThreadName);
+        m_Proto.EndNested(uiThread);
+      }
+
+      if (bCounter)
+      {
+        m_Proto.EndNested(m_Proto.BeginNested(Perfetto::TrackDescriptor_Counter));
+      }
+
+      m_Proto.EndNested(uiTrack);
+      EndPacket();
+    }
+
+    void WriteEvent(ezUInt64 uiTrackUuid, const ezProfilingSystem::Event& e)
+    {
+      BeginPacket(e.m_TimeStamp);
+
+      ezUInt64 uiNameIid = 0;
+      if (e.m_Type == ezProfilingSystem::Event::Begin)
+      {
+        const ezUInt64 uiNameHash = ezHashingUtils::xxHash64(e.m_szName, ezStringUtils::GetStringElementCount(e.m_szName));
+
+        if (!m_InternedNames.TryGetValue(uiNameHash, uiNameIid))
+        {
+          uiNameIid = m_InternedNames.GetCount() + 1;
+          m_InternedNames.Insert(uiNameHash, uiNameIid);
+
+          const ezUInt32 uiInterned = m_Proto.BeginNested(Perfetto::TracePacket_InternedData);
+          const ezUInt32 uiEventName = m_Proto.BeginNested(Perfetto::InternedData_EventNames);
+          m_Proto.UInt(Perfetto::EventName_Iid, uiNameIid);
+          m_Proto.String(Perfetto::EventName_Name, e.m_szName);
+          m_Proto.EndNested(uiEventName);
+          m_Proto.EndNested(uiInterned);
+        }
+      }
+
+      const ezUInt32 uiTrackEvent = m_Proto.BeginNested(Perfetto::TracePacket_TrackEvent);
+
+      if (e.m_Type == STREAM_EVENT_FRAME_START)
+      {
+        // frame names are unique, interning them would not save anything
+        m_Proto.UInt(Perfetto::TrackEvent_Type, Perfetto::TrackEventType_SliceBegin);
+        m_Proto.UInt(Perfetto::TrackEvent_TrackUuid, FRAMES_TRACK_UUID);
+        m_Proto.String(Perfetto::TrackEvent_Name, e.m_szName);
+      }
+      else
+      {
+        m_Proto.UInt(Perfetto::TrackEvent_Type,
+          e.m_Type == ezProfilingSystem::Event::Begin ? Perfetto::TrackEventType_SliceBegin : Perfetto::TrackEventType_SliceEnd);
+        m_Proto.UInt(Perfetto::TrackEvent_TrackUuid, uiTrackUuid);
+
+        if (uiNameIid != 0)
+          m_Proto.UInt(Perfetto::TrackEvent_NameIid, uiNameIid);
+      }
+
+      m_Proto.EndNested(uiTrackEvent);
+      EndPacket();
+    }
+
+    void WriteFrameEnd(ezTime timestamp)
+    {
+      BeginPacket(timestamp);
+      const ezUInt32 uiTrackEvent = m_Proto.BeginNested(Perfetto::TracePacket_TrackEvent);
+      m_Proto.UInt(Perfetto::TrackEvent_Type, Perfetto::TrackEventType_SliceEnd);
+      m_Proto.UInt(Perfetto::TrackEvent_TrackUuid, FRAMES_TRACK_UUID);
+      m_Proto.EndNested(uiTrackEvent);
+      EndPacket();
+    }
+
+    void WriteCounter(ezUInt64 uiKey, const char* szName, double fValue, ezTime timestamp)
+    {
+      const ezUInt64 uiTrackUuid = uiKey | 0x8000000000000000ull;
+
+      if (!m_KnownCounters.Contains(uiKey))
+      {
+        m_KnownCounters.Insert(uiKey, 0);
+        WriteTrackDescriptor(uiTrackUuid, szName, PROCESS_TRACK_UUID, nullptr, 0, true);
+      }
+
+      BeginPacket(timestamp);
+      const ezUInt32 uiTrackEvent = m_Proto.BeginNested(Perfetto::TracePacket_TrackEvent);
+      m_Proto.UInt(Perfetto::TrackEvent_Type, Perfetto::TrackEventType_Counter);
+      m_Proto.UInt(Perfetto::TrackEvent_TrackUuid, uiTrackUuid);
+      m_Proto.Double(Perfetto::TrackEvent_DoubleCounterValue, fValue);
+      m_Proto.EndNested(uiTrackEvent);
+      EndPacket();
+    }
+
+    void Drain()
+    {
+      // copy the thread names first, Reset() locks s_ThreadInfosMutex before s_AllEventBuffersMutex
+      {
+        EZ_LOCK(s_ThreadInfosMutex);
+        m_ThreadInfos = s_ThreadInfos;
+      }
+
+      // only copy the events while the buffers are locked, so that threads which start profiling are not blocked by the encoding
+      m_StagedThreads.Clear();
+      m_StagedEvents.Clear();
+
+      {
+        EZ_LOCK(s_AllEventBuffersMutex);
+
+        for (::EventBuffer* pEventBuffer : s_AllEventBuffers)
+        {
+          StreamBuffer* pStreamBuffer = pEventBuffer->m_pStreamBuffer;
+          if (pStreamBuffer == nullptr)
+            continue;
+
+          const ezInt64 iReadPos = pStreamBuffer->m_iReadPos;
+          const ezInt64 iWritePos = pStreamBuffer->m_iWritePos;
+
+          StagedThread& staged = m_StagedThreads.ExpandAndGetRef();
+          staged.m_uiThreadId = pEventBuffer->m_uiThreadId;
+          staged.m_uiSystemThreadId = pEventBuffer->m_uiSystemThreadId;
+          staged.m_uiFirstEvent = m_StagedEvents.GetCount();
+          staged.m_uiNumEvents = static_cast<ezUInt32>(iWritePos - iReadPos);
+
+          // at most two ranges, because the buffer wraps around
+          for (ezInt64 i = iReadPos; i < iWritePos;)
+          {
+            const ezUInt32 uiStart = static_cast<ezUInt32>(i & (StreamBuffer::CAPACITY - 1));
+            const ezUInt32 uiCount = ezMath::Min<ezUInt32>(static_cast<ezUInt32>(iWritePos - i), StreamBuffer::CAPACITY - uiStart);
+
+            m_StagedEvents.PushBackRange(ezArrayPtr<const ezProfilingSystem::Event>(pStreamBuffer->m_Events + uiStart, uiCount));
+            i += uiCount;
+          }
+
+          pStreamBuffer->m_iReadPos.Set(iWritePos);
+
+          m_uiDroppedEvents += pStreamBuffer->m_iDroppedEvents.Set(0);
+        }
+      }
+
+      for (const StagedThread& staged : m_StagedThreads)
+      {
+        const ezUInt64 uiTrackUuid = GetThreadTrackUuid(staged.m_uiThreadId);
+
+        if (!m_KnownThreads.Contains(staged.m_uiThreadId))
+        {
+          m_KnownThreads.Insert(staged.m_uiThreadId, 0);
+
+          const char* szThreadName = "Unnamed Thread";
+
+          for (const auto& threadInfo : m_ThreadInfos)
+          {
+            if (threadInfo.m_uiThreadId == staged.m_uiThreadId)
+              szThreadName = threadInfo.m_sName;
+          }
+
+          WriteTrackDescriptor(uiTrackUuid, nullptr, PROCESS_TRACK_UUID, szThreadName, staged.m_uiSystemThreadId, false);
+        }
+
+        for (ezUInt32 i = 0; i < staged.m_uiNumEvents; ++i)
+        {
+          const ezProfilingSystem::Event& e = m_StagedEvents[staged.m_uiFirstEvent + i];
+
+          if (e.m_Type == STREAM_EVENT_FRAME_START && m_bFrameOpen)
+          {
+            WriteFrameEnd(e.m_TimeStamp);
+          }
+
+          WriteEvent(uiTrackUuid, e);
+          m_bFrameOpen |= (e.m_Type == STREAM_EVENT_FRAME_START);
+        }
+      }
+
+      {
+        const ezTime now = ezTime::Now();
+
+        EZ_LOCK(s_StreamedCountersMutex);
+
+        for (auto it = s_StreamedCounters.GetIterator(); it.IsValid(); ++it)
+        {
+          if (!it.Value().m_bChanged)
+            continue;
+
+          it.Value().m_bChanged = false;
+          WriteCounter(it.Key(), it.Value().m_sName, it.Value().m_fValue, now);
+        }
+      }
+
+      if (!m_Proto.m_Data.IsEmpty())
+      {
+        if (m_File.Write(m_Proto.m_Data.GetData(), m_Proto.m_Data.GetCount()).Failed())
+        {
+          ezLog::Error("Failed to write to profiling stream file");
+        }
+
+        m_uiBytesWritten += m_Proto.m_Data.GetCount();
+        m_Proto.m_Data.Clear();
+      }
+
+      m_uiEventsWritten += m_StagedEvents.GetCount();
+
+      ezStats::SetStat("Profiling/Streaming/Events", m_uiEventsWritten);
+      ezStats::SetStat("Profiling/Streaming/DroppedEvents", m_uiDroppedEvents);
+      ezStats::SetStat("Profiling/Streaming/FileSizeKB", m_uiBytesWritten / 1024);
+    }
+
+    ezProtobufWriter m_Proto;
+    ezUInt32 m_uiPacketStart = 0;
+    bool m_bSequenceStarted = false;
+    bool m_bFrameOpen = false;
+    ezUInt32 m_uiProcessID = 0;
+
+    struct StagedThread
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt64 m_uiThreadId;
+      ezUInt32 m_uiSystemThreadId;
+      ezUInt32 m_uiFirstEvent;
+      ezUInt32 m_uiNumEvents;
+    };
+
+    ezHybridArray<ezProfilingSystem::ThreadInfo, 16> m_ThreadInfos;
+    ezDynamicArray<StagedThread> m_StagedThreads;
+    ezDynamicArray<ezProfilingSystem::Event> m_StagedEvents;
+    ezHashTable<ezUInt64, ezUInt64> m_InternedNames;
+    ezHashTable<ezUInt64, ezUInt8> m_KnownThreads;
+    ezHashTable<ezUInt64, ezUInt8> m_KnownCounters;
+
+    ezUInt64 m_uiEventsWritten = 0;
+    ezUInt64 m_uiDroppedEvents = 0;
+    ezUInt64 m_uiBytesWritten = 0;
+  };
+
+  static ezMutex s_StreamWriterMutex;
+  static StreamWriterThread* s_pStreamWriter = nullptr;
+} // namespace
+
+// static
+ezResult ezProfilingSystem::StartStreaming(const char* szFile, ezTime flushInterval)
+{
+  EZ_LOCK(s_StreamWriterMutex);
+
+  if (s_pStreamWriter != nullptr)
+  {
+    ezLog::Error("Profiling data is already being streamed");
+    return EZ_FAILURE;
+  }
+
+  ezStringBuilder sAbsolutePath;
+  if (ezFileSystem::ResolvePath(szFile, &sAbsolutePath, nullptr).Failed())
+  {
+    sAbsolutePath = szFile;
+  }
+
+  StreamWriterThread* pStreamWriter = EZ_DEFAULT_NEW(StreamWriterThread);
+  pStreamWriter->m_FlushInterval = flushInterval;
+
+  if (pStreamWriter->m_File.Open(sAbsolutePath.GetData(), ezFileOpenMode::Write).Failed())
+  {
+    ezLog::Error("Could not open profiling stream file '{0}'", sAbsolutePath);
+    EZ_DEFAULT_DELETE(pStreamWriter);
+    return EZ_FAILURE;
+  }
+
+  ezStats::AddEventHandler(ezMakeDelegate(&StreamStatsEventHandler));
+
+  s_pStreamWriter = pStreamWriter;
+  s_iStreamGeneration.Increment();
+  s_iStreaming.Set(1);
+
+  s_pStreamWriter->Start();
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopStreaming()
+{
+  EZ_LOCK(s_StreamWriterMutex);
+
+  if (s_pStreamWriter == nullptr)
+    return;
+
+  s_iStreaming.Set(0);
+
+  s_pStreamWriter->m_iStop.Set(1);
+  s_pStreamWriter->Join();
+  s_pStreamWriter->m_File.Close();
+
+  ezStats::RemoveEventHandler(ezMakeDelegate(&StreamStatsEventHandler));
+
+  {
+    EZ_LOCK(s_StreamedCountersMutex);
+    s_StreamedCounters.Clear();
+  }
+
+  EZ_DEFAULT_DELETE(s_pStreamWriter);
+}
+
+// static
+bool ezProfilingSystem::IsStreaming()
+{
+  return s_iStreaming != 0;
+}
+
+// static
+ezResult ezProfilingSystem::StartSampling(ezTime interval)
+{
+  EZ_LOCK(s_AllEventBuffersMutex);
+
+  if (s_iSampling)
+  {
+    ezLog::Error("CPU sampling is already active");
+    return EZ_FAILURE;
+  }
+
+  // the signal handler must never allocate, so every known thread gets its buffer up front
+  for (::EventBuffer* pEventBuffer : s_AllEventBuffers)
+  {
+    if (pEventBuffer->m_pSampleBuffer == nullptr)
+    {
+      pEventBuffer->m_pSampleBuffer = EZ_DEFAULT_NEW(SampleBuffer);
+    }
+  }
+
+  s_iSampling.Set(1);
+
+  if (StartSamplingTimer(interval).Failed())
+  {
+    s_iSampling.Set(0);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopSampling()
+{
+  EZ_LOCK(s_AllEventBuffersMutex);
+
+  if (!s_iSampling)
+    return;
+
+  // the sample buffers stay alive, a signal may still be in flight
+  StopSamplingTimer();
+  s_iSampling.Set(0);
+}
+
+// static
+bool ezProfilingSystem::IsSampling()
+{
+  return s_iSampling != 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 ezProfilingScope::ezProfilingScope(const char* szName, const char* szFunctionName)
   : m_szName(szName)
   , m_uiNameLength((ezUInt32)::strlen(szName))
@@ -491,28 +1433,14 @@ ezProfilingListScope::ezProfilingListScope(const char* szListName, const char* s
   m_pPreviousList = s_pCurrentList;
   s_pCurrentList = this;
 
-  {
-    ezProfilingSystem::Event& e = AllocateEvent(m_szListName, m_uiListNameLength, ezProfilingSystem::Event::Begin);
-    e.m_szFunctionName = szFunctionName;
-  }
-
-  {
-    ezProfilingSystem::Event& e = AllocateEvent(m_szCurSectionName, m_uiCurSectionNameLength, ezProfilingSystem::Event::Begin);
-    e.m_szFunctionName = nullptr;
-  }
+  AllocateEvent(m_szListName, m_uiListNameLength, ezProfilingSystem::Event::Begin, szFunctionName);
+  AllocateEvent(m_szCurSectionName, m_uiCurSectionNameLength, ezProfilingSystem::Event::Begin, nullptr);
 }
 
 ezProfilingListScope::~ezProfilingListScope()
 {
-  {
-    ezProfilingSystem::Event& e = AllocateEvent(m_szCurSectionName, m_uiCurSectionNameLength, ezProfilingSystem::Event::End);
-    e.m_szFunctionName = nullptr;
-  }
-
-  {
-    ezProfilingSystem::Event& e = AllocateEvent(m_szListName, m_uiListNameLength, ezProfilingSystem::Event::End);
-    e.m_szFunctionName = nullptr;
-  }
+  AllocateEvent(m_szCurSectionName, m_uiCurSectionNameLength, ezProfilingSystem::Event::End, nullptr);
+  AllocateEvent(m_szListName, m_uiListNameLength, ezProfilingSystem::Event::End, nullptr);
 
   s_pCurrentList = m_pPreviousList;
 }
@@ -521,18 +1449,12 @@ void ezProfilingListScope::StartNextSection(const char* szNextSectionName)
 {
   ezProfilingListScope* pCurScope = s_pCurrentList;
 
-  {
-    ezProfilingSystem::Event& e = AllocateEvent(pCurScope->m_szCurSectionName, pCurScope->m_uiCurSectionNameLength, ezProfilingSystem::Event::End);
-    e.m_szFunctionName = nullptr;
-  }
+  AllocateEvent(pCurScope->m_szCurSectionName, pCurScope->m_uiCurSectionNameLength, ezProfilingSystem::Event::End, nullptr);
 
   pCurScope->m_szCurSectionName = szNextSectionName;
   pCurScope->m_uiCurSectionNameLength = (ezUInt32)::strlen(szNextSectionName);
 
-  {
-    ezProfilingSystem::Event& e = AllocateEvent(pCurScope->m_szCurSectionName, pCurScope->m_uiCurSectionNameLength, ezProfilingSystem::Event::Begin);
-    e.m_szFunctionName = nullptr;
-  }
+  AllocateEvent(pCurScope->m_szCurSectionName, pCurScope->m_uiCurSectionNameLength, ezProfilingSystem::Event::Begin, nullptr);
 }
 
 
@@ -554,18 +1476,27 @@ void ezProfilingSystem::StartNewFrame()
   }
 
   s_FrameStartTimes.PushBack(ezTime::Now());
+
+  if (s_iStreaming)
+  {
+    Event e;
+    e.m_szFunctionName = nullptr;
+    e.m_TimeStamp = s_FrameStartTimes.PeekBack();
+    e.m_Type = STREAM_EVENT_FRAME_START;
+    ezStringUtils::snprintf(e.m_szName, EZ_ARRAY_SIZE(e.m_szName), "Frame %llu", static_cast<unsigned long long>(s_uiFrameCount));
+
+    StreamEvent(GetEventBuffer(), e);
+  }
 }
 
 void ezProfilingSystem::BeginScope(const char* szName, ezUInt32 uiNameLength, const char* szFunctionName)
 {
-  Event& e = AllocateEvent(szName, uiNameLength, Event::Begin);
-  e.m_szFunctionName = szFunctionName;
+  AllocateEvent(szName, uiNameLength, Event::Begin, szFunctionName);
 }
 
 void ezProfilingSystem::EndScope(const char* szName, ezUInt32 uiNameLegth)
 {
-  Event& e = AllocateEvent(szName, uiNameLegth, Event::End);
-  e.m_szFunctionName = nullptr;
+  AllocateEvent(szName, uiNameLegth, Event::End, nullptr);
 }
 
 #else
@@ -591,6 +1522,18 @@ void ezProfilingSystem::EndScope(const char* szName, ezUInt32 uiNameLegth) {}
 
 void ezProfilingSystem::InitializeGPUData() {}
 
+ezResult ezProfilingSystem::StartStreaming(const char* szFile, ezTime flushInterval) { return EZ_FAILURE; }
+
+void ezProfilingSystem::StopStreaming() {}
+
+bool ezProfilingSystem::IsStreaming() { return false; }
+
+ezResult ezProfilingSystem::StartSampling(ezTime interval) { return EZ_FAILURE; }
+
+void ezProfilingSystem::StopSampling() {}
+
+bool ezProfilingSystem::IsSampling() { return false; }
+
 static ezProfilingSystem::GPUData s_Dummy;
 ezProfilingSystem::GPUData& ezProfilingSystem::AllocateGPUData()
 {
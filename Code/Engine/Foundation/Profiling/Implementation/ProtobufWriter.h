@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/StringUtils.h>
+
+/// \brief Minimal protobuf encoder for the subset of the wire format that the profiling stream (Perfetto traces) needs.
+///
+/// Only varints, doubles, strings and nested messages are supported. Field numbers and message layouts are up to the caller.
+class ezProtobufWriter
+{
+public:
+  void Varint(ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      m_Data.PushBack(static_cast<ezUInt8>(uiValue | 0x80));
+      uiValue >>= 7;
+    }
+
+    m_Data.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  void UInt(ezUInt32 uiField, ezUInt64 uiValue)
+  {
+    Varint(uiField << 3);
+    Varint(uiValue);
+  }
+
+  void Double(ezUInt32 uiField, double fValue)
+  {
+    Varint((uiField << 3) | 1);
+    m_Data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&fValue), sizeof(double)));
+  }
+
+  void String(ezUInt32 uiField, const char* szValue)
+  {
+    const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szValue);
+
+    Varint((uiField << 3) | 2);
+    Varint(uiLength);
+    m_Data.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szValue), uiLength));
+  }
+
+  /// \brief Starts a length-delimited field. Reserves 4 bytes for the length, EndNested() shrinks that to what is actually needed.
+  ezUInt32 BeginNested(ezUInt32 uiField)
+  {
+    Varint((uiField << 3) | 2);
+    m_Data.SetCount(m_Data.GetCount() + 4);
+    return m_Data.GetCount();
+  }
+
+  /// \brief Finishes the field that BeginNested() returned \a uiStart for. Nested fields have to be finished innermost first.
+  void EndNested(ezUInt32 uiStart)
+  {
+    const ezUInt32 uiLength = m_Data.GetCount() - uiStart;
+    EZ_ASSERT_DEBUG(uiLength < (1u << 28), "Nested protobuf message is too large");
+
+    ezUInt32 uiLengthBytes = 1;
+    while (uiLengthBytes < 4 && (uiLength >> (7 * uiLengthBytes)) != 0)
+      ++uiLengthBytes;
+
+    ezUInt8* pData = m_Data.GetData();
+
+    if (uiLengthBytes < 4)
+    {
+      ezMemoryUtils::CopyOverlapped(pData + uiStart - 4 + uiLengthBytes, pData + uiStart, uiLength);
+      m_Data.SetCountUninitialized(m_Data.GetCount() - (4 - uiLengthBytes));
+    }
+
+    for (ezUInt32 i = 0; i < uiLengthBytes; ++i)
+    {
+      const ezUInt8 uiMore = (i + 1 < uiLengthBytes) ? 0x80 : 0;
+      pData[uiStart - 4 + i] = static_cast<ezUInt8>(((uiLength >> (7 * i)) & 0x7F) | uiMore);
+    }
+  }
+
+  ezDynamicArray<ezUInt8> m_Data;
+};
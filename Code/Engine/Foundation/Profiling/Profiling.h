@@ -95,6 +95,26 @@ public:
     char m_szName[NAME_SIZE];
   };
 
+  /// \brief A node in the call tree of the CPU samples. The root node of each sample is the profiling scope it was taken in.
+  struct StackFrame
+  {
+    ezString m_sName;
+    ezUInt32 m_uiParent = ezInvalidIndex;
+  };
+
+  /// \brief A symbolized call stack sample of one thread.
+  struct CPUSample
+  {
+    ezTime m_TimeStamp;
+    ezUInt32 m_uiStackFrame; ///< Index of the innermost frame in ProfilingData::m_StackFrames.
+  };
+
+  struct CPUSamplesFlat
+  {
+    ezDynamicArray<CPUSample> m_Samples;
+    ezUInt64 m_uiThreadId = 0;
+  };
+
   struct EZ_FOUNDATION_DLL ProfilingData
   {
     ezUInt32 m_uiFramesThreadID = 0;
@@ -110,6 +130,9 @@ public:
 
     ezDynamicArray<GPUData> m_GPUData;
 
+    ezDynamicArray<StackFrame> m_StackFrames;
+    ezDynamicArray<CPUSamplesFlat> m_CPUSamples;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& outputStream) const;
   };
@@ -146,6 +169,49 @@ public:
 
   /// \brief Allocates GPU profiling data in the internal event ringbuffer.
   static GPUData& AllocateGPUData();
+
+public:
+  /// \brief Starts writing all profiling events continuously into the given file, until StopStreaming() is called.
+  ///
+  /// Other than Capture(), which only returns what is still in the in-memory ring buffers, this records everything for as long as
+  /// needed. Each thread additionally pushes its events into a bounded stream buffer, which a background thread drains every
+  /// \a flushInterval and appends to the file in the Perfetto protobuf trace format (open it with ui.perfetto.dev).
+  /// Numeric ezStats values are recorded as counter tracks. When a thread produces more events than its stream buffer can hold
+  /// in one interval, the surplus is dropped and counted in the stat 'Profiling/Streaming/DroppedEvents', so the overhead on the
+  /// profiled threads stays bounded no matter how long the capture runs. Scopes are always dropped as a whole, including everything
+  /// nested inside them, so every scope in the stream is closed properly. GPU data is not streamed.
+  ///
+  /// If \a szFile cannot be resolved through ezFileSystem, it is used as an absolute path.
+  static ezResult StartStreaming(const char* szFile, ezTime flushInterval = ezTime::Milliseconds(100));
+
+  /// \brief Writes all remaining events and closes the stream file.
+  static void StopStreaming();
+
+  /// \brief Whether StartStreaming() is currently active.
+  static bool IsStreaming();
+
+public:
+  /// \brief Starts periodically sampling the call stacks of all threads, which are then part of every Capture().
+  ///
+  /// This finds hot code that is not covered by EZ_PROFILE_SCOPE. A CPU time timer interrupts whichever thread is running every
+  /// \a interval, the call stack is stored in a per-thread ring buffer and only symbolized in Capture(). Each sample is attributed to
+  /// the innermost profiling scope that was open on its thread at that time. Only threads that have recorded at least one profiling
+  /// scope are sampled. The samples are not part of the stream written by StartStreaming().
+  ///
+  /// Call stacks are walked along the frame pointers, so code that omits them only shows up with truncated stacks. Build with
+  /// -fno-omit-frame-pointer to get complete ones.
+  ///
+  /// Setting the CVar 'prof_SampleInterval' to a number of milliseconds, e.g. through "-prof_SampleInterval 1" on the command line,
+  /// starts sampling as well, setting it to 0 stops it again.
+  ///
+  /// Currently only supported on Linux, fails on all other platforms.
+  static ezResult StartSampling(ezTime interval = ezTime::Milliseconds(1));
+
+  /// \brief Stops sampling. Samples that were already taken remain part of the next Capture().
+  static void StopSampling();
+
+  /// \brief Whether StartSampling() is currently active.
+  static bool IsSampling();
 };
 
 #if EZ_ENABLED(EZ_USE_PROFILING) || defined(EZ_DOCS)
@@ -3,6 +3,8 @@
 /// \file
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Set.h>
 #include <Foundation/Reflection/Reflection.h>
@@ -33,6 +35,7 @@ public:
   const ezHybridArray<Property, 16>& GetProperties() const { return m_Properties; }
 
   void AddProperty(const char* szName, const ezVariant& value);
+  void AddProperty(const char* szName, ezVariant&& value);
 
   void RemoveProperty(const char* szName);
 
@@ -110,6 +113,11 @@ struct EZ_FOUNDATION_DLL ezDiffOperation
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_FOUNDATION_DLL, ezDiffOperation);
 
 
+/// \brief A graph of abstract objects, used as the intermediate representation for (de)serializing reflected objects.
+///
+/// Nodes are allocated from a chunked arena and recycled when removed, and all strings (types, node and property names) are
+/// interned in large blocks, so building a graph only allocates memory once per chunk or block instead of once per node and string.
+/// Nodes are looked up by guid through a hash table, GetAllNodes() still provides them ordered by guid.
 class EZ_FOUNDATION_DLL ezAbstractObjectGraph
 {
 public:
@@ -121,6 +129,9 @@ public:
 
   const char* RegisterString(const char* szString);
 
+  /// \brief Pre-allocates storage for the given number of additional nodes, e.g. before reading a graph of known size.
+  void ReserveNodes(ezUInt32 uiNumNodes);
+
   const ezAbstractObjectNode* GetNode(const ezUuid& guid) const;
   ezAbstractObjectNode* GetNode(const ezUuid& guid);
 
@@ -168,8 +179,23 @@ private:
   void ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUuid, ezUuid>& guidMap, ezAbstractObjectNode* lhs, const ezAbstractObjectGraph& rhsGraph,
                                            const ezAbstractObjectNode* rhs);
 
-  ezSet<ezString> m_Strings;
+  void RemapNodeGuid(ezAbstractObjectNode* pNode, const ezUuid& newGuid);
+
+  enum
+  {
+    StringBlockSize = 16 * 1024,
+  };
+
+  ezDeque<ezAbstractObjectNode> m_NodeStorage;
+  ezDynamicArray<ezAbstractObjectNode*> m_FreeNodes;
+
+  ezHashTable<const char*, const char*> m_Strings;
+  ezHybridArray<char*, 8> m_StringBlocks;
+  char* m_pCurrentStringBlock = nullptr;
+  ezUInt32 m_uiStringBlockRemaining = 0;
+
   ezMap<ezUuid, ezAbstractObjectNode*> m_Nodes;
+  ezHashTable<ezUuid, ezAbstractObjectNode*> m_NodeLookup;
   ezMap<const char*, ezAbstractObjectNode*, CompareConstChar> m_NodesByName;
 };
 
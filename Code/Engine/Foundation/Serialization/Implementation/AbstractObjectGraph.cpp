@@ -34,13 +34,20 @@ EZ_END_STATIC_REFLECTED_TYPE;
 
 void ezAbstractObjectGraph::Clear()
 {
-  for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
-  {
-    EZ_DEFAULT_DELETE(it.Value());
-  }
   m_Nodes.Clear();
+  m_NodeLookup.Clear();
   m_NodesByName.Clear();
+  m_FreeNodes.Clear();
+  m_NodeStorage.Clear();
+
+  for (char* pBlock : m_StringBlocks)
+  {
+    EZ_DELETE_RAW_BUFFER(ezFoundation::GetDefaultAllocator(), pBlock);
+  }
+  m_StringBlocks.Clear();
   m_Strings.Clear();
+  m_pCurrentStringBlock = nullptr;
+  m_uiStringBlockRemaining = 0;
 }
 
 
@@ -56,14 +63,53 @@ void ezAbstractObjectGraph::Clone(ezAbstractObjectGraph& cloneTarget) const
 
 const char* ezAbstractObjectGraph::RegisterString(const char* szString)
 {
-  auto it = m_Strings.Insert(szString);
-  EZ_ASSERT_DEV(it.IsValid(), "");
-  return it.Key().GetData();
+  if (szString == nullptr)
+    szString = "";
+
+  const char* szRegistered = nullptr;
+  if (m_Strings.TryGetValue(szString, szRegistered))
+    return szRegistered;
+
+  const ezUInt32 uiSize = ezStringUtils::GetStringElementCount(szString) + 1;
+
+  char* szTarget = nullptr;
+  if (uiSize > StringBlockSize / 4)
+  {
+    // long strings get a block of their own, so that they don't waste the remainder of the current block
+    szTarget = EZ_NEW_RAW_BUFFER(ezFoundation::GetDefaultAllocator(), char, uiSize);
+    m_StringBlocks.PushBack(szTarget);
+  }
+  else
+  {
+    if (uiSize > m_uiStringBlockRemaining)
+    {
+      m_pCurrentStringBlock = EZ_NEW_RAW_BUFFER(ezFoundation::GetDefaultAllocator(), char, StringBlockSize);
+      m_uiStringBlockRemaining = StringBlockSize;
+      m_StringBlocks.PushBack(m_pCurrentStringBlock);
+    }
+
+    szTarget = m_pCurrentStringBlock + (StringBlockSize - m_uiStringBlockRemaining);
+    m_uiStringBlockRemaining -= uiSize;
+  }
+
+  ezMemoryUtils::Copy(szTarget, szString, uiSize);
+  m_Strings.Insert(szTarget, szTarget);
+  return szTarget;
+}
+
+void ezAbstractObjectGraph::ReserveNodes(ezUInt32 uiNumNodes)
+{
+  const ezUInt32 uiNumRequired = m_Nodes.GetCount() + uiNumNodes;
+
+  m_NodeStorage.Reserve(uiNumRequired);
+  m_NodeLookup.Reserve(uiNumRequired);
 }
 
 ezAbstractObjectNode* ezAbstractObjectGraph::GetNode(const ezUuid& guid)
 {
-  return m_Nodes.GetValueOrDefault(guid, nullptr);
+  ezAbstractObjectNode* pNode = nullptr;
+  m_NodeLookup.TryGetValue(guid, pNode);
+  return pNode;
 }
 
 const ezAbstractObjectNode* ezAbstractObjectGraph::GetNode(const ezUuid& guid) const
@@ -83,7 +129,7 @@ ezAbstractObjectNode* ezAbstractObjectGraph::GetNodeByName(const char* szName)
 
 ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const char* szType, ezUInt32 uiTypeVersion, const char* szNodeName)
 {
-  EZ_ASSERT_DEV(!m_Nodes.Contains(guid), "object {0} must not yet exist", guid);
+  EZ_ASSERT_DEV(!m_NodeLookup.Contains(guid), "object {0} must not yet exist", guid);
   if (!ezStringUtils::IsNullOrEmpty(szNodeName))
   {
     szNodeName = RegisterString(szNodeName);
@@ -93,7 +139,17 @@ ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const c
     szNodeName = nullptr;
   }
 
-  ezAbstractObjectNode* pNode = EZ_DEFAULT_NEW(ezAbstractObjectNode);
+  ezAbstractObjectNode* pNode = nullptr;
+  if (!m_FreeNodes.IsEmpty())
+  {
+    pNode = m_FreeNodes.PeekBack();
+    m_FreeNodes.PopBack();
+  }
+  else
+  {
+    pNode = &m_NodeStorage.ExpandAndGetRef();
+  }
+
   pNode->m_Guid = guid;
   pNode->m_pOwner = this;
   pNode->m_szType = RegisterString(szType);
@@ -101,6 +157,7 @@ ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const c
   pNode->m_szNodeName = szNodeName;
 
   m_Nodes[guid] = pNode;
+  m_NodeLookup[guid] = pNode;
 
   if (!ezStringUtils::IsNullOrEmpty(szNodeName))
   {
@@ -121,7 +178,12 @@ void ezAbstractObjectGraph::RemoveNode(const ezUuid& guid)
       m_NodesByName.Remove(pNode->m_szNodeName);
 
     m_Nodes.Remove(guid);
-    EZ_DEFAULT_DELETE(pNode);
+    m_NodeLookup.Remove(guid);
+
+    // the node memory is owned by the graph and reused by the next AddNode
+    pNode->m_Properties.Clear();
+    pNode->m_szNodeName = nullptr;
+    m_FreeNodes.PushBack(pNode);
   }
 }
 
@@ -132,6 +194,13 @@ void ezAbstractObjectNode::AddProperty(const char* szName, const ezVariant& valu
   prop.m_Value = value;
 }
 
+void ezAbstractObjectNode::AddProperty(const char* szName, ezVariant&& value)
+{
+  auto& prop = m_Properties.ExpandAndGetRef();
+  prop.m_szPropertyName = m_pOwner->RegisterString(szName);
+  prop.m_Value = std::move(value);
+}
+
 void ezAbstractObjectNode::ChangeProperty(const char* szName, const ezVariant& value)
 {
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
@@ -223,6 +292,7 @@ void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapIn
   }
 
   m_Nodes.Clear();
+  m_NodeLookup.Clear();
 
   // go through all nodes to remap guids
   for (auto* pNode : nodes)
@@ -235,6 +305,7 @@ void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapIn
       RemapVariant(prop.m_Value, guidMap);
     }
     m_Nodes[pNode->m_Guid] = pNode;
+    m_NodeLookup[pNode->m_Guid] = pNode;
   }
 }
 
@@ -271,9 +342,7 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
   if (lhs->GetGuid() != rhs->GetGuid())
   {
     guidMap[lhs->GetGuid()] = rhs->GetGuid();
-    m_Nodes.Remove(lhs->GetGuid());
-    lhs->m_Guid = rhs->GetGuid();
-    m_Nodes.Insert(rhs->GetGuid(), lhs);
+    RemapNodeGuid(lhs, rhs->GetGuid());
   }
 
   for (ezAbstractObjectNode::Property& prop : lhs->m_Properties)
@@ -281,8 +350,8 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
     if (prop.m_Value.IsA<ezUuid>() && prop.m_Value.Get<ezUuid>().IsValid())
     {
       // if the guid is an owned object in the graph, remap to rhs.
-      auto it = m_Nodes.Find(prop.m_Value.Get<ezUuid>());
-      if (it.IsValid())
+      ezAbstractObjectNode* pPropNode = GetNode(prop.m_Value.Get<ezUuid>());
+      if (pPropNode != nullptr)
       {
         if (const ezAbstractObjectNode::Property* rhsProp = rhs->FindProperty(prop.m_szPropertyName))
         {
@@ -290,7 +359,7 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
           {
             if (const ezAbstractObjectNode* rhsPropNode = rhsGraph.GetNode(rhsProp->m_Value.Get<ezUuid>()))
             {
-              ReMapNodeGuidsToMatchGraphRecursive(guidMap, it.Value(), rhsGraph, rhsPropNode);
+              ReMapNodeGuidsToMatchGraphRecursive(guidMap, pPropNode, rhsGraph, rhsPropNode);
             }
           }
         }
@@ -306,8 +375,8 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
         if (subValue.IsA<ezUuid>() && subValue.Get<ezUuid>().IsValid())
         {
           // if the guid is an owned object in the graph, remap to array element.
-          auto it = m_Nodes.Find(subValue.Get<ezUuid>());
-          if (it.IsValid())
+          ezAbstractObjectNode* pPropNode = GetNode(subValue.Get<ezUuid>());
+          if (pPropNode != nullptr)
           {
             if (const ezAbstractObjectNode::Property* rhsProp = rhs->FindProperty(prop.m_szPropertyName))
             {
@@ -321,7 +390,7 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
                   {
                     if (const ezAbstractObjectNode* rhsPropNode = rhsGraph.GetNode(rhsElemValue.Get<ezUuid>()))
                     {
-                      ReMapNodeGuidsToMatchGraphRecursive(guidMap, it.Value(), rhsGraph, rhsPropNode);
+                      ReMapNodeGuidsToMatchGraphRecursive(guidMap, pPropNode, rhsGraph, rhsPropNode);
                     }
                   }
                 }
@@ -341,8 +410,8 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
         if (subValue.IsA<ezUuid>() && subValue.Get<ezUuid>().IsValid())
         {
           // if the guid is an owned object in the graph, remap to map element.
-          auto it = m_Nodes.Find(subValue.Get<ezUuid>());
-          if (it.IsValid())
+          ezAbstractObjectNode* pPropNode = GetNode(subValue.Get<ezUuid>());
+          if (pPropNode != nullptr)
           {
             if (const ezAbstractObjectNode::Property* rhsProp = rhs->FindProperty(prop.m_szPropertyName))
             {
@@ -356,7 +425,7 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
                   {
                     if (const ezAbstractObjectNode* rhsPropNode = rhsGraph.GetNode(rhsElemValue.Get<ezUuid>()))
                     {
-                      ReMapNodeGuidsToMatchGraphRecursive(guidMap, it.Value(), rhsGraph, rhsPropNode);
+                      ReMapNodeGuidsToMatchGraphRecursive(guidMap, pPropNode, rhsGraph, rhsPropNode);
                     }
                   }
                 }
@@ -370,6 +439,17 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUu
 }
 
 
+void ezAbstractObjectGraph::RemapNodeGuid(ezAbstractObjectNode* pNode, const ezUuid& newGuid)
+{
+  m_Nodes.Remove(pNode->m_Guid);
+  m_NodeLookup.Remove(pNode->m_Guid);
+
+  pNode->m_Guid = newGuid;
+
+  m_Nodes.Insert(newGuid, pNode);
+  m_NodeLookup.Insert(newGuid, pNode);
+}
+
 void ezAbstractObjectGraph::PruneGraph(const ezUuid& rootGuid)
 {
   ezSet<ezUuid> reachableNodes;
@@ -379,10 +459,8 @@ void ezAbstractObjectGraph::PruneGraph(const ezUuid& rootGuid)
   while (!inProgress.IsEmpty())
   {
     ezUuid current = *inProgress.GetIterator();
-    auto it = m_Nodes.Find(current);
-    if (it.IsValid())
+    if (ezAbstractObjectNode* pNode = GetNode(current))
     {
-      ezAbstractObjectNode* pNode = it.Value();
       for (auto& prop : pNode->m_Properties)
       {
         if (prop.m_Value.IsA<ezUuid>())
@@ -55,12 +55,19 @@ static void ReadGraph(ezStreamReader& stream, ezAbstractObjectGraph* pGraph)
 {
   ezUInt32 uiNodes = 0;
   stream >> uiNodes;
+
+  pGraph->ReserveNodes(uiNodes);
+
+  // the temporaries are reused for all nodes, the graph copies the strings into its own storage and the values are moved into it
+  ezUuid guid;
+  ezUInt32 uiTypeVersion;
+  ezStringBuilder sType;
+  ezStringBuilder sNodeName;
+  ezStringBuilder sPropName;
+  ezVariant value;
+
   for (ezUInt32 uiNodeIdx = 0; uiNodeIdx < uiNodes; uiNodeIdx++)
   {
-    ezUuid guid;
-    ezUInt32 uiTypeVersion;
-    ezStringBuilder sType;
-    ezStringBuilder sNodeName;
     stream >> guid;
     stream >> sType;
     stream >> uiTypeVersion;
@@ -70,11 +77,9 @@ static void ReadGraph(ezStreamReader& stream, ezAbstractObjectGraph* pGraph)
     stream >> uiProps;
     for (ezUInt32 propIdx = 0; propIdx < uiProps; ++propIdx)
     {
-      ezStringBuilder sPropName;
-      ezVariant value;
       stream >> sPropName;
       stream >> value;
-      pNode->AddProperty(sPropName, value);
+      pNode->AddProperty(sPropName, std::move(value));
     }
   }
 }
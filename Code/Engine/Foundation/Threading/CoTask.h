@@ -0,0 +1,283 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+
+#  include <Foundation/Threading/TaskSystem.h>
+
+#  include <coroutine>
+#  include <type_traits>
+
+template <typename T>
+class ezCoTask;
+
+namespace ezInternal
+{
+  /// \brief Starts a task with the given priority that resumes the coroutine. If \a dependency is valid, the task only starts after that
+  /// group has finished.
+  EZ_FOUNDATION_DLL void ScheduleCoroutineResume(
+    std::coroutine_handle<> hCoroutine, ezTaskPriority::Enum priority, ezTaskGroupID dependency);
+
+  /// \brief Blocks until \a iState is set to finished. Helps executing tasks in the meantime, same as ezTaskSystem::WaitForTask().
+  EZ_FOUNDATION_DLL void WaitForCoroutine(const ezAtomicInteger32& iState);
+
+  struct ezCoPromiseBase
+  {
+    enum State
+    {
+      Running = 0,
+      Finished = 1,
+      Detached = 2,
+    };
+
+    /// The coroutine that awaits this one, resumed when this one is finished.
+    std::coroutine_handle<> m_hContinuation;
+    ezAtomicInteger32 m_iState = Running;
+
+    struct FinalAwaiter
+    {
+      bool await_ready() noexcept { return false; }
+
+      template <typename Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> hCoroutine) noexcept
+      {
+        ezCoPromiseBase& promise = hCoroutine.promise();
+
+        // as soon as the state is set, the owner may destroy the frame
+        std::coroutine_handle<> hContinuation = promise.m_hContinuation;
+
+        if (promise.m_iState.Set(Finished) == Detached)
+        {
+          hCoroutine.destroy();
+        }
+
+        // continue the awaiting coroutine right away on this thread, without going through the task system
+        return hContinuation ? hContinuation : std::noop_coroutine();
+      }
+
+      void await_resume() noexcept {}
+    };
+
+    // coroutines start lazily, either when they are awaited or through StartDetached() / WaitForResult()
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { EZ_REPORT_FAILURE("Unhandled exception in a coroutine"); }
+
+    static void* operator new(size_t uiSize)
+    {
+      return ezFoundation::GetDefaultAllocator()->Allocate(uiSize, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    }
+    static void operator delete(void* ptr) { ezFoundation::GetDefaultAllocator()->Deallocate(ptr); }
+  };
+
+  template <typename T>
+  struct ezCoPromise : public ezCoPromiseBase
+  {
+    ~ezCoPromise()
+    {
+      if (m_bHasResult)
+      {
+        ezMemoryUtils::Destruct(&GetResult(), 1);
+      }
+    }
+
+    ezCoTask<T> get_return_object() noexcept { return ezCoTask<T>(std::coroutine_handle<ezCoPromise>::from_promise(*this)); }
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+      new (m_Result) T(std::forward<U>(value));
+      m_bHasResult = true;
+    }
+
+    T& GetResult()
+    {
+      EZ_ASSERT_DEBUG(m_bHasResult, "The coroutine has not returned a value");
+      return *reinterpret_cast<T*>(m_Result);
+    }
+
+    // T does not need to be default constructible
+    alignas(T) ezUInt8 m_Result[sizeof(T)];
+    bool m_bHasResult = false;
+  };
+
+  template <>
+  struct ezCoPromise<void> : public ezCoPromiseBase
+  {
+    ezCoTask<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+  };
+} // namespace ezInternal
+
+/// \brief A coroutine that runs on top of the ezTaskSystem.
+///
+/// Any function that returns an ezCoTask<T> and uses co_await or co_return is a coroutine. Such a function can await other coroutines
+/// (co_await SomeCoroutine()), task groups (co_await ezCoWaitForGroup(group)) or switch to a thread for a different kind of work
+/// (co_await ezCoSwitchTo(ezTaskPriority::FileAccess)). While a coroutine is suspended, no thread is blocked. It is resumed by a task
+/// once the awaited work is done. Contrary to ezTaskSystem::WaitForTask() this does not execute unrelated tasks on the waiting thread,
+/// so the stack does not grow with every wait.
+///
+/// Coroutines start lazily. A coroutine that is not awaited by another coroutine has to be started with StartDetached() or
+/// WaitForResult(). After a co_await the coroutine may continue on a different thread than before.
+template <typename T = void>
+class ezCoTask
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezCoTask);
+
+public:
+  using promise_type = ezInternal::ezCoPromise<T>;
+
+  ezCoTask(ezCoTask&& other) noexcept
+  {
+    m_hCoroutine = other.m_hCoroutine;
+    m_bStarted = other.m_bStarted;
+    other.m_hCoroutine = nullptr;
+  }
+
+  ~ezCoTask()
+  {
+    if (m_hCoroutine)
+    {
+      EZ_ASSERT_DEV(!m_bStarted || IsFinished(), "A running coroutine must not be destroyed, use StartDetached() for fire-and-forget work");
+      m_hCoroutine.destroy();
+    }
+  }
+
+  /// \brief Returns true once the coroutine has returned.
+  bool IsFinished() const { return m_hCoroutine && m_hCoroutine.promise().m_iState == ezInternal::ezCoPromiseBase::Finished; }
+
+  /// \brief Starts the coroutine on the calling thread, where it runs until it suspends for the first time.
+  ///
+  /// The coroutine destroys itself once it is finished, this object is empty afterwards.
+  void StartDetached()
+  {
+    EZ_ASSERT_DEV(m_hCoroutine && !m_bStarted, "The coroutine has already been started");
+
+    std::coroutine_handle<promise_type> hCoroutine = m_hCoroutine;
+    m_hCoroutine = nullptr;
+
+    // must be set before it runs, afterwards another thread may finish it at any time
+    hCoroutine.promise().m_iState = ezInternal::ezCoPromiseBase::Detached;
+    hCoroutine.resume();
+  }
+
+  /// \brief Starts the coroutine and blocks until it is finished, then returns its result.
+  ///
+  /// This is meant for code that cannot be a coroutine itself. The calling thread helps executing tasks while it waits, with all
+  /// consequences described at ezTaskSystem::WaitForTask().
+  T WaitForResult()
+  {
+    EZ_ASSERT_DEV(m_hCoroutine && !m_bStarted, "The coroutine has already been started");
+
+    m_bStarted = true;
+    m_hCoroutine.resume();
+
+    ezInternal::WaitForCoroutine(m_hCoroutine.promise().m_iState);
+
+    if constexpr (!std::is_void_v<T>)
+    {
+      return std::move(m_hCoroutine.promise().GetResult());
+    }
+  }
+
+  /// \brief Starts the coroutine when it is awaited. When it is finished, the awaiting coroutine continues on the same thread.
+  auto operator co_await() && noexcept
+  {
+    struct Awaiter
+    {
+      std::coroutine_handle<promise_type> m_hCoroutine;
+
+      bool await_ready() noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> hAwaiting) noexcept
+      {
+        m_hCoroutine.promise().m_hContinuation = hAwaiting;
+        return m_hCoroutine;
+      }
+
+      T await_resume()
+      {
+        if constexpr (!std::is_void_v<T>)
+        {
+          return std::move(m_hCoroutine.promise().GetResult());
+        }
+      }
+    };
+
+    EZ_ASSERT_DEV(m_hCoroutine && !m_bStarted, "The coroutine has already been started");
+    m_bStarted = true;
+
+    return Awaiter{m_hCoroutine};
+  }
+
+private:
+  friend promise_type;
+
+  explicit ezCoTask(std::coroutine_handle<promise_type> hCoroutine)
+    : m_hCoroutine(hCoroutine)
+  {
+  }
+
+  std::coroutine_handle<promise_type> m_hCoroutine;
+  bool m_bStarted = false;
+};
+
+inline ezCoTask<void> ezInternal::ezCoPromise<void>::get_return_object() noexcept
+{
+  return ezCoTask<void>(std::coroutine_handle<ezCoPromise>::from_promise(*this));
+}
+
+/// \brief Suspends the coroutine and continues it in a task with the given priority.
+///
+/// E.g. use ezTaskPriority::FileAccess before doing I/O, ezTaskPriority::LongRunning before decoding data and
+/// ezTaskPriority::SomeFrameMainThread before uploading it to the GPU.
+class ezCoSwitchTo
+{
+public:
+  explicit ezCoSwitchTo(ezTaskPriority::Enum priority)
+    : m_Priority(priority)
+  {
+  }
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> hCoroutine) const
+  {
+    ezInternal::ScheduleCoroutineResume(hCoroutine, m_Priority, ezTaskGroupID());
+  }
+  void await_resume() const noexcept {}
+
+private:
+  ezTaskPriority::Enum m_Priority;
+};
+
+/// \brief Suspends the coroutine until the given task group has finished, then continues it in a task with the given priority.
+///
+/// If the group has already finished, the coroutine just continues on the current thread.
+class ezCoWaitForGroup
+{
+public:
+  explicit ezCoWaitForGroup(ezTaskGroupID group, ezTaskPriority::Enum resumePriority = ezTaskPriority::LongRunning)
+    : m_Group(group)
+    , m_ResumePriority(resumePriority)
+  {
+  }
+
+  bool await_ready() const { return ezTaskSystem::IsTaskGroupFinished(m_Group); }
+  void await_suspend(std::coroutine_handle<> hCoroutine) const
+  {
+    ezInternal::ScheduleCoroutineResume(hCoroutine, m_ResumePriority, m_Group);
+  }
+  void await_resume() const noexcept {}
+
+private:
+  ezTaskGroupID m_Group;
+  ezTaskPriority::Enum m_ResumePriority;
+};
+
+/// \brief Reads the entire file on the file access thread. The awaiting coroutine continues on that thread.
+EZ_FOUNDATION_DLL ezCoTask<ezResult> ezCoReadFile(ezString sFile, ezDynamicArray<ezUInt8>& out_FileContent);
+
+#endif
@@ -0,0 +1,74 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Threading/CoTask.h>
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+
+#  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/Profiling/Profiling.h>
+
+namespace
+{
+  class ezCoResumeTask : public ezTask
+  {
+  public:
+    ezCoResumeTask(std::coroutine_handle<> hCoroutine)
+      : ezTask("Coroutine")
+      , m_hCoroutine(hCoroutine)
+    {
+    }
+
+  private:
+    virtual void Execute() override { m_hCoroutine.resume(); }
+
+    std::coroutine_handle<> m_hCoroutine;
+  };
+} // namespace
+
+void ezInternal::ScheduleCoroutineResume(std::coroutine_handle<> hCoroutine, ezTaskPriority::Enum priority, ezTaskGroupID dependency)
+{
+  // the coroutine frame may be gone once the task has run, so the task must not live inside it
+  ezCoResumeTask* pTask = EZ_DEFAULT_NEW(ezCoResumeTask, hCoroutine);
+  pTask->SetOnTaskFinished([](ezTask* pTask) { EZ_DEFAULT_DELETE(pTask); });
+
+  if (dependency.IsValid())
+    ezTaskSystem::StartSingleTask(pTask, priority, dependency);
+  else
+    ezTaskSystem::StartSingleTask(pTask, priority);
+}
+
+void ezInternal::WaitForCoroutine(const ezAtomicInteger32& iState)
+{
+  if (iState == ezCoPromiseBase::Finished)
+    return;
+
+  EZ_PROFILE_SCOPE("WaitForCoroutine");
+
+  while (iState != ezCoPromiseBase::Finished)
+  {
+    if (!ezTaskSystem::HelpExecutingTasks())
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+  }
+}
+
+ezCoTask<ezResult> ezCoReadFile(ezString sFile, ezDynamicArray<ezUInt8>& out_FileContent)
+{
+  co_await ezCoSwitchTo(ezTaskPriority::FileAccess);
+
+  ezFileReader file;
+  if (file.Open(sFile).Failed())
+    co_return EZ_FAILURE;
+
+  out_FileContent.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+
+  if (file.ReadBytes(out_FileContent.GetData(), out_FileContent.GetCount()) != out_FileContent.GetCount())
+    co_return EZ_FAILURE;
+
+  co_return EZ_SUCCESS;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_CoTask);
@@ -177,6 +177,7 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
 
     pGroup->m_iRemainingTasks = iRemainingTasks;
 
+    const ezTime scheduleTime = s_bInstrumentationEnabled ? ezTime::Now() : ezTime::Zero();
 
     for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
     {
@@ -189,6 +190,7 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
         td.m_pTask = pTask;
         td.m_pTask->m_bTaskIsScheduled = true;
         td.m_uiInvocation = mult;
+        td.m_ScheduleTime = scheduleTime;
 
         if (bHighPriority)
           s_Tasks[pGroup->m_Priority].PushFront(td);
@@ -196,6 +198,11 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
           s_Tasks[pGroup->m_Priority].PushBack(td);
       }
     }
+
+    if (s_bInstrumentationEnabled)
+    {
+      RecordQueueDepth(pGroup->m_Priority, s_Tasks[pGroup->m_Priority].GetCount());
+    }
   }
 
   // send the proper thread signal, to make sure one of the correct worker threads is awake
@@ -0,0 +1,128 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Utilities/Metrics.h>
+
+extern thread_local ezWorkerThreadType::Enum g_ThreadTaskType;
+extern const char* GetTaskPriorityName(ezTaskPriority::Enum priority);
+
+bool ezTaskSystem::s_bInstrumentationEnabled = false;
+
+namespace
+{
+  struct TaskMetrics
+  {
+    ezMetricHandle m_hExecutions;
+    ezMetricHandle m_hHelpedExecutions;
+    ezMetricHandle m_hLatency;
+    ezMetricHandle m_hRunTime;
+  };
+
+  // Registering a metric takes a lock, so each thread remembers the handles of the tasks it has executed.
+  // Never deallocated, the handles stay valid for the lifetime of the application anyway.
+  typedef ezHashTable<ezUInt64, TaskMetrics> TaskMetricsTable;
+  static thread_local TaskMetricsTable* s_pTaskMetrics = nullptr;
+
+  static ezMetricHandle s_hQueueDepth[ezTaskPriority::ENUM_COUNT];
+
+  const TaskMetrics& GetTaskMetrics(const ezString& sTaskName, ezTaskPriority::Enum priority)
+  {
+    if (s_pTaskMetrics == nullptr)
+    {
+      s_pTaskMetrics = EZ_DEFAULT_NEW(TaskMetricsTable);
+    }
+
+    const ezUInt64 uiKey = ezHashingUtils::xxHash64(sTaskName.GetData(), sTaskName.GetElementCount(), priority);
+
+    TaskMetrics* pMetrics = nullptr;
+    if (!s_pTaskMetrics->TryGetValue(uiKey, pMetrics))
+    {
+      ezStringBuilder sName;
+      TaskMetrics metrics;
+
+      sName.Format("TaskSystem/Tasks/{} ({})/Executions", sTaskName, GetTaskPriorityName(priority));
+      metrics.m_hExecutions = ezMetrics::RegisterCounter(sName);
+
+      sName.Format("TaskSystem/Tasks/{} ({})/Helped", sTaskName, GetTaskPriorityName(priority));
+      metrics.m_hHelpedExecutions = ezMetrics::RegisterCounter(sName);
+
+      sName.Format("TaskSystem/Tasks/{} ({})/LatencyUS", sTaskName, GetTaskPriorityName(priority));
+      metrics.m_hLatency = ezMetrics::RegisterHistogram(sName);
+
+      sName.Format("TaskSystem/Tasks/{} ({})/RunTimeUS", sTaskName, GetTaskPriorityName(priority));
+      metrics.m_hRunTime = ezMetrics::RegisterHistogram(sName);
+
+      s_pTaskMetrics->Insert(uiKey, metrics);
+      s_pTaskMetrics->TryGetValue(uiKey, pMetrics);
+    }
+
+    return *pMetrics;
+  }
+
+  ezWorkerThreadType::Enum GetDefaultWorkerType(ezTaskPriority::Enum priority)
+  {
+    switch (priority)
+    {
+      case ezTaskPriority::LongRunningHighPriority:
+      case ezTaskPriority::LongRunning:
+        return ezWorkerThreadType::LongTasks;
+
+      case ezTaskPriority::FileAccessHighPriority:
+      case ezTaskPriority::FileAccess:
+        return ezWorkerThreadType::FileAccess;
+
+      case ezTaskPriority::ThisFrameMainThread:
+      case ezTaskPriority::SomeFrameMainThread:
+        return ezWorkerThreadType::MainThread;
+
+      default:
+        return ezWorkerThreadType::ShortTasks;
+    }
+  }
+} // namespace
+
+void ezTaskSystem::SetInstrumentationEnabled(bool bEnabled)
+{
+  if (bEnabled)
+  {
+    // registering the same name again returns the same handle
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
+    {
+      sName.Format("TaskSystem/Queues/{}/Depth", GetTaskPriorityName(static_cast<ezTaskPriority::Enum>(i)));
+      s_hQueueDepth[i] = ezMetrics::RegisterHistogram(sName);
+    }
+  }
+
+  s_bInstrumentationEnabled = bEnabled;
+}
+
+void ezTaskSystem::RecordTaskExecution(const TaskData& td, ezTime startTime, ezTime endTime)
+{
+  // scheduled before instrumentation was enabled, the latency is unknown
+  if (td.m_ScheduleTime.IsZero())
+    return;
+
+  const ezTaskPriority::Enum priority = td.m_pBelongsToGroup->m_Priority;
+  const TaskMetrics& metrics = GetTaskMetrics(td.m_pTask->m_sTaskName, priority);
+
+  ezMetrics::Increment(metrics.m_hExecutions);
+
+  if (g_ThreadTaskType != GetDefaultWorkerType(priority))
+  {
+    ezMetrics::Increment(metrics.m_hHelpedExecutions);
+  }
+
+  ezMetrics::Record(metrics.m_hLatency, static_cast<ezUInt64>((startTime - td.m_ScheduleTime).GetMicroseconds()));
+  ezMetrics::Record(metrics.m_hRunTime, static_cast<ezUInt64>((endTime - startTime).GetMicroseconds()));
+}
+
+void ezTaskSystem::RecordQueueDepth(ezTaskPriority::Enum priority, ezUInt32 uiDepth)
+{
+  ezMetrics::Record(s_hQueueDepth[priority], uiDepth);
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskStatistics);
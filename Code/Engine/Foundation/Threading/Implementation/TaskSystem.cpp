@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Logging/Log.h>
@@ -10,6 +11,10 @@
 
 ezMutex ezTaskSystem::s_TaskSystemMutex;
 double ezTaskSystem::s_fSmoothFrameMS = 1000.0 / 40.0; // => 25 ms
+bool ezTaskSystem::s_bFramePacingEnabled = false;
+double ezTaskSystem::s_fBackgroundThrottleThreshold = 0.75;
+ezTime ezTaskSystem::s_FrameStartTime;
+volatile bool ezTaskSystem::s_bFinishingFrameTasks = false;
 ezThreadSignal ezTaskSystem::s_TasksAvailableSignal[ezWorkerThreadType::ENUM_COUNT];
 ezDynamicArray<ezTaskWorkerThread*> ezTaskSystem::s_WorkerThreads[ezWorkerThreadType::ENUM_COUNT];
 ezDeque<ezTaskGroup> ezTaskSystem::s_TaskGroups;
@@ -17,6 +22,65 @@ ezList<ezTaskSystem::TaskData> ezTaskSystem::s_Tasks[ezTaskPriority::ENUM_COUNT]
 
 thread_local ezWorkerThreadType::Enum g_ThreadTaskType = ezWorkerThreadType::Unknown;
 
+// The learned durations of 'SomeFrameMainThread' tasks, by hash of the task name. Protected by s_TaskSystemMutex.
+static ezHashTable<ezUInt64, ezTime> s_TaskCostHistory;
+
+static ezUInt64 GetTaskCostKey(const char* szTaskName)
+{
+  return ezHashingUtils::xxHash64(szTaskName, ezStringUtils::GetStringElementCount(szTaskName));
+}
+
+const char* GetTaskPriorityName(ezTaskPriority::Enum priority)
+{
+  switch (priority)
+  {
+    case ezTaskPriority::EarlyThisFrame:
+      return "EarlyThisFrame";
+    case ezTaskPriority::ThisFrame:
+      return "ThisFrame";
+    case ezTaskPriority::LateThisFrame:
+      return "LateThisFrame";
+    case ezTaskPriority::EarlyNextFrame:
+      return "EarlyNextFrame";
+    case ezTaskPriority::NextFrame:
+      return "NextFrame";
+    case ezTaskPriority::LateNextFrame:
+      return "LateNextFrame";
+    case ezTaskPriority::In2Frames:
+      return "In 2 Frames";
+    case ezTaskPriority::In3Frames:
+      return "In 3 Frames";
+    case ezTaskPriority::In4Frames:
+      return "In 4 Frames";
+    case ezTaskPriority::In5Frames:
+      return "In 5 Frames";
+    case ezTaskPriority::In6Frames:
+      return "In 6 Frames";
+    case ezTaskPriority::In7Frames:
+      return "In 7 Frames";
+    case ezTaskPriority::In8Frames:
+      return "In 8 Frames";
+    case ezTaskPriority::In9Frames:
+      return "In 9 Frames";
+    case ezTaskPriority::LongRunningHighPriority:
+      return "LongRunningHighPriority";
+    case ezTaskPriority::LongRunning:
+      return "LongRunning";
+    case ezTaskPriority::FileAccessHighPriority:
+      return "FileAccessHighPriority";
+    case ezTaskPriority::FileAccess:
+      return "FileAccess";
+    case ezTaskPriority::ThisFrameMainThread:
+      return "ThisFrameMainThread";
+    case ezTaskPriority::SomeFrameMainThread:
+      return "SomeFrameMainThread";
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return "";
+  }
+}
+
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, TaskSystem)
 
@@ -55,6 +119,9 @@ void ezTaskSystem::Shutdown()
 
   s_TaskGroups.Clear();
   s_TaskGroups.Compact();
+
+  s_TaskCostHistory.Clear();
+  s_TaskCostHistory.Compact();
 }
 
 ezTaskGroupID ezTaskSystem::StartSingleTask(ezTask* pTask, ezTaskPriority::Enum Priority, ezTaskGroupID Dependency)
@@ -228,6 +295,123 @@ void ezTaskSystem::ExecuteSomeFrameTasks(ezUInt32 uiSomeFrameTasks, double fSmoo
   }
 }
 
+void ezTaskSystem::ExecuteSomeFrameTasksPaced(ezUInt32 uiSomeFrameTasks, double fSmoothFrameMS)
+{
+  // if not a single task fit into the remaining frame time for this many frames, one task is executed anyway
+  const ezUInt32 uiMaxFramesWithoutProgress = 8;
+  static ezUInt32 s_uiFramesWithoutProgress = 0;
+
+  if (uiSomeFrameTasks == 0)
+  {
+    s_uiFramesWithoutProgress = 0;
+    return;
+  }
+
+  EZ_PROFILE_SCOPE("SomeFrameMainThreadTasks");
+
+  const ezTime frameBudget = ezTime::Milliseconds(fSmoothFrameMS);
+  bool bExecutedAny = false;
+
+  while (uiSomeFrameTasks > 0)
+  {
+    const ezTime tStart = ezTime::Now();
+    const ezTime remainingTime = frameBudget - (tStart - s_FrameStartTime);
+    const bool bForceProgress = !bExecutedAny && s_uiFramesWithoutProgress >= uiMaxFramesWithoutProgress;
+
+    if (remainingTime <= ezTime::Zero() && !bForceProgress)
+      break;
+
+    TaskData td = bForceProgress ? GetNextTask(ezTaskPriority::SomeFrameMainThread, ezTaskPriority::SomeFrameMainThread)
+                                 : GetNextSomeFrameTask(remainingTime);
+
+    // either nothing left to do, or everything that is left is too expensive for this frame
+    if (td.m_pTask == nullptr)
+      break;
+
+    // the task may be deallocated during execution
+    const ezUInt64 uiCostKey = GetTaskCostKey(td.m_pTask->m_sTaskName);
+
+    ExecuteTaskData(td);
+
+    const ezTime cost = ezTime::Now() - tStart;
+
+    {
+      EZ_LOCK(s_TaskSystemMutex);
+
+      ezTime* pAverageCost = nullptr;
+      if (s_TaskCostHistory.TryGetValue(uiCostKey, pAverageCost))
+      {
+        // exponential moving average, adapts within a few executions when the cost of a task type changes
+        *pAverageCost = *pAverageCost * 0.75 + cost * 0.25;
+      }
+      else
+      {
+        s_TaskCostHistory.Insert(uiCostKey, cost);
+      }
+    }
+
+    bExecutedAny = true;
+    --uiSomeFrameTasks;
+  }
+
+  s_uiFramesWithoutProgress = bExecutedAny ? 0 : s_uiFramesWithoutProgress + 1;
+}
+
+ezTaskSystem::TaskData ezTaskSystem::GetNextSomeFrameTask(ezTime MaxCost)
+{
+  // while streaming, the queue can get very long, only the front of it is considered to keep the lock short
+  const ezUInt32 uiMaxTasksToConsider = 64;
+
+  EZ_LOCK(s_TaskSystemMutex);
+
+  ezList<TaskData>& tasks = s_Tasks[ezTaskPriority::SomeFrameMainThread];
+
+  ezUInt32 uiConsidered = 0;
+  for (auto it = tasks.GetIterator(); it.IsValid() && uiConsidered < uiMaxTasksToConsider; ++it, ++uiConsidered)
+  {
+    // task types that have never been executed count as free, so that their cost gets learned
+    ezTime estimatedCost = ezTime::Zero();
+    s_TaskCostHistory.TryGetValue(GetTaskCostKey(it->m_pTask->m_sTaskName), estimatedCost);
+
+    if (estimatedCost <= MaxCost)
+    {
+      TaskData td = *it;
+
+      tasks.Remove(it);
+      return td;
+    }
+  }
+
+  TaskData td;
+  td.m_pTask = nullptr;
+  td.m_pBelongsToGroup = nullptr;
+  return td;
+}
+
+bool ezTaskSystem::ShouldThrottleBackgroundWork()
+{
+  if (!s_bFramePacingEnabled)
+    return false;
+
+  // quick check without the lock, same as in GetNextTask()
+  // a wrong result only means that background work is paused or resumed a moment too late
+  bool bFrameTasksQueued = !s_Tasks[ezTaskPriority::ThisFrameMainThread].IsEmpty();
+
+  for (ezUInt32 i = ezTaskPriority::EarlyThisFrame; i <= (ezUInt32)ezTaskPriority::LateThisFrame && !bFrameTasksQueued; ++i)
+  {
+    bFrameTasksQueued = !s_Tasks[i].IsEmpty();
+  }
+
+  if (!bFrameTasksQueued)
+    return false;
+
+  // the main thread is already blocked on the remaining tasks for this frame
+  if (s_bFinishingFrameTasks)
+    return true;
+
+  return (ezTime::Now() - s_FrameStartTime).GetMilliseconds() > s_fSmoothFrameMS * s_fBackgroundThrottleThreshold;
+}
+
 void ezTaskSystem::DetermineTasksToExecuteOnThread(
   ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority, bool& out_bAllowDefaultWork)
 {
@@ -294,11 +478,34 @@ void ezTaskSystem::SetTargetFrameTime(double fSmoothFrameMS)
   s_fSmoothFrameMS = fSmoothFrameMS;
 }
 
+void ezTaskSystem::SetFramePacingEnabled(bool bEnabled)
+{
+  s_bFramePacingEnabled = bEnabled;
+}
+
+void ezTaskSystem::SetBackgroundThrottleThreshold(double fFractionOfFrameTime)
+{
+  s_fBackgroundThrottleThreshold = ezMath::Max(fFractionOfFrameTime, 0.0);
+}
+
+ezTime ezTaskSystem::GetEstimatedTaskCost(const char* szTaskName)
+{
+  const ezUInt64 uiCostKey = GetTaskCostKey(szTaskName);
+
+  EZ_LOCK(s_TaskSystemMutex);
+
+  ezTime cost = ezTime::Zero();
+  s_TaskCostHistory.TryGetValue(uiCostKey, cost);
+  return cost;
+}
+
 void ezTaskSystem::FinishFrameTasks()
 {
   EZ_ASSERT_DEV(ezThreadUtils::IsMainThread(), "This function must be executed on the main thread.");
 
+  s_bFinishingFrameTasks = true;
   FinishMainThreadTasks();
+  s_bFinishingFrameTasks = false;
 
   ezUInt32 uiSomeFrameTasks = 0;
 
@@ -313,7 +520,10 @@ void ezTaskSystem::FinishFrameTasks()
     ReprioritizeFrameTasks();
   }
 
-  ExecuteSomeFrameTasks(uiSomeFrameTasks, s_fSmoothFrameMS);
+  if (s_bFramePacingEnabled)
+    ExecuteSomeFrameTasksPaced(uiSomeFrameTasks, s_fSmoothFrameMS);
+  else
+    ExecuteSomeFrameTasks(uiSomeFrameTasks, s_fSmoothFrameMS);
 
   // Update the thread utilization
   {
@@ -335,6 +545,8 @@ void ezTaskSystem::FinishFrameTasks()
       }
     }
   }
+
+  s_FrameStartTime = ezTime::Now();
 }
 
 void ezTaskSystem::WriteStateSnapshotToDGML(ezDGMLGraph& graph)
@@ -361,28 +573,6 @@ void ezTaskSystem::WriteStateSnapshotToDGML(ezDGMLGraph& graph)
   const ezDGMLGraph::PropertyId remainingRunsId = graph.AddPropertyType("RemainingRuns");
   const ezDGMLGraph::PropertyId priorityId = graph.AddPropertyType("GroupPriority");
 
-  const char* szTaskPriorityNames[ezTaskPriority::ENUM_COUNT] = {};
-  szTaskPriorityNames[ezTaskPriority::EarlyThisFrame] = "EarlyThisFrame";
-  szTaskPriorityNames[ezTaskPriority::ThisFrame] = "ThisFrame";
-  szTaskPriorityNames[ezTaskPriority::LateThisFrame] = "LateThisFrame";
-  szTaskPriorityNames[ezTaskPriority::EarlyNextFrame] = "EarlyNextFrame";
-  szTaskPriorityNames[ezTaskPriority::NextFrame] = "NextFrame";
-  szTaskPriorityNames[ezTaskPriority::LateNextFrame] = "LateNextFrame";
-  szTaskPriorityNames[ezTaskPriority::In2Frames] = "In 2 Frames";
-  szTaskPriorityNames[ezTaskPriority::In2Frames] = "In 3 Frames";
-  szTaskPriorityNames[ezTaskPriority::In4Frames] = "In 4 Frames";
-  szTaskPriorityNames[ezTaskPriority::In5Frames] = "In 5 Frames";
-  szTaskPriorityNames[ezTaskPriority::In6Frames] = "In 6 Frames";
-  szTaskPriorityNames[ezTaskPriority::In7Frames] = "In 7 Frames";
-  szTaskPriorityNames[ezTaskPriority::In8Frames] = "In 8 Frames";
-  szTaskPriorityNames[ezTaskPriority::In9Frames] = "In 9 Frames";
-  szTaskPriorityNames[ezTaskPriority::LongRunningHighPriority] = "LongRunningHighPriority";
-  szTaskPriorityNames[ezTaskPriority::LongRunning] = "LongRunning";
-  szTaskPriorityNames[ezTaskPriority::FileAccessHighPriority] = "FileAccessHighPriority";
-  szTaskPriorityNames[ezTaskPriority::FileAccess] = "FileAccess";
-  szTaskPriorityNames[ezTaskPriority::ThisFrameMainThread] = "ThisFrameMainThread";
-  szTaskPriorityNames[ezTaskPriority::SomeFrameMainThread] = "SomeFrameMainThread";
-
   for (ezUInt32 g = 0; g < s_TaskGroups.GetCount(); ++g)
   {
     const ezTaskGroup& tg = s_TaskGroups[g];
@@ -396,7 +586,7 @@ void ezTaskSystem::WriteStateSnapshotToDGML(ezDGMLGraph& graph)
     groupNodeIds[&tg] = taskGroupId;
 
     graph.AddNodeProperty(taskGroupId, startedByUserId, tg.m_bStartedByUser ? "true" : "false");
-    graph.AddNodeProperty(taskGroupId, priorityId, szTaskPriorityNames[tg.m_Priority]);
+    graph.AddNodeProperty(taskGroupId, priorityId, GetTaskPriorityName(tg.m_Priority));
     graph.AddNodeProperty(taskGroupId, activeDepsId, ezFmt("{}", tg.m_iActiveDependencies));
 
     for (ezUInt32 t = 0; t < tg.m_Tasks.GetCount(); ++t)
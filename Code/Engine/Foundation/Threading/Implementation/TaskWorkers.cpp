@@ -152,6 +152,8 @@ ezUInt32 ezTaskWorkerThread::Run()
 
   m_bExecutingTask = false;
 
+  const bool bIsBackgroundWorker = m_WorkerType == ezWorkerThreadType::LongTasks || m_WorkerType == ezWorkerThreadType::FileAccess;
+
   while (m_bActive)
   {
     if (!m_bExecutingTask)
@@ -160,6 +162,23 @@ ezUInt32 ezTaskWorkerThread::Run()
       m_StartedWorking = ezTime::Now();
     }
 
+    if (bIsBackgroundWorker && ezTaskSystem::ShouldThrottleBackgroundWork())
+    {
+      // the tasks for this frame might miss their deadline, so don't compete with them for CPU time
+      // long task threads may do default work, so they can help finishing the frame instead
+      if (m_WorkerType == ezWorkerThreadType::LongTasks &&
+          ezTaskSystem::ExecuteTask(ezTaskPriority::EarlyThisFrame, ezTaskPriority::LateThisFrame))
+      {
+        m_iTasksExecutionCounter.Increment();
+        continue;
+      }
+
+      m_ThreadActiveTime += ezTime::Now() - m_StartedWorking;
+      m_bExecutingTask = false;
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+      continue;
+    }
+
     if (!ezTaskSystem::ExecuteTask(FirstPriority, LastPriority))
     {
       // if no work is currently available, wait for the signal that new work has been added
@@ -193,16 +193,31 @@ bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriorit
   if (td.m_pTask == nullptr)
     return false;
 
+  ExecuteTaskData(td);
+  return true;
+}
+
+void ezTaskSystem::ExecuteTaskData(const TaskData& td)
+{
   s_currentRunningTask.PushBack(td.m_pTask);
 
-  td.m_pTask->Run(td.m_uiInvocation);
+  if (s_bInstrumentationEnabled)
+  {
+    const ezTime startTime = ezTime::Now();
+    td.m_pTask->Run(td.m_uiInvocation);
+
+    // must happen before TaskHasFinished(), which may deallocate the task
+    RecordTaskExecution(td, startTime, ezTime::Now());
+  }
+  else
+  {
+    td.m_pTask->Run(td.m_uiInvocation);
+  }
 
   s_currentRunningTask.PopBack();
 
   // notify the group, that a task is finished, which might trigger other tasks to be executed
   TaskHasFinished(td.m_pTask, td.m_pBelongsToGroup);
-
-  return true;
 }
 
 void ezTaskSystem::WaitForTask(ezTask* pTask)
@@ -2,6 +2,7 @@
 
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Threading/Thread.h>
+#include <Foundation/Utilities/Metrics.h>
 
 ezEvent<const ezThreadEvent&, ezNoMutex> ezThread::s_ThreadEvents;
 
@@ -58,6 +59,7 @@ ezUInt32 RunThread(ezThread* pThread)
   pThread->m_ThreadStatus = ezThread::Finished;
 
   ezProfilingSystem::RemoveThread();
+  ezMetrics::RemoveThread();
 
   return uiReturnCode;
 }
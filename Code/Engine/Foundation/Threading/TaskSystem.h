@@ -250,6 +250,32 @@ public:
   /// \see FinishFrameTasks() for more details.
   static void SetTargetFrameTime(double fSmoothFrameMS = 1000.0 / 40.0 /* 40 FPS -> 25 ms */);
 
+  /// \brief Enables the frame pacing scheduler. It is disabled by default.
+  ///
+  /// With frame pacing, FinishFrameTasks() learns how long each type of 'SomeFrameMainThread' task takes (identified by its task name)
+  /// and only executes those tasks that are expected to fit into what is left of the target frame time. Tasks that are too expensive
+  /// for the current frame are postponed, cheaper tasks that were queued after them may run instead. If a frame never has enough time
+  /// left, one task is executed every few frames nonetheless, to guarantee progress.
+  ///
+  /// Additionally background work is throttled, while the tasks for this frame are at risk of missing the deadline. That is the case
+  /// when 'this frame' tasks are still queued and either the main thread is already waiting for them in FinishFrameTasks(), or the
+  /// frame has used up more than the throttle threshold of the target frame time. During that time, threads for long running tasks
+  /// help with the 'this frame' tasks instead of starting new long running tasks, and the file access thread does not start new tasks.
+  /// Tasks that are already running are not interrupted.
+  static void SetFramePacingEnabled(bool bEnabled);
+
+  /// \brief Whether SetFramePacingEnabled() was called with true.
+  static bool IsFramePacingEnabled() { return s_bFramePacingEnabled; }
+
+  /// \brief Sets the fraction of the target frame time after which background work is throttled, as long as 'this frame' tasks are
+  /// still queued. The default is 0.75. Only has an effect when frame pacing is enabled.
+  static void SetBackgroundThrottleThreshold(double fFractionOfFrameTime);
+
+  /// \brief Returns the average duration of the last executions of tasks with the given name, as learned by the frame pacing scheduler.
+  ///
+  /// Returns zero, if no such task has been executed on the main thread while frame pacing was enabled.
+  static ezTime GetEstimatedTaskCost(const char* szTaskName);
+
   /// \brief Call this function once at the end of a frame. It will ensure that all tasks for 'this frame' get finished properly.
   ///
   /// Calling this function is crucial for several reasons. It is the central function to execute 'main thread' tasks.
@@ -334,6 +360,17 @@ public:
   /// ":appdata/TaskGraphs/__date__.dgml"
   static void WriteStateSnapshotToFile(const char* szPath = nullptr);
 
+  /// \brief Enables recording of per-task latencies and run times as well as of the queue depths.
+  ///
+  /// This is off by default. While enabled, every task execution additionally queries the time twice and updates ezMetrics entries of the
+  /// executing thread. Per task name and priority these are the counters 'TaskSystem/Tasks/<name> (<priority>)/Executions' and
+  /// '.../Helped', and the histograms '.../LatencyUS' and '.../RunTimeUS'. Per priority the histogram 'TaskSystem/Queues/<priority>/Depth'
+  /// records the queue length whenever tasks are added. They are published together with all other metrics by ezMetrics::Snapshot().
+  static void SetInstrumentationEnabled(bool bEnabled);
+
+  /// \brief Whether SetInstrumentationEnabled() was called with true.
+  static bool IsInstrumentationEnabled() { return s_bInstrumentationEnabled; }
+
   /// \brief Checks whether the given task is currently being executed on the calling thread.
   ///
   /// Can be used to prevent waiting on tasks that can never be finished, because the current thread is already executing them.
@@ -352,6 +389,7 @@ private:
     ezTask* m_pTask;
     ezTaskGroup* m_pBelongsToGroup;
     ezUInt32 m_uiInvocation = 0;
+    ezTime m_ScheduleTime; // only set while instrumentation is enabled
   };
 
   // The arrays of all the active worker threads.
@@ -378,6 +416,9 @@ private:
   // Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, ezTask* pPrioritizeThis = nullptr);
 
+  // Executes the given task, which has already been removed from the queues, and notifies its group afterwards.
+  static void ExecuteTaskData(const TaskData& td);
+
   // Ensures all 'main thread' tasks for this frame are finished ('ThisFrameMainThread').
   static void FinishMainThreadTasks();
 
@@ -388,12 +429,27 @@ private:
   // fSmoothFrameMS.
   static void ExecuteSomeFrameTasks(ezUInt32 uiSomeFrameTasks, double fSmoothFrameMS);
 
+  // Frame pacing variant of ExecuteSomeFrameTasks(), only executes tasks whose estimated cost fits into the remaining frame time.
+  static void ExecuteSomeFrameTasksPaced(ezUInt32 uiSomeFrameTasks, double fSmoothFrameMS);
+
+  // Removes the first 'SomeFrameMainThread' task from the queue whose estimated cost is not larger than \a MaxCost.
+  static TaskData GetNextSomeFrameTask(ezTime MaxCost);
+
+  // Whether threads for background work should currently not start new background tasks, see SetFramePacingEnabled().
+  static bool ShouldThrottleBackgroundWork();
+
   // Figures out the range of tasks that this thread may execute when it has free cycles to help out.
   // Uses a thread local variable to know whether this is the main thread / loading thread / long running thread and thus also decides
   // whether the thread is allowed to fall back to 'default' work (short tasks).
   static void DetermineTasksToExecuteOnThread(
     ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority, bool& out_bAllowDefaultWork);
 
+  // Adds the timings of one task execution to the metrics of that task.
+  static void RecordTaskExecution(const TaskData& td, ezTime startTime, ezTime endTime);
+
+  // Adds the current length of a queue to its metric.
+  static void RecordQueueDepth(ezTaskPriority::Enum priority, ezUInt32 uiDepth);
+
   template<typename ElemType>
   static void ParallelForInternal(ezArrayPtr<ElemType> taskItems, ParallelForFunction<ElemType> taskCallback, const char* taskName, ParallelForParams config);
 
@@ -414,6 +470,21 @@ private:
 
   // The target frame time used by FinishFrameTasks()
   static double s_fSmoothFrameMS;
+
+  // Whether the frame pacing scheduler is used.
+  static bool s_bFramePacingEnabled;
+
+  // The fraction of s_fSmoothFrameMS after which background work is throttled.
+  static double s_fBackgroundThrottleThreshold;
+
+  // The time at which FinishFrameTasks() returned the last time, i.e. when the current frame started.
+  static ezTime s_FrameStartTime;
+
+  // Set while the main thread waits for the 'this frame' tasks in FinishFrameTasks().
+  static volatile bool s_bFinishingFrameTasks;
+
+  // Whether task timings and queue depths are recorded.
+  static bool s_bInstrumentationEnabled;
 };
 
 #include <Foundation/Threading/Implementation/ParallelFor_inl.h>
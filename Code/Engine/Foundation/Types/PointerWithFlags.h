@@ -90,6 +90,12 @@ public:
     SetPtr(ptr);
   }
 
+  /// \brief Compares the pointer part for equality (flags are ignored)
+  bool operator==(const ezPointerWithFlags<PtrType, NumFlagBits>& other) const { return GetPtr() == other.GetPtr(); }
+
+  /// \brief Compares the pointer part for inequality (flags are ignored)
+  bool operator!=(const ezPointerWithFlags<PtrType, NumFlagBits>& other) const { return !(*this == other); }
+
   /// \brief Compares the pointer part for equality (flags are ignored)
   bool operator==(const PtrType* ptr) const { return GetPtr() == ptr; }
 
@@ -0,0 +1,378 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+struct ezMetricsThreadStorage
+{
+  enum
+  {
+    MaxSlots = 4096
+  };
+
+  // only the owning thread adds to these, Snapshot() takes the values out with an atomic exchange
+  ezAtomicInteger64 m_Slots[MaxSlots];
+};
+
+namespace
+{
+  enum MetricType
+  {
+    Counter,
+    Gauge,
+    Histogram,
+  };
+
+  enum
+  {
+    HistogramSumSlot = ezMetrics::NumHistogramBuckets,
+    HistogramMaxSlot = ezMetrics::NumHistogramBuckets + 1,
+    NumHistogramSlots = ezMetrics::NumHistogramBuckets + 2,
+  };
+
+  struct MetricDesc
+  {
+    ezString m_sName;
+    MetricType m_Type = Counter;
+    ezUInt32 m_uiFirstSlot = 0;
+    ezUInt32 m_uiNumSlots = 0;
+  };
+
+  static ezMutex s_MetricsMutex;
+  static ezDeque<MetricDesc> s_Metrics;
+  static ezHashTable<ezString, ezUInt32> s_MetricsByName;
+  static ezUInt32 s_uiNextSlot = 0;
+
+  // the values drained from the thread storages, only accessed while s_MetricsMutex is held
+  static ezInt64 s_Aggregated[ezMetricsThreadStorage::MaxSlots];
+
+  // gauges are not per thread, the double value is stored bitwise
+  static ezAtomicInteger64 s_Gauges[ezMetricsThreadStorage::MaxSlots];
+
+  static ezDynamicArray<ezMetricsThreadStorage*> s_AllThreadStorages;
+  static ezDynamicArray<ezMetricsThreadStorage*> s_FreeThreadStorages;
+  static thread_local ezMetricsThreadStorage* s_pThreadStorage = nullptr;
+
+  static ezTime s_SnapshotInterval = ezTime::Milliseconds(100);
+  static ezTime s_LastSnapshot;
+
+  ezMetricsThreadStorage* GetThreadStorage()
+  {
+    ezMetricsThreadStorage* pStorage = s_pThreadStorage;
+
+    if (pStorage == nullptr)
+    {
+      EZ_LOCK(s_MetricsMutex);
+
+      if (!s_FreeThreadStorages.IsEmpty())
+      {
+        pStorage = s_FreeThreadStorages.PeekBack();
+        s_FreeThreadStorages.PopBack();
+      }
+      else
+      {
+        pStorage = EZ_DEFAULT_NEW(ezMetricsThreadStorage);
+      }
+
+      s_AllThreadStorages.PushBack(pStorage);
+      s_pThreadStorage = pStorage;
+    }
+
+    return pStorage;
+  }
+
+  void DrainThreadStorage(ezMetricsThreadStorage* pStorage)
+  {
+    for (const MetricDesc& desc : s_Metrics)
+    {
+      if (desc.m_Type == Gauge)
+        continue;
+
+      for (ezUInt32 i = desc.m_uiFirstSlot; i < desc.m_uiFirstSlot + desc.m_uiNumSlots; ++i)
+      {
+        if (desc.m_Type == Histogram && i == desc.m_uiFirstSlot + HistogramMaxSlot)
+        {
+          s_Aggregated[i] = ezMath::Max(s_Aggregated[i], pStorage->m_Slots[i].Set(0));
+        }
+        else
+        {
+          s_Aggregated[i] += pStorage->m_Slots[i].Set(0);
+        }
+      }
+    }
+  }
+
+  ezUInt32 GetHistogramBucket(ezUInt64 uiValue)
+  {
+    if (uiValue == 0)
+      return 0;
+
+    const ezUInt32 uiHigh = static_cast<ezUInt32>(uiValue >> 32);
+    if (uiHigh != 0)
+      return 33 + ezMath::FirstBitHigh(uiHigh);
+
+    return 1 + ezMath::FirstBitHigh(static_cast<ezUInt32>(uiValue));
+  }
+
+  ezUInt64 GetHistogramPercentile(const ezInt64* pBuckets, ezInt64 iCount, double fPercentile)
+  {
+    const ezInt64 iRank = ezMath::Max<ezInt64>(1, static_cast<ezInt64>(ezMath::Ceil(iCount * fPercentile)));
+
+    ezInt64 iSum = 0;
+    for (ezUInt32 b = 0; b < ezMetrics::NumHistogramBuckets; ++b)
+    {
+      iSum += pBuckets[b];
+
+      if (iSum >= iRank)
+      {
+        // upper bound of the bucket
+        return (b == 0) ? 0 : (b == 64) ? 0xFFFFFFFFFFFFFFFFull : ((1ull << b) - 1);
+      }
+    }
+
+    return 0;
+  }
+
+  struct PublishedValue
+  {
+    ezString m_sName;
+    ezVariant m_Value;
+  };
+} // namespace
+
+// static
+ezMetricHandle ezMetrics::Register(const char* szName, ezUInt32 uiType, ezUInt32 uiNumSlots)
+{
+  EZ_LOCK(s_MetricsMutex);
+
+  ezMetricHandle handle;
+
+  ezUInt32 uiIndex = 0;
+  if (s_MetricsByName.TryGetValue(szName, uiIndex))
+  {
+    const MetricDesc& desc = s_Metrics[uiIndex];
+    EZ_ASSERT_DEV(static_cast<ezUInt32>(desc.m_Type) == uiType, "Metric '{0}' was already registered with a different type", szName);
+
+    if (static_cast<ezUInt32>(desc.m_Type) == uiType)
+    {
+      handle.m_uiMetric = uiIndex;
+      handle.m_uiFirstSlot = desc.m_uiFirstSlot;
+    }
+
+    return handle;
+  }
+
+  if (s_uiNextSlot + uiNumSlots > ezMetricsThreadStorage::MaxSlots)
+  {
+    ezLog::Error("Cannot register metric '{0}', the maximum number of metrics is reached", szName);
+    return handle;
+  }
+
+  uiIndex = s_Metrics.GetCount();
+
+  MetricDesc& desc = s_Metrics.ExpandAndGetRef();
+  desc.m_sName = szName;
+  desc.m_Type = static_cast<MetricType>(uiType);
+  desc.m_uiFirstSlot = s_uiNextSlot;
+  desc.m_uiNumSlots = uiNumSlots;
+
+  s_uiNextSlot += uiNumSlots;
+  s_MetricsByName.Insert(desc.m_sName, uiIndex);
+
+  handle.m_uiMetric = uiIndex;
+  handle.m_uiFirstSlot = desc.m_uiFirstSlot;
+  return handle;
+}
+
+// static
+ezMetricHandle ezMetrics::RegisterCounter(const char* szName)
+{
+  return Register(szName, Counter, 1);
+}
+
+// static
+ezMetricHandle ezMetrics::RegisterGauge(const char* szName)
+{
+  return Register(szName, Gauge, 1);
+}
+
+// static
+ezMetricHandle ezMetrics::RegisterHistogram(const char* szName)
+{
+  return Register(szName, Histogram, NumHistogramSlots);
+}
+
+// static
+void ezMetrics::Increment(ezMetricHandle hCounter, ezInt64 iValue)
+{
+  if (!hCounter.IsValid())
+    return;
+
+  GetThreadStorage()->m_Slots[hCounter.m_uiFirstSlot].Add(iValue);
+}
+
+// static
+void ezMetrics::SetGauge(ezMetricHandle hGauge, double fValue)
+{
+  if (!hGauge.IsValid())
+    return;
+
+  ezInt64 iBits;
+  ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&iBits), reinterpret_cast<const ezUInt8*>(&fValue), sizeof(double));
+
+  s_Gauges[hGauge.m_uiFirstSlot].Set(iBits);
+}
+
+// static
+void ezMetrics::Record(ezMetricHandle hHistogram, ezUInt64 uiValue)
+{
+  if (!hHistogram.IsValid())
+    return;
+
+  ezAtomicInteger64* pSlots = &GetThreadStorage()->m_Slots[hHistogram.m_uiFirstSlot];
+
+  pSlots[GetHistogramBucket(uiValue)].Increment();
+  pSlots[HistogramSumSlot].Add(static_cast<ezInt64>(uiValue));
+
+  // this thread is the only writer, but Snapshot() may reset the value in between, in that case the sample only counts for the next
+  // interval
+  if (static_cast<ezInt64>(uiValue) > pSlots[HistogramMaxSlot])
+  {
+    pSlots[HistogramMaxSlot].Set(static_cast<ezInt64>(uiValue));
+  }
+}
+
+// static
+void ezMetrics::Update()
+{
+  const ezTime now = ezTime::Now();
+
+  if (now - s_LastSnapshot < s_SnapshotInterval)
+    return;
+
+  s_LastSnapshot = now;
+  Snapshot();
+}
+
+// static
+void ezMetrics::Snapshot()
+{
+  ezDynamicArray<PublishedValue> values;
+
+  {
+    EZ_LOCK(s_MetricsMutex);
+
+    for (ezMetricsThreadStorage* pStorage : s_AllThreadStorages)
+    {
+      DrainThreadStorage(pStorage);
+    }
+
+    values.Reserve(s_Metrics.GetCount());
+
+    ezStringBuilder sName;
+
+    for (const MetricDesc& desc : s_Metrics)
+    {
+      if (desc.m_Type == Counter)
+      {
+        auto& value = values.ExpandAndGetRef();
+        value.m_sName = desc.m_sName;
+        value.m_Value = s_Aggregated[desc.m_uiFirstSlot];
+      }
+      else if (desc.m_Type == Gauge)
+      {
+        const ezInt64 iBits = s_Gauges[desc.m_uiFirstSlot];
+
+        double fValue;
+        ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&fValue), reinterpret_cast<const ezUInt8*>(&iBits), sizeof(double));
+
+        auto& value = values.ExpandAndGetRef();
+        value.m_sName = desc.m_sName;
+        value.m_Value = fValue;
+      }
+      else
+      {
+        ezInt64* pSlots = &s_Aggregated[desc.m_uiFirstSlot];
+
+        ezInt64 iCount = 0;
+        for (ezUInt32 b = 0; b < NumHistogramBuckets; ++b)
+        {
+          iCount += pSlots[b];
+        }
+
+        sName.Set(desc.m_sName, "/Count");
+        auto& count = values.ExpandAndGetRef();
+        count.m_sName = sName;
+        count.m_Value = iCount;
+
+        if (iCount > 0)
+        {
+          sName.Set(desc.m_sName, "/Mean");
+          auto& mean = values.ExpandAndGetRef();
+          mean.m_sName = sName;
+          mean.m_Value = static_cast<double>(pSlots[HistogramSumSlot]) / iCount;
+
+          const double fPercentiles[] = {0.5, 0.9, 0.99};
+          const char* szPercentiles[] = {"/P50", "/P90", "/P99"};
+
+          for (ezUInt32 p = 0; p < EZ_ARRAY_SIZE(fPercentiles); ++p)
+          {
+            // the bucket bound may be larger than anything that was recorded
+            const ezUInt64 uiPercentile = GetHistogramPercentile(pSlots, iCount, fPercentiles[p]);
+
+            sName.Set(desc.m_sName, szPercentiles[p]);
+            auto& percentile = values.ExpandAndGetRef();
+            percentile.m_sName = sName;
+            percentile.m_Value = ezMath::Min(uiPercentile, static_cast<ezUInt64>(pSlots[HistogramMaxSlot]));
+          }
+
+          sName.Set(desc.m_sName, "/Max");
+          auto& max = values.ExpandAndGetRef();
+          max.m_sName = sName;
+          max.m_Value = pSlots[HistogramMaxSlot];
+        }
+
+        // histograms only show the values of the last interval
+        ezMemoryUtils::ZeroFill(pSlots, desc.m_uiNumSlots);
+      }
+    }
+  }
+
+  // ezStats takes its own lock and broadcasts events, which must not happen while s_MetricsMutex is held
+  for (const PublishedValue& value : values)
+  {
+    ezStats::SetStat(value.m_sName.GetData(), value.m_Value);
+  }
+}
+
+// static
+void ezMetrics::SetSnapshotInterval(ezTime interval)
+{
+  s_SnapshotInterval = interval;
+}
+
+// static
+void ezMetrics::RemoveThread()
+{
+  ezMetricsThreadStorage* pStorage = s_pThreadStorage;
+
+  if (pStorage == nullptr)
+    return;
+
+  s_pThreadStorage = nullptr;
+
+  EZ_LOCK(s_MetricsMutex);
+
+  DrainThreadStorage(pStorage);
+
+  s_AllThreadStorages.RemoveAndSwap(pStorage);
+  s_FreeThreadStorages.PushBack(pStorage);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Utilities_Implementation_Metrics);
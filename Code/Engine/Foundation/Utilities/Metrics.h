@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Time/Time.h>
+
+/// \brief Identifies a metric that was registered with ezMetrics.
+///
+/// Handles stay valid for the lifetime of the application, so they are typically stored in a static variable.
+class ezMetricHandle
+{
+public:
+  EZ_ALWAYS_INLINE bool IsValid() const { return m_uiFirstSlot != ezInvalidIndex; }
+
+private:
+  friend class ezMetrics;
+
+  ezUInt32 m_uiMetric = ezInvalidIndex;
+  ezUInt32 m_uiFirstSlot = ezInvalidIndex;
+};
+
+/// \brief A registry for counters, gauges and histograms that can be updated from hot code paths at very low cost.
+///
+/// Contrary to ezStats, metrics are registered once and then updated through their handle. Updating a metric never takes a lock and
+/// never does a lookup. Counters and histograms are accumulated in per-thread storage, gauges are a single atomic value.
+///
+/// Snapshot() aggregates the values of all threads and publishes them through ezStats, which in turn forwards them to ezTelemetry.
+/// Update() does the same, but at most once per snapshot interval, and is meant to be called once per frame.
+///
+/// Counters are published as their total since they were registered. Histograms are published per snapshot interval, as
+/// 'Name/Count', 'Name/Mean', 'Name/P50', 'Name/P90', 'Name/P99' and 'Name/Max'. Their buckets have power-of-two boundaries, so the
+/// percentiles are an upper bound that is at most twice the real value.
+class EZ_FOUNDATION_DLL ezMetrics
+{
+public:
+  /// \brief Registers a counter with the given name. Registering the same name multiple times returns the same handle.
+  static ezMetricHandle RegisterCounter(const char* szName);
+
+  /// \brief Registers a gauge with the given name. Registering the same name multiple times returns the same handle.
+  static ezMetricHandle RegisterGauge(const char* szName);
+
+  /// \brief Registers a histogram with the given name. Registering the same name multiple times returns the same handle.
+  ///
+  /// The unit of the recorded values is up to the caller, e.g. microseconds or bytes.
+  static ezMetricHandle RegisterHistogram(const char* szName);
+
+  /// \brief Adds iValue to the counter.
+  static void Increment(ezMetricHandle hCounter, ezInt64 iValue = 1);
+
+  /// \brief Sets the value of the gauge.
+  static void SetGauge(ezMetricHandle hGauge, double fValue);
+
+  /// \brief Records one sample in the histogram.
+  static void Record(ezMetricHandle hHistogram, ezUInt64 uiValue);
+
+  /// \brief Calls Snapshot(), if the last snapshot is older than the snapshot interval.
+  static void Update();
+
+  /// \brief Aggregates the values of all threads and publishes them through ezStats.
+  static void Snapshot();
+
+  /// \brief Sets how often Update() publishes the metrics. The default is 100 milliseconds.
+  static void SetSnapshotInterval(ezTime interval);
+
+  /// \brief Moves the values of the current thread into the aggregated values. Called by ezThread before the thread exits.
+  static void RemoveThread();
+
+  enum
+  {
+    NumHistogramBuckets = 65, ///< Bucket 0 holds the value 0, bucket n holds values in the range [2^(n-1), 2^n).
+  };
+
+private:
+  friend struct ezMetricsThreadStorage;
+
+  static ezMetricHandle Register(const char* szName, ezUInt32 uiType, ezUInt32 uiNumSlots);
+};
@@ -12,11 +12,12 @@ struct ezDummyPointType
 static void CompileDummy()
 {
   ezPointOfInterestGraph<ezDummyPointType> graph;
-  graph.Initialize(ezVec3::ZeroVector(), ezVec3::ZeroVector());
+  graph.Initialize();
   auto& pt = graph.AddPoint(ezVec3::ZeroVector());
 
   ezDynamicArray<ezUInt32> points;
   graph.FindPointsOfInterest(ezVec3::ZeroVector(), 0, points);
+  graph.FindNearestPointsOfInterest(ezVec3::ZeroVector(), 1, 0, points);
 }
 
 
@@ -3,10 +3,10 @@
 #include <GameEngine/AI/PointOfInterestGraph.h>
 
 template<typename POINTTYPE>
-void ezPointOfInterestGraph<POINTTYPE>::Initialize(const ezVec3& center, const ezVec3& halfExtents, float cellSize)
+void ezPointOfInterestGraph<POINTTYPE>::Initialize(float fCellSize)
 {
   m_Points.Clear();
-  m_Octree.CreateTree(center, halfExtents, cellSize);
+  m_SpatialHash.Initialize(fCellSize);
 }
 
 template<typename POINTTYPE>
@@ -15,35 +15,26 @@ POINTTYPE& ezPointOfInterestGraph<POINTTYPE>::AddPoint(const ezVec3& position)
   const ezUInt32 id = m_Points.GetCount();
   auto& pt = m_Points.ExpandAndGetRef();
 
-  m_Octree.InsertObject(position, ezVec3::ZeroVector(), 0, id, nullptr, true);
+  m_SpatialHash.Insert(position, id);
 
   return pt;
 }
 
 template<typename POINTTYPE>
-void ezPointOfInterestGraph<POINTTYPE>::FindPointsOfInterest(const ezVec3& position, float radius, ezDynamicArray<ezUInt32>& out_Points) const
+void ezPointOfInterestGraph<POINTTYPE>::FindPointsOfInterest(const ezVec3& position, float radius, ezDynamicArrayBase<ezUInt32>& out_Points) const
 {
-  if (m_Octree.IsEmpty())
-    return;
-
-  struct Data
-  {
-    ezDynamicArray<ezUInt32>* m_pResults;
-  };
-
-  Data data;
-  data.m_pResults = &out_Points;
-
-  auto cb = [](void* pPassThrough, ezDynamicTreeObjectConst Object) -> bool
-  {
-    auto pData = static_cast<Data*>(pPassThrough);
-
-    const ezUInt32 id = (ezUInt32)Object.Value().m_iObjectInstance;
-    pData->m_pResults->PushBack(id);
+  m_SpatialHash.FindInRadius(position, radius, out_Points);
+}
 
-    return true;
-  };
+template<typename POINTTYPE>
+void ezPointOfInterestGraph<POINTTYPE>::FindPointsOfInterest(ezArrayPtr<const ezVec3> positions, float radius, ezDynamicArrayBase<ezUInt32>& out_Points, ezDynamicArrayBase<ezUInt32>& out_QueryStarts) const
+{
+  m_SpatialHash.FindInRadius(positions, radius, out_Points, out_QueryStarts);
+}
 
-  m_Octree.FindObjectsInRange(position, radius, cb, &data);
+template<typename POINTTYPE>
+void ezPointOfInterestGraph<POINTTYPE>::FindNearestPointsOfInterest(const ezVec3& position, ezUInt32 uiMaxCount, float maxRadius, ezDynamicArrayBase<ezUInt32>& out_Points) const
+{
+  m_SpatialHash.FindNearest(position, uiMaxCount, maxRadius, out_Points);
 }
 
@@ -1,25 +1,33 @@
 #pragma once
 
 #include <GameEngine/GameEngineDLL.h>
-#include <Foundation/Math/Vec3.h>
-#include <Utilities/DataStructures/DynamicOctree.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/SpatialHash.h>
 
 template<typename POINTTYPE>
 class ezPointOfInterestGraph
 {
 public:
-  void Initialize(const ezVec3& center, const ezVec3& halfExtents, float cellSize = 1.0f);
+  /// \brief Removes all points. The cell size of the underlying spatial hash should be in the range of the typical query radius.
+  void Initialize(float fCellSize = 4.0f);
 
   POINTTYPE& AddPoint(const ezVec3& position);
 
-  void FindPointsOfInterest(const ezVec3& position, float radius, ezDynamicArray<ezUInt32>& out_Points) const;
+  /// \brief Appends the indices of all points within the given radius to out_Points.
+  void FindPointsOfInterest(const ezVec3& position, float radius, ezDynamicArrayBase<ezUInt32>& out_Points) const;
+
+  /// \brief Executes one radius query per position. See ezSpatialHash::FindInRadius() for the layout of the results.
+  void FindPointsOfInterest(ezArrayPtr<const ezVec3> positions, float radius, ezDynamicArrayBase<ezUInt32>& out_Points, ezDynamicArrayBase<ezUInt32>& out_QueryStarts) const;
+
+  /// \brief Appends the indices of up to uiMaxCount points that are closest to the given position, sorted by distance.
+  void FindNearestPointsOfInterest(const ezVec3& position, ezUInt32 uiMaxCount, float maxRadius, ezDynamicArrayBase<ezUInt32>& out_Points) const;
 
   const ezDeque<POINTTYPE>& GetPoints() const { return m_Points; }
   ezDeque<POINTTYPE>& AccessPoints() { return m_Points; }
 
 private:
   ezDeque<POINTTYPE> m_Points;
-  ezDynamicOctree m_Octree;
+  ezSpatialHash<ezUInt32> m_SpatialHash;
 };
 
 #include <GameEngine/AI/Implementation/PointOfInterestGraph_inl.h>
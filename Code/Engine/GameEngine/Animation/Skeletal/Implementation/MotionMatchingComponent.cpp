@@ -97,12 +97,20 @@ void ezMotionMatchingComponent::OnSimulationStarted()
   m_Keyframe1.m_uiAnimClip = 0;
   m_Keyframe1.m_uiKeyframe = 1;
 
-  for (ezUInt32 anim = 0; anim < m_Animations.GetCount(); ++anim)
   {
-    ezResourceLock<ezAnimationClipResource> pClip(m_Animations[anim], ezResourceAcquireMode::BlockTillLoaded);
-    ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+    ezDynamicArray<MotionData> motionData;
 
-    PrecomputeMotion(m_MotionData, "Bip01_L_Foot", "Bip01_R_Foot", pClip->GetDescriptor(), anim, pSkeleton->GetDescriptor().m_Skeleton);
+    for (ezUInt32 anim = 0; anim < m_Animations.GetCount(); ++anim)
+    {
+      ezResourceLock<ezAnimationClipResource> pClip(m_Animations[anim], ezResourceAcquireMode::BlockTillLoaded);
+      ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+
+      PrecomputeMotion(motionData, "Bip01_L_Foot", "Bip01_R_Foot", pClip->GetDescriptor(), anim, pSkeleton->GetDescriptor().m_Skeleton);
+    }
+
+    m_MotionDatabase.Clear();
+    m_MotionDatabase.AddFrames(motionData);
+    m_MotionDatabase.Build();
   }
 
   m_vLeftFootPos.SetZero();
@@ -378,13 +386,18 @@ ezMotionMatchingComponent::TargetKeyframe ezMotionMatchingComponent::FindNextKey
 
     const ezUInt32 uiBestMM = FindBestKeyframe(current, vLeftFootPos, vRightFootPos, vTargetDir);
 
-    TargetKeyframe nkf;
-    nkf.m_uiAnimClip = m_MotionData[uiBestMM].m_uiAnimClipIndex;
-    nkf.m_uiKeyframe = m_MotionData[uiBestMM].m_uiKeyframeIndex;
-
-    if ((nkf.m_uiAnimClip != kf.m_uiAnimClip) || (nkf.m_uiKeyframe != kf.m_uiKeyframe && nkf.m_uiKeyframe != current.m_uiKeyframe))
+    if (uiBestMM != ezInvalidIndex)
     {
-      kf = nkf;
+      const MotionData& md = m_MotionDatabase.GetFrame(uiBestMM);
+
+      TargetKeyframe nkf;
+      nkf.m_uiAnimClip = md.m_uiAnimClipIndex;
+      nkf.m_uiKeyframe = md.m_uiKeyframeIndex;
+
+      if ((nkf.m_uiAnimClip != kf.m_uiAnimClip) || (nkf.m_uiKeyframe != kf.m_uiKeyframe && nkf.m_uiKeyframe != current.m_uiKeyframe))
+      {
+        kf = nkf;
+      }
     }
   }
 
@@ -475,47 +488,14 @@ void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& mot
 ezUInt32 ezMotionMatchingComponent::FindBestKeyframe(const TargetKeyframe& current, ezVec3 vLeftFootPosition, ezVec3 vRightFootPosition,
   ezVec3 vTargetDir) const
 {
-  float fClosest = 1000000000.0f;
-  ezUInt32 uiClosest = 0xFFFFFFFFu;
-
-  const float fDirWeight = 3.0f;
-
-  for (ezUInt32 i = 0; i < m_MotionData.GetCount(); ++i)
-  {
-    const auto& md = m_MotionData[i];
-
-    float penaltyMul = 1.1f;
-    float penaltyAdd = 100;
-
-    if (md.m_uiAnimClipIndex == current.m_uiAnimClip)
-    {
-      // do NOT allow to transition backwards to a keyframe within a certain range
-      if (md.m_uiKeyframeIndex < current.m_uiKeyframe && md.m_uiKeyframeIndex + 10 > current.m_uiKeyframe)
-        continue;
-
-      penaltyMul = 1.0f;
-
-      if (md.m_uiKeyframeIndex == current.m_uiKeyframe)
-      {
-        penaltyAdd = 0;
-        penaltyMul = 0.9f;
-      }
-    }
-
-    const float dirDist = ezMath::Pow((md.m_vRootVelocity - vTargetDir).GetLength(), fDirWeight);
-    const float leftFootDist = (md.m_vLeftFootPosition - vLeftFootPosition).GetLengthSquared();
-    const float rightFootDist = (md.m_vRightFootPosition - vRightFootPosition).GetLengthSquared();
-
-    const float fScore = dirDist + (leftFootDist + rightFootDist) * penaltyMul + penaltyAdd;
-
-    if (fScore < fClosest)
-    {
-      fClosest = fScore;
-      uiClosest = i;
-    }
-  }
-
-  return uiClosest;
+  ezMotionMatchingDatabase::Query query;
+  query.m_uiCurrentAnimClip = current.m_uiAnimClip;
+  query.m_uiCurrentKeyframe = current.m_uiKeyframe;
+  query.m_vLeftFootPosition = vLeftFootPosition;
+  query.m_vRightFootPosition = vRightFootPosition;
+  query.m_vTargetDirection = vTargetDir;
+
+  return m_MotionDatabase.FindBestFrame(query);
 }
 
 
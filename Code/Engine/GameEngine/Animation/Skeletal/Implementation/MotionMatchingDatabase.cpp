@@ -0,0 +1,333 @@
+#include <GameEnginePCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <GameEngine/Animation/Skeletal/MotionMatchingDatabase.h>
+
+namespace
+{
+  // the score of a frame is (rootVelocityDistance ^ 3) + (leftFootDistSqr + rightFootDistSqr) * penaltyMul + penaltyAdd
+  constexpr float s_fSameClipPenaltyMul = 1.0f;
+  constexpr float s_fOtherClipPenaltyMul = 1.1f;
+  constexpr float s_fOtherClipPenaltyAdd = 100.0f;
+  constexpr float s_fSameFramePenaltyMul = 0.9f; // the smallest multiplier, used for the lower bound of tree nodes
+
+  // do NOT allow to transition backwards to a keyframe within a certain range
+  constexpr ezUInt32 s_uiNoBackwardsTransitionRange = 10;
+
+  EZ_ALWAYS_INLINE float GetFeature(const ezMotionMatchingDatabase::Frame& frame, ezUInt32 uiFeature)
+  {
+    if (uiFeature < 3)
+      return frame.m_vLeftFootPosition.GetData()[uiFeature];
+    if (uiFeature < 6)
+      return frame.m_vRightFootPosition.GetData()[uiFeature - 3];
+
+    return frame.m_vRootVelocity.GetData()[uiFeature - 6];
+  }
+
+  /// \brief Applies the clip and keyframe dependent penalties. Returns false, if the frame may not be chosen at all.
+  EZ_ALWAYS_INLINE bool ComputeScore(const ezMotionMatchingDatabase::Frame& frame, const ezMotionMatchingDatabase::Query& query,
+    float fDirDist, float fFootDist, float& out_fScore)
+  {
+    float penaltyMul = s_fOtherClipPenaltyMul;
+    float penaltyAdd = s_fOtherClipPenaltyAdd;
+
+    if (frame.m_uiAnimClipIndex == query.m_uiCurrentAnimClip)
+    {
+      if (frame.m_uiKeyframeIndex < query.m_uiCurrentKeyframe &&
+          frame.m_uiKeyframeIndex + s_uiNoBackwardsTransitionRange > query.m_uiCurrentKeyframe)
+        return false;
+
+      penaltyMul = s_fSameClipPenaltyMul;
+
+      if (frame.m_uiKeyframeIndex == query.m_uiCurrentKeyframe)
+      {
+        penaltyAdd = 0;
+        penaltyMul = s_fSameFramePenaltyMul;
+      }
+    }
+
+    out_fScore = fDirDist + fFootDist * penaltyMul + penaltyAdd;
+    return true;
+  }
+
+  EZ_ALWAYS_INLINE float DistanceToRangeSquared(float fValue, float fMin, float fMax)
+  {
+    const float d = ezMath::Max(ezMath::Max(fMin - fValue, fValue - fMax), 0.0f);
+    return d * d;
+  }
+} // namespace
+
+ezMotionMatchingDatabase::ezMotionMatchingDatabase() = default;
+ezMotionMatchingDatabase::~ezMotionMatchingDatabase() = default;
+
+void ezMotionMatchingDatabase::Clear()
+{
+  m_Frames.Clear();
+  m_Nodes.Clear();
+
+  for (ezUInt32 f = 0; f < NumFeatures; ++f)
+  {
+    m_Features[f].Clear();
+  }
+}
+
+void ezMotionMatchingDatabase::AddFrames(ezArrayPtr<const Frame> frames)
+{
+  m_Frames.PushBackRange(frames);
+
+  // invalidate the search structure
+  m_Nodes.Clear();
+}
+
+void ezMotionMatchingDatabase::Build()
+{
+  m_Nodes.Clear();
+
+  if (m_Frames.IsEmpty())
+    return;
+
+  m_Nodes.Reserve(2 * (m_Frames.GetCount() / (MaxFramesPerLeaf / 2)) + 1);
+  BuildNode(0, m_Frames.GetCount());
+
+  // BuildNode has sorted the frames into tree order, so each leaf references a contiguous range of the SoA arrays.
+  // Leaves are read in blocks of four, so the arrays are padded to allow reading past the last frame.
+  const ezUInt32 uiPaddedCount = m_Frames.GetCount() + 3;
+
+  for (ezUInt32 f = 0; f < NumFeatures; ++f)
+  {
+    m_Features[f].SetCount(uiPaddedCount);
+
+    for (ezUInt32 i = 0; i < m_Frames.GetCount(); ++i)
+    {
+      m_Features[f][i] = GetFeature(m_Frames[i], f);
+    }
+  }
+}
+
+ezUInt32 ezMotionMatchingDatabase::BuildNode(ezUInt32 uiFirstFrame, ezUInt32 uiNumFrames)
+{
+  const ezUInt32 uiNodeIndex = m_Nodes.GetCount();
+
+  {
+    Node& node = m_Nodes.ExpandAndGetRef();
+    node.m_uiFirstFrame = uiFirstFrame;
+    node.m_uiNumFrames = uiNumFrames;
+
+    for (ezUInt32 f = 0; f < NumFeatures; ++f)
+    {
+      node.m_fMin[f] = GetFeature(m_Frames[uiFirstFrame], f);
+      node.m_fMax[f] = node.m_fMin[f];
+    }
+
+    for (ezUInt32 i = uiFirstFrame + 1; i < uiFirstFrame + uiNumFrames; ++i)
+    {
+      for (ezUInt32 f = 0; f < NumFeatures; ++f)
+      {
+        const float value = GetFeature(m_Frames[i], f);
+        node.m_fMin[f] = ezMath::Min(node.m_fMin[f], value);
+        node.m_fMax[f] = ezMath::Max(node.m_fMax[f], value);
+      }
+    }
+  }
+
+  if (uiNumFrames <= MaxFramesPerLeaf)
+    return uiNodeIndex;
+
+  // split along the feature with the largest extent
+  ezUInt32 uiSplitFeature = 0;
+  float fMaxExtent = 0.0f;
+
+  for (ezUInt32 f = 0; f < NumFeatures; ++f)
+  {
+    const float fExtent = m_Nodes[uiNodeIndex].m_fMax[f] - m_Nodes[uiNodeIndex].m_fMin[f];
+    if (fExtent > fMaxExtent)
+    {
+      fMaxExtent = fExtent;
+      uiSplitFeature = f;
+    }
+  }
+
+  // all frames are identical, splitting would not help
+  if (fMaxExtent <= 0.0f)
+    return uiNodeIndex;
+
+  ezArrayPtr<Frame> frames = m_Frames.GetArrayPtr().GetSubArray(uiFirstFrame, uiNumFrames);
+  ezSorting::QuickSort(frames, [uiSplitFeature](const Frame& a, const Frame& b) { return GetFeature(a, uiSplitFeature) < GetFeature(b, uiSplitFeature); });
+
+  const ezUInt32 uiHalf = uiNumFrames / 2;
+  const ezUInt32 uiChild0 = BuildNode(uiFirstFrame, uiHalf);
+  const ezUInt32 uiChild1 = BuildNode(uiFirstFrame + uiHalf, uiNumFrames - uiHalf);
+
+  m_Nodes[uiNodeIndex].m_uiChild0 = uiChild0;
+  m_Nodes[uiNodeIndex].m_uiChild1 = uiChild1;
+
+  return uiNodeIndex;
+}
+
+float ezMotionMatchingDatabase::ComputeLowerBound(const Node& node, const Query& query) const
+{
+  float fFootDist = 0.0f;
+  float fDirDistSqr = 0.0f;
+
+  for (ezUInt32 i = 0; i < 3; ++i)
+  {
+    fFootDist += DistanceToRangeSquared(query.m_vLeftFootPosition.GetData()[i], node.m_fMin[i], node.m_fMax[i]);
+    fFootDist += DistanceToRangeSquared(query.m_vRightFootPosition.GetData()[i], node.m_fMin[3 + i], node.m_fMax[3 + i]);
+    fDirDistSqr += DistanceToRangeSquared(query.m_vTargetDirection.GetData()[i], node.m_fMin[6 + i], node.m_fMax[6 + i]);
+  }
+
+  return fDirDistSqr * ezMath::Sqrt(fDirDistSqr) + fFootDist * s_fSameFramePenaltyMul;
+}
+
+void ezMotionMatchingDatabase::EvaluateLeaf(const Node& node, const Query& query, float& inout_fBestScore, ezUInt32& inout_uiBestFrame) const
+{
+  const ezSimdVec4f vLeftX(query.m_vLeftFootPosition.x);
+  const ezSimdVec4f vLeftY(query.m_vLeftFootPosition.y);
+  const ezSimdVec4f vLeftZ(query.m_vLeftFootPosition.z);
+  const ezSimdVec4f vRightX(query.m_vRightFootPosition.x);
+  const ezSimdVec4f vRightY(query.m_vRightFootPosition.y);
+  const ezSimdVec4f vRightZ(query.m_vRightFootPosition.z);
+  const ezSimdVec4f vDirX(query.m_vTargetDirection.x);
+  const ezSimdVec4f vDirY(query.m_vTargetDirection.y);
+  const ezSimdVec4f vDirZ(query.m_vTargetDirection.z);
+
+  const ezUInt32 uiEnd = node.m_uiFirstFrame + node.m_uiNumFrames;
+
+  EZ_ALIGN_16(float fDirDist[4]);
+  EZ_ALIGN_16(float fFootDist[4]);
+
+  for (ezUInt32 i = node.m_uiFirstFrame; i < uiEnd; i += 4)
+  {
+    ezSimdVec4f x, y, z;
+
+    x.Load<4>(m_Features[0].GetData() + i);
+    y.Load<4>(m_Features[1].GetData() + i);
+    z.Load<4>(m_Features[2].GetData() + i);
+    x -= vLeftX;
+    y -= vLeftY;
+    z -= vLeftZ;
+    ezSimdVec4f foot = ezSimdVec4f::MulAdd(x, x, ezSimdVec4f::MulAdd(y, y, z.CompMul(z)));
+
+    x.Load<4>(m_Features[3].GetData() + i);
+    y.Load<4>(m_Features[4].GetData() + i);
+    z.Load<4>(m_Features[5].GetData() + i);
+    x -= vRightX;
+    y -= vRightY;
+    z -= vRightZ;
+    foot = ezSimdVec4f::MulAdd(x, x, ezSimdVec4f::MulAdd(y, y, ezSimdVec4f::MulAdd(z, z, foot)));
+
+    x.Load<4>(m_Features[6].GetData() + i);
+    y.Load<4>(m_Features[7].GetData() + i);
+    z.Load<4>(m_Features[8].GetData() + i);
+    x -= vDirX;
+    y -= vDirY;
+    z -= vDirZ;
+    const ezSimdVec4f dirSqr = ezSimdVec4f::MulAdd(x, x, ezSimdVec4f::MulAdd(y, y, z.CompMul(z)));
+    const ezSimdVec4f dir = dirSqr.CompMul(dirSqr.GetSqrt());
+
+    dir.Store<4>(fDirDist);
+    foot.Store<4>(fFootDist);
+
+    const ezUInt32 uiNumLanes = ezMath::Min(4u, uiEnd - i);
+    for (ezUInt32 lane = 0; lane < uiNumLanes; ++lane)
+    {
+      float fScore;
+      if (ComputeScore(m_Frames[i + lane], query, fDirDist[lane], fFootDist[lane], fScore) && fScore < inout_fBestScore)
+      {
+        inout_fBestScore = fScore;
+        inout_uiBestFrame = i + lane;
+      }
+    }
+  }
+}
+
+ezUInt32 ezMotionMatchingDatabase::FindBestFrame(const Query& query) const
+{
+  EZ_ASSERT_DEBUG(IsBuilt(), "ezMotionMatchingDatabase::Build() has to be called before making queries");
+
+  float fBestScore = ezMath::MaxValue<float>();
+  ezUInt32 uiBestFrame = ezInvalidIndex;
+
+  if (m_Nodes.IsEmpty())
+    return uiBestFrame;
+
+  ezHybridArray<ezUInt32, 64> stack;
+  stack.PushBack(0);
+
+  while (!stack.IsEmpty())
+  {
+    const Node& node = m_Nodes[stack.PeekBack()];
+    stack.PopBack();
+
+    if (ComputeLowerBound(node, query) >= fBestScore)
+      continue;
+
+    if (node.m_uiChild0 == ezInvalidIndex)
+    {
+      EvaluateLeaf(node, query, fBestScore, uiBestFrame);
+      continue;
+    }
+
+    // visit the more promising child first, so that the other one is more likely to be culled
+    const float fBound0 = ComputeLowerBound(m_Nodes[node.m_uiChild0], query);
+    const float fBound1 = ComputeLowerBound(m_Nodes[node.m_uiChild1], query);
+
+    if (fBound0 < fBound1)
+    {
+      stack.PushBack(node.m_uiChild1);
+      stack.PushBack(node.m_uiChild0);
+    }
+    else
+    {
+      stack.PushBack(node.m_uiChild0);
+      stack.PushBack(node.m_uiChild1);
+    }
+  }
+
+  return uiBestFrame;
+}
+
+void ezMotionMatchingDatabase::FindBestFrames(ezArrayPtr<const Query> queries, ezArrayPtr<ezUInt32> out_Results) const
+{
+  EZ_ASSERT_DEV(queries.GetCount() == out_Results.GetCount(), "Number of queries ({}) and results ({}) does not match", queries.GetCount(), out_Results.GetCount());
+
+  ezTaskSystem::ParallelForParams params;
+  params.uiBinSize = 16;
+
+  ezTaskSystem::ParallelForIndexed(0, queries.GetCount(),
+    [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        out_Results[i] = FindBestFrame(queries[i]);
+      }
+    },
+    "MotionMatchingQueries", params);
+}
+
+ezUInt32 ezMotionMatchingDatabase::FindBestFrameBruteForce(const Query& query) const
+{
+  float fBestScore = ezMath::MaxValue<float>();
+  ezUInt32 uiBestFrame = ezInvalidIndex;
+
+  for (ezUInt32 i = 0; i < m_Frames.GetCount(); ++i)
+  {
+    const Frame& frame = m_Frames[i];
+
+    const float fDirDist = ezMath::Pow((frame.m_vRootVelocity - query.m_vTargetDirection).GetLength(), 3.0f);
+    const float fFootDist = (frame.m_vLeftFootPosition - query.m_vLeftFootPosition).GetLengthSquared() +
+                            (frame.m_vRightFootPosition - query.m_vRightFootPosition).GetLengthSquared();
+
+    float fScore;
+    if (ComputeScore(frame, query, fDirDist, fFootDist, fScore) && fScore < fBestScore)
+    {
+      fBestScore = fScore;
+      uiBestFrame = i;
+    }
+  }
+
+  return uiBestFrame;
+}
+
+EZ_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_MotionMatchingDatabase);
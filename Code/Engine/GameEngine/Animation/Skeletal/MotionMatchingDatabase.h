@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Vec3.h>
+#include <GameEngine/GameEngineDLL.h>
+
+/// \brief Stores the motion features of all keyframes of a set of animation clips and finds the best matching keyframe for a given
+/// character state.
+///
+/// Frames are added through AddFrames() and afterwards Build() must be called once. Build() sorts the frames into a bounding volume
+/// tree over the feature space and stores the features of each leaf in SoA layout, so that a query only needs to evaluate the
+/// leaves whose bounds can still beat the best candidate found so far. Leaves are evaluated four frames at a time with ezSimdVec4f.
+///
+/// The score that is minimized is the same one the motion matching component always used, so the result is identical to a brute
+/// force search over all frames (apart from ties).
+class EZ_GAMEENGINE_DLL ezMotionMatchingDatabase
+{
+public:
+  struct Frame
+  {
+    ezUInt16 m_uiAnimClipIndex;
+    ezUInt16 m_uiKeyframeIndex;
+    ezVec3 m_vLeftFootPosition;
+    ezVec3 m_vLeftFootVelocity;
+    ezVec3 m_vRightFootPosition;
+    ezVec3 m_vRightFootVelocity;
+    ezVec3 m_vRootVelocity;
+  };
+
+  struct Query
+  {
+    ezUInt16 m_uiCurrentAnimClip = 0;
+    ezUInt16 m_uiCurrentKeyframe = 0;
+    ezVec3 m_vLeftFootPosition;
+    ezVec3 m_vRightFootPosition;
+    ezVec3 m_vTargetDirection;
+  };
+
+  ezMotionMatchingDatabase();
+  ~ezMotionMatchingDatabase();
+
+  /// \brief Removes all frames and the acceleration structure.
+  void Clear();
+
+  /// \brief Appends the given frames. The database has to be rebuilt afterwards.
+  void AddFrames(ezArrayPtr<const Frame> frames);
+
+  /// \brief Builds the search structure. Must be called after all frames were added and before any query is made.
+  void Build();
+
+  bool IsBuilt() const { return !m_Nodes.IsEmpty() || m_Frames.IsEmpty(); }
+
+  ezUInt32 GetFrameCount() const { return m_Frames.GetCount(); }
+
+  /// \brief Returns the frame with the given index. Note that Build() reorders the frames.
+  const Frame& GetFrame(ezUInt32 uiIndex) const { return m_Frames[uiIndex]; }
+
+  /// \brief Returns the index of the frame that matches the query best or ezInvalidIndex if no frame is eligible.
+  ezUInt32 FindBestFrame(const Query& query) const;
+
+  /// \brief Answers many queries at once, e.g. for all characters that share the same database.
+  ///
+  /// Large batches are distributed across the task system. \a out_Results must have the same size as \a queries.
+  void FindBestFrames(ezArrayPtr<const Query> queries, ezArrayPtr<ezUInt32> out_Results) const;
+
+  /// \brief Reference implementation that evaluates every frame. Only meant for testing and profiling.
+  ezUInt32 FindBestFrameBruteForce(const Query& query) const;
+
+private:
+  enum
+  {
+    NumFeatures = 9, ///< left foot position, right foot position, root velocity
+    MaxFramesPerLeaf = 16,
+  };
+
+  struct Node
+  {
+    float m_fMin[NumFeatures];
+    float m_fMax[NumFeatures];
+    ezUInt32 m_uiFirstFrame;
+    ezUInt32 m_uiNumFrames;
+    ezUInt32 m_uiChild0 = ezInvalidIndex; ///< both children are invalid for leaf nodes
+    ezUInt32 m_uiChild1 = ezInvalidIndex;
+  };
+
+  ezUInt32 BuildNode(ezUInt32 uiFirstFrame, ezUInt32 uiNumFrames);
+  float ComputeLowerBound(const Node& node, const Query& query) const;
+  void EvaluateLeaf(const Node& node, const Query& query, float& inout_fBestScore, ezUInt32& inout_uiBestFrame) const;
+
+  ezDynamicArray<Frame> m_Frames;
+  ezDynamicArray<Node> m_Nodes;
+
+  // SoA copy of the features that are used for scoring, in the same order as m_Frames and padded to a multiple of four
+  ezDynamicArray<float> m_Features[NumFeatures];
+};
@@ -212,13 +212,7 @@ void ezGameApplication::UpdateWorldsAndExtractViews()
 
   if (ezRenderWorld::GetUseMultithreadedRendering())
   {
-    ezTaskGroupID updateWorldsTaskID = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
-    for (ezUInt32 i = 0; i < worldsToUpdate.GetCount(); ++i)
-    {
-      ezTaskSystem::AddTaskToGroup(updateWorldsTaskID, worldsToUpdate[i]->GetUpdateTask());
-    }
-    ezTaskSystem::StartTaskGroup(updateWorldsTaskID);
-    ezTaskSystem::WaitForGroup(updateWorldsTaskID);
+    ezWorld::UpdateWorlds(worldsToUpdate);
   }
   else
   {
@@ -12,6 +12,7 @@
 #include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Timestamp.h>
+#include <Foundation/Utilities/Metrics.h>
 #include <GameEngine/ActorSystem/ActorManager.h>
 #include <GameEngine/GameApplication/GameApplicationBase.h>
 #include <GameEngine/Interfaces/FrameCaptureInterface.h>
@@ -502,6 +503,7 @@ void ezGameApplicationBase::Run_Present()
 
 void ezGameApplicationBase::Run_FinishFrame()
 {
+  ezMetrics::Update();
   ezTelemetry::PerFrameUpdate();
   ezResourceManager::PerFrameUpdate();
   ezTaskSystem::FinishFrameTasks();
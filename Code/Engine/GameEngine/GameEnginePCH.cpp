@@ -9,6 +9,7 @@ EZ_STATICLINK_LIBRARY(GameEngine)
   EZ_STATICLINK_REFERENCE(GameEngine_Animation_Implementation_AnimatedMeshComponent);
   EZ_STATICLINK_REFERENCE(GameEngine_Animation_Implementation_JointAttachmentComponent);
   EZ_STATICLINK_REFERENCE(GameEngine_Animation_Implementation_MotionMatchingComponent);
+  EZ_STATICLINK_REFERENCE(GameEngine_Animation_Skeletal_Implementation_MotionMatchingDatabase);
   EZ_STATICLINK_REFERENCE(GameEngine_CollisionFilter_CollisionFilter);
   EZ_STATICLINK_REFERENCE(GameEngine_Components_Implementation_AgentSteeringComponent);
   EZ_STATICLINK_REFERENCE(GameEngine_Components_Implementation_AreaDamageComponent);
@@ -67,6 +68,7 @@ EZ_STATICLINK_LIBRARY(GameEngine)
   EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Implementation_VisualScriptComponent);
   EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Implementation_VisualScriptInstance);
   EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Implementation_VisualScriptNode);
+  EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Implementation_VisualScriptProgram);
   EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Implementation_VisualScriptResource);
   EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Nodes_VisualScriptLogicNodes);
   EZ_STATICLINK_REFERENCE(GameEngine_VisualScript_Nodes_VisualScriptMathExpressionNode);
@@ -42,9 +42,43 @@ void ezPrefabResource::InstantiatePrefab(ezWorld& world, const ezTransform& root
   }
 }
 
+void ezPrefabResource::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+                                          ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID,
+                                          const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic)
+{
+  if (GetLoadingState() != ezResourceState::Loaded)
+    return;
+
+  if (pExposedParamValues != nullptr && !pExposedParamValues->IsEmpty())
+  {
+    ezDynamicArray<ezGameObject*> createdRootObjects;
+    ezDynamicArray<ezGameObject*> createdChildObjects;
+
+    if (out_CreatedRootObjects == nullptr)
+      out_CreatedRootObjects = &createdRootObjects;
+
+    const ezUInt32 uiFirstRootObject = out_CreatedRootObjects->GetCount();
+
+    m_WorldReader.InstantiatePrefabs(world, rootTransforms, hParent, out_CreatedRootObjects, &createdChildObjects, pOverrideTeamID, bForceDynamic);
+
+    const ezUInt32 uiNumRootObjects = m_WorldReader.GetRootObjectCount();
+    const ezUInt32 uiNumChildObjects = m_WorldReader.GetChildObjectCount();
+
+    for (ezUInt32 i = 0; i < rootTransforms.GetCount(); ++i)
+    {
+      ApplyExposedParameterValues(pExposedParamValues, createdChildObjects.GetArrayPtr().GetSubArray(i * uiNumChildObjects, uiNumChildObjects),
+                                  out_CreatedRootObjects->GetArrayPtr().GetSubArray(uiFirstRootObject + i * uiNumRootObjects, uiNumRootObjects));
+    }
+  }
+  else
+  {
+    m_WorldReader.InstantiatePrefabs(world, rootTransforms, hParent, out_CreatedRootObjects, nullptr, pOverrideTeamID, bForceDynamic);
+  }
+}
+
 void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues,
-                                                   const ezHybridArray<ezGameObject*, 8>& createdChildObjects,
-                                                   const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const
+                                                   ezArrayPtr<ezGameObject*> createdChildObjects,
+                                                   ezArrayPtr<ezGameObject*> createdRootObjects) const
 {
   const ezUInt32 uiNumParamDescs = m_PrefabParamDescs.GetCount();
 
@@ -39,9 +39,16 @@ public:
                          ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID,
                          const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
 
+  /// \brief Creates one instance of this prefab per given root transform, see ezWorldReader::InstantiatePrefabs().
+  ///
+  /// If out_CreatedRootObjects is given, the root objects of all instances are appended to it, instance after instance.
+  /// The exposed parameter values are applied to every instance.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+                          ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID,
+                          const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
+
   void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues,
-                                   const ezHybridArray<ezGameObject*, 8>& createdChildObjects,
-                                   const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const;
+                                   ezArrayPtr<ezGameObject*> createdChildObjects, ezArrayPtr<ezGameObject*> createdRootObjects) const;
 
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
@@ -3,6 +3,7 @@
 #include <Core/Messages/EventMessage.h>
 #include <Core/World/Declarations.h>
 #include <Core/World/GameObject.h>
+#include <Core/World/World.h>
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/Strings/HashedString.h>
@@ -99,53 +100,52 @@ void ezVisualScriptInstance::Clear()
   }
 
   m_pWorld = nullptr;
+  m_pProgram = nullptr;
+  m_pMessageHandlers = nullptr;
   m_Nodes.Clear();
-  m_ExecutionConnections.Clear();
-  m_DataConnections.Clear();
+  m_DataTargetPointers.Clear();
   m_LocalVariables.Clear();
   m_hScriptResource.Invalidate();
 }
 
 
-void ezVisualScriptInstance::ComputeNodeDependencies()
+void ezVisualScriptInstance::ExecuteDependentNodes(ezUInt16 uiNode)
 {
-  m_NodeDependencies.SetCount(m_Nodes.GetCount());
+  const auto& node = m_pProgram->m_Nodes[uiNode];
+  const ezUInt16* pDependencies = m_pProgram->m_DependencyStream.GetData() + node.m_uiFirstDependency;
 
-  for (auto it = m_DataConnections.GetIterator(); it.IsValid(); ++it)
+  // the stream is already ordered such that the most dependent nodes come first
+  for (ezUInt32 i = 0; i < node.m_uiNumDependencies; ++i)
   {
-    const ezVisualScriptPinConnectionID src = it.Key();
-
-    const ezUInt16 uiSourceNode = (src >> 16) & 0xFFFF;
-
-    if (m_Nodes[uiSourceNode]->IsManuallyStepped())
-      continue;
-
-    const ezHybridArray<DataPinConnection, 2>& dst = it.Value();
+    auto* pNode = m_Nodes[pDependencies[i]];
 
-    for (const DataPinConnection& target : dst)
-    {
-      m_NodeDependencies[target.m_uiTargetNode].PushBack(uiSourceNode);
-    }
+    // only nodes that are not manually stepped are in the dependency list
+    // so we do not need to filter those out here
+    pNode->Execute(this, 0);
+    pNode->m_bInputValuesChanged = false;
   }
 }
 
-
-void ezVisualScriptInstance::ExecuteDependentNodes(ezUInt16 uiNode)
+void ezVisualScriptInstance::ReconfigureIfScriptChanged()
 {
-  const auto& dep = m_NodeDependencies[uiNode];
-  for (ezUInt32 i = 0; i < dep.GetCount(); ++i)
-  {
-    const ezUInt32 uiDependency = dep[i];
-    auto* pNode = m_Nodes[uiDependency];
+  if (!m_hScriptResource.IsValid())
+    return;
 
-    // recurse to the most dependent nodes first
-    ExecuteDependentNodes(uiDependency);
+  {
+    ezResourceLock<ezVisualScriptResource> pScript(m_hScriptResource, ezResourceAcquireMode::PointerOnly);
+    if (pScript->GetCurrentResourceChangeCounter() == m_uiResourceChangeCounter)
+      return;
+  }
 
-    // only nodes that are not manually stepped are in the dependency list
-    // so we do not need to filter those out here
-    pNode->Execute(this, 0);
-    pNode->m_bInputValuesChanged = false;
+  // Configure() clears the handle and the owner
+  const ezVisualScriptResourceHandle hScript = m_hScriptResource;
+  ezGameObject* pOwner = nullptr;
+  if (m_pWorld != nullptr)
+  {
+    m_pWorld->TryGetObject(m_hOwner, pOwner);
   }
+
+  Configure(hScript, pOwner);
 }
 
 void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScript, ezGameObject* pOwner)
@@ -154,9 +154,10 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 
   ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
   const auto& resource = pScript->GetDescriptor();
-  m_pMessageHandlers = &resource.m_MessageHandlers;
+  const auto& program = pScript->GetProgram();
 
   m_hScriptResource = hScript;
+  m_uiResourceChangeCounter = pScript->GetCurrentResourceChangeCounter();
 
   if (pOwner)
   {
@@ -164,6 +165,14 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
     m_pWorld = pOwner->GetWorld();
   }
 
+  if (program.m_Nodes.GetCount() != resource.m_Nodes.GetCount())
+  {
+    // the error has already been reported when the script was compiled
+    return;
+  }
+
+  m_pMessageHandlers = &resource.m_MessageHandlers;
+
   m_Nodes.Reserve(resource.m_Nodes.GetCount());
 
   for (ezUInt32 n = 0; n < resource.m_Nodes.GetCount(); ++n)
@@ -197,21 +206,15 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
     }
   }
 
-  m_ExecutionConnections.Reserve(resource.m_ExecutionPaths.GetCount());
-
-  for (const auto& con : resource.m_ExecutionPaths)
-  {
-    ConnectExecutionPins(con.m_uiSourceNode, con.m_uiOutputPin, con.m_uiTargetNode, con.m_uiInputPin);
-  }
+  m_pProgram = &program;
 
-  for (const auto& con : resource.m_DataPaths)
+  m_DataTargetPointers.SetCountUninitialized(program.m_DataTargets.GetCount());
+  for (ezUInt32 i = 0; i < program.m_DataTargets.GetCount(); ++i)
   {
-    ConnectDataPins(con.m_uiSourceNode, con.m_uiOutputPin, (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, con.m_uiTargetNode,
-      con.m_uiInputPin, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
+    const auto& target = program.m_DataTargets[i];
+    m_DataTargetPointers[i] = m_Nodes[target.m_uiTargetNode]->GetInputPinDataPointer(target.m_uiTargetPin);
   }
 
-  ComputeNodeDependencies();
-
   // initialize local variables
   {
     for (const auto& p : resource.m_BoolParameters)
@@ -402,6 +405,8 @@ void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ez
 
 void ezVisualScriptInstance::ExecuteScript(ezVisualScriptInstanceActivity* pActivity /*= nullptr*/)
 {
+  ReconfigureIfScriptChanged();
+
   m_pActivity = pActivity;
 
   if (m_pActivity != nullptr)
@@ -427,6 +432,8 @@ void ezVisualScriptInstance::ExecuteScript(ezVisualScriptInstanceActivity* pActi
 
 bool ezVisualScriptInstance::HandleMessage(ezMessage& msg)
 {
+  ReconfigureIfScriptChanged();
+
   if (m_pMessageHandlers == nullptr)
     return false;
 
@@ -450,44 +457,32 @@ bool ezVisualScriptInstance::HandleMessage(ezMessage& msg)
   return bHandled;
 }
 
-void ezVisualScriptInstance::ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin)
-{
-  auto& con = m_ExecutionConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiOutputSlot];
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-}
-
-void ezVisualScriptInstance::ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType,
-  ezUInt16 uiTargetNode, ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType)
-{
-  DataPinConnection& con = m_DataConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiSourcePin].ExpandAndGetRef();
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-  con.m_pTargetData = m_Nodes[uiTargetNode]->GetInputPinDataPointer(uiTargetPin);
-  con.m_AssignFunc = FindDataPinAssignFunction(sourcePinType, targetPinType);
-}
-
 void ezVisualScriptInstance::SetOutputPinValue(const ezVisualScriptNode* pNode, ezUInt8 uiPin, const void* pValue)
 {
-  const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin;
+  const auto& node = m_pProgram->m_Nodes[pNode->m_uiNodeID];
+  if (uiPin >= node.m_uiNumDataOutputs)
+    return;
 
-  ezHybridArray<DataPinConnection, 2>* TargetNodeAndPins;
-  if (!m_DataConnections.TryGetValue(uiConnectionID, TargetNodeAndPins))
+  const auto& output = m_pProgram->m_DataOutputs[node.m_uiFirstDataOutput + uiPin];
+  if (output.m_uiNumTargets == 0)
     return;
 
-  for (const DataPinConnection& TargetNodeAndPin : *TargetNodeAndPins)
+  for (ezUInt32 i = output.m_uiFirstTarget; i < output.m_uiFirstTarget + output.m_uiNumTargets; ++i)
   {
-    if (TargetNodeAndPin.m_AssignFunc)
+    const auto& target = m_pProgram->m_DataTargets[i];
+
+    if (target.m_AssignFunc)
     {
-      if (TargetNodeAndPin.m_AssignFunc(pValue, TargetNodeAndPin.m_pTargetData))
+      if (target.m_AssignFunc(pValue, m_DataTargetPointers[i]))
       {
-        m_Nodes[TargetNodeAndPin.m_uiTargetNode]->m_bInputValuesChanged = true;
+        m_Nodes[target.m_uiTargetNode]->m_bInputValuesChanged = true;
       }
     }
   }
 
   if (m_pActivity != nullptr)
   {
+    const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin;
     m_pActivity->m_ActiveDataConnections.PushBack(uiConnectionID);
   }
 }
@@ -499,21 +494,24 @@ Otherwise visual script graph execution can end up in an endless recursion with
 Override ezVisualScriptNode::IsManuallyStepped() for type '{}' if necessary.",
     pNode->GetDynamicRTTI()->GetTypeName());
 
-  const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget;
+  const auto& node = m_pProgram->m_Nodes[pNode->m_uiNodeID];
+  if (uiNthTarget >= node.m_uiNumExecOutputs)
+    return;
 
-  ExecPinConnection TargetNode;
-  if (!m_ExecutionConnections.TryGetValue(uiConnectionID, TargetNode))
+  const auto& target = m_pProgram->m_ExecTargets[node.m_uiFirstExecOutput + uiNthTarget];
+  if (target.m_uiTargetNode == ezVisualScriptProgram::InvalidNode)
     return;
 
-  auto* pTargetNode = m_Nodes[TargetNode.m_uiTargetNode];
+  auto* pTargetNode = m_Nodes[target.m_uiTargetNode];
 
-  ExecuteDependentNodes(TargetNode.m_uiTargetNode);
+  ExecuteDependentNodes(target.m_uiTargetNode);
 
-  pTargetNode->Execute(this, TargetNode.m_uiTargetPin);
+  pTargetNode->Execute(this, target.m_uiTargetPin);
   pTargetNode->m_bInputValuesChanged = false;
 
   if (m_pActivity != nullptr)
   {
+    const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget;
     m_pActivity->m_ActiveExecutionConnections.PushBack(uiConnectionID);
   }
 }
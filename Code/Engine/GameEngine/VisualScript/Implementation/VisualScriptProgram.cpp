@@ -0,0 +1,281 @@
+#include <GameEnginePCH.h>
+
+#include <Foundation/Containers/HashTable.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+
+namespace
+{
+  const ezRTTI* GetNodeType(const ezVisualScriptResourceDescriptor::Node& node)
+  {
+    if (node.m_isFunctionCall)
+      return ezGetStaticRTTI<ezVisualScriptNode_FunctionCall>();
+
+    if (node.m_pType == nullptr)
+      return nullptr;
+
+    if (node.m_pType->IsDerivedFrom<ezMessage>())
+    {
+      if (node.m_isMsgSender)
+        return ezGetStaticRTTI<ezVisualScriptNode_MessageSender>();
+
+      if (node.m_isMsgHandler)
+        return ezGetStaticRTTI<ezVisualScriptNode_GenericEvent>();
+
+      return nullptr;
+    }
+
+    if (node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
+      return node.m_pType;
+
+    return nullptr;
+  }
+
+  bool IsManuallyStepped(const ezRTTI* pNodeType, ezHashTable<const ezRTTI*, bool>& cache)
+  {
+    bool bManuallyStepped = false;
+    if (cache.TryGetValue(pNodeType, bManuallyStepped))
+      return bManuallyStepped;
+
+    // IsManuallyStepped() is virtual, so ask a temporary node of that type
+    ezVisualScriptNode* pNode = pNodeType->GetAllocator()->Allocate<ezVisualScriptNode>();
+    bManuallyStepped = pNode->IsManuallyStepped();
+    pNodeType->GetAllocator()->Deallocate(pNode);
+
+    cache.Insert(pNodeType, bManuallyStepped);
+    return bManuallyStepped;
+  }
+
+  struct VisitState
+  {
+    enum Enum : ezUInt8
+    {
+      NotVisited,
+      InProgress,
+      Done
+    };
+  };
+
+  struct DependencyFlattener
+  {
+    const ezDynamicArray<ezHybridArray<ezUInt16, 2>>& m_Dependencies;
+    ezDynamicArray<ezVisualScriptProgram::Node>& m_Nodes;
+    ezDynamicArray<ezUInt16>& m_Stream;
+
+    ezDynamicArray<ezUInt8> m_State; ///< VisitState for every node.
+    ezDynamicArray<ezUInt16> m_LastAddedFor; ///< For every node, the node into whose stream it was added last.
+    ezUInt16 m_uiCycleNode = ezVisualScriptProgram::InvalidNode;
+
+    /// \brief Builds the stream of the given node after the streams of all its dependencies, each of them only once.
+    ezResult Flatten(ezUInt16 uiNode)
+    {
+      if (m_State[uiNode] == VisitState::Done)
+        return EZ_SUCCESS;
+
+      // reached again through its own dependencies
+      if (m_State[uiNode] == VisitState::InProgress)
+      {
+        m_uiCycleNode = uiNode;
+        return EZ_FAILURE;
+      }
+
+      m_State[uiNode] = VisitState::InProgress;
+
+      for (ezUInt16 uiDependency : m_Dependencies[uiNode])
+      {
+        EZ_SUCCEED_OR_RETURN(Flatten(uiDependency));
+      }
+
+      ezVisualScriptProgram::Node& node = m_Nodes[uiNode];
+      node.m_uiFirstDependency = m_Stream.GetCount();
+
+      // the most dependent nodes come first, a node that several inputs depend on is still only executed once
+      for (ezUInt16 uiDependency : m_Dependencies[uiNode])
+      {
+        const ezVisualScriptProgram::Node& dependency = m_Nodes[uiDependency];
+
+        for (ezUInt32 i = 0; i < dependency.m_uiNumDependencies; ++i)
+        {
+          Add(m_Stream[dependency.m_uiFirstDependency + i], uiNode);
+        }
+
+        Add(uiDependency, uiNode);
+      }
+
+      node.m_uiNumDependencies = m_Stream.GetCount() - node.m_uiFirstDependency;
+      m_State[uiNode] = VisitState::Done;
+      return EZ_SUCCESS;
+    }
+
+    void Add(ezUInt16 uiDependency, ezUInt16 uiNode)
+    {
+      if (m_LastAddedFor[uiDependency] == uiNode)
+        return;
+
+      m_LastAddedFor[uiDependency] = uiNode;
+      m_Stream.PushBack(uiDependency);
+    }
+  };
+} // namespace
+
+ezResult ezVisualScriptProgram::Compile(const ezVisualScriptResourceDescriptor& desc)
+{
+  Clear();
+
+  ezVisualScriptInstance::SetupPinDataTypeConversions();
+
+  const ezUInt32 uiNumNodes = desc.m_Nodes.GetCount();
+  if (uiNumNodes >= InvalidNode)
+  {
+    ezLog::Error("Visual script has too many nodes ({0})", uiNumNodes);
+    return EZ_FAILURE;
+  }
+
+  ezHashTable<const ezRTTI*, bool> manuallySteppedCache;
+  ezDynamicArray<bool> manuallyStepped;
+  manuallyStepped.SetCount(uiNumNodes);
+
+  m_Nodes.SetCount(uiNumNodes);
+
+  for (ezUInt32 n = 0; n < uiNumNodes; ++n)
+  {
+    const ezRTTI* pNodeType = GetNodeType(desc.m_Nodes[n]);
+    if (pNodeType == nullptr)
+    {
+      ezLog::Error("Invalid node type '{0}' in visual script", desc.m_Nodes[n].m_sTypeName);
+      Clear();
+      return EZ_FAILURE;
+    }
+
+    manuallyStepped[n] = IsManuallyStepped(pNodeType, manuallySteppedCache);
+
+    ezMemoryUtils::ZeroFill(&m_Nodes[n], 1);
+  }
+
+  // execution connections, one slot per output pin
+  {
+    for (const auto& con : desc.m_ExecutionPaths)
+    {
+      Node& node = m_Nodes[con.m_uiSourceNode];
+      node.m_uiNumExecOutputs = ezMath::Max<ezUInt16>(node.m_uiNumExecOutputs, con.m_uiOutputPin + 1);
+    }
+
+    ezUInt32 uiNumExecOutputs = 0;
+    for (Node& node : m_Nodes)
+    {
+      node.m_uiFirstExecOutput = uiNumExecOutputs;
+      uiNumExecOutputs += node.m_uiNumExecOutputs;
+    }
+
+    m_ExecTargets.SetCountUninitialized(uiNumExecOutputs);
+    for (ExecTarget& target : m_ExecTargets)
+    {
+      target.m_uiTargetNode = InvalidNode;
+      target.m_uiTargetPin = 0;
+    }
+
+    for (const auto& con : desc.m_ExecutionPaths)
+    {
+      ExecTarget& target = m_ExecTargets[m_Nodes[con.m_uiSourceNode].m_uiFirstExecOutput + con.m_uiOutputPin];
+      target.m_uiTargetNode = con.m_uiTargetNode;
+      target.m_uiTargetPin = con.m_uiInputPin;
+    }
+  }
+
+  // data connections, the targets of each output pin are stored consecutively
+  {
+    for (const auto& con : desc.m_DataPaths)
+    {
+      Node& node = m_Nodes[con.m_uiSourceNode];
+      node.m_uiNumDataOutputs = ezMath::Max<ezUInt16>(node.m_uiNumDataOutputs, con.m_uiOutputPin + 1);
+    }
+
+    ezUInt32 uiNumDataOutputs = 0;
+    for (Node& node : m_Nodes)
+    {
+      node.m_uiFirstDataOutput = uiNumDataOutputs;
+      uiNumDataOutputs += node.m_uiNumDataOutputs;
+    }
+
+    m_DataOutputs.SetCount(uiNumDataOutputs);
+    ezMemoryUtils::ZeroFill(m_DataOutputs.GetData(), uiNumDataOutputs);
+
+    for (const auto& con : desc.m_DataPaths)
+    {
+      m_DataOutputs[m_Nodes[con.m_uiSourceNode].m_uiFirstDataOutput + con.m_uiOutputPin].m_uiNumTargets++;
+    }
+
+    ezUInt32 uiNumDataTargets = 0;
+    for (DataOutput& output : m_DataOutputs)
+    {
+      output.m_uiFirstTarget = uiNumDataTargets;
+      uiNumDataTargets += output.m_uiNumTargets;
+      output.m_uiNumTargets = 0;
+    }
+
+    m_DataTargets.SetCountUninitialized(uiNumDataTargets);
+
+    for (const auto& con : desc.m_DataPaths)
+    {
+      DataOutput& output = m_DataOutputs[m_Nodes[con.m_uiSourceNode].m_uiFirstDataOutput + con.m_uiOutputPin];
+
+      DataTarget& target = m_DataTargets[output.m_uiFirstTarget + output.m_uiNumTargets];
+      target.m_uiTargetNode = con.m_uiTargetNode;
+      target.m_uiTargetPin = con.m_uiInputPin;
+      target.m_AssignFunc = ezVisualScriptInstance::FindDataPinAssignFunction(
+        (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
+
+      ++output.m_uiNumTargets;
+    }
+  }
+
+  // nodes that are not manually stepped are executed on demand, right before the nodes that use their output values
+  {
+    ezDynamicArray<ezHybridArray<ezUInt16, 2>> dependencies;
+    dependencies.SetCount(uiNumNodes);
+
+    for (const auto& con : desc.m_DataPaths)
+    {
+      if (!manuallyStepped[con.m_uiSourceNode])
+      {
+        dependencies[con.m_uiTargetNode].PushBack(con.m_uiSourceNode);
+      }
+    }
+
+    // depth first, so every stream is built only once and then copied into the streams of the nodes that depend on it
+    DependencyFlattener flattener{dependencies, m_Nodes, m_DependencyStream};
+    flattener.m_State.SetCount(uiNumNodes, VisitState::NotVisited);
+    flattener.m_LastAddedFor.SetCount(uiNumNodes, InvalidNode);
+
+    for (ezUInt32 n = 0; n < uiNumNodes; ++n)
+    {
+      if (flattener.Flatten(static_cast<ezUInt16>(n)).Failed())
+      {
+        ezLog::Error("Visual script has a cycle in its data connections at node '{0}'", desc.m_Nodes[flattener.m_uiCycleNode].m_sTypeName);
+        Clear();
+        return EZ_FAILURE;
+      }
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezVisualScriptProgram::Clear()
+{
+  m_Nodes.Clear();
+  m_ExecTargets.Clear();
+  m_DataOutputs.Clear();
+  m_DataTargets.Clear();
+  m_DependencyStream.Clear();
+}
+
+ezUInt64 ezVisualScriptProgram::GetHeapMemoryUsage() const
+{
+  return m_Nodes.GetHeapMemoryUsage() + m_ExecTargets.GetHeapMemoryUsage() + m_DataOutputs.GetHeapMemoryUsage() +
+         m_DataTargets.GetHeapMemoryUsage() + m_DependencyStream.GetHeapMemoryUsage();
+}
+
+EZ_STATICLINK_FILE(GameEngine, GameEngine_VisualScript_Implementation_VisualScriptProgram);
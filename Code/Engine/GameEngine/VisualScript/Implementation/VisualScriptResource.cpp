@@ -67,19 +67,24 @@ ezResourceLoadDesc ezVisualScriptResource::UpdateContent(ezStreamReader* Stream)
     context.EndRestoringHandles();
   }
 
+  // errors are logged, instances of a script that failed to compile stay empty
+  m_Program.Compile(m_Descriptor);
+
   res.m_State = ezResourceState::Loaded;
   return res;
 }
 
 void ezVisualScriptResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
-  out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezVisualScriptResourceDescriptor);
+  out_NewMemoryUsage.m_uiMemoryCPU =
+    sizeof(ezVisualScriptResourceDescriptor) + sizeof(ezVisualScriptProgram) + static_cast<ezUInt32>(m_Program.GetHeapMemoryUsage());
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
 }
 
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezVisualScriptResource, ezVisualScriptResourceDescriptor)
 {
   m_Descriptor = descriptor;
+  m_Program.Compile(m_Descriptor);
 
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
@@ -7,6 +7,7 @@
 #include <Foundation/Types/Variant.h>
 #include <Foundation/Containers/Map.h>
 #include <GameEngine/VisualScript/VisualScriptNode.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
 #include <GameEngine/GameState/StateMap.h>
 #include <Foundation/Containers/ArrayMap.h>
 #include <Core/ResourceManager/ResourceHandle.h>
@@ -23,9 +24,9 @@ typedef ezUInt32 ezVisualScriptNodeConnectionID;
 typedef ezUInt32 ezVisualScriptPinConnectionID;
 typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
 
-typedef bool(*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
-
 /// \brief An instance of a visual script resource. Stores the current script state and executes nodes.
+///
+/// The connections between the nodes are not stored per instance, they are looked up in the ezVisualScriptProgram of the resource.
 class EZ_GAMEENGINE_DLL ezVisualScriptInstance
 {
 public:
@@ -72,11 +73,10 @@ private:
   friend class ezVisualScriptNode;
 
   void Clear();
-  void ComputeNodeDependencies();
   void ExecuteDependentNodes(ezUInt16 uiNode);
 
-  void ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin);
-  void ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType);
+  /// \brief Recreates the instance when the resource was reloaded, because the program and the descriptor that it points into were replaced.
+  void ReconfigureIfScriptChanged();
 
   void CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
   void CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
@@ -84,31 +84,13 @@ private:
   void CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
   ezAbstractFunctionProperty* SearchForScriptableFunctionOnType(const ezRTTI* pObjectType, ezStringView sFuncName, const ezScriptableFunctionAttribute*& out_pSfAttr) const;
 
-  struct DataPinConnection
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    ezUInt16 m_uiTargetNode;
-    ezUInt8 m_uiTargetPin;
-    ezVisualScriptDataPinAssignFunc m_AssignFunc = nullptr;
-    void* m_pTargetData = nullptr;
-  };
-
-  struct ExecPinConnection
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    ezUInt16 m_uiTargetNode;
-    ezUInt8 m_uiTargetPin;
-  };
-
   ezVisualScriptResourceHandle m_hScriptResource;
   ezGameObjectHandle m_hOwner;
   ezWorld* m_pWorld = nullptr;
+  const ezVisualScriptProgram* m_pProgram = nullptr;
+  ezUInt32 m_uiResourceChangeCounter = 0; ///< The change counter of the resource when m_pProgram was taken from it
   ezDynamicArray<ezVisualScriptNode*> m_Nodes;
-  ezDynamicArray<ezHybridArray<ezUInt16, 2>> m_NodeDependencies;
-  ezHashTable<ezVisualScriptNodeConnectionID, ExecPinConnection > m_ExecutionConnections;
-  ezHashTable<ezVisualScriptPinConnectionID, ezHybridArray<DataPinConnection, 2> > m_DataConnections;
+  ezDynamicArray<void*> m_DataTargetPointers; ///< The input pin data of every target in ezVisualScriptProgram::m_DataTargets
   ezStateMap m_LocalVariables;
   ezVisualScriptInstanceActivity* m_pActivity = nullptr;
   const ezArrayMap<ezMessageId, ezUInt16>* m_pMessageHandlers = nullptr;
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <GameEngine/GameEngineDLL.h>
+
+struct ezVisualScriptResourceDescriptor;
+
+typedef bool(*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
+
+/// \brief The compiled form of a visual script graph. It is built once per ezVisualScriptResource and shared by all instances of that script.
+///
+/// All connections are stored in flat arrays that are indexed by node and pin, so executing a script does not need any hash table lookups.
+/// The nodes that have to run before a node, because they compute its input values, are precomputed into one instruction stream per node.
+/// An ezVisualScriptInstance only stores its node objects and the pointers to their input pin data.
+struct EZ_GAMEENGINE_DLL ezVisualScriptProgram
+{
+  enum
+  {
+    InvalidNode = 0xFFFF
+  };
+
+  /// \brief Builds the program from the given graph. Returns EZ_FAILURE and leaves the program empty if the graph is invalid.
+  ezResult Compile(const ezVisualScriptResourceDescriptor& desc);
+
+  void Clear();
+
+  bool IsEmpty() const { return m_Nodes.IsEmpty(); }
+
+  ezUInt64 GetHeapMemoryUsage() const;
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstExecOutput; ///< Index into m_ExecTargets, one entry per output execution pin.
+    ezUInt32 m_uiFirstDataOutput; ///< Index into m_DataOutputs, one entry per output data pin.
+    ezUInt32 m_uiFirstDependency; ///< Index into m_DependencyStream.
+    ezUInt32 m_uiNumDependencies;
+    ezUInt16 m_uiNumExecOutputs;
+    ezUInt16 m_uiNumDataOutputs;
+  };
+
+  struct ExecTarget
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode; ///< InvalidNode if the pin is not connected.
+    ezUInt8 m_uiTargetPin;
+  };
+
+  struct DataOutput
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstTarget; ///< Index into m_DataTargets.
+    ezUInt32 m_uiNumTargets;
+  };
+
+  struct DataTarget
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezVisualScriptDataPinAssignFunc m_AssignFunc;
+    ezUInt16 m_uiTargetNode;
+    ezUInt8 m_uiTargetPin;
+  };
+
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<ExecTarget> m_ExecTargets;
+  ezDynamicArray<DataOutput> m_DataOutputs;
+  ezDynamicArray<DataTarget> m_DataTargets;
+
+  /// For every node, the nodes that need to be executed before it, in execution order.
+  ezDynamicArray<ezUInt16> m_DependencyStream;
+};
@@ -4,6 +4,7 @@
 #include <Foundation/Containers/ArrayMap.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <GameEngine/GameEngineDLL.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
 
 typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
 
@@ -95,6 +96,9 @@ public:
 
   const ezVisualScriptResourceDescriptor& GetDescriptor() const { return m_Descriptor; }
 
+  /// \brief Returns the compiled script that is shared by all ezVisualScriptInstance objects of this resource.
+  const ezVisualScriptProgram& GetProgram() const { return m_Program; }
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
@@ -102,5 +106,6 @@ private:
 
 private:
   ezVisualScriptResourceDescriptor m_Descriptor;
+  ezVisualScriptProgram m_Program;
 };
 
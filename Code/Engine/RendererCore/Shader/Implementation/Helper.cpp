@@ -88,7 +88,7 @@ namespace ezShaderHelper
     out_Sections.Process(szContent);
   }
 
-  ezUInt32 CalculateHash(const ezArrayPtr<ezPermutationVar>& vars)
+  ezUInt32 CalculateHash(const ezArrayPtr<const ezPermutationVar>& vars)
   {
     ezHybridArray<ezUInt32, 128> buffer;
     buffer.SetCountUninitialized(vars.GetCount() * 2);
@@ -64,6 +64,6 @@ namespace ezShaderHelper
 
   void GetShaderSections(const char* szContent, ezTextSectionizer& out_Sections);
 
-  ezUInt32 CalculateHash(const ezArrayPtr<ezPermutationVar>& vars);
+  ezUInt32 CalculateHash(const ezArrayPtr<const ezPermutationVar>& vars);
 }
 
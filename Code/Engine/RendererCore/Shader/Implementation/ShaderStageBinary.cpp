@@ -2,6 +2,7 @@
 
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/Lock.h>
 #include <RendererCore/Shader/ShaderStageBinary.h>
 #include <RendererCore/Shader/Types.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
@@ -168,6 +169,7 @@ ezShaderResourceBinding::~ezShaderResourceBinding() {}
 
 //////////////////////////////////////////////////////////////////////////
 
+ezMutex ezShaderStageBinary::s_ShaderStageBinariesMutex;
 ezMap<ezUInt32, ezShaderStageBinary> ezShaderStageBinary::s_ShaderStageBinaries[ezGALShaderStage::ENUM_COUNT];
 
 ezShaderStageBinary::ezShaderStageBinary()
@@ -340,6 +342,14 @@ ezShaderConstantBufferLayout* ezShaderStageBinary::CreateConstantBufferLayout()
 
 ezResult ezShaderStageBinary::WriteStageBinary(ezLogInterface* pLog) const
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
+  // stage binaries are identified by their source hash, so when another permutation has already produced the same one, there is
+  // nothing left to do
+  auto itStage = s_ShaderStageBinaries[m_Stage].Find(m_uiSourceHash);
+  if (itStage.IsValid() && !itStage.Value().m_ByteCode.IsEmpty())
+    return EZ_SUCCESS;
+
   ezStringBuilder sShaderStageFile = ezShaderManager::GetCacheDirectory();
 
   sShaderStageFile.AppendPath(ezShaderManager::GetActivePlatform().GetData());
@@ -358,12 +368,23 @@ ezResult ezShaderStageBinary::WriteStageBinary(ezLogInterface* pLog) const
     return EZ_FAILURE;
   }
 
+  if (itStage.IsValid())
+  {
+    itStage.Value() = *this;
+  }
+  else
+  {
+    s_ShaderStageBinaries[m_Stage].Insert(m_uiSourceHash, *this);
+  }
+
   return EZ_SUCCESS;
 }
 
 // static
 ezShaderStageBinary* ezShaderStageBinary::LoadStageBinary(ezGALShaderStage::Enum Stage, ezUInt32 uiHash)
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   auto itStage = s_ShaderStageBinaries[Stage].Find(uiHash);
 
   if (!itStage.IsValid())
@@ -405,9 +426,53 @@ ezShaderStageBinary* ezShaderStageBinary::LoadStageBinary(ezGALShaderStage::Enum
   return pShaderStageBinary;
 }
 
+// static
+bool ezShaderStageBinary::HasStageBinary(ezGALShaderStage::Enum Stage, ezUInt32 uiHash)
+{
+  {
+    EZ_LOCK(s_ShaderStageBinariesMutex);
+
+    auto itStage = s_ShaderStageBinaries[Stage].Find(uiHash);
+    if (itStage.IsValid())
+      return !itStage.Value().m_ByteCode.IsEmpty();
+  }
+
+  ezStringBuilder sShaderStageFile = ezShaderManager::GetCacheDirectory();
+
+  sShaderStageFile.AppendPath(ezShaderManager::GetActivePlatform().GetData());
+  sShaderStageFile.AppendFormat("/{0}_{1}.ezShaderStage", ezGALShaderStage::Names[Stage], ezArgU(uiHash, 8, true, 16, true));
+
+  ezFileReader StageFileIn;
+  if (StageFileIn.Open(sShaderStageFile.GetData()).Failed())
+    return false;
+
+  // the header is laid out as in Write(), the byte code itself is not read
+  ezUInt8 uiVersion = 0;
+  if (StageFileIn.ReadBytes(&uiVersion, sizeof(ezUInt8)) != sizeof(ezUInt8) || uiVersion > ezShaderStageBinary::VersionCurrent)
+    return false;
+
+  ezUInt32 uiSourceHash = 0;
+  if (StageFileIn.ReadDWordValue(&uiSourceHash).Failed() || uiSourceHash != uiHash)
+    return false;
+
+  ezUInt8 uiStage = 0;
+  if (StageFileIn.ReadBytes(&uiStage, sizeof(ezUInt8)) != sizeof(ezUInt8) || uiStage != Stage)
+    return false;
+
+  ezUInt32 uiByteCodeSize = 0;
+  if (StageFileIn.ReadDWordValue(&uiByteCodeSize).Failed() || uiByteCodeSize == 0)
+    return false;
+
+  // a binary that was cut off while writing cannot contain all of its byte code
+  const ezUInt64 uiHeaderSize = 2 * sizeof(ezUInt8) + 2 * sizeof(ezUInt32);
+  return StageFileIn.GetFileSize() >= uiHeaderSize + uiByteCodeSize;
+}
+
 // static
 void ezShaderStageBinary::OnEngineShutdown()
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
   {
     s_ShaderStageBinaries[stage].Clear();
@@ -6,6 +6,7 @@
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/Stream.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/Enum.h>
 
 class EZ_RENDERERCORE_DLL ezShaderConstantBufferLayout : public ezRefCounted
@@ -161,8 +162,15 @@ private:
   ezResult WriteStageBinary(ezLogInterface* pLog) const;
   static ezShaderStageBinary* LoadStageBinary(ezGALShaderStage::Enum Stage, ezUInt32 uiHash);
 
+  /// \brief Checks whether a readable stage binary with the given hash exists, without loading its byte code.
+  ///
+  /// Only the header of the file is read, to reject binaries that were written in an incompatible version or are truncated.
+  static bool HasStageBinary(ezGALShaderStage::Enum Stage, ezUInt32 uiHash);
+
   static void OnEngineShutdown();
 
+  // shaders may be compiled on multiple threads at once, e.g. by the ShaderCompiler tool
+  static ezMutex s_ShaderStageBinariesMutex;
   static ezMap<ezUInt32, ezShaderStageBinary> s_ShaderStageBinaries[ezGALShaderStage::ENUM_COUNT];
 };
 
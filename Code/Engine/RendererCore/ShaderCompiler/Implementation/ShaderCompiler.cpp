@@ -165,10 +165,13 @@ ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<e
 
 ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFile,
                                                                 const ezArrayPtr<const ezPermutationVar>& permutationVars,
-                                                                ezLogInterface* pLog, const char* szPlatform)
+                                                                ezLogInterface* pLog, const char* szPlatform, bool bSkipUpToDatePermutations)
 {
   ezStringBuilder sFileContent, sTemp;
 
+  m_uiNumPlatforms = 0;
+  m_uiNumSkippedPlatforms = 0;
+
   {
     ezFileReader File;
     if (File.Open(szFile).Failed())
@@ -276,7 +279,7 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
     {
       ezShaderProgramCompiler* pCompiler = pAllocator->Allocate<ezShaderProgramCompiler>();
 
-      const ezResult ret = RunShaderCompiler(szFile, szPlatform, pCompiler, pLog);
+      const ezResult ret = RunShaderCompiler(szFile, szPlatform, pCompiler, pLog, bSkipUpToDatePermutations);
       pAllocator->Deallocate(pCompiler);
 
       if (ret.Failed())
@@ -290,7 +293,7 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
 }
 
 ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler,
-                                             ezLogInterface* pLog)
+                                             ezLogInterface* pLog, bool bSkipUpToDatePermutations)
 {
   EZ_LOG_BLOCK(pLog, "Compiling Shader", szFile);
 
@@ -310,6 +313,18 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
 
     EZ_LOG_BLOCK(pLog, "Platform", Platforms[p].GetData());
 
+    ++m_uiNumPlatforms;
+
+    ezStringBuilder sPermutationFile;
+    GetPermutationFilePath(szFile, Platforms[p], sPermutationFile);
+
+    if (bSkipUpToDatePermutations && IsPermutationUpToDate(sPermutationFile))
+    {
+      ezLog::Dev(pLog, "Permutation is up to date: '{0}'", sPermutationFile);
+      ++m_uiNumSkippedPlatforms;
+      continue;
+    }
+
     ezShaderProgramCompiler::ezShaderProgramData spd;
     spd.m_szSourceFile = szFile;
     spd.m_szPlatform = Platforms[p].GetData();
@@ -329,6 +344,14 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
     GenerateDefines(Platforms[p].GetData(), m_ShaderData.m_Permutations, defines);
     GenerateDefines(Platforms[p].GetData(), m_ShaderData.m_FixedPermVars, defines);
 
+    // stage binaries are shared between all shaders and permutations, so besides the source their key has to contain everything else
+    // that affects the byte code
+    ezStringBuilder sStageHashSeed = Platforms[p];
+    if (spd.m_Flags.IsSet(ezShaderCompilerFlags::Debug))
+      sStageHashSeed.Append("_DEBUG");
+
+    const ezUInt32 uiStageHashSeed = ezHashingUtils::xxHash32(sStageHashSeed.GetData(), sStageHashSeed.GetElementCount());
+
     ezShaderPermutationBinary shaderPermutationBinary;
 
     // Generate Shader State Source
@@ -423,7 +446,7 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
         uiSourceStringLen = sProcessed[stage].GetElementCount();
       }
 
-      spd.m_StageBinary[stage].m_uiSourceHash = ezHashingUtils::xxHash32(spd.m_szShaderSource[stage], uiSourceStringLen);
+      spd.m_StageBinary[stage].m_uiSourceHash = ezHashingUtils::xxHash32(spd.m_szShaderSource[stage], uiSourceStringLen, uiStageHashSeed);
 
       if (spd.m_StageBinary[stage].m_uiSourceHash != 0)
       {
@@ -464,16 +487,6 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       }
     }
 
-    ezStringBuilder sTemp = ezShaderManager::GetCacheDirectory();
-    sTemp.AppendPath(Platforms[p].GetData());
-    sTemp.AppendPath(szFile);
-    sTemp.ChangeFileExtension("");
-    if (sTemp.EndsWith("."))
-      sTemp.Shrink(0, 1);
-
-    const ezUInt32 uiPermutationHash = ezShaderHelper::CalculateHash(m_ShaderData.m_Permutations);
-    sTemp.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
-
     shaderPermutationBinary.m_DependencyFile.Clear();
     shaderPermutationBinary.m_DependencyFile.AddFileDependency(szFile);
 
@@ -485,12 +498,12 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
     shaderPermutationBinary.m_PermutationVars = m_ShaderData.m_Permutations;
 
     ezDeferredFileWriter PermutationFileOut;
-    PermutationFileOut.SetOutput(sTemp.GetData());
+    PermutationFileOut.SetOutput(sPermutationFile.GetData());
     shaderPermutationBinary.Write(PermutationFileOut);
 
     if (PermutationFileOut.Close().Failed())
     {
-      ezLog::Error(pLog, "Could not open file for writing: '{0}'", sTemp);
+      ezLog::Error(pLog, "Could not open file for writing: '{0}'", sPermutationFile);
       return EZ_FAILURE;
     }
   }
@@ -498,6 +511,51 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
   return EZ_SUCCESS;
 }
 
+void ezShaderCompiler::GetPermutationFilePath(const char* szFile, const char* szPlatform, ezStringBuilder& out_sPath) const
+{
+  out_sPath = ezShaderManager::GetCacheDirectory();
+  out_sPath.AppendPath(szPlatform);
+  out_sPath.AppendPath(szFile);
+  out_sPath.ChangeFileExtension("");
+  if (out_sPath.EndsWith("."))
+    out_sPath.Shrink(0, 1);
+
+  const ezUInt32 uiPermutationHash = ezShaderHelper::CalculateHash(m_ShaderData.m_Permutations);
+  out_sPath.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
+}
+
+bool ezShaderCompiler::IsPermutationUpToDate(const char* szPermutationFile) const
+{
+  ezFileReader file;
+  if (file.Open(szPermutationFile).Failed())
+    return false;
+
+  ezShaderPermutationBinary permutationBinary;
+  bool bOldVersion = false;
+  if (permutationBinary.Read(file, bOldVersion).Failed() || bOldVersion)
+    return false;
+
+  // the permutation hash in the file name could collide
+  if (permutationBinary.m_PermutationVars != m_ShaderData.m_Permutations)
+    return false;
+
+  // covers the shader file itself and all its includes
+  if (permutationBinary.m_DependencyFile.HasAnyFileChanged())
+    return false;
+
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    const ezUInt32 uiStageHash = permutationBinary.m_uiShaderStageHashes[stage];
+    if (uiStageHash == 0)
+      continue;
+
+    // only the header is checked, loading the byte code of every permutation would cost more than most recompiles save
+    if (!ezShaderStageBinary::HasStageBinary((ezGALShaderStage::Enum)stage, uiStageHash))
+      return false;
+  }
+
+  return true;
+}
 
 void ezShaderCompiler::WriteFailedShaderSource(ezShaderProgramCompiler::ezShaderProgramData& spd, ezLogInterface* pLog)
 {
@@ -64,11 +64,27 @@ public:
 class EZ_RENDERERCORE_DLL ezShaderCompiler
 {
 public:
+  /// \brief Compiles one permutation of the given shader for all enabled platforms.
+  ///
+  /// Stage binaries are stored by the hash of their preprocessed source and platform, so identical stages of different permutations are
+  /// only compiled once. With \a bSkipUpToDatePermutations, platforms for which the permutation file already exists, references only
+  /// existing stage binaries and none of the source files changed since, are skipped without even preprocessing the shader.
   ezResult CompileShaderPermutationForPlatforms(const char* szFile, const ezArrayPtr<const ezPermutationVar>& permutationVars,
-                                                ezLogInterface* pLog, const char* szPlatform = "ALL");
+                                                ezLogInterface* pLog, const char* szPlatform = "ALL", bool bSkipUpToDatePermutations = false);
+
+  /// \brief Returns for how many platforms the last call to CompileShaderPermutationForPlatforms() found the permutation to be up to date.
+  ezUInt32 GetNumSkippedPlatforms() const { return m_uiNumSkippedPlatforms; }
+
+  /// \brief Returns for how many platforms the last call to CompileShaderPermutationForPlatforms() had to provide the permutation, ie. the
+  /// platforms that were requested and that the shader is tagged for.
+  ezUInt32 GetNumPlatforms() const { return m_uiNumPlatforms; }
 
 private:
-  ezResult RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezLogInterface* pLog);
+  ezResult RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezLogInterface* pLog,
+                             bool bSkipUpToDatePermutations);
+
+  void GetPermutationFilePath(const char* szFile, const char* szPlatform, ezStringBuilder& out_sPath) const;
+  bool IsPermutationUpToDate(const char* szPermutationFile) const;
 
   void WriteFailedShaderSource(ezShaderProgramCompiler::ezShaderProgramData& spd, ezLogInterface* pLog);
 
@@ -91,5 +107,7 @@ private:
   ezShaderData m_ShaderData;
 
   ezSet<ezString> m_IncludeFiles;
+  ezUInt32 m_uiNumPlatforms = 0;
+  ezUInt32 m_uiNumSkippedPlatforms = 0;
 };
 
@@ -4,8 +4,10 @@
 #include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
@@ -16,6 +18,7 @@ bool ezFileserveClient::s_bEnableFileserve = true;
 
 ezFileserveClient::ezFileserveClient()
     : m_SingletonRegistrar(this)
+    , m_CacheWriteTask("Fileserve Cache Writes", ezMakeDelegate(&ezFileserveClient::ProcessCacheWrites, this))
 {
   AddServerAddressToTry("localhost:1042");
 
@@ -48,12 +51,15 @@ ezFileserveClient::ezFileserveClient()
   if (ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-fs_off"))
     s_bEnableFileserve = false;
 
+  m_PrefetchTimeout = ezTime::Seconds(ezCommandLineUtils::GetGlobalInstance()->GetFloatOption("-fs_prefetch_timeout", 5.0));
+
   m_CurrentTime = ezTime::Now();
 }
 
 ezFileserveClient::~ezFileserveClient()
 {
   ShutdownConnection();
+  WaitForCacheWrites();
 }
 
 void ezFileserveClient::ShutdownConnection()
@@ -71,9 +77,17 @@ void ezFileserveClient::ClearState()
 {
   m_bDownloading = false;
   m_bWaitingForUploadFinished = false;
+  m_uiServerProtocolVersion = ezFileserveProtocolVersion::Basic;
   m_CurFileRequestGuid = ezUuid();
   m_sCurFileRequest.Clear();
   m_Download.Clear();
+  m_PrefetchBatches.Clear();
+  m_PrefetchedFiles.Clear();
+
+  for (DataDir& dd : m_MountedDataDirs)
+  {
+    dd.m_bPrefetched = false;
+  }
 }
 
 ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
@@ -126,7 +140,10 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
       ezLog::Success("Connected to ezFileserver '{0}", m_sServerConnectionAddress);
       m_Network->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserveClient::NetworkMsgHandler, this));
 
-      m_Network->Send('FSRV', 'HELO'); // be friendly
+      // be friendly, newer servers answer when they are told the protocol version
+      ezRemoteMessage hello('FSRV', 'HELO');
+      hello.GetWriter() << (ezUInt16)ezFileserveProtocolVersion::Current;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, hello);
     }
 
     m_bFailedToConnect = false;
@@ -154,6 +171,8 @@ void ezFileserveClient::UpdateClient()
   m_CurrentTime = ezTime::Now();
 
   m_Network->ExecuteAllMessageHandlers();
+
+  StartCacheWriteTask();
 }
 
 void ezFileserveClient::AddServerAddressToTry(const char* szAddress)
@@ -191,9 +210,9 @@ void ezFileserveClient::UploadFile(ezUInt16 uiDataDirID, const char* szFile, con
       uiHash = ezHashingUtils::xxHash64(fileContent.GetData(), fileContent.GetCount(), uiHash);
     }
 
-    WriteMetaFile(sCachedMetaFile, 0, uiHash);
-
     InvalidateFileCache(uiDataDirID, szFile, uiHash);
+
+    WriteMetaFile(sCachedMetaFile, 0, uiHash);
   }
 
   const ezUInt32 uiFileSize = fileContent.GetCount();
@@ -254,6 +273,10 @@ void ezFileserveClient::UploadFile(ezUInt16 uiDataDirID, const char* szFile, con
 void ezFileserveClient::InvalidateFileCache(ezUInt16 uiDataDirID, const char* szFile, ezUInt64 uiHash)
 {
   EZ_LOCK(m_Mutex);
+
+  // an update from the server that is still queued must not overwrite the new state
+  FinishCacheWrite(uiDataDirID, szFile, true);
+
   auto& cache = m_MountedDataDirs[uiDataDirID].m_CacheStatus[szFile];
   cache.m_FileHash = uiHash;
   cache.m_TimeStamp = 0;
@@ -267,8 +290,7 @@ void ezFileserveClient::InvalidateFileCache(ezUInt16 uiDataDirID, const char* sz
 void ezFileserveClient::FillFileStatusCache(const char* szFile)
 {
   EZ_LOCK(m_Mutex);
-  auto it = m_FileDataDir.FindOrAdd(szFile);
-  it.Value() = 0xffff; // does not exist
+  ezUInt16 uiBestDataDir = 0xffff; // does not exist
 
   for (ezUInt32 i = m_MountedDataDirs.GetCount(); i > 0; --i)
   {
@@ -285,13 +307,15 @@ void ezFileserveClient::FillFileStatusCache(const char* szFile)
     if (cache.m_TimeStamp != 0 && cache.m_FileHash != 0) // file exists
     {
       // best possible candidate
-      if (it.Value() == 0xffff)
-        it.Value() = dd;
+      if (uiBestDataDir == 0xffff)
+        uiBestDataDir = dd;
     }
   }
 
-  if (it.Value() == 0xffff)
-    it.Value() = 0; // fallback
+  if (uiBestDataDir == 0xffff)
+    uiBestDataDir = 0; // fallback
+
+  m_FileDataDir[szFile] = uiBestDataDir;
 }
 
 void ezFileserveClient::BuildPathInCache(const char* szFile, const char* szMountPoint, ezStringBuilder& out_sAbsPath,
@@ -345,6 +369,30 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'HELO')
+  {
+    HandleHelloMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFDT')
+  {
+    HandlePrefetchTransferMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFFN')
+  {
+    HandlePrefetchFileFinishedMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFEN')
+  {
+    HandlePrefetchBatchFinishedMsg(msg);
+    return;
+  }
+
   static bool s_bReloadResources = false;
 
   if (msg.GetMessageID() == 'RLDR')
@@ -399,6 +447,12 @@ ezUInt16 ezFileserveClient::MountDataDirectory(const char* szDataDirectory, cons
   dd.m_sMountPoint = sMountPoint;
   dd.m_bMounted = true;
 
+  // otherwise this is done once the server has told which protocol it supports
+  if (m_uiServerProtocolVersion >= ezFileserveProtocolVersion::Prefetch)
+  {
+    PrefetchCachedFiles(uiDataDirID);
+  }
+
   return uiDataDirID;
 }
 
@@ -481,29 +535,170 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
     }
   }
 
-  ezFileserveFileState fileState;
+  CacheWrite write;
   {
     ezInt8 iFileStatus = 0;
     msg.GetReader() >> iFileStatus;
-    fileState = (ezFileserveFileState)iFileStatus;
+    write.m_FileState = (ezFileserveFileState)iFileStatus;
+  }
+
+  msg.GetReader() >> write.m_iTimeStamp;
+  msg.GetReader() >> write.m_uiFileHash;
+
+  ezUInt16 uiFoundInDataDir = 0;
+  msg.GetReader() >> uiFoundInDataDir;
+
+  write.m_uiFileSize = m_Download.GetCount();
+  write.m_Data.Swap(m_Download);
+
+  // the file is accessed right after this, so it is written to the cache immediately
+  ApplyFileState(m_sCurFileRequest, uiFoundInDataDir, write, false);
+}
+
+void ezFileserveClient::HandleHelloMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  msg.GetReader() >> m_uiServerProtocolVersion;
+
+  if (m_uiServerProtocolVersion < ezFileserveProtocolVersion::Prefetch)
+    return;
+
+  // data directories that were mounted before the answer arrived
+  for (ezUInt16 uiDataDirID = 0; uiDataDirID < m_MountedDataDirs.GetCount(); ++uiDataDirID)
+  {
+    if (m_MountedDataDirs[uiDataDirID].m_bMounted)
+    {
+      PrefetchCachedFiles(uiDataDirID);
+    }
   }
+}
+
+void ezFileserveClient::HandlePrefetchTransferMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  // the server broadcasts its answers to all clients
+  if (m_PrefetchBatches.IsEmpty() || m_PrefetchBatches.PeekFront().m_BatchGuid != batchGuid)
+    return;
 
-  ezInt64 iFileTimeStamp = 0;
-  msg.GetReader() >> iFileTimeStamp;
+  PrefetchBatch& batch = m_PrefetchBatches.PeekFront();
+
+  ezUInt16 uiChunkSize = 0;
+  msg.GetReader() >> uiChunkSize;
+
+  const ezUInt32 uiStartPos = batch.m_Download.GetCount();
+  batch.m_Download.SetCountUninitialized(uiStartPos + uiChunkSize);
+  msg.GetReader().ReadBytes(&batch.m_Download[uiStartPos], uiChunkSize);
+}
+
+void ezFileserveClient::HandlePrefetchFileFinishedMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
 
-  ezUInt64 uiFileHash = 0;
-  msg.GetReader() >> uiFileHash;
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  if (m_PrefetchBatches.IsEmpty() || m_PrefetchBatches.PeekFront().m_BatchGuid != batchGuid)
+    return;
+
+  PrefetchBatch& batch = m_PrefetchBatches.PeekFront();
+
+  ezUInt32 uiEntry = 0;
+  msg.GetReader() >> uiEntry;
+
+  CacheWrite write;
+  {
+    ezInt8 iFileStatus = 0;
+    msg.GetReader() >> iFileStatus;
+    write.m_FileState = (ezFileserveFileState)iFileStatus;
+  }
+
+  msg.GetReader() >> write.m_iTimeStamp;
+  msg.GetReader() >> write.m_uiFileHash;
 
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
+  msg.GetReader() >> write.m_uiCompression;
+  msg.GetReader() >> write.m_uiFileSize;
+
+  write.m_Data.Swap(batch.m_Download);
+
+  // the server answers in order, everything it skipped is unchanged
+  ValidatePrefetchedFiles(batch, uiEntry);
+
+  const ezString& sFile = batch.m_Entries[uiEntry].m_sFile;
+  ApplyFileState(sFile, uiFoundInDataDir, write, true);
+  ReleasePrefetchedFile(sFile);
+
+  batch.m_uiNextEntry = uiEntry + 1;
+}
+
+void ezFileserveClient::HandlePrefetchBatchFinishedMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  if (m_PrefetchBatches.IsEmpty() || m_PrefetchBatches.PeekFront().m_BatchGuid != batchGuid)
+    return;
+
+  PrefetchBatch& batch = m_PrefetchBatches.PeekFront();
+  ValidatePrefetchedFiles(batch, batch.m_Entries.GetCount());
+
+  m_PrefetchBatches.PopFront();
+}
+
+void ezFileserveClient::ValidatePrefetchedFiles(PrefetchBatch& batch, ezUInt32 uiEndEntry)
+{
+  EZ_LOCK(m_Mutex);
+
+  for (ezUInt32 i = batch.m_uiNextEntry; i < uiEndEntry; ++i)
+  {
+    const PrefetchEntry& entry = batch.m_Entries[i];
+
+    // the server found the same file in the same data directory, so the cached version is still the best match
+    m_FileDataDir[entry.m_sFile] = batch.m_uiDataDirID;
+
+    auto& ref = m_MountedDataDirs[batch.m_uiDataDirID].m_CacheStatus[entry.m_sFile];
+    ref.m_FileHash = entry.m_uiFileHash;
+    ref.m_TimeStamp = entry.m_iTimeStamp;
+    ref.m_LastCheck = m_CurrentTime;
+
+    ReleasePrefetchedFile(entry.m_sFile);
+  }
+
+  batch.m_uiNextEntry = uiEndEntry;
+}
+
+void ezFileserveClient::ReleasePrefetchedFile(const ezString& sFile)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUInt32* pCount = nullptr;
+  if (m_PrefetchedFiles.TryGetValue(sFile, pCount))
+  {
+    if (--(*pCount) == 0)
+      m_PrefetchedFiles.Remove(sFile);
+  }
+}
+
+void ezFileserveClient::ApplyFileState(const char* szFile, ezUInt16 uiFoundInDataDir, CacheWrite& write, bool bWriteInBackground)
+{
+  EZ_LOCK(m_Mutex);
+
   if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[szFile] = 0; // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[szFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
@@ -513,43 +708,142 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[szFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
-    ref.m_FileHash = uiFileHash;
-    ref.m_TimeStamp = iFileTimeStamp;
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[szFile];
+    ref.m_FileHash = write.m_uiFileHash;
+    ref.m_TimeStamp = write.m_iTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
   }
 
-  // nothing changed
-  if (fileState == ezFileserveFileState::SameTimestamp || fileState == ezFileserveFileState::NonExistantEither)
-    return;
-
   const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, sCachedFile, sCachedMetaFile);
+  BuildPathInCache(szFile, sMountPoint, sCachedFile, sCachedMetaFile);
 
-  if (fileState == ezFileserveFileState::NonExistant)
+  // nothing changed
+  if (write.m_FileState == ezFileserveFileState::SameTimestamp || write.m_FileState == ezFileserveFileState::NonExistantEither)
   {
-    // remove them from the cache as well, if they still exist there
-    ezOSFile::DeleteFile(sCachedFile);
-    ezOSFile::DeleteFile(sCachedMetaFile);
+    // but a previous update may still be queued, which has to be done before the file gets read
+    FinishCacheWrite(sCachedFile, false);
     return;
   }
 
-  // timestamp changed, but hash is still the same -> update timestamp
-  if (fileState == ezFileserveFileState::SameHash)
+  write.m_sCachedFile = sCachedFile;
+  write.m_sCachedMetaFile = sCachedMetaFile;
+
+  if (bWriteInBackground)
+  {
+    QueueCacheWrite(std::move(write));
+  }
+  else
   {
-    WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
+    // this update supersedes anything that is still queued
+    FinishCacheWrite(sCachedFile, true);
+    WriteToCache(write);
   }
+}
+
+void ezFileserveClient::PrefetchCachedFiles(ezUInt16 uiDataDirID)
+{
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+  EZ_LOCK(m_Mutex);
+
+  if (m_MountedDataDirs[uiDataDirID].m_bPrefetched)
+    return;
+
+  m_MountedDataDirs[uiDataDirID].m_bPrefetched = true;
 
-  if (fileState == ezFileserveFileState::Different)
+  // small batches allow the server to start answering before the entire manifest was transmitted
+  const ezUInt32 uiMaxBatchSize = 128;
+
+  const ezString& sMountPoint = m_MountedDataDirs[uiDataDirID].m_sMountPoint;
+
+  ezStringBuilder sMetaFolder = m_sFileserveCacheMetaFolder;
+  sMetaFolder.AppendPath(sMountPoint);
+  sMetaFolder.MakeCleanPath();
+
+  ezFileSystemIterator it;
+  if (it.StartSearch(sMetaFolder, ezFileSystemIteratorFlags::ReportFilesRecursive).Failed())
+    return;
+
+  ezStringBuilder sFile, sCachedFile, sCachedMetaFile;
+
+  PrefetchBatch batch;
+  batch.m_uiDataDirID = uiDataDirID;
+
+  do
+  {
+    it.GetStats().GetFullPath(sFile);
+    sFile.MakeCleanPath();
+
+    if (sFile.MakeRelativeTo(sMetaFolder).Failed())
+      continue;
+
+    BuildPathInCache(sFile, sMountPoint, sCachedFile, sCachedMetaFile);
+
+    if (!ezOSFile::ExistsFile(sCachedFile))
+      continue;
+
+    ezOSFile meta;
+    if (meta.Open(sCachedMetaFile, ezFileOpenMode::Read).Failed())
+      continue;
+
+    PrefetchEntry& entry = batch.m_Entries.ExpandAndGetRef();
+    entry.m_sFile = sFile;
+    meta.Read(&entry.m_iTimeStamp, sizeof(ezInt64));
+    meta.Read(&entry.m_uiFileHash, sizeof(ezUInt64));
+
+    if (batch.m_Entries.GetCount() == uiMaxBatchSize)
+    {
+      SendPrefetchBatch(std::move(batch));
+
+      batch = PrefetchBatch();
+      batch.m_uiDataDirID = uiDataDirID;
+    }
+  } while (it.Next().Succeeded());
+
+  if (!batch.m_Entries.IsEmpty())
   {
-    WriteDownloadToDisk(sCachedFile);
-    WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
+    SendPrefetchBatch(std::move(batch));
   }
+#endif
 }
 
+void ezFileserveClient::SendPrefetchBatch(PrefetchBatch&& batch)
+{
+  EZ_LOCK(m_Mutex);
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  const bool bSupportsZstd = true;
+#else
+  const bool bSupportsZstd = false;
+#endif
+
+  batch.m_BatchGuid.CreateNewUuid();
+
+  ezRemoteMessage msg('FSRV', 'PFRQ');
+  msg.GetWriter() << batch.m_BatchGuid;
+  msg.GetWriter() << batch.m_uiDataDirID;
+  msg.GetWriter() << bSupportsZstd;
+  msg.GetWriter() << batch.m_Entries.GetCount();
+
+  for (const PrefetchEntry& entry : batch.m_Entries)
+  {
+    msg.GetWriter() << entry.m_sFile;
+    msg.GetWriter() << entry.m_iTimeStamp;
+    msg.GetWriter() << entry.m_uiFileHash;
+
+    ezUInt32* pCount = nullptr;
+    if (m_PrefetchedFiles.TryGetValue(entry.m_sFile, pCount))
+      ++(*pCount);
+    else
+      m_PrefetchedFiles.Insert(entry.m_sFile, 1);
+  }
+
+  m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+
+  m_PrefetchBatches.PushBack(std::move(batch));
+}
 
 void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash)
 {
@@ -567,23 +861,178 @@ void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 i
   }
 }
 
-void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile)
+void ezFileserveClient::WriteToCache(CacheWrite& write)
+{
+  if (write.m_FileState == ezFileserveFileState::NonExistant)
+  {
+    // remove them from the cache as well, if they still exist there
+    ezOSFile::DeleteFile(write.m_sCachedFile);
+    ezOSFile::DeleteFile(write.m_sCachedMetaFile);
+    return;
+  }
+
+  if (write.m_FileState == ezFileserveFileState::Different)
+  {
+    ezArrayPtr<const ezUInt8> content = write.m_Data;
+    ezDynamicArray<ezUInt8> decompressed;
+
+    if (write.m_uiCompression != 0)
+    {
+      bool bDecompressed = false;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      ezRawMemoryStreamReader compressedReader(write.m_Data.GetData(), write.m_Data.GetCount());
+      ezCompressedStreamReaderZstd decompressor(&compressedReader);
+
+      decompressed.SetCountUninitialized(write.m_uiFileSize);
+      bDecompressed = decompressor.ReadBytes(decompressed.GetData(), write.m_uiFileSize) == write.m_uiFileSize;
+#endif
+
+      if (!bDecompressed)
+      {
+        ezLog::Error("Failed to decompress download for '{0}'", write.m_sCachedFile);
+
+        // without the meta file, the broken file gets requested again
+        ezOSFile::DeleteFile(write.m_sCachedFile);
+        ezOSFile::DeleteFile(write.m_sCachedMetaFile);
+        return;
+      }
+
+      content = decompressed;
+    }
+
+    ezOSFile file;
+    if (file.Open(write.m_sCachedFile, ezFileOpenMode::Write).Succeeded())
+    {
+      if (!content.IsEmpty())
+        file.Write(content.GetPtr(), content.GetCount());
+
+      file.Close();
+    }
+    else
+    {
+      ezLog::Error("Failed to write download to '{0}'", write.m_sCachedFile);
+    }
+  }
+
+  // for ezFileserveFileState::SameHash only the timestamp needs to be updated
+  WriteMetaFile(write.m_sCachedMetaFile, write.m_iTimeStamp, write.m_uiFileHash);
+}
+
+void ezFileserveClient::QueueCacheWrite(CacheWrite&& write)
+{
+  {
+    EZ_LOCK(m_CacheWriteMutex);
+
+    const ezString sCachedFile = write.m_sCachedFile;
+    m_CacheWriteQueue.PushBack(sCachedFile);
+    m_CacheWrites[sCachedFile] = std::move(write);
+  }
+
+  StartCacheWriteTask();
+}
+
+void ezFileserveClient::StartCacheWriteTask()
 {
   EZ_LOCK(m_Mutex);
-  ezOSFile file;
-  if (file.Open(sCachedFile, ezFileOpenMode::Write).Succeeded())
+
+  // while the task is running it picks up all new work, if it just finished, the next update starts it again
+  if (!m_CacheWriteTask.IsTaskFinished())
+    return;
+
   {
-    if (!m_Download.IsEmpty())
-      file.Write(m_Download.GetData(), m_Download.GetCount());
+    EZ_LOCK(m_CacheWriteMutex);
+    if (m_CacheWriteQueue.IsEmpty())
+      return;
+  }
 
-    file.Close();
+  m_CacheWriteTaskGroup = ezTaskSystem::StartSingleTask(&m_CacheWriteTask, ezTaskPriority::FileAccess);
+}
+
+void ezFileserveClient::ProcessCacheWrites()
+{
+  CacheWrite write;
+
+  while (true)
+  {
+    {
+      EZ_LOCK(m_CacheWriteMutex);
+      m_sCacheWriteInProgress.Clear();
+
+      bool bFound = false;
+      while (!bFound && !m_CacheWriteQueue.IsEmpty())
+      {
+        // entries may have been written or discarded through FinishCacheWrite() already
+        bFound = m_CacheWrites.Remove(m_CacheWriteQueue.PeekFront(), &write);
+
+        if (bFound)
+          m_sCacheWriteInProgress = m_CacheWriteQueue.PeekFront();
+
+        m_CacheWriteQueue.PopFront();
+      }
+
+      if (!bFound)
+        return;
+    }
+
+    WriteToCache(write);
   }
-  else
+}
+
+void ezFileserveClient::FinishCacheWrite(const char* szCachedFile, bool bDiscard)
+{
+  CacheWrite write;
+
+  while (true)
   {
-    ezLog::Error("Failed to write download to '{0}'", sCachedFile);
+    {
+      EZ_LOCK(m_CacheWriteMutex);
+
+      if (m_sCacheWriteInProgress != szCachedFile)
+      {
+        if (!m_CacheWrites.Remove(szCachedFile, &write))
+          return;
+
+        break;
+      }
+    }
+
+    // the background task is currently writing this file
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  if (!bDiscard)
+  {
+    WriteToCache(write);
   }
 }
 
+void ezFileserveClient::FinishCacheWrite(ezUInt16 uiDataDirID, const char* szFile, bool bDiscard)
+{
+  {
+    EZ_LOCK(m_CacheWriteMutex);
+
+    if (m_CacheWrites.IsEmpty() && m_sCacheWriteInProgress.IsEmpty())
+      return;
+  }
+
+  ezStringBuilder sCachedFile, sCachedMetaFile;
+  BuildPathInCache(szFile, m_MountedDataDirs[uiDataDirID].m_sMountPoint, sCachedFile, sCachedMetaFile);
+
+  FinishCacheWrite(sCachedFile, bDiscard);
+}
+
+void ezFileserveClient::WaitForCacheWrites()
+{
+  if (m_CacheWriteTaskGroup.IsValid())
+  {
+    ezTaskSystem::WaitForGroup(m_CacheWriteTaskGroup);
+  }
+
+  // anything that was queued after the task stopped
+  ProcessCacheWrites();
+}
+
 ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir)
 {
   EZ_LOCK(m_Mutex);
@@ -600,14 +1049,32 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   if (!m_Network->IsConnectedToServer())
     return EZ_FAILURE;
 
-  bool bCachedYet = false;
-  auto itFileDataDir = m_FileDataDir.FindOrAdd(szFile, &bCachedYet);
-  if (!bCachedYet)
+  // the file is part of a manifest that the server has not fully answered yet, asking for it separately would usually take longer
+  if (m_PrefetchedFiles.Contains(szFile))
+  {
+    const ezTime tStart = ezTime::Now();
+
+    while (m_PrefetchedFiles.Contains(szFile) && m_Network->IsConnectedToServer())
+    {
+      if (ezTime::Now() - tStart > m_PrefetchTimeout)
+      {
+        // a late answer for the file only updates the cache again, so it does not need to be waited for anymore
+        ezLog::Warning("Fileserve prefetch of '{0}' timed out, downloading it separately", szFile);
+        m_PrefetchedFiles.Remove(szFile);
+        break;
+      }
+
+      m_Network->UpdateRemoteInterface();
+      m_Network->ExecuteAllMessageHandlers();
+    }
+  }
+
+  if (!m_FileDataDir.Contains(szFile))
   {
     FillFileStatusCache(szFile);
   }
 
-  const ezUInt16 uiUseDataDirCache = bForceThisDataDir ? uiDataDirID : itFileDataDir.Value();
+  const ezUInt16 uiUseDataDirCache = bForceThisDataDir ? uiDataDirID : m_FileDataDir[szFile];
   const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiUseDataDirCache].m_CacheStatus[szFile];
 
   if (m_CurrentTime - CacheStatus.m_LastCheck < ezTime::Seconds(5.0f))
@@ -615,6 +1082,8 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
     if (CacheStatus.m_FileHash == 0) // file does not exist
       return EZ_FAILURE;
 
+    // a prefetched update of the file might not be written yet
+    FinishCacheWrite(uiUseDataDirCache, szFile, false);
     return EZ_SUCCESS;
   }
 
@@ -648,7 +1117,7 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
   else
   {
-    const ezUInt16 uiBestDir = itFileDataDir.Value();
+    const ezUInt16 uiBestDir = m_FileDataDir[m_sCurFileRequest];
     if (uiBestDir == uiDataDirID) // best match is still this? -> success
     {
       // file does not exist
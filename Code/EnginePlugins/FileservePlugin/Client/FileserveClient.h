@@ -2,8 +2,12 @@
 
 #include <FileservePlugin/FileservePluginDLL.h>
 
+#include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Configuration/Singleton.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <Foundation/Types/Uuid.h>
 
@@ -24,6 +28,12 @@ namespace ezDataDirectory
 /// The timeout for connecting to the server can be configured through the command line option "-fs_timeout seconds"
 /// The server to connect to can be configured through command line option "-fs_server address".
 /// The default address is "localhost:1042".
+///
+/// When a data directory gets mounted, the client sends a manifest of all files that it already has in its cache for that directory.
+/// The server answers only for the files that have changed and streams those without waiting for the client. Unchanged files are
+/// thus validated without a round trip per file, and changed files get written to the cache on a background task.
+/// This is only done once the server has reported through its reply to 'HELO' that it supports it. A file that is requested while its
+/// manifest is still unanswered is waited for at most "-fs_prefetch_timeout seconds" (default 5), then it is downloaded on its own.
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClient
 {
   EZ_DECLARE_SINGLETON(ezFileserveClient);
@@ -98,8 +108,39 @@ private:
     // ezString m_sPathOnClient;
     ezString m_sMountPoint;
     bool m_bMounted = false;
+    bool m_bPrefetched = false;
+
+    ezHashTable<ezString, FileCacheStatus> m_CacheStatus;
+  };
 
-    ezMap<ezString, FileCacheStatus> m_CacheStatus;
+  struct PrefetchEntry
+  {
+    ezString m_sFile;
+    ezInt64 m_iTimeStamp = 0;
+    ezUInt64 m_uiFileHash = 0;
+  };
+
+  /// \brief A manifest of cached files that was sent to the server and is not fully answered yet.
+  struct PrefetchBatch
+  {
+    ezUuid m_BatchGuid;
+    ezUInt16 m_uiDataDirID = 0;
+    ezUInt32 m_uiNextEntry = 0; ///< The server answers in order, all entries before this one are handled.
+    ezDynamicArray<PrefetchEntry> m_Entries;
+    ezDynamicArray<ezUInt8> m_Download;
+  };
+
+  /// \brief An update to a file in the cache, done either right away or on a background task.
+  struct CacheWrite
+  {
+    ezString m_sCachedFile;
+    ezString m_sCachedMetaFile;
+    ezFileserveFileState m_FileState = ezFileserveFileState::None;
+    ezInt64 m_iTimeStamp = 0;
+    ezUInt64 m_uiFileHash = 0;
+    ezUInt8 m_uiCompression = 0; ///< 0 = uncompressed, 1 = zstd
+    ezUInt32 m_uiFileSize = 0;
+    ezDynamicArray<ezUInt8> m_Data;
   };
 
   void DeleteFile(ezUInt16 uiDataDir, const char* szFile);
@@ -112,8 +153,23 @@ private:
   void NetworkMsgHandler(ezRemoteMessage& msg);
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
+  void HandleHelloMsg(ezRemoteMessage& msg);
+  void HandlePrefetchTransferMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFileFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchBatchFinishedMsg(ezRemoteMessage& msg);
+  void ValidatePrefetchedFiles(PrefetchBatch& batch, ezUInt32 uiEndEntry);
+  void ReleasePrefetchedFile(const ezString& sFile);
+  void ApplyFileState(const char* szFile, ezUInt16 uiFoundInDataDir, CacheWrite& write, bool bWriteInBackground);
+  void PrefetchCachedFiles(ezUInt16 uiDataDirID);
+  void SendPrefetchBatch(PrefetchBatch&& batch);
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
-  void WriteDownloadToDisk(ezStringBuilder sCachedFile);
+  static void WriteToCache(CacheWrite& write);
+  void QueueCacheWrite(CacheWrite&& write);
+  void StartCacheWriteTask();
+  void FinishCacheWrite(const char* szCachedFile, bool bDiscard);
+  void FinishCacheWrite(ezUInt16 uiDataDirID, const char* szFile, bool bDiscard);
+  void ProcessCacheWrites();
+  void WaitForCacheWrites();
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir);
   void DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const;
   void UploadFile(ezUInt16 uiDataDirID, const char* szFile, const ezDynamicArray<ezUInt8>& fileContent);
@@ -131,6 +187,8 @@ private:
   bool m_bDownloading = false;
   bool m_bFailedToConnect = false;
   bool m_bWaitingForUploadFinished = false;
+  ezUInt16 m_uiServerProtocolVersion = ezFileserveProtocolVersion::Basic;
+  ezTime m_PrefetchTimeout;
   ezUuid m_CurFileRequestGuid;
   ezStringBuilder m_sCurFileRequest;
   ezUniquePtr<ezRemoteInterface> m_Network;
@@ -138,6 +196,18 @@ private:
   ezTime m_CurrentTime;
   ezHybridArray<ezString, 4> m_TryServerAddresses;
 
-  ezMap<ezString, ezUInt16> m_FileDataDir;
+  ezHashTable<ezString, ezUInt16> m_FileDataDir;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
+
+  // manifests that were sent to the server in this order and files that are part of them (with a counter)
+  ezDeque<PrefetchBatch> m_PrefetchBatches;
+  ezHashTable<ezString, ezUInt32> m_PrefetchedFiles;
+
+  // cache writes that are not done yet, by cached file path, the queue is processed in order by m_CacheWriteTask
+  ezMutex m_CacheWriteMutex;
+  ezHashTable<ezString, CacheWrite> m_CacheWrites;
+  ezDeque<ezString> m_CacheWriteQueue;
+  ezString m_sCacheWriteInProgress;
+  ezDelegateTask<void> m_CacheWriteTask;
+  ezTaskGroupID m_CacheWriteTaskGroup;
 };
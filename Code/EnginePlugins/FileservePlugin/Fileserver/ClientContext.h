@@ -14,6 +14,20 @@ enum class ezFileserveFileState
   Different = 5,
 };
 
+/// \brief The protocol version that client and server exchange through their 'HELO' messages.
+///
+/// The server only replies to clients that send a version of at least Prefetch, older clients send an empty 'HELO'.
+/// Servers that do not reply at all only support single file requests.
+struct ezFileserveProtocolVersion
+{
+  enum Enum : ezUInt16
+  {
+    Basic = 0,
+    Prefetch = 1, ///< Supports manifests of cached files ('PFRQ')
+    Current = Prefetch,
+  };
+};
+
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClientContext
 {
 public:
@@ -4,7 +4,9 @@
 #include <FileservePlugin/Fileserver/Fileserver.h>
 #include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
 EZ_IMPLEMENT_SINGLETON(ezFileserver);
@@ -83,7 +85,24 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
   auto& client = DetermineClient(msg);
 
   if (msg.GetMessageID() == 'HELO')
+  {
+    // older clients send no protocol version and would not know what to do with an answer
+    if (msg.GetMessageSize() < sizeof(ezUInt16))
+      return;
+
+    ezUInt16 uiClientProtocolVersion = ezFileserveProtocolVersion::Basic;
+    msg.GetReader() >> uiClientProtocolVersion;
+
+    if (uiClientProtocolVersion < ezFileserveProtocolVersion::Prefetch)
+      return;
+
+    // tells the client which messages it may use, older servers do not answer
+    ezRemoteMessage ret('FSRV', 'HELO');
+    ret.GetWriter() << (ezUInt16)ezFileserveProtocolVersion::Current;
+
+    m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
     return;
+  }
 
   if (msg.GetMessageID() == 'RUTR')
   {
@@ -102,6 +121,12 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PFRQ')
+  {
+    HandlePrefetchRequest(client, msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -334,6 +359,138 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   }
 }
 
+void ezFileserver::HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  ezUInt16 uiDataDirID = 0;
+  msg.GetReader() >> uiDataDirID;
+
+  bool bClientSupportsZstd = false;
+  msg.GetReader() >> bClientSupportsZstd;
+
+  ezUInt32 uiNumEntries = 0;
+  msg.GetReader() >> uiNumEntries;
+
+  ezFileserverEvent e;
+  e.m_uiClientID = client.m_uiApplicationID;
+
+  ezUInt32 uiNumChangedFiles = 0;
+  ezStringBuilder sRequestedFile;
+
+  for (ezUInt32 uiEntry = 0; uiEntry < uiNumEntries; ++uiEntry)
+  {
+    msg.GetReader() >> sRequestedFile;
+
+    ezFileserveClientContext::FileStatus status;
+    msg.GetReader() >> status.m_iTimestamp;
+    msg.GetReader() >> status.m_uiHash;
+
+    ezUInt16 uiFoundInDataDir = uiDataDirID;
+    ezFileserveFileState filestate = client.GetFileStatus(uiFoundInDataDir, sRequestedFile, status, m_SendToClient, false);
+
+    // the client only reports files that are in its cache, everything it does not hear about is considered up to date
+    if (filestate == ezFileserveFileState::SameTimestamp)
+      continue;
+
+    // the client has the file in its cache, so it has to be removed there
+    if (filestate == ezFileserveFileState::NonExistantEither)
+      filestate = ezFileserveFileState::NonExistant;
+
+    ++uiNumChangedFiles;
+
+    ezUInt8 uiCompression = 0; // 0 = uncompressed, 1 = zstd
+    ezArrayPtr<const ezUInt8> data;
+
+    if (filestate == ezFileserveFileState::Different)
+    {
+      data = m_SendToClient;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      // tiny files are not worth the effort
+      if (bClientSupportsZstd && m_SendToClient.GetCount() > 256)
+      {
+        m_CompressedSendToClient.Clear();
+
+        {
+          ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&m_CompressedSendToClient);
+          ezMemoryStreamWriter writer(&storage);
+          ezCompressedStreamWriterZstd compressor(&writer, ezCompressedStreamWriterZstd::Compression::Fastest);
+          compressor.WriteBytes(m_SendToClient.GetData(), m_SendToClient.GetCount());
+          compressor.FinishCompressedStream();
+        }
+
+        if (m_CompressedSendToClient.GetCount() < m_SendToClient.GetCount())
+        {
+          data = m_CompressedSendToClient;
+          uiCompression = 1;
+        }
+      }
+#endif
+    }
+
+    e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
+    e.m_szPath = sRequestedFile;
+    e.m_uiSizeTotal = data.GetCount();
+    e.m_uiSentTotal = 0;
+    e.m_FileState = filestate;
+    m_Events.Broadcast(e);
+
+    // the data is streamed without waiting for the client, chunks are larger than for single file requests to reduce the overhead
+    for (ezUInt32 uiNextByte = 0; uiNextByte < data.GetCount();)
+    {
+      const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(16 * 1024, data.GetCount() - uiNextByte);
+
+      ezRemoteMessage ret;
+      ret.GetWriter() << batchGuid;
+      ret.GetWriter() << uiChunkSize;
+      ret.GetWriter().WriteBytes(&data[uiNextByte], uiChunkSize);
+
+      ret.SetMessageID('FSRV', 'PFDT');
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+
+      uiNextByte += uiChunkSize;
+
+      e.m_Type = ezFileserverEvent::Type::FileDownloading;
+      e.m_uiSentTotal = uiNextByte;
+      m_Events.Broadcast(e);
+    }
+
+    {
+      ezRemoteMessage ret('FSRV', 'PFFN');
+      ret.GetWriter() << batchGuid;
+      ret.GetWriter() << uiEntry;
+      ret.GetWriter() << (ezInt8)filestate;
+      ret.GetWriter() << status.m_iTimestamp;
+      ret.GetWriter() << status.m_uiHash;
+      ret.GetWriter() << uiFoundInDataDir;
+      ret.GetWriter() << uiCompression;
+      ret.GetWriter() << (ezUInt32)m_SendToClient.GetCount();
+
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
+    e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
+    m_Events.Broadcast(e);
+  }
+
+  // tells the client that all remaining files of the batch are up to date
+  {
+    ezRemoteMessage ret('FSRV', 'PFEN');
+    ret.GetWriter() << batchGuid;
+
+    m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+  }
+
+  e.m_Type = ezFileserverEvent::Type::FilePrefetchRequest;
+  e.m_szPath = nullptr;
+  e.m_uiSizeTotal = uiNumEntries;
+  e.m_uiSentTotal = uiNumChangedFiles;
+  e.m_FileState = ezFileserveFileState::None;
+  m_Events.Broadcast(e);
+}
+
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezUInt16 uiDataDirID = 0xffff;
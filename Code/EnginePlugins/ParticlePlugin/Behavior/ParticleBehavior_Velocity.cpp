@@ -2,7 +2,7 @@
 
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <GameEngine/Interfaces/PhysicsWorldModule.h>
@@ -10,6 +10,7 @@
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParticleBehaviorFactory_Velocity, 1, ezRTTIDefaultAllocator<ezParticleBehaviorFactory_Velocity>)
@@ -125,17 +126,17 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
   const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<ezSimdVec4f>();
+  ezVec3* pVelocity = m_pStreamVelocity->GetWritableData<ezVec3>();
 
-  while (!itPosition.HasReachedEnd())
-  {
-    itPosition.Current() += vAddPos;
-    itVelocity.Current() *= fFrictionFactor;
+  ezParticleStreamSimd::ProcessInChunks(uiNumElements, [&](ezUInt64 uiFirstElement, ezUInt64 uiNumChunkElements) {
+    for (ezUInt64 i = uiFirstElement; i < uiFirstElement + uiNumChunkElements; ++i)
+    {
+      pPosition[i] += vAddPos;
+    }
 
-    itPosition.Advance();
-    itVelocity.Advance();
-  }
+    ezParticleStreamSimd::MulFloat3(pVelocity + uiFirstElement, uiNumChunkElements, fFrictionFactor);
+  });
 }
 
 
@@ -94,6 +94,21 @@ void ezParticleEffectInstance::SetEmitterEnabled(bool enable)
 }
 
 
+ezUInt64 ezParticleEffectInstance::GetNumActiveParticles() const
+{
+  ezUInt64 uiNumParticles = 0;
+
+  for (ezUInt32 i = 0; i < m_ParticleSystems.GetCount(); ++i)
+  {
+    if (m_ParticleSystems[i])
+    {
+      uiNumParticles += m_ParticleSystems[i]->GetNumActiveParticles();
+    }
+  }
+
+  return uiNumParticles;
+}
+
 bool ezParticleEffectInstance::HasActiveParticles() const
 {
   for (ezUInt32 i = 0; i < m_ParticleSystems.GetCount(); ++i)
@@ -680,17 +695,42 @@ void ezParticleffectUpdateTask::Execute()
   if (HasBeenCanceled())
     return;
 
-  if (m_UpdateDiff.GetSeconds() != 0.0)
+  m_pEffect->UpdateFromTask(m_UpdateDiff);
+}
+
+ezParticleEffectBatchUpdateTask::ezParticleEffectBatchUpdateTask()
+{
+  m_UpdateDiff.SetZero();
+  SetTaskName("Particle Effect Batch Update");
+}
+
+void ezParticleEffectBatchUpdateTask::Execute()
+{
+  for (ezParticleEffectInstance* pEffect : m_Effects)
   {
-    m_pEffect->PreSimulate();
+    if (HasBeenCanceled())
+      return;
 
-    if (!m_pEffect->Update(m_UpdateDiff))
-    {
-      const ezParticleEffectHandle hEffect = m_pEffect->GetHandle();
-      EZ_ASSERT_DEBUG(!hEffect.IsInvalidated(), "Invalid particle effect handle");
+    pEffect->UpdateFromTask(m_UpdateDiff);
+  }
+}
 
-      m_pEffect->GetOwnerWorldModule()->DestroyEffectInstance(hEffect, false, nullptr);
-    }
+void ezParticleEffectInstance::UpdateFromTask(const ezTime& tDiff)
+{
+  if (tDiff.GetSeconds() == 0.0)
+    return;
+
+  // one scope per effect resource, so that expensive effects are easy to spot, even when they are updated in a batch
+  EZ_PROFILE_SCOPE(m_hResource.GetResourceID().GetData());
+
+  PreSimulate();
+
+  if (!Update(tDiff))
+  {
+    const ezParticleEffectHandle hEffect = GetHandle();
+    EZ_ASSERT_DEBUG(!hEffect.IsInvalidated(), "Invalid particle effect handle");
+
+    GetOwnerWorldModule()->DestroyEffectInstance(hEffect, false, nullptr);
   }
 }
 
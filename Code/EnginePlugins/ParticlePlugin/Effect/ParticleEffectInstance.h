@@ -21,10 +21,26 @@ private:
   ezParticleEffectInstance* m_pEffect;
 };
 
+/// \brief Updates multiple small effects in one task.
+///
+/// Used by ezParticleWorldModule to merge effects with only few particles, such that they don't each pay the overhead of a separate task.
+class ezParticleEffectBatchUpdateTask : public ezTask
+{
+public:
+  ezParticleEffectBatchUpdateTask();
+
+  ezTime m_UpdateDiff;
+  ezHybridArray<ezParticleEffectInstance*, 32> m_Effects;
+
+private:
+  virtual void Execute() override;
+};
+
 class EZ_PARTICLEPLUGIN_DLL ezParticleEffectInstance
 {
   friend class ezParticleWorldModule;
   friend class ezParticleffectUpdateTask;
+  friend class ezParticleEffectBatchUpdateTask;
 
 public:
   struct SharedInstance
@@ -51,6 +67,9 @@ public:
 
   bool HasActiveParticles() const;
 
+  /// \brief Returns the number of active particles in all particle systems of this effect.
+  ezUInt64 GetNumActiveParticles() const;
+
   void ClearParticleSystems();
   void ClearEventReactions();
 
@@ -103,7 +122,10 @@ private: // friend ezParticleWorldModule
   /// \brief Returns the task that is used to update the effect
   ezParticleffectUpdateTask* GetUpdateTask() { return &m_Task; }
 
-private: // friend ezParticleffectUpdateTask
+private: // friend ezParticleffectUpdateTask, ezParticleEffectBatchUpdateTask
+  /// \brief Runs PreSimulate() and Update() and destroys the effect when it is finished.
+  void UpdateFromTask(const ezTime& tDiff);
+
   /// \brief If the effect wants to skip all the initial behavior, this simulates it multiple times before it is shown the first time.
   void PreSimulate();
 
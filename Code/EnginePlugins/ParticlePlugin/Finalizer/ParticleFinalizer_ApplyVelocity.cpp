@@ -1,10 +1,11 @@
 #include <ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
 #include <Foundation/Math/Declarations.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParticleFinalizerFactory_ApplyVelocity, 1, ezRTTIDefaultAllocator<ezParticleFinalizerFactory_ApplyVelocity>)
@@ -42,16 +43,10 @@ void ezParticleFinalizer_ApplyVelocity::Process(ezUInt64 uiNumElements)
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<ezSimdVec4f>();
+  const ezVec3* pVelocity = m_pStreamVelocity->GetData<ezVec3>();
 
-  while (!itPosition.HasReachedEnd())
-  {
-    ezVec3& pos = reinterpret_cast<ezVec3&>(itPosition.Current());
-
-    pos += itVelocity.Current() * tDiff;
-
-    itPosition.Advance();
-    itVelocity.Advance();
-  }
+  ezParticleStreamSimd::ProcessInChunks(uiNumElements, [&](ezUInt64 uiFirstElement, ezUInt64 uiNumChunkElements) {
+    ezParticleStreamSimd::AddScaledFloat3ToFloat4(pPosition + uiFirstElement, pVelocity + uiFirstElement, uiNumChunkElements, tDiff);
+  });
 }
@@ -6,6 +6,7 @@
 #include <Foundation/SimdMath/SimdTransform.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
 #include <ParticlePlugin/Initializer/ParticleInitializer_BoxPosition.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
 
 // clang-format off
@@ -146,25 +147,12 @@ void ezParticleInitializer_BoxPosition::InitializeElements(ezUInt64 uiStartIndex
   {
     ezTransform ownerTransform = GetOwnerSystem()->GetTransform();
 
-    ezSimdVec4f pos;
     ezSimdTransform transform;
     transform.m_Position.Load<3>(&ownerTransform.m_vPosition.x);
     transform.m_Rotation.m_v.Load<4>(&ownerTransform.m_qRotation.v.x);
     transform.m_Scale.Load<3>(&ownerTransform.m_vScale.x);
 
-    float p0[4];
-    p0[3] = 0;
-
-    for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
-    {
-      p0[0] = (float)(rng.DoubleMinMax(-m_vSize.x, m_vSize.x) * 0.5) + m_vPositionOffset.x;
-      p0[1] = (float)(rng.DoubleMinMax(-m_vSize.y, m_vSize.y) * 0.5) + m_vPositionOffset.y;
-      p0[2] = (float)(rng.DoubleMinMax(-m_vSize.z, m_vSize.z) * 0.5) + m_vPositionOffset.z;
-
-      pos.Load<4>(p0);
-
-      pPosition[i] = transform.TransformPosition(pos);
-    }
+    ezParticleStreamSimd::SetRandomPositionsInBox(pPosition + uiStartIndex, uiNumElements, rng, m_vSize, m_vPositionOffset, transform);
   }
 }
 
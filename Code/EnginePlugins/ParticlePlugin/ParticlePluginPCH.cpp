@@ -86,6 +86,7 @@ EZ_STATICLINK_LIBRARY(ParticlePlugin)
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Startup);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Streams_DefaultParticleStreams);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Streams_ParticleStream);
+  EZ_STATICLINK_REFERENCE(ParticlePlugin_Streams_ParticleStreamSimd);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_System_ParticleSystemDescriptor);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_System_ParticleSystemInstance);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_Billboard_BillboardRenderer);
@@ -94,6 +95,7 @@ EZ_STATICLINK_LIBRARY(ParticlePlugin)
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_Fragment_FragmentRenderer);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_Fragment_ParticleTypeFragment);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_Light_ParticleTypeLight);
+  EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_ParticleDepthSorter);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_ParticleType);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_Point_ParticleTypePoint);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Type_Point_PointRenderer);
@@ -0,0 +1,188 @@
+#include <ParticlePluginPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdRandom.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
+
+ezCVarBool CVarParticlesSimd("pfx_Simd", true, ezCVarFlags::Default, "Whether particle behaviors use their vectorized code paths");
+ezCVarInt CVarParticlesChunkSize("pfx_ChunkSize", 16384, ezCVarFlags::Default, "Particle systems with more particles than this are processed in parallel chunks of this size");
+
+bool ezParticleStreamSimd::IsEnabled()
+{
+  return CVarParticlesSimd;
+}
+
+void ezParticleStreamSimd::ProcessInChunks(ezUInt64 uiNumElements, ChunkFunction func)
+{
+  const ezUInt64 uiChunkSize = ezProcessingStream::GetPaddedElementCount(static_cast<ezUInt64>(ezMath::Max(CVarParticlesChunkSize.GetValue(), 1)));
+
+  if (uiNumElements <= uiChunkSize)
+  {
+    func(0, uiNumElements);
+    return;
+  }
+
+  // distribute whole blocks of padded elements, so that no two chunks ever share an element
+  const ezUInt32 uiNumBlocks = static_cast<ezUInt32>(ezProcessingStream::GetPaddedElementCount(uiNumElements) / ezProcessingStream::ElementPadding);
+
+  ezTaskSystem::ParallelForParams params;
+  params.uiBinSize = static_cast<ezUInt32>(uiChunkSize / ezProcessingStream::ElementPadding);
+  params.uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelForIndexed(0, uiNumBlocks,
+    [&](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock) {
+      const ezUInt64 uiFirstElement = static_cast<ezUInt64>(uiStartBlock) * ezProcessingStream::ElementPadding;
+      const ezUInt64 uiEndElement = ezMath::Min<ezUInt64>(static_cast<ezUInt64>(uiEndBlock) * ezProcessingStream::ElementPadding, uiNumElements);
+
+      func(uiFirstElement, uiEndElement - uiFirstElement);
+    },
+    "Particle Stream Chunk", params);
+}
+
+void ezParticleStreamSimd::AddToFloat3(ezVec3* pData, ezUInt64 uiNumElements, const ezVec3& vAdd)
+{
+  if (!IsEnabled())
+  {
+    for (ezUInt64 i = 0; i < uiNumElements; ++i)
+    {
+      pData[i] += vAdd;
+    }
+
+    return;
+  }
+
+  // four consecutive ezVec3 are exactly three SIMD registers, the value to add just has to be rotated accordingly
+  const ezSimdVec4f vAdd0(vAdd.x, vAdd.y, vAdd.z, vAdd.x);
+  const ezSimdVec4f vAdd1(vAdd.y, vAdd.z, vAdd.x, vAdd.y);
+  const ezSimdVec4f vAdd2(vAdd.z, vAdd.x, vAdd.y, vAdd.z);
+
+  float* pFloats = &pData->x;
+  ezSimdVec4f v;
+
+  for (ezUInt64 i = 0; i < uiNumElements; i += 4, pFloats += 12)
+  {
+    v.Load<4>(pFloats + 0);
+    (v + vAdd0).Store<4>(pFloats + 0);
+
+    v.Load<4>(pFloats + 4);
+    (v + vAdd1).Store<4>(pFloats + 4);
+
+    v.Load<4>(pFloats + 8);
+    (v + vAdd2).Store<4>(pFloats + 8);
+  }
+}
+
+void ezParticleStreamSimd::MulFloat3(ezVec3* pData, ezUInt64 uiNumElements, float fScale)
+{
+  if (!IsEnabled())
+  {
+    for (ezUInt64 i = 0; i < uiNumElements; ++i)
+    {
+      pData[i] *= fScale;
+    }
+
+    return;
+  }
+
+  const ezSimdFloat fSimdScale(fScale);
+
+  float* pFloats = &pData->x;
+  ezSimdVec4f v;
+
+  for (ezUInt64 i = 0; i < uiNumElements; i += 4, pFloats += 12)
+  {
+    v.Load<4>(pFloats + 0);
+    (v * fSimdScale).Store<4>(pFloats + 0);
+
+    v.Load<4>(pFloats + 4);
+    (v * fSimdScale).Store<4>(pFloats + 4);
+
+    v.Load<4>(pFloats + 8);
+    (v * fSimdScale).Store<4>(pFloats + 8);
+  }
+}
+
+void ezParticleStreamSimd::AddScaledFloat3ToFloat4(ezSimdVec4f* pPosition, const ezVec3* pVelocity, ezUInt64 uiNumElements, float fScale)
+{
+  if (!IsEnabled())
+  {
+    for (ezUInt64 i = 0; i < uiNumElements; ++i)
+    {
+      ezVec3& pos = reinterpret_cast<ezVec3&>(pPosition[i]);
+      pos += pVelocity[i] * fScale;
+    }
+
+    return;
+  }
+
+  // w is zero, so that the w component of the positions is not modified
+  const ezSimdVec4f vScale(fScale, fScale, fScale, 0.0f);
+
+  const float* pFloats = &pVelocity->x;
+  ezSimdVec4f v0, v1, v2;
+
+  for (ezUInt64 i = 0; i < uiNumElements; i += 4, pFloats += 12)
+  {
+    v0.Load<4>(pFloats + 0); // x0 y0 z0 x1
+    v1.Load<4>(pFloats + 4); // y1 z1 x2 y2
+    v2.Load<4>(pFloats + 8); // z2 x3 y3 z3
+
+    const ezSimdVec4f vel1 = v0.GetCombined<ezSwizzle::WWXX>(v1).GetCombined<ezSwizzle::XZYY>(v1);
+    const ezSimdVec4f vel2 = v1.GetCombined<ezSwizzle::ZWXX>(v2);
+    const ezSimdVec4f vel3 = v2.GetCombined<ezSwizzle::YZWW>(v2);
+
+    pPosition[i + 0] = ezSimdVec4f::MulAdd(v0, vScale, pPosition[i + 0]);
+    pPosition[i + 1] = ezSimdVec4f::MulAdd(vel1, vScale, pPosition[i + 1]);
+    pPosition[i + 2] = ezSimdVec4f::MulAdd(vel2, vScale, pPosition[i + 2]);
+    pPosition[i + 3] = ezSimdVec4f::MulAdd(vel3, vScale, pPosition[i + 3]);
+  }
+}
+
+void ezParticleStreamSimd::SetRandomPositionsInBox(
+  ezSimdVec4f* pPosition, ezUInt64 uiNumElements, ezRandom& rng, const ezVec3& vSize, const ezVec3& vOffset, const ezSimdTransform& transform)
+{
+  if (!IsEnabled())
+  {
+    float p0[4];
+    p0[3] = 0;
+
+    ezSimdVec4f pos;
+
+    for (ezUInt64 i = 0; i < uiNumElements; ++i)
+    {
+      p0[0] = (float)(rng.DoubleMinMax(-vSize.x, vSize.x) * 0.5) + vOffset.x;
+      p0[1] = (float)(rng.DoubleMinMax(-vSize.y, vSize.y) * 0.5) + vOffset.y;
+      p0[2] = (float)(rng.DoubleMinMax(-vSize.z, vSize.z) * 0.5) + vOffset.z;
+
+      pos.Load<4>(p0);
+
+      pPosition[i] = transform.TransformPosition(pos);
+    }
+
+    return;
+  }
+
+  // generate all three random coordinates at once, seeded from the (deterministic) system RNG
+  const ezInt32 iSeed = static_cast<ezInt32>(rng.UInt());
+  ezSimdVec4i vSeed(iSeed, iSeed + 1, iSeed + 2, iSeed + 3);
+  const ezSimdVec4i vSeedStep(4);
+
+  const ezSimdVec4f vHalfSize(vSize.x * 0.5f, vSize.y * 0.5f, vSize.z * 0.5f, 0.0f);
+  const ezSimdVec4f vSimdOffset(vOffset.x, vOffset.y, vOffset.z, 0.0f);
+
+  for (ezUInt64 i = 0; i < uiNumElements; ++i)
+  {
+    // the signed random integers map to [-1; 1)
+    const ezSimdVec4f vRandom = ezSimdRandom::Int(vSeed).ToFloat() * (1.0f / 2147483648.0f);
+    vSeed += vSeedStep;
+
+    pPosition[i] = transform.TransformPosition(ezSimdVec4f::MulAdd(vRandom, vHalfSize, vSimdOffset));
+  }
+}
+
+
+
+EZ_STATICLINK_FILE(ParticlePlugin, ParticlePlugin_Streams_ParticleStreamSimd);
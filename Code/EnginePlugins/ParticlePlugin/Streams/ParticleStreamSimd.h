@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/SimdMath/SimdTransform.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Types/Delegate.h>
+#include <ParticlePlugin/ParticlePluginDLL.h>
+
+class ezRandom;
+
+/// \brief Vectorized operations on the raw data of particle streams.
+///
+/// All functions process the particles in blocks of four. This relies on ezProcessingStream allocating its data padded to
+/// ezProcessingStream::ElementPadding elements, so up to three elements behind the last particle may be read and written.
+///
+/// If the CVar 'pfx_Simd' is disabled, the functions use the plain scalar loops instead, which is useful for profiling
+/// and for tracking down differences between the two code paths.
+struct EZ_PARTICLEPLUGIN_DLL ezParticleStreamSimd
+{
+  /// \brief Returns whether the vectorized code paths are enabled.
+  static bool IsEnabled();
+
+  using ChunkFunction = ezDelegate<void(ezUInt64 uiFirstElement, ezUInt64 uiNumElements), 48>;
+
+  /// \brief Splits the elements [0; uiNumElements) of a large particle system into chunks and processes them in parallel on the task system.
+  ///
+  /// Small systems are processed directly on the calling thread. The chunk boundaries are aligned to ezProcessingStream::ElementPadding,
+  /// so the functions below can be called for each chunk without two chunks touching the same elements.
+  /// Only use this for operations that treat each particle independently of all others.
+  static void ProcessInChunks(ezUInt64 uiNumElements, ChunkFunction func);
+
+  /// \brief pData[i] += vAdd
+  static void AddToFloat3(ezVec3* pData, ezUInt64 uiNumElements, const ezVec3& vAdd);
+
+  /// \brief pData[i] *= fScale
+  static void MulFloat3(ezVec3* pData, ezUInt64 uiNumElements, float fScale);
+
+  /// \brief pPosition[i].xyz += pVelocity[i] * fScale, the w component of the positions stays unchanged.
+  static void AddScaledFloat3ToFloat4(ezSimdVec4f* pPosition, const ezVec3* pVelocity, ezUInt64 uiNumElements, float fScale);
+
+  /// \brief pPosition[i] = transform * (random point in the box of size vSize around vOffset), the w component is zero.
+  ///
+  /// The vectorized path only takes its seed from \a rng and generates different (but equally distributed) points than the scalar path.
+  static void SetRandomPositionsInBox(ezSimdVec4f* pPosition, ezUInt64 uiNumElements, ezRandom& rng, const ezVec3& vSize, const ezVec3& vOffset,
+    const ezSimdTransform& transform);
+};
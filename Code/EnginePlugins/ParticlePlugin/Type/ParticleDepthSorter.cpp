@@ -0,0 +1,204 @@
+#include <ParticlePluginPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <ParticlePlugin/Type/ParticleDepthSorter.h>
+
+ezCVarInt CVarParticlesSortChunkSize("pfx_SortChunkSize", 16384, ezCVarFlags::Default, "Particle systems with more particles than this are depth sorted in parallel chunks of this size");
+
+ezParticleDepthSorter::ezParticleDepthSorter() = default;
+ezParticleDepthSorter::~ezParticleDepthSorter() = default;
+
+void ezParticleDepthSorter::Clear()
+{
+  m_Order.Clear();
+}
+
+ezArrayPtr<const ezUInt32> ezParticleDepthSorter::SortBackToFront(const ezVec4* pPositions, ezUInt32 uiNumParticles, const ezVec3& vCameraPos)
+{
+  if (uiNumParticles == 0)
+  {
+    m_Order.Clear();
+    return ezArrayPtr<const ezUInt32>();
+  }
+
+  ezAllocatorBase* pAllocator = ezFrameAllocator::GetCurrentAllocator();
+  Entry* pEntries = EZ_NEW_RAW_BUFFER(pAllocator, Entry, uiNumParticles);
+
+  // start with the order of the previous frame
+  // dead particles were swapped with the last ones, so dropping all indices that are now out of range and appending the new ones
+  // yields a valid permutation of all particles
+  ezUInt32 uiNumEntries = 0;
+  for (ezUInt32 uiIndex : m_Order)
+  {
+    if (uiIndex < uiNumParticles)
+    {
+      pEntries[uiNumEntries++].m_uiIndex = uiIndex;
+    }
+  }
+
+  for (ezUInt32 uiIndex = m_Order.GetCount(); uiIndex < uiNumParticles; ++uiIndex)
+  {
+    pEntries[uiNumEntries++].m_uiIndex = uiIndex;
+  }
+
+  EZ_ASSERT_DEBUG(uiNumEntries == uiNumParticles, "Invalid particle order");
+
+  // squared distances are never negative, so their bit patterns sort the same way as the floats themselves
+  // the bits are inverted, so that sorting the keys in ascending order yields the farthest particles first
+  ezUInt32 uiNumUnsorted = 0;
+  for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+  {
+    const ezIntFloatUnion dist((pPositions[pEntries[i].m_uiIndex].GetAsVec3() - vCameraPos).GetLengthSquared());
+    pEntries[i].m_uiKey = ~dist.i;
+
+    if (i > 0 && pEntries[i].m_uiKey < pEntries[i - 1].m_uiKey)
+    {
+      ++uiNumUnsorted;
+    }
+  }
+
+  Entry* pSorted = pEntries;
+
+  if (uiNumUnsorted > 0)
+  {
+    // when only a few particles changed their place, fixing up the old order is cheaper than sorting from scratch
+    // the number of moves is limited though, in case a single particle has to travel very far
+    const bool bNearlySorted = uiNumUnsorted <= uiNumEntries / 16;
+
+    if (!bNearlySorted || !InsertionSort(pEntries, uiNumEntries, uiNumEntries * 4))
+    {
+      Entry* pTemp = EZ_NEW_RAW_BUFFER(pAllocator, Entry, uiNumEntries);
+      pSorted = RadixSort(pEntries, pTemp, uiNumEntries);
+    }
+  }
+
+  m_Order.SetCountUninitialized(uiNumEntries);
+  for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+  {
+    m_Order[i] = pSorted[i].m_uiIndex;
+  }
+
+  return m_Order;
+}
+
+bool ezParticleDepthSorter::InsertionSort(Entry* pEntries, ezUInt32 uiNumEntries, ezUInt32 uiMaxMoves)
+{
+  ezUInt32 uiNumMoves = 0;
+
+  for (ezUInt32 i = 1; i < uiNumEntries; ++i)
+  {
+    const Entry entry = pEntries[i];
+
+    ezUInt32 j = i;
+    while (j > 0 && entry.m_uiKey < pEntries[j - 1].m_uiKey)
+    {
+      pEntries[j] = pEntries[j - 1];
+      --j;
+    }
+
+    pEntries[j] = entry;
+
+    uiNumMoves += i - j;
+    if (uiNumMoves > uiMaxMoves)
+    {
+      // the entries are still a valid permutation, just not sorted yet
+      return false;
+    }
+  }
+
+  return true;
+}
+
+ezParticleDepthSorter::Entry* ezParticleDepthSorter::RadixSort(Entry* pEntries, Entry* pTemp, ezUInt32 uiNumEntries)
+{
+  constexpr ezUInt32 uiNumBuckets = 256;
+
+  const ezUInt32 uiChunkSize = static_cast<ezUInt32>(ezMath::Max(CVarParticlesSortChunkSize.GetValue(), 1024));
+  const ezUInt32 uiNumChunks = (uiNumEntries + uiChunkSize - 1) / uiChunkSize;
+
+  // one histogram per chunk, which is turned into the scatter offsets of that chunk in place
+  ezUInt32* pHistograms = EZ_NEW_RAW_BUFFER(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, uiNumChunks * uiNumBuckets);
+
+  auto ForEachChunk = [uiNumChunks](ezTaskSystem::ParallelForIndexedFunction func) {
+    if (uiNumChunks == 1)
+    {
+      func(0, 1);
+      return;
+    }
+
+    ezTaskSystem::ParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumChunks, func, "Particle Depth Sort", params);
+  };
+
+  Entry* pSrc = pEntries;
+  Entry* pDst = pTemp;
+
+  for (ezUInt32 uiShift = 0; uiShift < 32; uiShift += 8)
+  {
+    ForEachChunk([&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+      for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        ezUInt32* pHistogram = pHistograms + uiChunk * uiNumBuckets;
+        ezMemoryUtils::ZeroFill(pHistogram, uiNumBuckets);
+
+        const ezUInt32 uiEnd = ezMath::Min(uiNumEntries, (uiChunk + 1) * uiChunkSize);
+        for (ezUInt32 i = uiChunk * uiChunkSize; i < uiEnd; ++i)
+        {
+          ++pHistogram[(pSrc[i].m_uiKey >> uiShift) & 0xFF];
+        }
+      }
+    });
+
+    // compute where each chunk writes its entries for each bucket, chunks in order within each bucket to keep the sort stable
+    bool bAllInOneBucket = false;
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 uiBucket = 0; uiBucket < uiNumBuckets; ++uiBucket)
+    {
+      const ezUInt32 uiBucketStart = uiOffset;
+
+      for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+      {
+        ezUInt32& uiCount = pHistograms[uiChunk * uiNumBuckets + uiBucket];
+        const ezUInt32 uiChunkCount = uiCount;
+        uiCount = uiOffset;
+        uiOffset += uiChunkCount;
+      }
+
+      if (uiOffset - uiBucketStart == uiNumEntries)
+      {
+        bAllInOneBucket = true;
+        break;
+      }
+    }
+
+    // nothing to do for this digit, happens a lot for the upper bits, when all particles have a similar distance
+    if (bAllInOneBucket)
+      continue;
+
+    ForEachChunk([&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+      for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        ezUInt32* pOffsets = pHistograms + uiChunk * uiNumBuckets;
+
+        const ezUInt32 uiEnd = ezMath::Min(uiNumEntries, (uiChunk + 1) * uiChunkSize);
+        for (ezUInt32 i = uiChunk * uiChunkSize; i < uiEnd; ++i)
+        {
+          pDst[pOffsets[(pSrc[i].m_uiKey >> uiShift) & 0xFF]++] = pSrc[i];
+        }
+      }
+    });
+
+    ezMath::Swap(pSrc, pDst);
+  }
+
+  return pSrc;
+}
+
+
+
+EZ_STATICLINK_FILE(ParticlePlugin, ParticlePlugin_Type_ParticleDepthSorter);
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/Math/Vec4.h>
+#include <ParticlePlugin/ParticlePluginDLL.h>
+
+/// \brief Sorts the particles of one particle type back to front for rendering.
+///
+/// Each particle type that needs sorted output owns one instance of this class. The order of the previous call is kept and used as
+/// the starting point for the next one. Since particles move only a little from frame to frame, that order is usually already sorted
+/// or very close to it, in which case an insertion sort finishes in almost linear time. Otherwise the particles are sorted with an
+/// LSD radix sort on the bits of their float distances. All temporary memory comes from the frame allocator.
+///
+/// Systems with more particles than the CVar 'pfx_SortChunkSize' have the histogram and scatter steps of the radix sort
+/// distributed across the task system.
+class EZ_PARTICLEPLUGIN_DLL ezParticleDepthSorter
+{
+public:
+  ezParticleDepthSorter();
+  ~ezParticleDepthSorter();
+
+  /// \brief Sorts the given particle positions by their distance to \a vCameraPos, farthest first.
+  ///
+  /// Returns the particle indices in render order. The returned array stays valid until the next call to SortBackToFront() or Clear().
+  ezArrayPtr<const ezUInt32> SortBackToFront(const ezVec4* pPositions, ezUInt32 uiNumParticles, const ezVec3& vCameraPos);
+
+  /// \brief Forgets the order of the previous frame.
+  void Clear();
+
+private:
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiKey;
+    ezUInt32 m_uiIndex;
+  };
+
+  static bool InsertionSort(Entry* pEntries, ezUInt32 uiNumEntries, ezUInt32 uiMaxMoves);
+  static Entry* RadixSort(Entry* pEntries, Entry* pTemp, ezUInt32 uiNumEntries);
+
+  ezDynamicArray<ezUInt32> m_Order;
+};
@@ -181,13 +181,6 @@ void ezParticleTypeQuad::CreateRequiredStreams()
   }
 }
 
-struct sodComparer
-{
-  // sort farther particles to the front, so that they get rendered first (back to front)
-  EZ_ALWAYS_INLINE bool Less(const ezParticleTypeQuad::sod& a, const ezParticleTypeQuad::sod& b) const { return a.dist > b.dist; }
-  EZ_ALWAYS_INLINE bool Equal(const ezParticleTypeQuad::sod& a, const ezParticleTypeQuad::sod& b) const { return a.dist == b.dist; }
-};
-
 void ezParticleTypeQuad::ExtractTypeRenderData(const ezView& view, ezExtractedRenderData& extractedRenderData,
                                                const ezTransform& instanceTransform, ezUInt64 uiExtractedFrame) const
 {
@@ -209,30 +202,14 @@ void ezParticleTypeQuad::ExtractTypeRenderData(const ezView& view, ezExtractedRe
 
     if (bNeedsSorting)
     {
-      // TODO: Using the frame allocator this way results in memory corruptions.
-      // Not sure, whether this is supposed to work.
-      ezHybridArray<sod, 64> sorted; // (ezFrameAllocator::GetCurrentAllocator());
-      sorted.SetCountUninitialized(numParticles);
-
+      // sort farther particles to the front, so that they get rendered first (back to front)
       const ezVec3 vCameraPos = view.GetCamera()->GetCenterPosition();
-      const ezVec4* pPosition = m_pStreamPosition->GetData<ezVec4>();
+      ezArrayPtr<const ezUInt32> sorted = m_DepthSorter.SortBackToFront(m_pStreamPosition->GetData<ezVec4>(), numParticles, vCameraPos);
 
-      for (ezUInt32 p = 0; p < numParticles; ++p)
-      {
-        sorted[p].dist = (pPosition[p].GetAsVec3() - vCameraPos).GetLengthSquared();
-        sorted[p].index = p;
-      }
-
-      sorted.Sort(sodComparer());
-
-      auto redirectIdx = [&sorted](ezUInt32 idx) -> ezUInt32 { return sorted[idx].index; };
-
-      CreateExtractedData(view, extractedRenderData, instanceTransform, uiExtractedFrame, &sorted);
+      CreateExtractedData(view, extractedRenderData, instanceTransform, uiExtractedFrame, sorted.GetPtr());
     }
     else
     {
-      auto redirectIdx = [](ezUInt32 idx) -> ezUInt32 { return idx; };
-
       CreateExtractedData(view, extractedRenderData, instanceTransform, uiExtractedFrame, nullptr);
     }
   }
@@ -240,21 +217,21 @@ void ezParticleTypeQuad::ExtractTypeRenderData(const ezView& view, ezExtractedRe
   AddParticleRenderData(extractedRenderData, instanceTransform);
 }
 
-ezUInt32 noRedirect(ezUInt32 idx, const ezHybridArray<ezParticleTypeQuad::sod, 64>* pSorted)
+ezUInt32 noRedirect(ezUInt32 idx, const ezUInt32* pSortedIndices)
 {
   return idx;
 }
 
-ezUInt32 sortedRedirect(ezUInt32 idx, const ezHybridArray<ezParticleTypeQuad::sod, 64>* pSorted)
+ezUInt32 sortedRedirect(ezUInt32 idx, const ezUInt32* pSortedIndices)
 {
-  return (*pSorted)[idx].index;
+  return pSortedIndices[idx];
 }
 
 void ezParticleTypeQuad::CreateExtractedData(const ezView& view, ezExtractedRenderData& extractedRenderData,
                                              const ezTransform& instanceTransform, ezUInt64 uiExtractedFrame,
-                                             const ezHybridArray<sod, 64>* pSorted) const
+                                             const ezUInt32* pSortedIndices) const
 {
-  auto redirect = (pSorted != nullptr) ? sortedRedirect : noRedirect;
+  auto redirect = (pSortedIndices != nullptr) ? sortedRedirect : noRedirect;
 
   const ezUInt32 numParticles = (ezUInt32)GetOwnerSystem()->GetNumActiveParticles();
 
@@ -363,14 +340,14 @@ void ezParticleTypeQuad::CreateExtractedData(const ezView& view, ezExtractedRend
 
   for (ezUInt32 p = 0; p < numParticles; ++p)
   {
-    SetBaseData(p, redirect(p, pSorted));
+    SetBaseData(p, redirect(p, pSortedIndices));
   }
 
   if (bNeedsBillboardData)
   {
     for (ezUInt32 p = 0; p < numParticles; ++p)
     {
-      SetBillboardData(p, redirect(p, pSorted));
+      SetBillboardData(p, redirect(p, pSortedIndices));
     }
   }
 
@@ -380,14 +357,14 @@ void ezParticleTypeQuad::CreateExtractedData(const ezView& view, ezExtractedRend
     {
       for (ezUInt32 p = 0; p < numParticles; ++p)
       {
-        SetTangentDataEmitterDir(p, redirect(p, pSorted));
+        SetTangentDataEmitterDir(p, redirect(p, pSortedIndices));
       }
     }
     else if (m_Orientation == ezQuadParticleOrientation::Rotating_OrthoEmitterDir)
     {
       for (ezUInt32 p = 0; p < numParticles; ++p)
       {
-        SetTangentDataEmitterDirOrtho(p, redirect(p, pSorted));
+        SetTangentDataEmitterDirOrtho(p, redirect(p, pSortedIndices));
       }
     }
     else if (m_Orientation == ezQuadParticleOrientation::Fixed_EmitterDir || m_Orientation == ezQuadParticleOrientation::Fixed_RandomDir ||
@@ -395,21 +372,21 @@ void ezParticleTypeQuad::CreateExtractedData(const ezView& view, ezExtractedRend
     {
       for (ezUInt32 p = 0; p < numParticles; ++p)
       {
-        SetTangentDataFromAxis(p, redirect(p, pSorted));
+        SetTangentDataFromAxis(p, redirect(p, pSortedIndices));
       }
     }
     else if (m_Orientation == ezQuadParticleOrientation::FixedAxis_EmitterDir)
     {
       for (ezUInt32 p = 0; p < numParticles; ++p)
       {
-        SetTangentDataAligned_Emitter(p, redirect(p, pSorted));
+        SetTangentDataAligned_Emitter(p, redirect(p, pSortedIndices));
       }
     }
     else if (m_Orientation == ezQuadParticleOrientation::FixedAxis_ParticleDir)
     {
       for (ezUInt32 p = 0; p < numParticles; ++p)
       {
-        SetTangentDataAligned_ParticleDir(p, redirect(p, pSorted));
+        SetTangentDataAligned_ParticleDir(p, redirect(p, pSortedIndices));
       }
     }
     else
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ParticlePlugin/Type/ParticleDepthSorter.h>
 #include <ParticlePlugin/Type/ParticleType.h>
 #include <ParticlePlugin/Type/Quad/QuadParticleRenderer.h>
 #include <RendererFoundation/RendererFoundationDLL.h>
@@ -79,22 +80,13 @@ public:
   virtual void ExtractTypeRenderData(const ezView& view, ezExtractedRenderData& extractedRenderData, const ezTransform& instanceTransform,
                                      ezUInt64 uiExtractedFrame) const override;
 
-  struct sod
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    float dist;
-    ezUInt32 index;
-  };
-
-
 protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
   virtual void Process(ezUInt64 uiNumElements) override {}
   void AllocateParticleData(const ezUInt32 numParticles, const bool bNeedsBillboardData, const bool bNeedsTangentData) const;
   void AddParticleRenderData(ezExtractedRenderData& extractedRenderData, const ezTransform& instanceTransform) const;
   void CreateExtractedData(const ezView& view, ezExtractedRenderData& extractedRenderData, const ezTransform& instanceTransform,
-                           ezUInt64 uiExtractedFrame, const ezHybridArray<sod, 64>* pSorted) const;
+                           ezUInt64 uiExtractedFrame, const ezUInt32* pSortedIndices) const;
 
   ezProcessingStream* m_pStreamLifeTime = nullptr;
   ezProcessingStream* m_pStreamPosition = nullptr;
@@ -109,4 +101,5 @@ protected:
   mutable ezArrayPtr<ezBaseParticleShaderData> m_BaseParticleData;
   mutable ezArrayPtr<ezBillboardQuadParticleShaderData> m_BillboardParticleData;
   mutable ezArrayPtr<ezTangentQuadParticleShaderData> m_TangentParticleData;
+  mutable ezParticleDepthSorter m_DepthSorter;
 };
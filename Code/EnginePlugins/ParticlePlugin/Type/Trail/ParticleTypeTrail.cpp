@@ -11,6 +11,7 @@
 #include <RendererCore/Pipeline/Declarations.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
+#include <RendererCore/Pipeline/View.h>
 #include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/Shader/ShaderResource.h>
 #include <RendererCore/Textures/Texture2DResource.h>
@@ -212,19 +213,34 @@ void ezParticleTypeTrail::ExtractTypeRenderData(const ezView& view, ezExtractedR
     m_TrailParticleData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezTrailParticleShaderData,
                                        (ezUInt32)GetOwnerSystem()->GetNumActiveParticles());
 
+    const bool bNeedsSorting = (m_RenderMode == ezParticleTypeRenderMode::Blended) ||
+                               (m_RenderMode == ezParticleTypeRenderMode::BlendedForeground) ||
+                               (m_RenderMode == ezParticleTypeRenderMode::BlendedBackground);
+
+    // trails are sorted by the position of their head, farther trails get rendered first
+    const ezUInt32* pSortedIndices = nullptr;
+    if (bNeedsSorting)
+    {
+      const ezVec3 vCameraPos = view.GetCamera()->GetCenterPosition();
+      pSortedIndices = m_DepthSorter.SortBackToFront(m_pStreamPosition->GetData<ezVec4>(), numActiveParticles, vCameraPos).GetPtr();
+    }
+
     for (ezUInt32 p = 0; p < numActiveParticles; ++p)
     {
-      m_BaseParticleData[p].Size = pSize[p];
-      m_BaseParticleData[p].Color = pColor[p].ToLinearFloat() * tintColor;
-      m_BaseParticleData[p].Life = pLifeTime[p].x * pLifeTime[p].y;
-      m_BaseParticleData[p].Variation = (pVariation != nullptr) ? pVariation[p] : 0;
+      const ezUInt32 idx = (pSortedIndices != nullptr) ? pSortedIndices[p] : p;
+
+      m_BaseParticleData[p].Size = pSize[idx];
+      m_BaseParticleData[p].Color = pColor[idx].ToLinearFloat() * tintColor;
+      m_BaseParticleData[p].Life = pLifeTime[idx].x * pLifeTime[idx].y;
+      m_BaseParticleData[p].Variation = (pVariation != nullptr) ? pVariation[idx] : 0;
 
-      m_TrailParticleData[p].NumPoints = pTrailData[p].m_uiNumPoints;
+      m_TrailParticleData[p].NumPoints = pTrailData[idx].m_uiNumPoints;
     }
 
     for (ezUInt32 p = 0; p < numActiveParticles; ++p)
     {
-      const ezVec4* pTrailPositions = GetTrailPointsPositions(pTrailData[p].m_uiIndexForTrailPoints);
+      const ezUInt32 idx = (pSortedIndices != nullptr) ? pSortedIndices[p] : p;
+      const ezVec4* pTrailPositions = GetTrailPointsPositions(pTrailData[idx].m_uiIndexForTrailPoints);
 
       ezVec4* pRenderPositions = &m_TrailPointsShared[p * uiBucketSize];
 
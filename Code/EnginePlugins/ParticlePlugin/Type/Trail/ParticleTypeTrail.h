@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ParticlePlugin/Type/ParticleDepthSorter.h>
 #include <ParticlePlugin/Type/ParticleType.h>
 #include <RendererFoundation/RendererFoundationDLL.h>
 #include <Foundation/Containers/DynamicArray.h>
@@ -73,6 +74,7 @@ protected:
   mutable ezArrayPtr<ezBaseParticleShaderData> m_BaseParticleData;
   mutable ezArrayPtr<ezTrailParticleShaderData> m_TrailParticleData;
   mutable ezArrayPtr<ezVec4> m_TrailPointsShared;
+  mutable ezParticleDepthSorter m_DepthSorter;
 
   struct TrailData
   {
@@ -1,9 +1,18 @@
 #include <ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
 #include <ParticlePlugin/Resources/ParticleEffectResource.h>
 #include <ParticlePlugin/WorldModule/ParticleWorldModule.h>
 
+ezCVarInt CVarParticleUpdateGranularity("pfx_UpdateGranularity", 4096, ezCVarFlags::Default, "Effects with fewer particles than this are updated together in one task");
+
+namespace
+{
+  // every effect has some update cost, even when it currently has no particles
+  constexpr ezUInt64 s_uiEffectBaseCost = 64;
+}
+
 ezParticleEffectHandle ezParticleWorldModule::InternalCreateEffectInstance(const ezParticleEffectResourceHandle& hResource,
                                                                            ezUInt64 uiRandomSeed, bool bIsShared,
                                                                            ezArrayPtr<ezParticleEffectFloatParam> floatParams,
@@ -135,6 +144,13 @@ void ezParticleWorldModule::UpdateEffects(const ezWorldModule::UpdateContext& co
   m_EffectUpdateTaskGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyNextFrame);
 
   const ezTime tDiff = GetWorld()->GetClock().GetTimeDiff();
+  const ezUInt64 uiGranularity = static_cast<ezUInt64>(ezMath::Max(CVarParticleUpdateGranularity.GetValue(), 1));
+
+  // large effects get their own task, small effects are merged into batches of roughly uiGranularity particles
+  ezUInt32 uiNumBatchTasks = 0;
+  ezParticleEffectBatchUpdateTask* pBatchTask = nullptr;
+  ezUInt64 uiBatchCost = 0;
+
   for (ezUInt32 i = 0; i < m_ParticleEffects.GetCount(); ++i)
   {
     if (!m_ParticleEffects[i].ShouldBeUpdated())
@@ -142,10 +158,36 @@ void ezParticleWorldModule::UpdateEffects(const ezWorldModule::UpdateContext& co
 
     m_ParticleEffects[i].ProcessEventQueues();
 
-    ezParticleffectUpdateTask* pTask = m_ParticleEffects[i].GetUpdateTask();
-    pTask->m_UpdateDiff = tDiff;
+    const ezUInt64 uiCost = m_ParticleEffects[i].GetNumActiveParticles() + s_uiEffectBaseCost;
+
+    if (uiCost >= uiGranularity)
+    {
+      ezParticleffectUpdateTask* pTask = m_ParticleEffects[i].GetUpdateTask();
+      pTask->m_UpdateDiff = tDiff;
+
+      ezTaskSystem::AddTaskToGroup(m_EffectUpdateTaskGroup, pTask);
+      continue;
+    }
+
+    if (pBatchTask == nullptr || uiBatchCost + uiCost > uiGranularity)
+    {
+      if (uiNumBatchTasks == m_EffectBatchUpdateTasks.GetCount())
+      {
+        m_EffectBatchUpdateTasks.ExpandAndGetRef();
+      }
+
+      pBatchTask = &m_EffectBatchUpdateTasks[uiNumBatchTasks];
+      ++uiNumBatchTasks;
+
+      pBatchTask->m_Effects.Clear();
+      pBatchTask->m_UpdateDiff = tDiff;
+      uiBatchCost = 0;
+
+      ezTaskSystem::AddTaskToGroup(m_EffectUpdateTaskGroup, pBatchTask);
+    }
 
-    ezTaskSystem::AddTaskToGroup(m_EffectUpdateTaskGroup, pTask);
+    pBatchTask->m_Effects.PushBack(&m_ParticleEffects[i]);
+    uiBatchCost += uiCost;
   }
 
   ezTaskSystem::StartTaskGroup(m_EffectUpdateTaskGroup);
@@ -84,5 +84,6 @@ private:
   ezDeque<ezParticleSystemInstance> m_ParticleSystems;
   ezDynamicArray<ezParticleSystemInstance*> m_ParticleSystemFreeList;
   ezTaskGroupID m_EffectUpdateTaskGroup;
+  ezDeque<ezParticleEffectBatchUpdateTask> m_EffectBatchUpdateTasks;
   ezMap<ezString, ezParticleStreamFactory*> m_StreamFactories;
 };
@@ -84,6 +84,8 @@ void ezRcAgentComponent::UninitializeRecast()
 
 void ezRcAgentComponent::ClearTargetPosition()
 {
+  CancelPathRequest();
+
   m_iNumNextSteps = 0;
   m_iFirstNextStep = 0;
   m_PathCorridor.Clear();
@@ -142,41 +144,7 @@ ezResult ezRcAgentComponent::FindNavMeshPolyAt(const ezVec3& vPosition, dtPolyRe
   return EZ_SUCCESS;
 }
 
-ezResult ezRcAgentComponent::ComputePathCorridor(dtPolyRef startPoly, dtPolyRef endPoly, bool& bFoundPartialPath)
-{
-  bFoundPartialPath = false;
-
-  ezRcPos rcStart = m_vCurrentPositionOnNavmesh;
-  ezRcPos rcEnd = m_vTargetPosition;
-
-  ezInt32 iPathCorridorLength = 0;
-
-  // make enough room
-  m_PathCorridor.SetCountUninitialized(256);
-  if (dtStatusFailed(m_pQuery->findPath(startPoly, endPoly, rcStart, rcEnd, &m_QueryFilter, m_PathCorridor.GetData(), &iPathCorridorLength,
-        (int)m_PathCorridor.GetCount())) ||
-      iPathCorridorLength <= 0)
-  {
-    m_PathCorridor.Clear();
-    return EZ_FAILURE;
-  }
-
-  // reduce to actual length
-  m_PathCorridor.SetCountUninitialized(iPathCorridorLength);
-
-  if (m_PathCorridor[iPathCorridorLength - 1] != endPoly)
-  {
-    // if this is the case, the target position cannot be reached, but we can walk close to it
-    bFoundPartialPath = true;
-  }
-
-  m_pCorridor->reset(startPoly, rcStart);
-  m_pCorridor->setCorridor(rcEnd, m_PathCorridor.GetData(), iPathCorridorLength);
-
-  return EZ_SUCCESS;
-}
-
-ezResult ezRcAgentComponent::ComputePathToTarget()
+ezResult ezRcAgentComponent::RequestPathToTarget()
 {
   const ezVec3 vStartPos = GetOwner()->GetGlobalPosition();
 
@@ -206,20 +174,49 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
 
   /// \todo Optimize case when endPoly is same as previously ?
 
-  bool bFoundPartialPath = false;
-  if (ComputePathCorridor(startPoly, endPoly, bFoundPartialPath).Failed() || bFoundPartialPath)
+  ezRecastPathQueryQueue& queue = static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule()->GetPathQueryQueue();
+  m_uiPathRequestID = queue.RequestPath(startPoly, m_vCurrentPositionOnNavmesh, endPoly, m_vTargetPosition);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRcAgentComponent::ReceivePathToTarget()
+{
+  ezRecastPathQueryQueue& queue = static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule()->GetPathQueryQueue();
+  const ezRecastPathQueryState::Enum state = queue.FetchResult(m_uiPathRequestID, m_PathCorridor);
+
+  if (state == ezRecastPathQueryState::Pending)
+    return EZ_FAILURE;
+
+  m_uiPathRequestID = 0;
+
+  if (state == ezRecastPathQueryState::NavMeshChanged)
   {
+    // the navmesh is being replaced, the path is requested again as soon as the new one is available
+    UninitializeRecast();
+    return EZ_FAILURE;
+  }
+
+  if (state != ezRecastPathQueryState::Succeeded)
+  {
+    m_PathCorridor.Clear();
     m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
     /// \todo For now a partial path is considered an error
 
     ezAgentSteeringEvent e;
     e.m_pComponent = this;
-    e.m_Type = bFoundPartialPath ? ezAgentSteeringEvent::WarningNoFullPathToTarget : ezAgentSteeringEvent::ErrorNoPathToTarget;
+    e.m_Type = state == ezRecastPathQueryState::PartialPath ? ezAgentSteeringEvent::WarningNoFullPathToTarget : ezAgentSteeringEvent::ErrorNoPathToTarget;
     m_SteeringEvents.Broadcast(e);
     return EZ_FAILURE;
   }
 
+  const ezRcPos rcStart = m_vCurrentPositionOnNavmesh;
+  const ezRcPos rcEnd = m_vTargetPosition;
+
+  m_pCorridor->reset(m_PathCorridor[0], rcStart);
+  m_pCorridor->setCorridor(rcEnd, m_PathCorridor.GetData(), (int)m_PathCorridor.GetCount());
+
   m_PathToTargetState = ezAgentPathFindingState::HasTargetAndValidPath;
 
   ezAgentSteeringEvent e;
@@ -229,6 +226,15 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
   return EZ_SUCCESS;
 }
 
+void ezRcAgentComponent::CancelPathRequest()
+{
+  if (m_uiPathRequestID == 0)
+    return;
+
+  static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule()->GetPathQueryQueue().CancelRequest(m_uiPathRequestID);
+  m_uiPathRequestID = 0;
+}
+
 bool ezRcAgentComponent::HasReachedPosition(const ezVec3& pos, float fMaxDistance) const
 {
   ezVec3 vTargetPos = pos;
@@ -301,6 +307,14 @@ void ezRcAgentComponent::OnSimulationStarted()
   }
 }
 
+void ezRcAgentComponent::OnDeactivated()
+{
+  // the target is kept, a new path is requested once the agent is active again
+  CancelPathRequest();
+
+  SUPER::OnDeactivated();
+}
+
 void ezRcAgentComponent::ApplySteering(const ezVec3& vDirection, float fSpeed)
 {
   // compute new rotation
@@ -376,7 +390,11 @@ void ezRcAgentComponent::Update()
   // target is set, but no path is computed yet
   if (GetPathToTargetState() == ezAgentPathFindingState::HasTargetWaitingForPath)
   {
-    if (ComputePathToTarget().Failed())
+    // the path is computed asynchronously by the world module, the result arrives in one of the next frames
+    if (m_uiPathRequestID == 0 && RequestPathToTarget().Failed())
+      return;
+
+    if (ReceivePathToTarget().Failed())
       return;
 
     PlanNextSteps();
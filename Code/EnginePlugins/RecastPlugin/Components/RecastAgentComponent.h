@@ -84,8 +84,9 @@ private:
   // Path Finding and Steering
 
 private:
-  ezResult ComputePathToTarget();
-  ezResult ComputePathCorridor(dtPolyRef startPoly, dtPolyRef endPoly, bool& bFoundPartialPath);
+  ezResult RequestPathToTarget();
+  ezResult ReceivePathToTarget();
+  void CancelPathRequest();
   void ComputeSteeringDirection(float fMaxDistance);
   void ApplySteering(const ezVec3& vDirection, float fSpeed);
   void SyncSteeringWithReality();
@@ -98,6 +99,7 @@ private:
   ezUniquePtr<dtPathCorridor> m_pCorridor; // careful, dtPathCorridor is not moveble
   dtQueryFilter m_QueryFilter;             /// \todo hard-coded filter
   ezDynamicArray<dtPolyRef> m_PathCorridor;
+  ezUInt32 m_uiPathRequestID = 0; // 0 means that no request is in flight
   // path following
   ezInt32 m_iFirstNextStep = 0;
   ezInt32 m_iNumNextSteps = 0;
@@ -120,6 +122,7 @@ private:
   ezResult InitializeRecast();
   void UninitializeRecast();
   virtual void OnSimulationStarted() override;
+  virtual void OnDeactivated() override;
   void Update();
 
   bool m_bRecastInitialized = false;
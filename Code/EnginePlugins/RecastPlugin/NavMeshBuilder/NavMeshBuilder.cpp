@@ -2,6 +2,7 @@
 
 #include <Core/Utils/WorldGeoExtractionUtil.h>
 #include <Core/World/World.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
@@ -28,6 +29,7 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezRecastConfig, ezNoBase, 1, ezRTTIDefaultAllocat
     EZ_MEMBER_PROPERTY("SampleErrorFactor", m_fDetailMeshSampleErrorFactor)->AddAttributes(new ezDefaultValueAttribute(1.0f)),
     EZ_MEMBER_PROPERTY("MaxSimplification", m_fMaxSimplificationError)->AddAttributes(new ezDefaultValueAttribute(1.3f)),
     EZ_MEMBER_PROPERTY("MaxEdgeLength", m_fMaxEdgeLength)->AddAttributes(new ezDefaultValueAttribute(4.0f)),
+    EZ_MEMBER_PROPERTY("TileSize", m_fTileSize)->AddAttributes(new ezClampValueAttribute(0.0f, ezVariant())),
   }
   EZ_END_PROPERTIES;
 }
@@ -81,7 +83,7 @@ ezResult ezRecastNavMeshBuilder::ExtractWorldGeometry(const ezWorld& world, ezWo
 }
 
 ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& geo,
-  ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress)
+  ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress, const ezRecastNavMeshResourceDescriptor* pTileCache)
 {
   EZ_LOG_BLOCK("ezRecastNavMeshBuilder::Build");
 
@@ -113,6 +115,14 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
 
   ComputeBoundingBox();
 
+  if (config.m_fTileSize > 0.0f)
+  {
+    if (!pg.BeginNextStep("Build Tiles"))
+      return EZ_FAILURE;
+
+    return BuildTiles(config, out_NavMeshDesc, progress, pTileCache);
+  }
+
   if (!pg.BeginNextStep("Build Poly Mesh"))
     return EZ_FAILURE;
 
@@ -261,21 +271,19 @@ void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig&
   rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 }
 
-ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress)
+/// \brief Runs the Recast pipeline from rasterization up to the polygon mesh for the given triangles.
+///
+/// Used both for building the whole navmesh at once and for building individual tiles. In the latter case the function runs on
+/// worker threads and \a pProgressRange is null.
+static ezResult BuildPolyMesh(rcContext* pContext, const rcConfig& cfg, const float* pVertices, ezUInt32 uiNumVertices, const ezInt32* pTriangles,
+  ezUInt8* pAreaIDs, ezUInt32 uiNumTriangles, rcPolyMesh& out_PolyMesh, ezProgressRange* pProgressRange)
 {
-  ezProgressRange pgRange("Build Poly Mesh", 13, true, &progress);
-
-  rcConfig cfg;
-  FillOutConfig(cfg, config, m_BoundingBox);
-
-  ezRcBuildContext* pContext = m_pRecastContext;
-  const float* pVertices = &m_Vertices[0].x;
-  const ezInt32* pTriangles = &m_Triangles[0].m_VertexIdx[0];
+  auto NextStep = [pProgressRange](const char* szStepName) -> bool { return pProgressRange == nullptr || pProgressRange->BeginNextStep(szStepName); };
 
   rcHeightfield* heightfield = rcAllocHeightfield();
   EZ_SCOPE_EXIT(rcFreeHeightField(heightfield));
 
-  if (!pgRange.BeginNextStep("Creating Heightfield"))
+  if (!NextStep("Creating Heightfield"))
     return EZ_FAILURE;
 
   if (!rcCreateHeightfield(pContext, *heightfield, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
@@ -284,18 +292,16 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Mark Walkable Area"))
+  if (!NextStep("Mark Walkable Area"))
     return EZ_FAILURE;
 
   // TODO Instead of this, it should use area IDs and then clear the non-walkable triangles
-  rcMarkWalkableTriangles(
-    pContext, cfg.walkableSlopeAngle, pVertices, m_Vertices.GetCount(), pTriangles, m_Triangles.GetCount(), m_TriangleAreaIDs.GetData());
+  rcMarkWalkableTriangles(pContext, cfg.walkableSlopeAngle, pVertices, uiNumVertices, pTriangles, uiNumTriangles, pAreaIDs);
 
-  if (!pgRange.BeginNextStep("Rasterize Triangles"))
+  if (!NextStep("Rasterize Triangles"))
     return EZ_FAILURE;
 
-  if (!rcRasterizeTriangles(pContext, pVertices, m_Vertices.GetCount(), pTriangles, m_TriangleAreaIDs.GetData(), m_Triangles.GetCount(),
-        *heightfield, cfg.walkableClimb))
+  if (!rcRasterizeTriangles(pContext, pVertices, uiNumVertices, pTriangles, pAreaIDs, uiNumTriangles, *heightfield, cfg.walkableClimb))
   {
     pContext->log(RC_LOG_ERROR, "Could not rasterize triangles");
     return EZ_FAILURE;
@@ -303,26 +309,26 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
 
   // Optional stuff
   {
-    if (!pgRange.BeginNextStep("Filter Low Hanging Obstacles"))
+    if (!NextStep("Filter Low Hanging Obstacles"))
       return EZ_FAILURE;
 
     // if (m_filterLowHangingObstacles)
     rcFilterLowHangingWalkableObstacles(pContext, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Ledge Spans"))
+    if (!NextStep("Filter Ledge Spans"))
       return EZ_FAILURE;
 
     // if (m_filterLedgeSpans)
     rcFilterLedgeSpans(pContext, cfg.walkableHeight, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Low Height Spans"))
+    if (!NextStep("Filter Low Height Spans"))
       return EZ_FAILURE;
 
     // if (m_filterWalkableLowHeightSpans)
     rcFilterWalkableLowHeightSpans(pContext, cfg.walkableHeight, *heightfield);
   }
 
-  if (!pgRange.BeginNextStep("Build Compact Heightfield"))
+  if (!NextStep("Build Compact Heightfield"))
     return EZ_FAILURE;
 
   rcCompactHeightfield* compactHeightfield = rcAllocCompactHeightfield();
@@ -334,7 +340,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Erode Walkable Area"))
+  if (!NextStep("Erode Walkable Area"))
     return EZ_FAILURE;
 
   if (!rcErodeWalkableArea(pContext, cfg.walkableRadius, *compactHeightfield))
@@ -357,7 +363,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   {
     // PARTITION_WATERSHED
     {
-      if (!pgRange.BeginNextStep("Build Distance Field"))
+      if (!NextStep("Build Distance Field"))
         return EZ_FAILURE;
 
       // Prepare for region partitioning, by calculating distance field along the walkable surface.
@@ -367,11 +373,11 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
         return EZ_FAILURE;
       }
 
-      if (!pgRange.BeginNextStep("Build Regions"))
+      if (!NextStep("Build Regions"))
         return EZ_FAILURE;
 
       // Partition the walkable surface into simple regions without holes.
-      if (!rcBuildRegions(pContext, *compactHeightfield, 0, cfg.minRegionArea, cfg.mergeRegionArea))
+      if (!rcBuildRegions(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
         pContext->log(RC_LOG_ERROR, "Could not build watershed regions.");
         return EZ_FAILURE;
@@ -400,7 +406,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     //}
   }
 
-  if (!pgRange.BeginNextStep("Build Contours"))
+  if (!NextStep("Build Contours"))
     return EZ_FAILURE;
 
   rcContourSet* contourSet = rcAllocContourSet();
@@ -412,7 +418,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Build Poly Mesh"))
+  if (!NextStep("Build Poly Mesh"))
     return EZ_FAILURE;
 
   if (!rcBuildPolyMesh(pContext, *contourSet, cfg.maxVertsPerPoly, out_PolyMesh))
@@ -424,7 +430,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   //////////////////////////////////////////////////////////////////////////
   // Detour Navmesh
 
-  if (!pgRange.BeginNextStep("Set Area Flags"))
+  if (!NextStep("Set Area Flags"))
     return EZ_FAILURE;
 
   // TODO modify area IDs and flags
@@ -440,7 +446,19 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   return EZ_SUCCESS;
 }
 
-ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData)
+ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress)
+{
+  ezProgressRange pgRange("Build Poly Mesh", 13, true, &progress);
+
+  rcConfig cfg;
+  FillOutConfig(cfg, config, m_BoundingBox);
+
+  return BuildPolyMesh(m_pRecastContext, cfg, &m_Vertices[0].x, m_Vertices.GetCount(), &m_Triangles[0].m_VertexIdx[0],
+    m_TriangleAreaIDs.GetData(), m_Triangles.GetCount(), out_PolyMesh, &pgRange);
+}
+
+ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(
+  const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData, ezInt32 iTileX, ezInt32 iTileY)
 {
   dtNavMeshCreateParams params;
   ezMemoryUtils::ZeroFill(&params, 1);
@@ -460,6 +478,8 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   params.cs = config.m_fCellSize;
   params.ch = config.m_fCellHeight;
   params.buildBvTree = true;
+  params.tileX = iTileX;
+  params.tileY = iTileY;
 
   ezUInt8* navData = nullptr;
   ezInt32 navDataSize = 0;
@@ -477,9 +497,229 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   return EZ_SUCCESS;
 }
 
+ezResult ezRecastNavMeshBuilder::BuildTiles(const ezRecastConfig& config, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress,
+  const ezRecastNavMeshResourceDescriptor* pTileCache)
+{
+  ezProgressRange pgRange("Build Tiles", 3, true, &progress);
+  pgRange.SetStepWeighting(0, 0.05f);
+  pgRange.SetStepWeighting(1, 0.9f);
+  pgRange.SetStepWeighting(2, 0.05f);
+
+  rcConfig baseCfg;
+  FillOutConfig(baseCfg, config, m_BoundingBox);
+
+  // the tile grid starts at the world origin, so that tiles stay at the same place when the level grows, which is what makes them cacheable
+  const ezInt32 iTileCells = ezMath::Max(1, (int)ceilf(config.m_fTileSize / baseCfg.cs));
+  const float fTileSize = iTileCells * baseCfg.cs;
+  const ezInt32 iBorderCells = baseCfg.walkableRadius + 3;
+  const float fBorder = iBorderCells * baseCfg.cs;
+
+  const ezInt32 iFirstTileX = (ezInt32)ezMath::Floor(m_BoundingBox.m_vMin.x / fTileSize);
+  const ezInt32 iFirstTileY = (ezInt32)ezMath::Floor(m_BoundingBox.m_vMin.z / fTileSize);
+  const ezInt32 iNumTilesX = (ezInt32)ezMath::Floor(m_BoundingBox.m_vMax.x / fTileSize) - iFirstTileX + 1;
+  const ezInt32 iNumTilesY = (ezInt32)ezMath::Floor(m_BoundingBox.m_vMax.z / fTileSize) - iFirstTileY + 1;
+  const ezUInt32 uiNumTiles = static_cast<ezUInt32>(iNumTilesX * iNumTilesY);
+
+  if (!pgRange.BeginNextStep("Sort Triangles into Tiles"))
+    return EZ_FAILURE;
+
+  // every triangle is added to all tiles that it touches, including their border
+  ezDynamicArray<ezDynamicArray<ezUInt32>> tileTriangles;
+  tileTriangles.SetCount(uiNumTiles);
+
+  for (ezUInt32 t = 0; t < m_Triangles.GetCount(); ++t)
+  {
+    ezBoundingBox triBox;
+    triBox.SetInvalid();
+    for (ezUInt32 v = 0; v < 3; ++v)
+    {
+      triBox.ExpandToInclude(m_Vertices[m_Triangles[t].m_VertexIdx[v]]);
+    }
+
+    const ezInt32 iMinX = ezMath::Max((ezInt32)ezMath::Floor((triBox.m_vMin.x - fBorder) / fTileSize) - iFirstTileX, 0);
+    const ezInt32 iMinY = ezMath::Max((ezInt32)ezMath::Floor((triBox.m_vMin.z - fBorder) / fTileSize) - iFirstTileY, 0);
+    const ezInt32 iMaxX = ezMath::Min((ezInt32)ezMath::Floor((triBox.m_vMax.x + fBorder) / fTileSize) - iFirstTileX, iNumTilesX - 1);
+    const ezInt32 iMaxY = ezMath::Min((ezInt32)ezMath::Floor((triBox.m_vMax.z + fBorder) / fTileSize) - iFirstTileY, iNumTilesY - 1);
+
+    for (ezInt32 y = iMinY; y <= iMaxY; ++y)
+    {
+      for (ezInt32 x = iMinX; x <= iMaxX; ++x)
+      {
+        tileTriangles[y * iNumTilesX + x].PushBack(t);
+      }
+    }
+  }
+
+  if (!pgRange.BeginNextStep("Build Tiles"))
+    return EZ_FAILURE;
+
+  ezDynamicArray<ezRecastNavMeshTile> tiles;
+  tiles.SetCount(uiNumTiles);
+
+  ezAtomicInteger32 iNumBuilt;
+  ezAtomicInteger32 iNumReused;
+  ezAtomicInteger32 iNumFailed;
+
+  ezTaskSystem::ParallelForParams params;
+  params.uiBinSize = 1;
+
+  ezTaskSystem::ParallelForIndexed(0, uiNumTiles,
+    [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiTile = uiStartIndex; uiTile < uiEndIndex; ++uiTile)
+      {
+        const ezArrayPtr<const ezUInt32> triangles = tileTriangles[uiTile];
+        if (triangles.IsEmpty())
+          continue;
+
+        ezRecastNavMeshTile& tile = tiles[uiTile];
+        tile.m_iTileX = iFirstTileX + static_cast<ezInt32>(uiTile) % iNumTilesX;
+        tile.m_iTileY = iFirstTileY + static_cast<ezInt32>(uiTile) / iNumTilesX;
+        tile.m_uiGeometryHash = ComputeTileHash(config, tile.m_iTileX, tile.m_iTileY, triangles);
+
+        if (pTileCache != nullptr)
+        {
+          const ezRecastNavMeshTile* pCachedTile = pTileCache->FindTile(tile.m_iTileX, tile.m_iTileY);
+
+          if (pCachedTile != nullptr && pCachedTile->m_uiGeometryHash == tile.m_uiGeometryHash)
+          {
+            tile.m_DetourTileData = pCachedTile->m_DetourTileData;
+
+            if (pCachedTile->m_pPolygons != nullptr)
+            {
+              rcContext context(false);
+              tile.m_pPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+              rcCopyPolyMesh(&context, *pCachedTile->m_pPolygons, *tile.m_pPolygons);
+            }
+
+            iNumReused.Increment();
+            continue;
+          }
+        }
+
+        rcConfig tileCfg = baseCfg;
+        tileCfg.tileSize = iTileCells;
+        tileCfg.borderSize = iBorderCells;
+        tileCfg.width = iTileCells + iBorderCells * 2;
+        tileCfg.height = iTileCells + iBorderCells * 2;
+        tileCfg.bmin[0] = tile.m_iTileX * fTileSize - fBorder;
+        tileCfg.bmin[2] = tile.m_iTileY * fTileSize - fBorder;
+        tileCfg.bmax[0] = (tile.m_iTileX + 1) * fTileSize + fBorder;
+        tileCfg.bmax[2] = (tile.m_iTileY + 1) * fTileSize + fBorder;
+
+        // the height range only covers the triangles of this tile, aligned to the cell height so that neighboring tiles match up
+        float fMinHeight = ezMath::MaxValue<float>();
+        float fMaxHeight = -ezMath::MaxValue<float>();
+        for (ezUInt32 t : triangles)
+        {
+          for (ezUInt32 v = 0; v < 3; ++v)
+          {
+            const float fHeight = m_Vertices[m_Triangles[t].m_VertexIdx[v]].y;
+            fMinHeight = ezMath::Min(fMinHeight, fHeight);
+            fMaxHeight = ezMath::Max(fMaxHeight, fHeight);
+          }
+        }
+
+        tileCfg.bmin[1] = ezMath::Floor(fMinHeight / tileCfg.ch) * tileCfg.ch;
+        tileCfg.bmax[1] = ezMath::Ceil(fMaxHeight / tileCfg.ch) * tileCfg.ch + tileCfg.ch;
+
+        if (BuildTile(config, tileCfg, triangles, tile).Failed())
+        {
+          iNumFailed.Increment();
+          continue;
+        }
+
+        iNumBuilt.Increment();
+      }
+    },
+    "Build NavMesh Tiles", params);
+
+  if (iNumFailed > 0)
+  {
+    ezLog::Error("Building {0} navmesh tiles failed", (ezInt32)iNumFailed);
+    return EZ_FAILURE;
+  }
+
+  ezLog::Info("NavMesh tiles: {0} built, {1} reused", (ezInt32)iNumBuilt, (ezInt32)iNumReused);
+
+  if (!pgRange.BeginNextStep("Collect Tiles"))
+    return EZ_FAILURE;
+
+  // tiles without geometry are not stored at all, tiles with geometry but without walkable area are kept for the tile cache
+  out_NavMeshDesc.m_fTileSize = fTileSize;
+
+  for (ezRecastNavMeshTile& tile : tiles)
+  {
+    if (tile.m_uiGeometryHash != 0)
+    {
+      out_NavMeshDesc.m_Tiles.PushBack(std::move(tile));
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshBuilder::BuildTile(
+  const ezRecastConfig& config, const rcConfig& tileConfig, ezArrayPtr<const ezUInt32> triangles, ezRecastNavMeshTile& out_Tile) const
+{
+  ezRcBuildContext context;
+
+  ezDynamicArray<ezInt32> indices;
+  indices.SetCountUninitialized(triangles.GetCount() * 3);
+
+  for (ezUInt32 t = 0; t < triangles.GetCount(); ++t)
+  {
+    const Triangle& tri = m_Triangles[triangles[t]];
+    indices[t * 3 + 0] = tri.m_VertexIdx[0];
+    indices[t * 3 + 1] = tri.m_VertexIdx[1];
+    indices[t * 3 + 2] = tri.m_VertexIdx[2];
+  }
+
+  ezDynamicArray<ezUInt8> areaIDs;
+  areaIDs.SetCount(triangles.GetCount());
+
+  out_Tile.m_pPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+  EZ_SUCCEED_OR_RETURN(BuildPolyMesh(&context, tileConfig, &m_Vertices[0].x, m_Vertices.GetCount(), indices.GetData(), areaIDs.GetData(),
+    triangles.GetCount(), *out_Tile.m_pPolygons, nullptr));
+
+  if (out_Tile.m_pPolygons->npolys == 0)
+  {
+    // nothing walkable in this tile
+    EZ_DEFAULT_DELETE(out_Tile.m_pPolygons);
+    return EZ_SUCCESS;
+  }
+
+  return BuildDetourNavMeshData(config, *out_Tile.m_pPolygons, out_Tile.m_DetourTileData, out_Tile.m_iTileX, out_Tile.m_iTileY);
+}
+
+ezUInt64 ezRecastNavMeshBuilder::ComputeTileHash(
+  const ezRecastConfig& config, ezInt32 iTileX, ezInt32 iTileY, ezArrayPtr<const ezUInt32> triangles) const
+{
+  // hash the config values one by one, the struct itself may contain padding or members that do not affect the build
+  const float configValues[] = {config.m_fAgentHeight, config.m_fAgentRadius, config.m_fAgentClimbHeight, config.m_WalkableSlope.GetRadian(),
+    config.m_fCellSize, config.m_fCellHeight, config.m_fMaxEdgeLength, config.m_fMaxSimplificationError, config.m_fMinRegionSize,
+    config.m_fRegionMergeSize, config.m_fDetailMeshSampleDistanceFactor, config.m_fDetailMeshSampleErrorFactor, config.m_fTileSize};
+
+  const ezInt32 tileCoords[2] = {iTileX, iTileY};
+
+  ezUInt64 uiHash = ezHashingUtils::xxHash64(configValues, sizeof(configValues));
+  uiHash = ezHashingUtils::xxHash64(tileCoords, sizeof(tileCoords), uiHash);
+
+  for (ezUInt32 t : triangles)
+  {
+    const Triangle& tri = m_Triangles[t];
+    const ezVec3 positions[3] = {m_Vertices[tri.m_VertexIdx[0]], m_Vertices[tri.m_VertexIdx[1]], m_Vertices[tri.m_VertexIdx[2]]};
+
+    uiHash = ezHashingUtils::xxHash64(positions, sizeof(positions), uiHash);
+  }
+
+  // zero marks tiles without geometry
+  return uiHash != 0 ? uiHash : 1;
+}
+
 ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(1);
+  stream.WriteVersion(2);
 
   stream << m_fAgentHeight;
   stream << m_fAgentRadius;
@@ -494,12 +734,15 @@ ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
   stream << m_fDetailMeshSampleDistanceFactor;
   stream << m_fDetailMeshSampleErrorFactor;
 
+  // version 2
+  stream << m_fTileSize;
+
   return EZ_SUCCESS;
 }
 
 ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
 {
-  stream.ReadVersion(1);
+  const ezTypeVersion version = stream.ReadVersion(2);
 
   stream >> m_fAgentHeight;
   stream >> m_fAgentRadius;
@@ -514,5 +757,10 @@ ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
   stream >> m_fDetailMeshSampleDistanceFactor;
   stream >> m_fDetailMeshSampleErrorFactor;
 
+  if (version >= 2)
+  {
+    stream >> m_fTileSize;
+  }
+
   return EZ_SUCCESS;
 }
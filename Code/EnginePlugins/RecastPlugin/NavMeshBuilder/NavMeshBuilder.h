@@ -6,11 +6,13 @@
 #include <RecastPlugin/RecastPluginDLL.h>
 
 class ezRcBuildContext;
+struct rcConfig;
 struct rcPolyMesh;
 struct rcPolyMeshDetail;
 class ezWorld;
 class dtNavMesh;
 struct ezRecastNavMeshResourceDescriptor;
+struct ezRecastNavMeshTile;
 class ezProgress;
 class ezStreamWriter;
 class ezStreamReader;
@@ -30,6 +32,11 @@ struct EZ_RECASTPLUGIN_DLL ezRecastConfig
   float m_fDetailMeshSampleDistanceFactor = 1.0f;
   float m_fDetailMeshSampleErrorFactor = 1.0f;
 
+  /// \brief If larger than zero, the navmesh is built as a grid of tiles of this size (in meters).
+  ///
+  /// Tiles are built in parallel and each tile can be reused from a previous build, if none of the geometry that touches it changed.
+  float m_fTileSize = 0.0f;
+
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
 };
@@ -46,8 +53,12 @@ public:
 
   static ezResult ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::Geometry& out_worldGeo);
 
+  /// \brief Builds the navmesh for the given geometry.
+  ///
+  /// For tiled navmeshes (ezRecastConfig::m_fTileSize > 0) \a pTileCache may point to the result of a previous build.
+  /// All tiles whose geometry hash did not change are then copied from it instead of being rebuilt.
   ezResult Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& worldGeo,
-    ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress);
+    ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress, const ezRecastNavMeshResourceDescriptor* pTileCache = nullptr);
 
 private:
   static void FillOutConfig(struct rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
@@ -57,7 +68,14 @@ private:
   void GenerateTriangleMeshFromDescription(const ezWorldGeoExtractionUtil::Geometry& desc);
   void ComputeBoundingBox();
   ezResult BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress);
-  static ezResult BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData);
+  static ezResult BuildDetourNavMeshData(
+    const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData, ezInt32 iTileX = 0, ezInt32 iTileY = 0);
+
+  ezResult BuildTiles(const ezRecastConfig& config, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress,
+    const ezRecastNavMeshResourceDescriptor* pTileCache);
+  ezResult BuildTile(const ezRecastConfig& config, const rcConfig& tileConfig, ezArrayPtr<const ezUInt32> triangles,
+    ezRecastNavMeshTile& out_Tile) const;
+  ezUInt64 ComputeTileHash(const ezRecastConfig& config, ezInt32 iTileX, ezInt32 iTileY, ezArrayPtr<const ezUInt32> triangles) const;
 
   struct Triangle
   {
@@ -262,23 +262,8 @@ void ezNavMeshPointOfInterestGraph::ExtractInterestPointsFromMesh(const rcPolyMe
 
   if (bReinitialize)
   {
-    ezBoundingBox box;
-    box.SetInvalid();
-
-    // compute bounding box
-    {
-      for (auto potPoi : interestPoints)
-      {
-        if (potPoi.m_bUsed)
-        {
-          box.ExpandToInclude(potPoi.m_vPosition);
-        }
-      }
-
-      box.Grow(ezVec3(1.0f));
-    }
-
-    m_NavMeshPointGraph.Initialize(box.GetCenter(), box.GetHalfExtents());
+    // the AI components look for points within 10 to 20 meters
+    m_NavMeshPointGraph.Initialize(5.0f);
   }
 
 
@@ -16,6 +16,39 @@ EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezRecastNavMeshResource);
 
 //////////////////////////////////////////////////////////////////////////
 
+ezRecastNavMeshTile::ezRecastNavMeshTile() = default;
+ezRecastNavMeshTile::ezRecastNavMeshTile(ezRecastNavMeshTile&& rhs)
+{
+  *this = std::move(rhs);
+}
+
+ezRecastNavMeshTile::~ezRecastNavMeshTile()
+{
+  Clear();
+}
+
+void ezRecastNavMeshTile::operator=(ezRecastNavMeshTile&& rhs)
+{
+  Clear();
+
+  m_iTileX = rhs.m_iTileX;
+  m_iTileY = rhs.m_iTileY;
+  m_uiGeometryHash = rhs.m_uiGeometryHash;
+  m_DetourTileData = std::move(rhs.m_DetourTileData);
+
+  m_pPolygons = rhs.m_pPolygons;
+  rhs.m_pPolygons = nullptr;
+}
+
+void ezRecastNavMeshTile::Clear()
+{
+  m_uiGeometryHash = 0;
+  m_DetourTileData.Clear();
+  EZ_DEFAULT_DELETE(m_pPolygons);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor() = default;
 ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor(ezRecastNavMeshResourceDescriptor&& rhs)
 {
@@ -33,29 +66,58 @@ void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescrip
 
   m_pNavMeshPolygons = rhs.m_pNavMeshPolygons;
   rhs.m_pNavMeshPolygons = nullptr;
+
+  m_Tiles = std::move(rhs.m_Tiles);
+  m_fTileSize = rhs.m_fTileSize;
 }
 
 void ezRecastNavMeshResourceDescriptor::Clear()
 {
   m_DetourNavmeshData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
+  m_Tiles.Clear();
+  m_fTileSize = 0.0f;
+}
+
+const ezRecastNavMeshTile* ezRecastNavMeshResourceDescriptor::FindTile(ezInt32 iTileX, ezInt32 iTileY) const
+{
+  ezUInt32 uiFirst = 0;
+  ezUInt32 uiCount = m_Tiles.GetCount();
+
+  while (uiCount > 0)
+  {
+    const ezUInt32 uiStep = uiCount / 2;
+    const ezRecastNavMeshTile& tile = m_Tiles[uiFirst + uiStep];
+
+    if (tile.m_iTileY < iTileY || (tile.m_iTileY == iTileY && tile.m_iTileX < iTileX))
+    {
+      uiFirst += uiStep + 1;
+      uiCount -= uiStep + 1;
+    }
+    else
+    {
+      uiCount = uiStep;
+    }
+  }
+
+  if (uiFirst < m_Tiles.GetCount() && m_Tiles[uiFirst].m_iTileX == iTileX && m_Tiles[uiFirst].m_iTileY == iTileY)
+    return &m_Tiles[uiFirst];
+
+  return nullptr;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) const
+static ezResult WritePolyMesh(ezStreamWriter& stream, const rcPolyMesh* pPolyMesh)
 {
-  stream.WriteVersion(1);
-  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_DetourNavmeshData));
-
-  const bool hasPolygons = m_pNavMeshPolygons != nullptr;
+  const bool hasPolygons = pPolyMesh != nullptr;
   stream << hasPolygons;
 
   if (hasPolygons)
   {
     EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
 
-    const auto& mesh = *m_pNavMeshPolygons;
+    const auto& mesh = *pPolyMesh;
 
     stream << (int)mesh.nverts;
     stream << (int)mesh.npolys;
@@ -84,13 +146,8 @@ ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) co
   return EZ_SUCCESS;
 }
 
-ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
+static void ReadPolyMesh(ezStreamReader& stream, rcPolyMesh*& out_pPolyMesh)
 {
-  Clear();
-
-  const ezTypeVersion version = stream.ReadVersion(1);
-  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_DetourNavmeshData));
-
   bool hasPolygons = false;
   stream >> hasPolygons;
 
@@ -98,9 +155,9 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
   {
     EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
 
-    m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+    out_pPolyMesh = EZ_DEFAULT_NEW(rcPolyMesh);
 
-    auto& mesh = *m_pNavMeshPolygons;
+    auto& mesh = *out_pPolyMesh;
 
     stream >> mesh.nverts;
     stream >> mesh.npolys;
@@ -122,6 +179,7 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
     mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
     mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
     mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+    mesh.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
     mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
 
     stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
@@ -130,6 +188,55 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
     stream.ReadBytes(mesh.flags, sizeof(ezUInt16) * mesh.maxpolys);
     stream.ReadBytes(mesh.areas, sizeof(ezUInt8) * mesh.maxpolys);
   }
+}
+
+ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) const
+{
+  stream.WriteVersion(2);
+  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_DetourNavmeshData));
+  EZ_SUCCEED_OR_RETURN(WritePolyMesh(stream, m_pNavMeshPolygons));
+
+  // version 2
+  stream << m_fTileSize;
+  stream << m_Tiles.GetCount();
+
+  for (const ezRecastNavMeshTile& tile : m_Tiles)
+  {
+    stream << tile.m_iTileX;
+    stream << tile.m_iTileY;
+    stream << tile.m_uiGeometryHash;
+    EZ_SUCCEED_OR_RETURN(stream.WriteArray(tile.m_DetourTileData));
+    EZ_SUCCEED_OR_RETURN(WritePolyMesh(stream, tile.m_pPolygons));
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
+{
+  Clear();
+
+  const ezTypeVersion version = stream.ReadVersion(2);
+  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_DetourNavmeshData));
+  ReadPolyMesh(stream, m_pNavMeshPolygons);
+
+  if (version >= 2)
+  {
+    ezUInt32 uiNumTiles = 0;
+    stream >> m_fTileSize;
+    stream >> uiNumTiles;
+
+    m_Tiles.SetCount(uiNumTiles);
+
+    for (ezRecastNavMeshTile& tile : m_Tiles)
+    {
+      stream >> tile.m_iTileX;
+      stream >> tile.m_iTileY;
+      stream >> tile.m_uiGeometryHash;
+      EZ_SUCCEED_OR_RETURN(stream.ReadArray(tile.m_DetourTileData));
+      ReadPolyMesh(stream, tile.m_pPolygons);
+    }
+  }
 
   return EZ_SUCCESS;
 }
@@ -155,8 +262,10 @@ ezResourceLoadDesc ezRecastNavMeshResource::UnloadData(Unload WhatToUnload)
   res.m_uiQualityLevelsLoadable = 0;
   res.m_State = ezResourceState::Unloaded;
 
-  m_DetourNavmeshData.Clear();
+  // the navmesh references the tile data, so it has to go first
   EZ_DEFAULT_DELETE(m_pNavMesh);
+  m_DetourNavmeshData.Clear();
+  m_TileData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
 
   return res;
@@ -195,6 +304,11 @@ void ezRecastNavMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
   out_NewMemoryUsage.m_uiMemoryCPU += m_DetourNavmeshData.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU += m_TileData.GetHeapMemoryUsage();
+  for (const ezDataBuffer& tileData : m_TileData)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += tileData.GetHeapMemoryUsage();
+  }
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMesh != nullptr ? sizeof(dtNavMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMeshPolygons != nullptr ? sizeof(rcPolyMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
@@ -207,6 +321,16 @@ ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResour
   res.m_uiQualityLevelsLoadable = 0;
   res.m_State = ezResourceState::Loaded;
 
+  if (descriptor.IsTiled())
+  {
+    if (CreateTiledNavMesh(descriptor).Failed())
+    {
+      res.m_State = ezResourceState::LoadedResourceMissing;
+    }
+
+    return res;
+  }
+
   m_pNavMeshPolygons = descriptor.m_pNavMeshPolygons;
   descriptor.m_pNavMeshPolygons = nullptr;
 
@@ -220,3 +344,94 @@ ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResour
 
   return res;
 }
+
+ezResult ezRecastNavMeshResource::CreateTiledNavMesh(ezRecastNavMeshResourceDescriptor& descriptor)
+{
+  ezUInt32 uiNumTilesWithData = 0;
+  ezUInt32 uiMaxTilePolys = 0;
+  for (const ezRecastNavMeshTile& tile : descriptor.m_Tiles)
+  {
+    if (tile.m_DetourTileData.IsEmpty())
+      continue;
+
+    ++uiNumTilesWithData;
+
+    // the tile data starts with the Detour header
+    const dtMeshHeader* pHeader = reinterpret_cast<const dtMeshHeader*>(tile.m_DetourTileData.GetData());
+    uiMaxTilePolys = ezMath::Max(uiMaxTilePolys, static_cast<ezUInt32>(pHeader->polyCount));
+  }
+
+  // polygon references are 32 bit (22 of them for the tile and polygon index), the more tiles, the fewer polygons per tile
+  const ezUInt32 uiTileBits = ezMath::Max(ezMath::Log2i(ezMath::PowerOfTwo_Ceil(ezMath::Max(uiNumTilesWithData, 1u))), 1u);
+  if (uiTileBits > 14)
+  {
+    ezLog::Error("NavMesh has too many tiles ({0}), use a larger tile size", uiNumTilesWithData);
+    return EZ_FAILURE;
+  }
+
+  const ezUInt32 uiMaxPolys = 1u << (22 - uiTileBits);
+  if (uiMaxTilePolys > uiMaxPolys)
+  {
+    ezLog::Error("A navmesh tile has {0} polygons, but with {1} tiles only {2} polygons per tile can be referenced, use a smaller tile size",
+      uiMaxTilePolys, uiNumTilesWithData, uiMaxPolys);
+    return EZ_FAILURE;
+  }
+
+  dtNavMeshParams params;
+  params.orig[0] = 0.0f;
+  params.orig[1] = 0.0f;
+  params.orig[2] = 0.0f;
+  params.tileWidth = descriptor.m_fTileSize;
+  params.tileHeight = descriptor.m_fTileSize;
+  params.maxTiles = 1 << uiTileBits;
+  params.maxPolys = static_cast<int>(uiMaxPolys);
+
+  m_pNavMesh = EZ_DEFAULT_NEW(dtNavMesh);
+  if (dtStatusFailed(m_pNavMesh->init(&params)))
+  {
+    ezLog::Error("Could not initialize tiled navmesh");
+    return EZ_FAILURE;
+  }
+
+  // every tile keeps its own data buffer, so tiles can be added to the navmesh one at a time
+  ezHybridArray<rcPolyMesh*, 64> tilePolygons;
+  m_TileData.Reserve(uiNumTilesWithData);
+
+  for (ezRecastNavMeshTile& tile : descriptor.m_Tiles)
+  {
+    if (tile.m_DetourTileData.IsEmpty())
+      continue;
+
+    ezDataBuffer& tileData = m_TileData.ExpandAndGetRef();
+    tileData = std::move(tile.m_DetourTileData);
+
+    // the dtNavMesh does not need to free the data, the resource owns it
+    const int dtTileFlags = 0;
+    if (dtStatusFailed(m_pNavMesh->addTile(tileData.GetData(), tileData.GetCount(), dtTileFlags, 0, nullptr)))
+    {
+      ezLog::Error("Could not add navmesh tile ({0}, {1})", tile.m_iTileX, tile.m_iTileY);
+      m_TileData.PopBack();
+      continue;
+    }
+
+    if (tile.m_pPolygons != nullptr && tile.m_pPolygons->npolys > 0)
+    {
+      tilePolygons.PushBack(tile.m_pPolygons);
+    }
+  }
+
+  // merge the polygons of all tiles into one mesh, which is what the visualization and the points of interest work with
+  if (!tilePolygons.IsEmpty())
+  {
+    rcContext context(false);
+    m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+    if (!rcMergePolyMeshes(&context, tilePolygons.GetData(), tilePolygons.GetCount(), *m_pNavMeshPolygons))
+    {
+      ezLog::Warning("Could not merge the navmesh tile polygons");
+      EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
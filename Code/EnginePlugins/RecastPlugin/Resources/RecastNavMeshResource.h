@@ -8,6 +8,31 @@ class dtNavMesh;
 
 typedef ezTypedResourceHandle<class ezRecastNavMeshResource> ezRecastNavMeshResourceHandle;
 
+/// \brief One tile of a tiled navmesh.
+struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshTile
+{
+  ezRecastNavMeshTile();
+  ezRecastNavMeshTile(const ezRecastNavMeshTile& rhs) = delete;
+  ezRecastNavMeshTile(ezRecastNavMeshTile&& rhs);
+  ~ezRecastNavMeshTile();
+  void operator=(ezRecastNavMeshTile&& rhs);
+  void operator=(const ezRecastNavMeshTile& rhs) = delete;
+
+  ezInt32 m_iTileX = 0;
+  ezInt32 m_iTileY = 0;
+
+  /// \brief Hash of the build configuration and of all triangles that touch this tile. Used to skip rebuilding unchanged tiles.
+  ezUInt64 m_uiGeometryHash = 0;
+
+  /// \brief Data that was created by dtCreateNavMeshData() and will be used for dtNavMesh::addTile()
+  ezDataBuffer m_DetourTileData;
+
+  /// \brief The polygons of this tile, they are merged into one mesh for visualization at runtime
+  rcPolyMesh* m_pPolygons = nullptr;
+
+  void Clear();
+};
+
 struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
 {
   ezRecastNavMeshResourceDescriptor();
@@ -23,6 +48,17 @@ struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
   /// \brief Optional, if available the navmesh can be visualized at runtime
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 
+  /// \brief For tiled navmeshes, m_DetourNavmeshData is empty and the navmesh consists of these tiles instead
+  ezDynamicArray<ezRecastNavMeshTile> m_Tiles;
+
+  /// \brief The size of each tile, the tile grid starts at the world origin
+  float m_fTileSize = 0.0f;
+
+  bool IsTiled() const { return !m_Tiles.IsEmpty(); }
+
+  /// \brief Returns the tile with the given coordinates or nullptr. The tiles must be sorted by their y and then x coordinate.
+  const ezRecastNavMeshTile* FindTile(ezInt32 iTileX, ezInt32 iTileY) const;
+
   void Clear();
 
   ezResult Serialize(ezStreamWriter& stream) const;
@@ -42,12 +78,18 @@ public:
   const dtNavMesh* GetNavMesh() const { return m_pNavMesh; }
   const rcPolyMesh* GetNavMeshPolygons() const { return m_pNavMeshPolygons; }
 
+  /// \brief Returns how many tiles the navmesh consists of, zero for navmeshes that were not built in tiled mode.
+  ezUInt32 GetNumTiles() const { return m_TileData.GetCount(); }
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
+  ezResult CreateTiledNavMesh(ezRecastNavMeshResourceDescriptor& descriptor);
+
   ezDataBuffer m_DetourNavmeshData;
+  ezDynamicArray<ezDataBuffer> m_TileData;
   dtNavMesh* m_pNavMesh = nullptr;
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 };
@@ -0,0 +1,356 @@
+#include <RecastPluginPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <RecastPlugin/WorldModule/RecastPathQueryQueue.h>
+
+ezCVarFloat CVarPathQueryBudget("ai_PathQueryBudget", 1.0f, ezCVarFlags::Default, "How many milliseconds each worker thread may spend on path queries per frame");
+
+/// \todo Hard-coded limits
+static constexpr ezUInt32 s_uiMaxCorridorLength = 256;
+static constexpr int s_iMaxSearchNodes = 2048;
+static constexpr int s_iIterationsPerSlice = 32;
+
+ezRecastPathQueryQueue::ezRecastPathQueryQueue() = default;
+
+ezRecastPathQueryQueue::~ezRecastPathQueryQueue()
+{
+  Clear();
+}
+
+ezUInt32 ezRecastPathQueryQueue::RequestPath(dtPolyRef startPoly, const ezVec3& vStartPos, dtPolyRef endPoly, const ezVec3& vEndPos)
+{
+  const ezUInt32 uiRequestID = m_uiNextRequestID++;
+  if (m_uiNextRequestID == 0)
+    m_uiNextRequestID = 1;
+
+  m_Results.Insert(uiRequestID, Result());
+
+  // agents that stand on the same polygon and want to go to the same target polygon all get the same corridor
+  const ezUInt64 uiKey = ComputeQueryKey(startPoly, endPoly);
+
+  ezUInt32 uiPendingIndex = 0;
+  if (m_PendingByPolys.TryGetValue(uiKey, uiPendingIndex))
+  {
+    Query& query = m_Pending[uiPendingIndex];
+
+    if (query.m_StartPoly == startPoly && query.m_EndPoly == endPoly)
+    {
+      query.m_RequestIDs.PushBack(uiRequestID);
+      return uiRequestID;
+    }
+  }
+
+  Query& query = m_Pending.ExpandAndGetRef();
+  query.m_StartPoly = startPoly;
+  query.m_EndPoly = endPoly;
+  query.m_vStartPos = vStartPos;
+  query.m_vEndPos = vEndPos;
+  query.m_RequestIDs.PushBack(uiRequestID);
+
+  m_PendingByPolys.Insert(uiKey, m_Pending.GetCount() - 1);
+
+  return uiRequestID;
+}
+
+void ezRecastPathQueryQueue::CancelRequest(ezUInt32 uiRequestID)
+{
+  // queries that only serve canceled requests are skipped before they are started
+  m_Results.Remove(uiRequestID);
+}
+
+ezRecastPathQueryState::Enum ezRecastPathQueryQueue::FetchResult(ezUInt32 uiRequestID, ezDynamicArray<dtPolyRef>& out_Corridor)
+{
+  Result* pResult = nullptr;
+  if (!m_Results.TryGetValue(uiRequestID, pResult))
+    return ezRecastPathQueryState::Invalid;
+
+  const ezRecastPathQueryState::Enum state = pResult->m_State;
+
+  if (state == ezRecastPathQueryState::Pending)
+    return state;
+
+  out_Corridor = std::move(pResult->m_Corridor);
+  m_Results.Remove(uiRequestID);
+
+  return state;
+}
+
+void ezRecastPathQueryQueue::BeginUpdate(const dtNavMesh* pNavMesh)
+{
+  EZ_ASSERT_DEV(!m_UpdateTaskGroup.IsValid(), "FinishUpdate() was not called");
+
+  if (m_pNavMesh != pNavMesh)
+  {
+    // all queued polygon references belong to the previous navmesh
+    Clear();
+    m_pNavMesh = pNavMesh;
+  }
+
+  if (m_pNavMesh == nullptr)
+    return;
+
+  EZ_PROFILE_SCOPE("Start Path Queries");
+
+  if (m_Workers.IsEmpty())
+  {
+    const ezUInt32 uiNumWorkers = ezMath::Max(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks), 1u);
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      ezUniquePtr<Worker> pWorker = EZ_DEFAULT_NEW(Worker);
+      pWorker->m_pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+      pWorker->m_pQuery->init(m_pNavMesh, s_iMaxSearchNodes);
+      pWorker->m_Task.m_pQueue = this;
+      pWorker->m_Task.m_pWorker = pWorker.Borrow();
+      pWorker->m_Task.SetTaskName("Path Queries");
+
+      m_Workers.PushBack(std::move(pWorker));
+    }
+  }
+
+  // only a few queries per target are started at once, the others wait a frame, because chances are that they start on the corridor
+  // that one of the first ones computes
+  ezHashTable<dtPolyRef, ezUInt32> startedPerTarget;
+  ezDynamicArray<Query> deferred;
+
+  m_Starting.Clear();
+
+  for (Query& query : m_Pending)
+  {
+    if (!HasLiveRequests(query))
+      continue;
+
+    if (TryReuseRecentCorridor(query))
+      continue;
+
+    ezUInt32& uiNumStarted = startedPerTarget[query.m_EndPoly];
+    if (uiNumStarted >= m_Workers.GetCount())
+    {
+      deferred.PushBack(std::move(query));
+      continue;
+    }
+
+    ++uiNumStarted;
+    m_Starting.PushBack(std::move(query));
+  }
+
+  m_Pending = std::move(deferred);
+
+  m_PendingByPolys.Clear();
+  for (ezUInt32 i = 0; i < m_Pending.GetCount(); ++i)
+  {
+    m_PendingByPolys.Insert(ComputeQueryKey(m_Pending[i].m_StartPoly, m_Pending[i].m_EndPoly), i);
+  }
+
+  m_iNextStartingQuery = 0;
+
+  bool bHasWork = !m_Starting.IsEmpty();
+  for (const auto& pWorker : m_Workers)
+  {
+    bHasWork |= pWorker->m_bQueryActive;
+  }
+
+  if (!bHasWork)
+    return;
+
+  m_UpdateBudget = ezTime::Milliseconds(ezMath::Max(CVarPathQueryBudget.GetValue(), 0.01f));
+  m_UpdateTaskGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyNextFrame);
+
+  for (const auto& pWorker : m_Workers)
+  {
+    ezTaskSystem::AddTaskToGroup(m_UpdateTaskGroup, &pWorker->m_Task);
+  }
+
+  ezTaskSystem::StartTaskGroup(m_UpdateTaskGroup);
+}
+
+void ezRecastPathQueryQueue::FinishUpdate()
+{
+  if (!m_UpdateTaskGroup.IsValid())
+    return;
+
+  EZ_PROFILE_SCOPE("Finish Path Queries");
+
+  ezTaskSystem::WaitForGroup(m_UpdateTaskGroup);
+  m_UpdateTaskGroup.Invalidate();
+
+  // queries that no worker got to in time are tried first in the next frame
+  const ezUInt32 uiFirstUnclaimed = ezMath::Min(static_cast<ezUInt32>(static_cast<ezInt32>(m_iNextStartingQuery)), m_Starting.GetCount());
+  if (uiFirstUnclaimed < m_Starting.GetCount())
+  {
+    for (ezUInt32 i = uiFirstUnclaimed; i < m_Starting.GetCount(); ++i)
+    {
+      m_Pending.Insert(std::move(m_Starting[i]), i - uiFirstUnclaimed);
+    }
+
+    m_PendingByPolys.Clear();
+    for (ezUInt32 i = 0; i < m_Pending.GetCount(); ++i)
+    {
+      m_PendingByPolys.Insert(ComputeQueryKey(m_Pending[i].m_StartPoly, m_Pending[i].m_EndPoly), i);
+    }
+  }
+
+  m_Starting.Clear();
+  m_RecentCorridors.Clear();
+
+  for (const auto& pWorker : m_Workers)
+  {
+    for (FinishedQuery& finished : pWorker->m_Finished)
+    {
+      PublishResult(finished.m_RequestIDs, finished.m_State, finished.m_Corridor);
+
+      if (finished.m_State == ezRecastPathQueryState::Succeeded)
+      {
+        m_RecentCorridors[finished.m_EndPoly] = std::move(finished.m_Corridor);
+      }
+    }
+
+    pWorker->m_Finished.Clear();
+  }
+}
+
+void ezRecastPathQueryQueue::Clear()
+{
+  if (m_UpdateTaskGroup.IsValid())
+  {
+    ezTaskSystem::WaitForGroup(m_UpdateTaskGroup);
+    m_UpdateTaskGroup.Invalidate();
+  }
+
+  for (auto it = m_Results.GetIterator(); it.IsValid(); ++it)
+  {
+    if (it.Value().m_State == ezRecastPathQueryState::Pending)
+    {
+      it.Value().m_State = ezRecastPathQueryState::NavMeshChanged;
+    }
+  }
+
+  m_Pending.Clear();
+  m_PendingByPolys.Clear();
+  m_Starting.Clear();
+  m_RecentCorridors.Clear();
+  m_Workers.Clear();
+  m_pNavMesh = nullptr;
+}
+
+ezUInt64 ezRecastPathQueryQueue::ComputeQueryKey(dtPolyRef startPoly, dtPolyRef endPoly)
+{
+  const dtPolyRef polys[2] = {startPoly, endPoly};
+  return ezHashingUtils::xxHash64(polys, sizeof(polys));
+}
+
+bool ezRecastPathQueryQueue::HasLiveRequests(const Query& query) const
+{
+  for (ezUInt32 uiRequestID : query.m_RequestIDs)
+  {
+    if (m_Results.Contains(uiRequestID))
+      return true;
+  }
+
+  return false;
+}
+
+bool ezRecastPathQueryQueue::TryReuseRecentCorridor(const Query& query)
+{
+  const ezDynamicArray<dtPolyRef>* pCorridor = m_RecentCorridors.GetValue(query.m_EndPoly);
+  if (pCorridor == nullptr)
+    return false;
+
+  for (ezUInt32 i = 0; i < pCorridor->GetCount(); ++i)
+  {
+    if ((*pCorridor)[i] == query.m_StartPoly)
+    {
+      PublishResult(query.m_RequestIDs, ezRecastPathQueryState::Succeeded, pCorridor->GetArrayPtr().GetSubArray(i));
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ezRecastPathQueryQueue::UpdateTask::Execute()
+{
+  m_pQueue->UpdateWorker(*m_pWorker);
+}
+
+void ezRecastPathQueryQueue::UpdateWorker(Worker& worker)
+{
+  /// \todo Hard-coded filter
+  const dtQueryFilter filter;
+
+  // the budget starts when the worker actually gets to run, not when the tasks were started
+  const ezTime tEnd = ezTime::Now() + m_UpdateBudget;
+
+  while (ezTime::Now() < tEnd)
+  {
+    if (!worker.m_bQueryActive)
+    {
+      const ezInt32 iNextQuery = m_iNextStartingQuery.Increment() - 1;
+      if (iNextQuery >= static_cast<ezInt32>(m_Starting.GetCount()))
+        return;
+
+      worker.m_ActiveQuery = std::move(m_Starting[iNextQuery]);
+      worker.m_bQueryActive = true;
+
+      const Query& query = worker.m_ActiveQuery;
+      const dtStatus status = worker.m_pQuery->initSlicedFindPath(query.m_StartPoly, query.m_EndPoly, query.m_vStartPos, query.m_vEndPos, &filter);
+
+      if (!dtStatusInProgress(status))
+      {
+        FinishQuery(worker, status);
+      }
+
+      continue;
+    }
+
+    const dtStatus status = worker.m_pQuery->updateSlicedFindPath(s_iIterationsPerSlice, nullptr);
+
+    if (!dtStatusInProgress(status))
+    {
+      FinishQuery(worker, status);
+    }
+  }
+}
+
+void ezRecastPathQueryQueue::FinishQuery(Worker& worker, dtStatus status)
+{
+  FinishedQuery& finished = worker.m_Finished.ExpandAndGetRef();
+  finished.m_EndPoly = worker.m_ActiveQuery.m_EndPoly;
+  finished.m_RequestIDs = std::move(worker.m_ActiveQuery.m_RequestIDs);
+  finished.m_State = ezRecastPathQueryState::Failed;
+
+  worker.m_bQueryActive = false;
+
+  if (dtStatusFailed(status))
+    return;
+
+  int iCorridorLength = 0;
+  finished.m_Corridor.SetCountUninitialized(s_uiMaxCorridorLength);
+
+  if (dtStatusFailed(worker.m_pQuery->finalizeSlicedFindPath(finished.m_Corridor.GetData(), &iCorridorLength, (int)s_uiMaxCorridorLength)) ||
+      iCorridorLength <= 0)
+  {
+    finished.m_Corridor.Clear();
+    return;
+  }
+
+  finished.m_Corridor.SetCountUninitialized(iCorridorLength);
+
+  // if the corridor does not end in the target polygon, the target cannot be reached, but the agent can walk close to it
+  finished.m_State = finished.m_Corridor.PeekBack() == finished.m_EndPoly ? ezRecastPathQueryState::Succeeded : ezRecastPathQueryState::PartialPath;
+}
+
+void ezRecastPathQueryQueue::PublishResult(
+  const ezArrayPtr<const ezUInt32>& requestIDs, ezRecastPathQueryState::Enum state, ezArrayPtr<const dtPolyRef> corridor)
+{
+  for (ezUInt32 uiRequestID : requestIDs)
+  {
+    Result* pResult = nullptr;
+    if (!m_Results.TryGetValue(uiRequestID, pResult))
+      continue;
+
+    pResult->m_State = state;
+    pResult->m_Corridor = corridor;
+  }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <RecastPlugin/RecastPluginDLL.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Recast/DetourNavMeshQuery.h>
+#include <RecastPlugin/Utils/RcMath.h>
+
+struct ezRecastPathQueryState
+{
+  enum Enum
+  {
+    Invalid,        ///< The request ID is unknown, e.g. because the result was already fetched or the request was canceled.
+    Pending,        ///< The path is not computed yet.
+    Succeeded,      ///< A path to the target polygon was found.
+    PartialPath,    ///< The target polygon cannot be reached, the path leads as close to it as possible.
+    Failed,         ///< No path could be computed.
+    NavMeshChanged, ///< The navmesh was replaced before the path was computed. The path has to be requested again with polygons of the new navmesh.
+  };
+};
+
+/// \brief Computes path corridors for many agents asynchronously, within a fixed time budget per frame.
+///
+/// Agents submit requests with RequestPath() and poll for the result with FetchResult() in later frames.
+/// All requests are processed with sliced Detour queries on worker threads, each worker uses its own dtNavMeshQuery, so a long query
+/// can span multiple frames. How much time each worker may spend per frame is configured through the CVar 'ai_PathQueryBudget'.
+///
+/// Requests are coalesced in two ways. Requests with the same start and end polygon are merged into a single query. And when a
+/// request starts on a polygon that lies on a corridor towards the same target that was computed shortly before, the remainder of that
+/// corridor is used instead of running a new query. Both cases are very common when many agents get the same goal at once.
+///
+/// All public functions must be called from the main thread.
+class EZ_RECASTPLUGIN_DLL ezRecastPathQueryQueue
+{
+public:
+  ezRecastPathQueryQueue();
+  ~ezRecastPathQueryQueue();
+
+  /// \brief Queues a path request and returns its ID, which is never zero.
+  ezUInt32 RequestPath(dtPolyRef startPoly, const ezVec3& vStartPos, dtPolyRef endPoly, const ezVec3& vEndPos);
+
+  /// \brief Drops the request. Its result is discarded, if it was already computed.
+  void CancelRequest(ezUInt32 uiRequestID);
+
+  /// \brief Returns the state of the request. Once it is not pending anymore, the result is handed out and the request ID becomes invalid.
+  ezRecastPathQueryState::Enum FetchResult(ezUInt32 uiRequestID, ezDynamicArray<dtPolyRef>& out_Corridor);
+
+  /// \brief Starts processing pending requests on worker threads.
+  void BeginUpdate(const dtNavMesh* pNavMesh);
+
+  /// \brief Waits for the processing to finish and makes all computed results available through FetchResult().
+  void FinishUpdate();
+
+  /// \brief Cancels all queries, e.g. because the navmesh is about to be unloaded.
+  ///
+  /// Running queries are only waited for as long as the per-frame budget allows. All outstanding requests are finished with
+  /// ezRecastPathQueryState::NavMeshChanged, since their polygon references may not be valid anymore.
+  void Clear();
+
+private:
+  struct Query
+  {
+    dtPolyRef m_StartPoly = 0;
+    dtPolyRef m_EndPoly = 0;
+    ezRcPos m_vStartPos;
+    ezRcPos m_vEndPos;
+    ezHybridArray<ezUInt32, 1> m_RequestIDs;
+  };
+
+  struct FinishedQuery
+  {
+    ezRecastPathQueryState::Enum m_State = ezRecastPathQueryState::Failed;
+    dtPolyRef m_EndPoly = 0;
+    ezHybridArray<ezUInt32, 1> m_RequestIDs;
+    ezDynamicArray<dtPolyRef> m_Corridor;
+  };
+
+  struct Result
+  {
+    ezRecastPathQueryState::Enum m_State = ezRecastPathQueryState::Pending;
+    ezDynamicArray<dtPolyRef> m_Corridor;
+  };
+
+  struct Worker;
+
+  class UpdateTask : public ezTask
+  {
+  public:
+    ezRecastPathQueryQueue* m_pQueue = nullptr;
+    Worker* m_pWorker = nullptr;
+
+  private:
+    virtual void Execute() override;
+  };
+
+  struct Worker
+  {
+    ezUniquePtr<dtNavMeshQuery> m_pQuery; // careful, dtNavMeshQuery is not moveable
+    bool m_bQueryActive = false;
+    Query m_ActiveQuery;
+    ezDynamicArray<FinishedQuery> m_Finished;
+    UpdateTask m_Task;
+  };
+
+  static ezUInt64 ComputeQueryKey(dtPolyRef startPoly, dtPolyRef endPoly);
+  bool HasLiveRequests(const Query& query) const;
+  bool TryReuseRecentCorridor(const Query& query);
+  void UpdateWorker(Worker& worker);
+  void FinishQuery(Worker& worker, dtStatus status);
+  void PublishResult(const ezArrayPtr<const ezUInt32>& requestIDs, ezRecastPathQueryState::Enum state, ezArrayPtr<const dtPolyRef> corridor);
+
+  const dtNavMesh* m_pNavMesh = nullptr;
+  ezUInt32 m_uiNextRequestID = 1;
+  ezHashTable<ezUInt32, Result> m_Results;
+
+  // requests that have not started yet, new requests with the same start and end polygon are added to these
+  ezDynamicArray<Query> m_Pending;
+  ezHashTable<ezUInt64, ezUInt32> m_PendingByPolys;
+
+  // the requests handed to the workers in this frame, each worker takes the next one when it is done with its previous query
+  ezDynamicArray<Query> m_Starting;
+  ezAtomicInteger32 m_iNextStartingQuery;
+
+  // full corridors that were computed in the previous frame, by target polygon
+  ezHashTable<dtPolyRef, ezDynamicArray<dtPolyRef>> m_RecentCorridors;
+
+  ezDynamicArray<ezUniquePtr<Worker>> m_Workers;
+  ezTaskGroupID m_UpdateTaskGroup;
+  ezTime m_UpdateBudget;
+};
@@ -31,6 +31,23 @@ void ezRecastWorldModule::Initialize()
     RegisterUpdateFunction(updateDesc);
   }
 
+  // the path queries run on worker threads for the rest of the frame and are finished before the agents are updated in the next one
+  {
+    auto updateDesc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezRecastWorldModule::FinishPathQueries, this);
+    updateDesc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PreAsync;
+    updateDesc.m_fPriority = 1000.0f;
+
+    RegisterUpdateFunction(updateDesc);
+  }
+
+  {
+    auto updateDesc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezRecastWorldModule::StartPathQueries, this);
+    updateDesc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PreAsync;
+    updateDesc.m_fPriority = -1000.0f;
+
+    RegisterUpdateFunction(updateDesc);
+  }
+
   ezResourceManager::GetResourceEvents().AddEventHandler(ezMakeDelegate(&ezRecastWorldModule::ResourceEventHandler, this));
 }
 
@@ -38,6 +55,8 @@ void ezRecastWorldModule::Deinitialize()
 {
   ezResourceManager::GetResourceEvents().RemoveEventHandler(ezMakeDelegate(&ezRecastWorldModule::ResourceEventHandler, this));
 
+  m_PathQueryQueue.Clear();
+
   SUPER::Deinitialize();
 }
 
@@ -45,6 +64,7 @@ void ezRecastWorldModule::SetNavMeshResource(const ezRecastNavMeshResourceHandle
 {
   m_hNavMesh = hNavMesh;
   m_pDetourNavMesh = nullptr;
+  m_PathQueryQueue.Clear();
   m_pNavMeshPointsOfInterest.Clear();
 }
 
@@ -60,7 +80,11 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
     m_pDetourNavMesh = pNavMesh->GetNavMesh();
 
     m_pNavMeshPointsOfInterest = EZ_DEFAULT_NEW(ezNavMeshPointOfInterestGraph);
-    m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*pNavMesh->GetNavMeshPolygons());
+
+    if (pNavMesh->GetNavMeshPolygons() != nullptr)
+    {
+      m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*pNavMesh->GetNavMeshPolygons());
+    }
   }
 
   if (m_pNavMeshPointsOfInterest)
@@ -69,11 +93,25 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
   }
 }
 
+void ezRecastWorldModule::FinishPathQueries(const UpdateContext& ctxt)
+{
+  m_PathQueryQueue.FinishUpdate();
+}
+
+void ezRecastWorldModule::StartPathQueries(const UpdateContext& ctxt)
+{
+  m_PathQueryQueue.BeginUpdate(m_pDetourNavMesh);
+}
+
 void ezRecastWorldModule::ResourceEventHandler(const ezResourceEvent& e)
 {
   if (e.m_Type == ezResourceEvent::Type::ResourceContentUnloading &&
       e.m_pResource->GetDynamicRTTI()->IsDerivedFrom<ezRecastNavMeshResource>())
   {
+    // the running queries still reference the navmesh, waiting for them takes at most the per-frame budget of the queue
+    // the agents request their paths again once the new navmesh is available
+    m_PathQueryQueue.Clear();
+
     // triggers a recreation in the next update
     m_pDetourNavMesh = nullptr;
   }
@@ -5,6 +5,7 @@
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/WorldModule.h>
 #include <NavMeshBuilder/NavMeshPointsOfInterest.h>
+#include <RecastPlugin/WorldModule/RecastPathQueryQueue.h>
 
 class dtCrowd;
 class dtNavMesh;
@@ -31,11 +32,18 @@ public:
   const ezNavMeshPointOfInterestGraph* GetNavMeshPointsOfInterestGraph() const { return m_pNavMeshPointsOfInterest.Borrow(); }
   ezNavMeshPointOfInterestGraph* AccessNavMeshPointsOfInterestGraph() const { return m_pNavMeshPointsOfInterest.Borrow(); }
 
+  /// \brief Path requests are processed asynchronously. Results of the previous frame are available before the components are updated,
+  /// requests made during the component update are started right afterwards.
+  ezRecastPathQueryQueue& GetPathQueryQueue() { return m_PathQueryQueue; }
+
 private:
   void UpdateNavMesh(const UpdateContext& ctxt);
+  void FinishPathQueries(const UpdateContext& ctxt);
+  void StartPathQueries(const UpdateContext& ctxt);
   void ResourceEventHandler(const ezResourceEvent& e);
 
   const dtNavMesh* m_pDetourNavMesh = nullptr;
   ezRecastNavMeshResourceHandle m_hNavMesh;
   ezUniquePtr<ezNavMeshPointOfInterestGraph> m_pNavMeshPointsOfInterest;
+  ezRecastPathQueryQueue m_PathQueryQueue;
 };
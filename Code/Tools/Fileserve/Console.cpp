@@ -73,6 +73,12 @@ void ezFileserverApp::FileserverEventHandlerConsole(const ezFileserverEvent& e)
     }
     break;
 
+    case ezFileserverEvent::Type::FilePrefetchRequest:
+    {
+      ezLog::Info("Prefetch: {0} cached files checked, {1} changed", e.m_uiSizeTotal, e.m_uiSentTotal);
+    }
+    break;
+
     case ezFileserverEvent::Type::FileDeleteRequest:
     {
       ezLog::Warning("File Deletion: '{0}'", e.m_szPath);
@@ -2,6 +2,7 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererCore/ShaderCompiler/ShaderParser.h>
@@ -34,6 +35,9 @@ ezResult ezShaderCompilerApplication::BeforeCoreSystemsStartup()
   if (m_sPlatforms.IsEmpty())
     m_sPlatforms = "DX11_SM50"; // "ALL";
 
+  // by default permutations whose sources did not change since they were last compiled are skipped
+  m_bForceRebuild = cmd->GetBoolOption("-force");
+
   const ezUInt32 pvs = cmd->GetStringOptionArguments("-perm");
 
   for (ezUInt32 pv = 0; pv < pvs; ++pv)
@@ -81,23 +85,65 @@ ezResult ezShaderCompilerApplication::CompileShader(const char* szShaderFile)
   if (ExtractPermutationVarValues(szShaderFile).Failed())
     return EZ_FAILURE;
 
-  ezHybridArray<ezPermutationVar, 16> PermVars;
-
   const ezUInt32 uiMaxPerms = m_PermutationGenerator.GetPermutationCount();
 
   ezLog::Info("Shader has {0} permutations", uiMaxPerms);
 
-  for (ezUInt32 perm = 0; perm < uiMaxPerms; ++perm)
+  if (uiMaxPerms == 0)
+    return EZ_SUCCESS;
+
+  // the permutation variable configs are loaded on first access, which must not happen on several threads at once
   {
-    EZ_LOG_BLOCK("Compiling Permutation");
+    ezHybridArray<ezPermutationVar, 16> PermVars;
+    m_PermutationGenerator.GetPermutation(0, PermVars);
 
-    m_PermutationGenerator.GetPermutation(perm, PermVars);
-    ezShaderCompiler sc;
-    if (sc.CompileShaderPermutationForPlatforms(szShaderFile, PermVars, ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
-      return EZ_FAILURE;
+    for (const ezPermutationVar& var : PermVars)
+    {
+      ezShaderManager::GetPermutationEnumValues(var.m_sName);
+    }
   }
 
-  ezLog::Success("Compiled Shader '{0}'", szShaderFile);
+  ezAtomicInteger32 iNumFailed;
+  ezAtomicInteger32 iNumUpToDate;
+
+  ezTaskSystem::ParallelForParams params;
+  params.uiBinSize = 1;
+
+  // every permutation gets its own compiler, stage binaries that several permutations have in common are only written once
+  ezTaskSystem::ParallelForIndexed(0, uiMaxPerms,
+    [&](ezUInt32 uiStartPerm, ezUInt32 uiEndPerm) {
+      ezHybridArray<ezPermutationVar, 16> PermVars;
+
+      for (ezUInt32 perm = uiStartPerm; perm < uiEndPerm; ++perm)
+      {
+        // stop as early as the serial compilation would have
+        if (iNumFailed > 0)
+          return;
+
+        EZ_LOG_BLOCK("Compiling Permutation");
+
+        m_PermutationGenerator.GetPermutation(perm, PermVars);
+        ezShaderCompiler sc;
+        if (sc.CompileShaderPermutationForPlatforms(szShaderFile, PermVars, ezLog::GetThreadLocalLogSystem(), m_sPlatforms, !m_bForceRebuild).Failed())
+        {
+          iNumFailed.Increment();
+          return;
+        }
+
+        // with several platforms, the permutation only counts as up to date when none of them had to be compiled,
+        // without any platform nothing was checked at all
+        if (sc.GetNumPlatforms() > 0 && sc.GetNumSkippedPlatforms() == sc.GetNumPlatforms())
+        {
+          iNumUpToDate.Increment();
+        }
+      }
+    },
+    "Compile Shader Permutations", params);
+
+  if (iNumFailed > 0)
+    return EZ_FAILURE;
+
+  ezLog::Success("Compiled Shader '{0}' ({1} of {2} permutations were up to date)", szShaderFile, (ezInt32)iNumUpToDate, uiMaxPerms);
   return EZ_SUCCESS;
 }
 
@@ -172,6 +218,7 @@ void ezShaderCompilerApplication::PrintConfig()
   ezLog::Info("Project: '{0}'", m_sAppProjectPath);
   ezLog::Info("Shader: '{0}'", m_sShaderFiles);
   ezLog::Info("Platform: '{0}'", m_sPlatforms);
+  ezLog::Info("Force Rebuild: {0}", m_bForceRebuild ? "yes" : "no");
 }
 
 ezApplication::ApplicationExecution ezShaderCompilerApplication::Run()
@@ -29,6 +29,7 @@ private:
   ezPermutationGenerator m_PermutationGenerator;
   ezString m_sPlatforms;
   ezString m_sShaderFiles;
+  bool m_bForceRebuild = false;
   ezMap<ezString, ezHybridArray<ezString, 4>> m_FixedPermVars;
 };
 
@@ -1,6 +1,7 @@
 #include <CoreTestPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Time/Clock.h>
 
 namespace
@@ -152,6 +153,29 @@ namespace
       TestComponent2::CreateComponent(pChild, pChildComponent);
     }
   }
+
+  typedef ezComponentManager<class TestCompactComponent, ezBlockStorageType::Compact> TestCompactComponentManager;
+
+  class TestCompactComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestCompactComponent, ezComponent, TestCompactComponentManager);
+
+  public:
+    ezUInt32 m_uiIndex = 0;
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(TestCompactComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  typedef ezComponentManager<class TestFreeListComponent, ezBlockStorageType::FreeList> TestFreeListComponentManager;
+
+  class TestFreeListComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestFreeListComponent, ezComponent, TestFreeListComponentManager);
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(TestFreeListComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
 } // namespace
 
 
@@ -520,3 +544,180 @@ EZ_CREATE_SIMPLE_TEST(World, Components)
     EZ_TEST_INT(TestComponent::s_iSimulationStartedCounter, 1);
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, BulkComponents)
+{
+  constexpr ezUInt32 uiNumComponents = 3000;
+
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  TestCompactComponentManager* pManager = world.GetOrCreateComponentManager<TestCompactComponentManager>();
+
+  ezDynamicArray<ezGameObject*> objects;
+  for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+  {
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(ezGameObjectDesc(), pObject);
+    objects.PushBack(pObject);
+  }
+
+  ezDynamicArray<ezComponentHandle> handles;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreateComponents")
+  {
+    // one regular component first, so the bulk creation starts in a partially filled block
+    TestCompactComponent* pFirst = nullptr;
+    pManager->CreateComponent(objects[0], pFirst);
+    handles.PushBack(pFirst->GetHandle());
+
+    ezDynamicArray<ezComponent*> components;
+    pManager->CreateComponents(objects.GetArrayPtr().GetSubArray(1), components);
+
+    EZ_TEST_INT(components.GetCount(), uiNumComponents - 1);
+    EZ_TEST_INT(pManager->GetComponentCount(), uiNumComponents);
+
+    for (ezComponent* pComponent : components)
+    {
+      handles.PushBack(pComponent->GetHandle());
+    }
+
+    for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+    {
+      TestCompactComponent* pComponent = nullptr;
+      EZ_TEST_BOOL(world.TryGetComponent(handles[i], pComponent));
+      EZ_TEST_BOOL(pComponent->GetOwner() == objects[i]);
+
+      pComponent->m_uiIndex = i;
+    }
+
+    world.Update();
+
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_BOOL(it->IsActiveAndInitialized());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DeleteComponents")
+  {
+    // delete every third component and the ones at the end, which would otherwise be moved into the gaps
+    ezDynamicArray<ezComponentHandle> handlesToDelete;
+    for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+    {
+      if (i % 3 == 0 || i >= uiNumComponents - 100)
+      {
+        handlesToDelete.PushBack(handles[i]);
+      }
+    }
+
+    pManager->DeleteComponents(handlesToDelete);
+
+    // deleting a component twice has no effect
+    pManager->DeleteComponent(handles[0]);
+
+    world.Update();
+
+    EZ_TEST_INT(pManager->GetComponentCount(), uiNumComponents - handlesToDelete.GetCount());
+
+    for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+    {
+      const bool bDeleted = (i % 3 == 0 || i >= uiNumComponents - 100);
+
+      TestCompactComponent* pComponent = nullptr;
+      EZ_TEST_BOOL(world.TryGetComponent(handles[i], pComponent) != bDeleted);
+      EZ_TEST_INT(objects[i]->GetComponents().GetCount(), bDeleted ? 0 : 1);
+
+      if (!bDeleted)
+      {
+        EZ_TEST_INT(pComponent->m_uiIndex, i);
+        EZ_TEST_BOOL(objects[i]->GetComponents()[0] == pComponent);
+      }
+    }
+
+    ezUInt32 uiCounter = 0;
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_BOOL(it->GetOwner() == objects[it->m_uiIndex]);
+      ++uiCounter;
+    }
+
+    EZ_TEST_INT(uiCounter, pManager->GetComponentCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DeleteComponent By Pointer")
+  {
+    TestCompactComponent* pComponent = pManager->GetComponents();
+    const ezUInt32 uiIndex = pComponent->m_uiIndex;
+    const ezUInt32 uiCountBefore = pManager->GetComponentCount();
+
+    // the component stays in memory until the end of the frame, deleting it again through the pointer or the handle has no effect
+    pManager->DeleteComponent(pComponent);
+    pManager->DeleteComponent(pComponent);
+    pManager->DeleteComponents(ezMakeArrayPtr(&handles[uiIndex], 1));
+    pManager->DeleteComponent(pComponent);
+
+    world.Update();
+
+    EZ_TEST_INT(pManager->GetComponentCount(), uiCountBefore - 1);
+    EZ_TEST_BOOL(!world.IsValidComponent(handles[uiIndex]));
+    EZ_TEST_INT(objects[uiIndex]->GetComponents().GetCount(), 0);
+
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_BOOL(it->m_uiIndex != uiIndex);
+      EZ_TEST_BOOL(it->GetOwner() == objects[it->m_uiIndex]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreateComponents Reuses Free List")
+  {
+    TestFreeListComponentManager* pFreeListManager = world.GetOrCreateComponentManager<TestFreeListComponentManager>();
+
+    ezDynamicArray<ezComponent*> components;
+    pFreeListManager->CreateComponents(objects.GetArrayPtr(), components);
+
+    // free some slots in the middle of the storage
+    ezDynamicArray<ezComponentHandle> handlesToDelete;
+    ezHashSet<ezComponent*> freedSlots;
+    for (ezUInt32 i = 0; i < uiNumComponents; i += 7)
+    {
+      handlesToDelete.PushBack(components[i]->GetHandle());
+      freedSlots.Insert(components[i]);
+    }
+
+    pFreeListManager->DeleteComponents(handlesToDelete);
+    world.Update();
+
+    EZ_TEST_INT(pFreeListManager->GetComponentCount(), uiNumComponents - handlesToDelete.GetCount());
+
+    // the free slots are used first, only the remaining components are appended at the end
+    const ezUInt32 uiNumNewComponents = handlesToDelete.GetCount() + 10;
+    ezDynamicArray<ezComponent*> newComponents;
+    pFreeListManager->CreateComponents(objects.GetArrayPtr().GetSubArray(0, uiNumNewComponents), newComponents);
+
+    EZ_TEST_INT(newComponents.GetCount(), uiNumNewComponents);
+    EZ_TEST_INT(pFreeListManager->GetComponentCount(), uiNumComponents + 10);
+
+    for (ezUInt32 i = 0; i < uiNumNewComponents; ++i)
+    {
+      EZ_TEST_BOOL(freedSlots.Contains(newComponents[i]) == (i < handlesToDelete.GetCount()));
+      EZ_TEST_BOOL(newComponents[i]->GetOwner() == objects[i]);
+      EZ_TEST_BOOL(world.IsValidComponent(newComponents[i]->GetHandle()));
+    }
+
+    for (ezUInt32 i = uiNumNewComponents - 10; i < uiNumNewComponents; ++i)
+    {
+      EZ_TEST_BOOL(!components.Contains(newComponents[i]));
+    }
+
+    ezUInt32 uiCounter = 0;
+    for (auto it = pFreeListManager->GetComponents(); it.IsValid(); ++it)
+    {
+      ++uiCounter;
+    }
+
+    EZ_TEST_INT(uiCounter, uiNumComponents + 10);
+  }
+}
@@ -2,6 +2,8 @@
 
 #include <Core/World/World.h>
 #include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Clock.h>
 
 namespace
@@ -96,6 +98,25 @@ namespace
       ResetComponents(*it);
     }
   }
+
+  class PostMessageThread : public ezThread
+  {
+  public:
+    ezWorld* m_pWorld = nullptr;
+    ezGameObjectHandle m_hObject;
+    ezUInt64 m_uiUsedPostBufferIndices = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      TestMessage1 msg;
+      msg.m_iValue = 1;
+      m_pWorld->PostMessage(m_hObject, msg, ezObjectMsgQueueType::NextFrame);
+
+      m_uiUsedPostBufferIndices = ezInternal::WorldData::GetUsedPostBufferIndices();
+      return 0;
+    }
+  };
 }
 
 EZ_CREATE_SIMPLE_TEST(World, Messaging)
@@ -235,4 +256,126 @@ EZ_CREATE_SIMPLE_TEST(World, Messaging)
 
     ezFrameAllocator::Reset();
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from multiple threads")
+  {
+    ResetComponents(*pRoot);
+
+    const ezGameObjectHandle hRoot = pRoot->GetHandle();
+
+    ezDynamicArray<ezUniquePtr<ezDelegateTask<void>>> tasks;
+    ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
+    for (ezUInt32 t = 0; t < 8; ++t)
+    {
+      tasks.PushBack(EZ_DEFAULT_NEW(ezDelegateTask<void>, "PostMessages", [&world, hRoot]() {
+        for (ezUInt32 i = 0; i < 100; ++i)
+        {
+          TestMessage1 msg;
+          msg.m_iValue = 1;
+          world.PostMessage(hRoot, msg, ezObjectMsgQueueType::NextFrame);
+
+          TestMessage2 msg2;
+          msg2.m_iValue = 1;
+          world.PostMessage(hRoot, msg2, ezObjectMsgQueueType::NextFrame, ezTime::Seconds(0.5));
+        }
+      }));
+
+      ezTaskSystem::AddTaskToGroup(group, tasks.PeekBack().Borrow());
+    }
+
+    ezTaskSystem::StartTaskGroup(group);
+    ezTaskSystem::WaitForGroup(group);
+
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(1.0));
+    world.Update();
+
+    TestComponentMsg* pComponent = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent);
+    EZ_TEST_INT(pComponent->m_iSomeData, 801);
+    EZ_TEST_INT(pComponent->m_iSomeData2, 1602);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from short-lived threads")
+  {
+    ResetComponents(*pRoot);
+
+    // more threads than there are post buffers, each one hands its buffer back when it exits
+    const ezUInt32 uiNumThreads = 100;
+
+    const ezUInt64 uiUsedBefore = ezInternal::WorldData::GetUsedPostBufferIndices();
+    ezUInt64 uiFirstThreadIndex = 0;
+
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      PostMessageThread thread;
+      thread.m_pWorld = &world;
+      thread.m_hObject = pRoot->GetHandle();
+      thread.Start();
+      thread.Join();
+
+      // every thread owned exactly one index of its own and gave it back when it exited
+      const ezUInt64 uiThreadIndex = thread.m_uiUsedPostBufferIndices & ~uiUsedBefore;
+      EZ_TEST_BOOL(uiThreadIndex != 0 && (uiThreadIndex & (uiThreadIndex - 1)) == 0);
+      EZ_TEST_BOOL(ezInternal::WorldData::GetUsedPostBufferIndices() == uiUsedBefore);
+
+      // so the next thread gets the same one again
+      if (t == 0)
+        uiFirstThreadIndex = uiThreadIndex;
+
+      EZ_TEST_BOOL(uiThreadIndex == uiFirstThreadIndex);
+    }
+
+    world.Update();
+
+    TestComponentMsg* pComponent = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent);
+    EZ_TEST_INT(pComponent->m_iSomeData, 1 + uiNumThreads);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing with long delay")
+  {
+    ResetComponents(*pRoot);
+
+    // the delays span all levels of the timing wheel
+    const double delays[] = {0.005, 0.7, 30.1, 45.6, 700.1, 2700.6, 5000.1};
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(delays); ++i)
+    {
+      TestMessage1 msg;
+      msg.m_iValue = 1 << i;
+      pRoot->PostMessage(msg, ezObjectMsgQueueType::PostAsync, ezTime::Seconds(delays[i]));
+    }
+
+    const ezTime start = world.GetClock().GetAccumulatedTime();
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(0.5));
+
+    TestComponentMsg* pComponent = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent);
+
+    for (ezUInt32 uiFrame = 0; uiFrame < 10100; ++uiFrame)
+    {
+      world.Update();
+
+      const double fElapsed = (world.GetClock().GetAccumulatedTime() - start).GetSeconds();
+
+      int iExpectedValue = 1;
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(delays); ++i)
+      {
+        if (delays[i] <= fElapsed)
+          iExpectedValue += 1 << i;
+      }
+
+      if (EZ_TEST_INT(pComponent->m_iSomeData, iExpectedValue).Failed())
+        break;
+    }
+
+    EZ_TEST_INT(pComponent->m_iSomeData, 128);
+
+    ezFrameAllocator::Reset();
+  }
 }
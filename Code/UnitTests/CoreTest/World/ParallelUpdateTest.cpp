@@ -0,0 +1,383 @@
+#include <CoreTestPCH.h>
+
+#include <Core/World/World.h>
+
+namespace
+{
+  class ParallelTestComponentA;
+  class ParallelTestComponentB;
+
+  class ParallelTestComponent : public ezComponent
+  {
+    EZ_DECLARE_ABSTRACT_COMPONENT_TYPE(ParallelTestComponent, ezComponent);
+
+  public:
+    ezInt32 m_iValue = 0;
+  };
+
+  EZ_BEGIN_ABSTRACT_COMPONENT_TYPE(ParallelTestComponent, 1)
+  EZ_END_ABSTRACT_COMPONENT_TYPE
+
+  //////////////////////////////////////////////////////////////////////////
+
+  class ParallelTestComponentBManager : public ezComponentManager<ParallelTestComponentB, ezBlockStorageType::FreeList>
+  {
+  public:
+    ParallelTestComponentBManager(ezWorld* pWorld)
+      : ezComponentManager<ParallelTestComponentB, ezBlockStorageType::FreeList>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestComponentBManager::Update, this);
+      desc.m_bCanRunInParallel = true;
+
+      this->RegisterUpdateFunction(desc);
+    }
+
+    void Update(const ezWorldModule::UpdateContext& context);
+  };
+
+  class ParallelTestComponentB : public ParallelTestComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ParallelTestComponentB, ParallelTestComponent, ParallelTestComponentBManager);
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(ParallelTestComponentB, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  void ParallelTestComponentBManager::Update(const ezWorldModule::UpdateContext& context)
+  {
+    for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+    {
+      it->m_iValue++;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+
+  class ParallelTestComponentAManager : public ezComponentManager<ParallelTestComponentA, ezBlockStorageType::FreeList>
+  {
+  public:
+    ParallelTestComponentAManager(ezWorld* pWorld)
+      : ezComponentManager<ParallelTestComponentA, ezBlockStorageType::FreeList>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestComponentAManager::Update, this);
+      desc.m_bCanRunInParallel = true;
+
+      // reads the components of B, so it can't run in parallel to B's update, the lower priority makes it run after it
+      auto descSum = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestComponentAManager::SumUpB, this);
+      descSum.m_bCanRunInParallel = true;
+      descSum.m_ReadsFrom.PushBack(ezGetStaticRTTI<ParallelTestComponentB>());
+      descSum.m_fPriority = -1.0f;
+
+      this->RegisterUpdateFunction(desc);
+      this->RegisterUpdateFunction(descSum);
+    }
+
+    void Update(const ezWorldModule::UpdateContext& context);
+    void SumUpB(const ezWorldModule::UpdateContext& context);
+
+    void GetUpdateSchedule(ezDynamicArray<ezDynamicArray<ezHashedString>>& out_Batches)
+    {
+      GetWorld()->GetUpdateSchedule(UpdateFunctionDesc::Phase::PreAsync, out_Batches);
+    }
+
+    ezInt32 m_iSumOfB = 0;
+  };
+
+  class ParallelTestComponentA : public ParallelTestComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ParallelTestComponentA, ParallelTestComponent, ParallelTestComponentAManager);
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(ParallelTestComponentA, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  void ParallelTestComponentAManager::Update(const ezWorldModule::UpdateContext& context)
+  {
+    for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+    {
+      it->m_iValue++;
+    }
+  }
+
+  void ParallelTestComponentAManager::SumUpB(const ezWorldModule::UpdateContext& context)
+  {
+    const ezWorld* pWorld = GetWorld();
+    const ParallelTestComponentBManager* pManagerB = pWorld->GetComponentManager<ParallelTestComponentBManager>();
+
+    m_iSumOfB = 0;
+    if (pManagerB == nullptr)
+      return;
+
+    for (auto it = pManagerB->GetComponents(); it.IsValid(); ++it)
+    {
+      m_iSumOfB += it->m_iValue;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+
+  typedef ezComponentManager<class ParallelTestComponentC, ezBlockStorageType::FreeList> ParallelTestComponentCBaseManager;
+
+  class ParallelTestComponentCManager : public ParallelTestComponentCBaseManager
+  {
+  public:
+    ParallelTestComponentCManager(ezWorld* pWorld)
+      : ParallelTestComponentCBaseManager(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestComponentCManager::Update, this);
+      desc.m_bCanRunInParallel = true;
+
+      this->RegisterUpdateFunction(desc);
+    }
+
+    /// Reads from A without having declared it.
+    void Update(const ezWorldModule::UpdateContext& context)
+    {
+      const ezWorld* pWorld = GetWorld();
+      pWorld->GetComponentManager<ParallelTestComponentAManager>();
+    }
+  };
+
+  class ParallelTestComponentC : public ParallelTestComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ParallelTestComponentC, ParallelTestComponent, ParallelTestComponentCManager);
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(ParallelTestComponentC, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  //////////////////////////////////////////////////////////////////////////
+
+  ezAssertHandler s_PrevAssertHandler = nullptr;
+  ezAtomicInteger32 s_iUndeclaredAccessAsserts;
+
+  bool UndeclaredAccessAssertHandler(const char* szSourceFile, ezUInt32 uiLine, const char* szFunction, const char* szExpression, const char* szAssertMsg)
+  {
+    if (ezStringUtils::FindSubString(szAssertMsg, "that it has not declared") != nullptr)
+    {
+      s_iUndeclaredAccessAsserts.Increment();
+      return false;
+    }
+
+    return s_PrevAssertHandler(szSourceFile, uiLine, szFunction, szExpression, szAssertMsg);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, ParallelUpdateFunctions)
+{
+  constexpr ezUInt32 uiNumComponents = 100;
+  constexpr ezUInt32 uiNumUpdates = 10;
+
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  ParallelTestComponentAManager* pManagerA = world.GetOrCreateComponentManager<ParallelTestComponentAManager>();
+  ParallelTestComponentBManager* pManagerB = world.GetOrCreateComponentManager<ParallelTestComponentBManager>();
+
+  for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+  {
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(ezGameObjectDesc(), pObject);
+
+    ParallelTestComponentA* pComponentA = nullptr;
+    pManagerA->CreateComponent(pObject, pComponentA);
+
+    ParallelTestComponentB* pComponentB = nullptr;
+    pManagerB->CreateComponent(pObject, pComponentB);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Declared Access")
+  {
+    for (ezUInt32 i = 1; i <= uiNumUpdates; ++i)
+    {
+      world.Update();
+
+      // B has been updated before it was summed up
+      EZ_TEST_INT(pManagerA->m_iSumOfB, i * uiNumComponents);
+    }
+
+    for (auto it = pManagerA->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it->m_iValue, uiNumUpdates);
+    }
+
+    for (auto it = pManagerB->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it->m_iValue, uiNumUpdates);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Update Schedule")
+  {
+    ezDynamicArray<ezDynamicArray<ezHashedString>> batches;
+    pManagerA->GetUpdateSchedule(batches);
+
+    // the two updates only write to their own manager, summing up B has to wait for both
+    if (EZ_TEST_INT(batches.GetCount(), 2).Succeeded())
+    {
+      if (EZ_TEST_INT(batches[0].GetCount(), 2).Succeeded())
+      {
+        EZ_TEST_STRING(batches[0][0].GetData(), "ParallelTestComponentAManager::Update");
+        EZ_TEST_STRING(batches[0][1].GetData(), "ParallelTestComponentBManager::Update");
+      }
+
+      if (EZ_TEST_INT(batches[1].GetCount(), 1).Succeeded())
+      {
+        EZ_TEST_STRING(batches[1][0].GetData(), "ParallelTestComponentAManager::SumUpB");
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deregister")
+  {
+    world.DeleteComponentManager<ParallelTestComponentBManager>();
+    pManagerB = nullptr;
+
+    world.Update();
+
+    for (auto it = pManagerA->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it->m_iValue, uiNumUpdates + 1);
+    }
+
+    // summing up B still conflicts with A's update, because both write to A
+    ezDynamicArray<ezDynamicArray<ezHashedString>> batches;
+    pManagerA->GetUpdateSchedule(batches);
+
+    if (EZ_TEST_INT(batches.GetCount(), 2).Succeeded())
+    {
+      EZ_TEST_INT(batches[0].GetCount(), 1);
+      EZ_TEST_INT(batches[1].GetCount(), 1);
+    }
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Undeclared Access")
+  {
+    // C runs in parallel to A's update, but accesses A without having declared it
+    world.GetOrCreateComponentManager<ParallelTestComponentCManager>();
+
+    s_iUndeclaredAccessAsserts.Set(0);
+    s_PrevAssertHandler = ezGetAssertHandler();
+    ezSetAssertHandler(UndeclaredAccessAssertHandler);
+
+    world.Update();
+
+    ezSetAssertHandler(s_PrevAssertHandler);
+    s_PrevAssertHandler = nullptr;
+
+    EZ_TEST_INT(s_iUndeclaredAccessAsserts, 1);
+
+    ezDynamicArray<ezDynamicArray<ezHashedString>> batches;
+    pManagerA->GetUpdateSchedule(batches);
+
+    if (EZ_TEST_INT(batches.GetCount(), 2).Succeeded())
+    {
+      EZ_TEST_INT(batches[0].GetCount(), 2);
+    }
+  }
+#endif
+}
+
+EZ_CREATE_SIMPLE_TEST(World, UpdateWorlds)
+{
+  constexpr ezUInt32 uiNumWorlds = 4;
+  constexpr ezUInt32 uiNumComponents = 10;
+  constexpr ezUInt32 uiNumUpdates = 3;
+
+  ezDynamicArray<ezUniquePtr<ezWorld>> worlds;
+  ezDynamicArray<ezWorld*> worldPtrs;
+
+  for (ezUInt32 i = 0; i < uiNumWorlds; ++i)
+  {
+    ezStringBuilder sName;
+    sName.Format("Test{0}", i);
+
+    ezWorldDesc worldDesc(sName);
+    worlds.PushBack(EZ_DEFAULT_NEW(ezWorld, worldDesc));
+    worldPtrs.PushBack(worlds.PeekBack().Borrow());
+
+    ezWorld& world = *worlds.PeekBack();
+    EZ_LOCK(world.GetWriteMarker());
+
+    ParallelTestComponentBManager* pManager = world.GetOrCreateComponentManager<ParallelTestComponentBManager>();
+
+    for (ezUInt32 j = 0; j < uiNumComponents; ++j)
+    {
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(ezGameObjectDesc(), pObject);
+
+      ParallelTestComponentB* pComponent = nullptr;
+      pManager->CreateComponent(pObject, pComponent);
+    }
+
+    EZ_TEST_BOOL(world.GetLastUpdateDuration().IsZero());
+  }
+
+  // every component of a world counts the updates of that world
+  auto CheckUpdateCount = [](ezWorld* pWorld, ezInt32 iExpectedUpdates) {
+    EZ_LOCK(pWorld->GetReadMarker());
+
+    const ParallelTestComponentBManager* pManager = pWorld->GetComponentManager<ParallelTestComponentBManager>();
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it->m_iValue, iExpectedUpdates);
+    }
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Worlds")
+  {
+    for (ezUInt32 i = 1; i <= uiNumUpdates; ++i)
+    {
+      ezWorld::UpdateWorlds(worldPtrs);
+
+      for (ezWorld* pWorld : worldPtrs)
+      {
+        CheckUpdateCount(pWorld, i);
+      }
+    }
+
+    for (ezWorld* pWorld : worldPtrs)
+    {
+      EZ_TEST_BOOL(pWorld->GetLastUpdateDuration().GetSeconds() > 0.0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Single World")
+  {
+    // updated directly on the calling thread
+    ezWorld::UpdateWorlds(worldPtrs.GetArrayPtr().GetSubArray(0, 1));
+
+    CheckUpdateCount(worldPtrs[0], uiNumUpdates + 1);
+
+    for (ezUInt32 i = 1; i < uiNumWorlds; ++i)
+    {
+      CheckUpdateCount(worldPtrs[i], uiNumUpdates);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "No Worlds")
+  {
+    ezWorld::UpdateWorlds(ezArrayPtr<ezWorld*>());
+
+    CheckUpdateCount(worldPtrs[0], uiNumUpdates + 1);
+
+    for (ezUInt32 i = 1; i < uiNumWorlds; ++i)
+    {
+      CheckUpdateCount(worldPtrs[i], uiNumUpdates);
+    }
+  }
+}
@@ -288,3 +288,124 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+namespace
+{
+  void MeasureUpdateTimeWithMovingObjects(ezUInt32 uiMoveEveryNth, bool bMultiThreaded)
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bAutoCreateSpatialSystem = !bMultiThreaded;
+    ezWorld world(worldDesc);
+    MeasureCreationTime(true, 100, 1, 3, 0, &world);
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezDynamicArray<ezGameObject*> objects;
+    objects.Reserve(world.GetObjectCount());
+    world.Traverse([&objects](ezGameObject* pObject) {
+      objects.PushBack(pObject);
+      return ezVisitorExecution::Continue;
+    });
+
+    // first round always has some overhead
+    world.Update();
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      const ezVec3 vOffset(0.0f, 0.0f, (i + 1) * 0.1f);
+      for (ezUInt32 j = 0; j < objects.GetCount(); j += uiMoveEveryNth)
+      {
+        objects[j]->SetLocalPosition(objects[j]->GetLocalPosition() + vOffset);
+      }
+
+      world.Update();
+
+      const ezTime tDiff = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u objects, every %u. moving%s: %.2fms", world.GetObjectCount(),
+        uiMoveEveryNth, bMultiThreaded ? " (MT)" : "", tDiff.GetMilliseconds());
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_DirtyTransforms)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Update 1,000,000 dynamic objects, mostly idle")
+  {
+    MeasureUpdateTimeWithMovingObjects(100, false);
+    MeasureUpdateTimeWithMovingObjects(100, true);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Update 1,000,000 dynamic objects, mostly moving")
+  {
+    MeasureUpdateTimeWithMovingObjects(1, false);
+    MeasureUpdateTimeWithMovingObjects(1, true);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_UpdateWorlds)
+{
+  constexpr ezUInt32 uiNumWorlds = 16;
+
+  ezDynamicArray<ezUniquePtr<ezWorld>> worlds;
+  ezDynamicArray<ezWorld*> worldPtrs;
+  ezUInt32 uiNumObjects = 0;
+
+  for (ezUInt32 i = 0; i < uiNumWorlds; ++i)
+  {
+    ezStringBuilder sName;
+    sName.Format("Test{0}", i);
+
+    ezWorldDesc worldDesc(sName);
+    worlds.PushBack(EZ_DEFAULT_NEW(ezWorld, worldDesc));
+    worldPtrs.PushBack(worlds.PeekBack().Borrow());
+
+    EZ_LOCK(worlds.PeekBack()->GetWriteMarker());
+    AddObjectsToWorld(*worlds.PeekBack(), true, 10, 1, 4, 2);
+
+    uiNumObjects += worlds.PeekBack()->GetObjectCount();
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Update 16 worlds one after another")
+  {
+    ezStopwatch sw;
+
+    // first round always has some overhead
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      for (ezWorld* pWorld : worldPtrs)
+      {
+        EZ_LOCK(pWorld->GetWriteMarker());
+        pWorld->Update();
+      }
+
+      const ezTime tDiff = sw.Checkpoint();
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u objects in %u worlds serially: %.2fms", uiNumObjects, uiNumWorlds,
+        tDiff.GetMilliseconds());
+    }
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Update 16 worlds in parallel")
+  {
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezWorld::UpdateWorlds(worldPtrs);
+
+      const ezTime tDiff = sw.Checkpoint();
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u objects in %u worlds in parallel: %.2fms", uiNumObjects, uiNumWorlds,
+        tDiff.GetMilliseconds());
+    }
+
+    for (ezWorld* pWorld : worldPtrs)
+    {
+      EZ_TEST_BOOL(pWorld->GetLastUpdateDuration().GetSeconds() > 0.0);
+    }
+  }
+
+  worldPtrs.Clear();
+  worlds.Clear();
+}
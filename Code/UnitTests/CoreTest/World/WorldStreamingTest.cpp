@@ -0,0 +1,431 @@
+#include <CoreTestPCH.h>
+
+#include <Core/WorldSerializer/WorldCellWriter.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldStreamer.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  constexpr float s_fCellSize = 10.0f;
+  constexpr ezInt32 s_iGridSize = 4;
+  constexpr ezUInt32 s_uiNumChildren = 2;
+
+  typedef ezComponentManager<class StreamingTestComponent, ezBlockStorageType::Compact> StreamingTestComponentManager;
+
+  /// References another component and checks on initialization whether that reference has been resolved already.
+  class StreamingTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(StreamingTestComponent, ezComponent, StreamingTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override
+    {
+      SUPER::SerializeComponent(stream);
+
+      stream.WriteComponentHandle(m_hLinked);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& stream) override
+    {
+      SUPER::DeserializeComponent(stream);
+
+      stream.ReadComponentHandle(&m_hLinked);
+    }
+
+    virtual void Initialize() override
+    {
+      ++s_iInitCounter;
+
+      if (!GetWorld()->IsValidComponent(m_hLinked))
+        ++s_iUnresolvedOnInitCounter;
+    }
+
+    ezComponentHandle m_hLinked;
+
+    static ezInt32 s_iInitCounter;
+    static ezInt32 s_iUnresolvedOnInitCounter;
+  };
+
+  ezInt32 StreamingTestComponent::s_iInitCounter = 0;
+  ezInt32 StreamingTestComponent::s_iUnresolvedOnInitCounter = 0;
+
+  EZ_BEGIN_COMPONENT_TYPE(StreamingTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  // one root object with a few children in every cell of a s_iGridSize x s_iGridSize grid, around the origin
+  void CreateGridWorld(ezWorld& world)
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    for (ezInt32 y = -s_iGridSize / 2; y < s_iGridSize / 2; ++y)
+    {
+      for (ezInt32 x = -s_iGridSize / 2; x < s_iGridSize / 2; ++x)
+      {
+        ezGameObjectDesc desc;
+        desc.m_LocalPosition.Set(x * s_fCellSize + 1.0f, y * s_fCellSize + 1.0f, 0.0f);
+
+        // the children are in the neighbor cell, but stay with their parent
+        const ezGameObjectHandle hRoot = world.CreateObject(desc);
+
+        for (ezUInt32 i = 0; i < s_uiNumChildren; ++i)
+        {
+          ezGameObjectDesc childDesc;
+          childDesc.m_hParent = hRoot;
+          childDesc.m_LocalPosition.Set(s_fCellSize, 0, 0);
+
+          world.CreateObject(childDesc);
+        }
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, Streaming)
+{
+  ezWorldDesc sourceDesc("Source");
+  ezWorld sourceWorld(sourceDesc);
+  CreateGridWorld(sourceWorld);
+
+  ezWorldCellWriter cellWriter;
+  cellWriter.PartitionWorld(sourceWorld, s_fCellSize);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PartitionWorld")
+  {
+    EZ_TEST_INT(cellWriter.GetCellCount(), s_iGridSize * s_iGridSize);
+
+    for (ezUInt32 i = 0; i < cellWriter.GetCellCount(); ++i)
+    {
+      const ezVec2I32& vCell = cellWriter.GetCellCoordinates(i);
+      EZ_TEST_BOOL(vCell.x >= -s_iGridSize / 2 && vCell.x < s_iGridSize / 2);
+      EZ_TEST_BOOL(vCell.y >= -s_iGridSize / 2 && vCell.y < s_iGridSize / 2);
+    }
+
+    EZ_TEST_BOOL(ezWorldCellWriter::ComputeCellCoordinates(ezVec3(-0.5f, 19.5f, 3.0f), s_fCellSize) == ezVec2I32(-1, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cell Table")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    cellWriter.WriteCellTable(writer);
+
+    float fCellSize = 0.0f;
+    ezDynamicArray<ezVec2I32> cells;
+
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(ezWorldCellWriter::ReadCellTable(reader, fCellSize, cells).Succeeded());
+
+    EZ_TEST_FLOAT(fCellSize, s_fCellSize, 0.0f);
+    EZ_TEST_INT(cells.GetCount(), cellWriter.GetCellCount());
+
+    for (ezUInt32 i = 0; i < cells.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(cells[i] == cellWriter.GetCellCoordinates(i));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Incremental Instantiation")
+  {
+    ezWorldDesc targetDesc("Target");
+    ezWorld targetWorld(targetDesc);
+
+    for (ezUInt32 i = 0; i < cellWriter.GetCellCount(); ++i)
+    {
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      cellWriter.WriteCell(writer, i);
+
+      ezMemoryStreamReader memReader(&storage);
+      ezWorldReader reader;
+      reader.ReadWorldDescription(memReader);
+
+      reader.BeginInstantiateWorldIncremental(targetWorld);
+      EZ_TEST_BOOL(reader.IsInstantiatingIncrementally());
+
+      // every step makes progress, even without any time
+      ezUInt32 uiNumSteps = 0;
+      while (!reader.InstantiateWorldIncremental(ezTime::Zero()))
+      {
+        ++uiNumSteps;
+        EZ_TEST_BOOL(uiNumSteps < 100);
+      }
+
+      EZ_TEST_BOOL(!reader.IsInstantiatingIncrementally());
+      EZ_TEST_INT(reader.GetCreatedRootObjects().GetCount(), 1);
+
+      EZ_LOCK(targetWorld.GetReadMarker());
+
+      ezGameObject* pRoot = nullptr;
+      EZ_TEST_BOOL(targetWorld.TryGetObject(reader.GetCreatedRootObjects()[0], pRoot));
+      EZ_TEST_INT(pRoot->GetChildCount(), s_uiNumChildren);
+      EZ_TEST_BOOL(ezWorldCellWriter::ComputeCellCoordinates(pRoot->GetGlobalPosition(), s_fCellSize) == cellWriter.GetCellCoordinates(i));
+    }
+
+    EZ_LOCK(targetWorld.GetReadMarker());
+    EZ_TEST_INT(targetWorld.GetObjectCount(), s_iGridSize * s_iGridSize * (1 + s_uiNumChildren));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Incremental Instantiation in Steps")
+  {
+    constexpr ezUInt32 uiNumObjects = 200;
+
+    ezMemoryStreamStorage storage;
+    {
+      ezWorldDesc sourceDesc2("Source2");
+      ezWorld world(sourceDesc2);
+      EZ_LOCK(world.GetWriteMarker());
+
+      for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+      {
+        world.CreateObject(ezGameObjectDesc());
+      }
+
+      ezWorldCellWriter writer;
+      writer.PartitionWorld(world, s_fCellSize);
+      EZ_TEST_INT(writer.GetCellCount(), 1);
+
+      ezMemoryStreamWriter memWriter(&storage);
+      writer.WriteCell(memWriter, 0);
+    }
+
+    ezWorldDesc targetDesc("Target");
+    ezWorld targetWorld(targetDesc);
+
+    ezMemoryStreamReader memReader(&storage);
+    ezWorldReader reader;
+    reader.ReadWorldDescription(memReader);
+    reader.BeginInstantiateWorldIncremental(targetWorld);
+
+    // without any time, only one batch of objects is created per step
+    EZ_TEST_BOOL(!reader.InstantiateWorldIncremental(ezTime::Zero()));
+    EZ_TEST_INT(reader.GetCreatedRootObjects().GetCount(), 32);
+
+    while (!reader.InstantiateWorldIncremental(ezTime::Zero()))
+    {
+    }
+
+    EZ_TEST_INT(reader.GetCreatedRootObjects().GetCount(), uiNumObjects);
+
+    EZ_LOCK(targetWorld.GetReadMarker());
+    EZ_TEST_INT(targetWorld.GetObjectCount(), uiNumObjects);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Incremental Instantiation of Components")
+  {
+    // more components than fit into one batch, all referencing the component on the root object
+    constexpr ezUInt32 uiNumComponents = 100;
+
+    ezMemoryStreamStorage storage;
+    {
+      ezWorldDesc sourceDesc2("Source2");
+      ezWorld world(sourceDesc2);
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezGameObject* pRoot = nullptr;
+      const ezGameObjectHandle hRoot = world.CreateObject(ezGameObjectDesc(), pRoot);
+
+      StreamingTestComponent* pRootComponent = nullptr;
+      const ezComponentHandle hRootComponent = StreamingTestComponent::CreateComponent(pRoot, pRootComponent);
+
+      for (ezUInt32 i = 1; i < uiNumComponents; ++i)
+      {
+        ezGameObjectDesc childDesc;
+        childDesc.m_hParent = hRoot;
+
+        ezGameObject* pChild = nullptr;
+        world.CreateObject(childDesc, pChild);
+
+        StreamingTestComponent* pComponent = nullptr;
+        StreamingTestComponent::CreateComponent(pChild, pComponent);
+        pComponent->m_hLinked = hRootComponent;
+      }
+
+      pRootComponent->m_hLinked = hRootComponent;
+
+      ezWorldCellWriter writer;
+      writer.PartitionWorld(world, s_fCellSize);
+      EZ_TEST_INT(writer.GetCellCount(), 1);
+
+      ezMemoryStreamWriter memWriter(&storage);
+      writer.WriteCell(memWriter, 0);
+    }
+
+    StreamingTestComponent::s_iInitCounter = 0;
+    StreamingTestComponent::s_iUnresolvedOnInitCounter = 0;
+
+    ezWorldDesc targetDesc("Target");
+    ezWorld targetWorld(targetDesc);
+    EZ_LOCK(targetWorld.GetWriteMarker());
+
+    ezMemoryStreamReader memReader(&storage);
+    ezWorldReader reader;
+    reader.ReadWorldDescription(memReader);
+    reader.BeginInstantiateWorldIncremental(targetWorld);
+
+    // the world is updated between the steps, but none of the components may be initialized before all of them are complete
+    ezUInt32 uiNumSteps = 0;
+    while (!reader.InstantiateWorldIncremental(ezTime::Zero()))
+    {
+      targetWorld.Update();
+
+      ++uiNumSteps;
+      EZ_TEST_INT(StreamingTestComponent::s_iInitCounter, 0);
+    }
+
+    // objects and components are created in several batches each
+    EZ_TEST_BOOL(uiNumSteps >= 2 * ((uiNumComponents + 31) / 32) - 1);
+
+    targetWorld.Update();
+
+    EZ_TEST_INT(StreamingTestComponent::s_iInitCounter, uiNumComponents);
+    EZ_TEST_INT(StreamingTestComponent::s_iUnresolvedOnInitCounter, 0);
+
+    const StreamingTestComponentManager* pManager = targetWorld.GetComponentManager<StreamingTestComponentManager>();
+    if (EZ_TEST_BOOL(pManager != nullptr).Succeeded())
+    {
+      EZ_TEST_INT(pManager->GetComponentCount(), uiNumComponents);
+
+      for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+      {
+        EZ_TEST_BOOL(it->IsActiveAndInitialized());
+        EZ_TEST_BOOL(targetWorld.IsValidComponent(it->m_hLinked));
+      }
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Streamer)
+{
+  ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputPath.AppendPath("WorldStreaming");
+
+  if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputPath, "WorldStreamingTest", "WorldStreamingTest", ezFileSystem::AllowWrites).Succeeded())
+        .Failed())
+    return;
+
+  const char* szDirectory = ":WorldStreamingTest/Cells";
+
+  {
+    ezWorldDesc sourceDesc("Source");
+    ezWorld sourceWorld(sourceDesc);
+    CreateGridWorld(sourceWorld);
+
+    ezWorldCellWriter cellWriter;
+    cellWriter.PartitionWorld(sourceWorld, s_fCellSize);
+    EZ_TEST_BOOL(cellWriter.WriteToDirectory(szDirectory).Succeeded());
+  }
+
+  ezWorldDesc targetDesc("Target");
+  ezWorld targetWorld(targetDesc);
+
+  ezWorldStreamer streamer(targetWorld);
+  EZ_TEST_BOOL(streamer.Initialize(szDirectory).Succeeded());
+  EZ_TEST_INT(streamer.GetCellCount(), s_iGridSize * s_iGridSize);
+
+  auto GetNumCellsInState = [&](ezWorldStreamer::CellState::Enum state) {
+    ezUInt32 uiCount = 0;
+    for (ezUInt32 i = 0; i < streamer.GetCellCount(); ++i)
+    {
+      if (streamer.GetCellState(i) == state)
+        ++uiCount;
+    }
+    return uiCount;
+  };
+
+  auto GetObjectCount = [&]() {
+    // deleted objects are only removed from the storage during the world update
+    EZ_LOCK(targetWorld.GetWriteMarker());
+    targetWorld.Update();
+    return targetWorld.GetObjectCount();
+  };
+
+  // only cell (0, 0) is in the load radius, everything outside of the unload radius is unloaded
+  const ezVec3 vCenter(5, 5, 0);
+  const ezVec3 vBesideGrid(22, 5, 0);
+  const ezVec3 vFarAway(1000, 1000, 0);
+  streamer.SetStreamingRadius(1.0f, 15.0f);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load")
+  {
+    streamer.Update(vCenter, ezTime::Zero());
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Loading), 1);
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloaded), s_iGridSize * s_iGridSize - 1);
+
+    // the cell is read on a worker thread, without any time budget every update makes one step of progress
+    bool bSawInstantiating = false;
+    for (ezUInt32 i = 0; i < 10000 && GetNumCellsInState(ezWorldStreamer::CellState::Instantiated) == 0; ++i)
+    {
+      streamer.Update(vCenter, ezTime::Zero());
+      bSawInstantiating |= GetNumCellsInState(ezWorldStreamer::CellState::Instantiating) == 1;
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    }
+
+    EZ_TEST_BOOL(bSawInstantiating);
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Instantiated), 1);
+    EZ_TEST_INT(GetObjectCount(), 1 + s_uiNumChildren);
+
+    for (ezUInt32 i = 0; i < streamer.GetCellCount(); ++i)
+    {
+      if (streamer.GetCellState(i) == ezWorldStreamer::CellState::Instantiated)
+      {
+        EZ_TEST_BOOL(streamer.GetCellCoordinates(i) == ezVec2I32(0, 0));
+      }
+    }
+
+    // nothing changes as long as the point of interest stays within the unload radius
+    streamer.Update(vBesideGrid, ezTime::Zero());
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Instantiated), 1);
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloaded), s_iGridSize * s_iGridSize - 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unload")
+  {
+    // one root object is deleted per update without a time budget, the cell is unloaded in the update after that
+    streamer.Update(vFarAway, ezTime::Zero());
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloading), 1);
+
+    streamer.Update(vFarAway, ezTime::Zero());
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloaded), s_iGridSize * s_iGridSize);
+    EZ_TEST_INT(GetObjectCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cancel Loading")
+  {
+    streamer.Update(vCenter, ezTime::Zero());
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Loading), 1);
+
+    // the pending load is canceled, its result is never instantiated
+    streamer.UnloadAll();
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloaded), s_iGridSize * s_iGridSize);
+
+    streamer.Update(vFarAway, ezTime::Zero());
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloaded), s_iGridSize * s_iGridSize);
+    EZ_TEST_INT(GetObjectCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "UnloadAll")
+  {
+    // with the larger load radius, the whole grid is loaded
+    streamer.SetStreamingRadius(100.0f, 150.0f);
+
+    for (ezUInt32 i = 0; i < 10000 && GetNumCellsInState(ezWorldStreamer::CellState::Instantiated) < streamer.GetCellCount(); ++i)
+    {
+      streamer.Update(vCenter, ezTime::Seconds(1));
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    }
+
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Instantiated), s_iGridSize * s_iGridSize);
+    EZ_TEST_INT(GetObjectCount(), s_iGridSize * s_iGridSize * (1 + s_uiNumChildren));
+
+    streamer.UnloadAll();
+    EZ_TEST_INT(GetNumCellsInState(ezWorldStreamer::CellState::Unloaded), s_iGridSize * s_iGridSize);
+    EZ_TEST_INT(GetObjectCount(), 0);
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("WorldStreamingTest");
+}
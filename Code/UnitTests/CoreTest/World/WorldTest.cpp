@@ -167,6 +167,70 @@ EZ_CREATE_SIMPLE_TEST(World, World)
     TestTransforms(o, offset);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms dynamic, only moved objects")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    TestWorldObjects o = CreateTestWorld(world, true);
+
+    // a few idle frames
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      world.Update();
+    }
+
+    TestTransforms(o);
+
+    // only the first hierarchy moves, the children have to follow their parent
+    ezVec3 offset = ezVec3(200.0f, 0.0f, 0.0f);
+    o.pParent1->SetLocalPosition(offset);
+
+    world.Update();
+
+    TestTransforms({o.pParent1, o.pParent1, o.pChild11, o.pChild11}, offset);
+    TestTransforms({o.pParent2, o.pParent2, o.pChild21, o.pChild21});
+
+    // deleting dirty objects must not leave dangling entries behind
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+    desc.m_hParent = o.pParent2->GetHandle();
+
+    ezGameObjectHandle hObjects[4];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(hObjects); ++i)
+    {
+      ezGameObject* pObject = nullptr;
+      hObjects[i] = world.CreateObject(desc, pObject);
+    }
+
+    o.pParent2->SetLocalPosition(offset);
+    o.pChild21->SetLocalPosition(ezVec3(100.0f, 0.0f, 0.0f));
+
+    world.DeleteObjectNow(hObjects[0]);
+    world.DeleteObjectNow(hObjects[2]);
+
+    world.Update();
+
+    TestTransforms({o.pParent2, o.pParent2, o.pChild21, o.pChild21}, offset);
+
+    ezGameObject* pObject = nullptr;
+    EZ_TEST_BOOL(world.TryGetObject(hObjects[3], pObject));
+    EZ_TEST_VEC3(pObject->GetGlobalPosition(), offset, 0);
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+    // the velocity drops back to zero after an object has stopped moving
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(0.5));
+    o.pParent1->SetLocalPosition(offset + ezVec3(1.0f, 0.0f, 0.0f));
+
+    world.Update();
+    EZ_TEST_VEC3(o.pParent1->GetVelocity(), ezVec3(2.0f, 0.0f, 0.0f), ezMath::DefaultEpsilon<float>());
+
+    world.Update();
+    EZ_TEST_VEC3(o.pParent1->GetVelocity(), ezVec3::ZeroVector(), 0);
+#endif
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms static")
   {
     ezWorldDesc worldDesc("Test");
@@ -0,0 +1,99 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Communication/RemoteInterfaceEnet.h>
+
+// creating a server disables the fileserve client, which the test framework relies on where it uses fileserve
+#if defined(BUILDSYSTEM_ENABLE_ENET_SUPPORT) && EZ_DISABLED(EZ_PLATFORM_WINDOWS_UWP)
+
+#include <FileservePlugin/Fileserver/ClientContext.h>
+#include <FileservePlugin/Fileserver/Fileserver.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  /// Pumps both sides until the condition is met or the timeout is reached.
+  template <typename Condition>
+  bool UpdateUntil(ezFileserver& server, ezRemoteInterface& client, ezTime timeout, Condition condition)
+  {
+    const ezTime tStart = ezTime::Now();
+
+    while (!condition())
+    {
+      if (ezTime::Now() - tStart > timeout)
+        return false;
+
+      server.UpdateServer();
+      client.UpdateRemoteInterface();
+      client.ExecuteAllMessageHandlers();
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, FileserveHandshake)
+{
+  ezFileserver server;
+  server.SetPort(1052);
+  server.StartServer();
+
+  ezUniquePtr<ezRemoteInterfaceEnet> client = ezRemoteInterfaceEnet::Make();
+  EZ_TEST_BOOL(client->ConnectToServer('EZFS', "localhost:1052", false).Succeeded());
+
+  ezUInt32 uiNumHelloReplies = 0;
+  ezUInt16 uiServerProtocolVersion = ezFileserveProtocolVersion::Basic;
+
+  if (EZ_TEST_BOOL(UpdateUntil(server, *client, ezTime::Seconds(10), [&]() { return client->IsConnectedToServer(); })).Failed())
+  {
+    client->ShutdownConnection();
+    server.StopServer();
+    return;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Old client")
+  {
+    // older clients send no protocol version and do not know the reply
+    client->Send('FSRV', 'HELO');
+
+    // a reply would have to overtake the answer to this one
+    bool bServerFound = false;
+    client->SetMessageHandler('FSRV', [&](ezRemoteMessage& msg) {
+      if (msg.GetMessageID() == 'HELO')
+        ++uiNumHelloReplies;
+
+      if (msg.GetMessageID() == ' YES')
+        bServerFound = true;
+    });
+
+    client->Send('FSRV', 'RUTR');
+
+    EZ_TEST_BOOL(UpdateUntil(server, *client, ezTime::Seconds(10), [&]() { return bServerFound; }));
+    EZ_TEST_INT(uiNumHelloReplies, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "New client")
+  {
+    client->SetMessageHandler('FSRV', [&](ezRemoteMessage& msg) {
+      if (msg.GetMessageID() == 'HELO')
+      {
+        ++uiNumHelloReplies;
+        msg.GetReader() >> uiServerProtocolVersion;
+      }
+    });
+
+    ezRemoteMessage hello('FSRV', 'HELO');
+    hello.GetWriter() << (ezUInt16)ezFileserveProtocolVersion::Current;
+    client->Send(ezRemoteTransmitMode::Reliable, hello);
+
+    EZ_TEST_BOOL(UpdateUntil(server, *client, ezTime::Seconds(10), [&]() { return uiNumHelloReplies > 0; }));
+    EZ_TEST_INT(uiNumHelloReplies, 1);
+    EZ_TEST_INT(uiServerProtocolVersion, ezFileserveProtocolVersion::Current);
+  }
+
+  client->ShutdownConnection();
+  server.StopServer();
+}
+
+#endif
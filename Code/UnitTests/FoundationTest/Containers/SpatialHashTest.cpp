@@ -0,0 +1,286 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/SpatialHash.h>
+#include <Foundation/Math/Random.h>
+
+namespace
+{
+  void FindInRadiusBruteForce(const ezDynamicArray<ezVec3>& points, const ezVec3& vCenter, float fRadius, ezDynamicArray<ezUInt32>& out_Values)
+  {
+    for (ezUInt32 i = 0; i < points.GetCount(); ++i)
+    {
+      if ((points[i] - vCenter).GetLengthSquared() <= fRadius * fRadius)
+      {
+        out_Values.PushBack(i);
+      }
+    }
+  }
+
+  /// Checks that the result contains the distances of the closest points, ties may be resolved either way.
+  bool IsNearest(const ezDynamicArray<ezVec3>& points, const ezVec3& vCenter, ezUInt32 uiMaxCount, const ezDynamicArray<ezUInt32>& result)
+  {
+    ezDynamicArray<float> distances;
+    for (const ezVec3& vPoint : points)
+    {
+      distances.PushBack((vPoint - vCenter).GetLengthSquared());
+    }
+
+    distances.Sort();
+
+    if (result.GetCount() != ezMath::Min(uiMaxCount, points.GetCount()))
+      return false;
+
+    for (ezUInt32 i = 0; i < result.GetCount(); ++i)
+    {
+      if ((points[result[i]] - vCenter).GetLengthSquared() != distances[i])
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Containers, SpatialHash)
+{
+  constexpr ezUInt32 uiNumPoints = 2000;
+  constexpr float fExtents = 50.0f;
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  ezDynamicArray<ezVec3> points;
+  for (ezUInt32 i = 0; i < uiNumPoints; ++i)
+  {
+    points.PushBack(ezVec3(rng.FloatMinMax(-fExtents, fExtents), rng.FloatMinMax(-fExtents, fExtents), rng.FloatMinMax(-fExtents, fExtents)));
+  }
+
+  ezDynamicArray<ezVec3> centers;
+  for (ezUInt32 i = 0; i < 100; ++i)
+  {
+    centers.PushBack(ezVec3(rng.FloatMinMax(-fExtents, fExtents), rng.FloatMinMax(-fExtents, fExtents), rng.FloatMinMax(-fExtents, fExtents)));
+  }
+
+  ezSpatialHash<ezUInt32> hash;
+  hash.Initialize(4.0f);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert")
+  {
+    EZ_TEST_BOOL(hash.IsEmpty());
+
+    for (ezUInt32 i = 0; i < uiNumPoints; ++i)
+    {
+      hash.Insert(points[i], i);
+    }
+
+    EZ_TEST_INT(hash.GetCount(), uiNumPoints);
+    EZ_TEST_BOOL(!hash.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindInRadius")
+  {
+    ezDynamicArray<ezUInt32> expected;
+    ezDynamicArray<ezUInt32> result;
+
+    // small radii look up the cells in range, huge radii go through all cells
+    for (float fRadius : {0.0f, 3.0f, 10.0f, 1000.0f})
+    {
+      for (const ezVec3& vCenter : centers)
+      {
+        expected.Clear();
+        FindInRadiusBruteForce(points, vCenter, fRadius, expected);
+
+        result.Clear();
+        hash.FindInRadius(vCenter, fRadius, result);
+        result.Sort();
+
+        EZ_TEST_BOOL(result == expected);
+      }
+    }
+
+    // the exact position of a point is found with radius zero
+    result.Clear();
+    hash.FindInRadius(points[7], 0.0f, result);
+    EZ_TEST_BOOL(result.Contains(7));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindInRadius Batched")
+  {
+    const float fRadius = 8.0f;
+
+    ezDynamicArray<ezUInt32> values;
+    ezDynamicArray<ezUInt32> queryStarts;
+    hash.FindInRadius(centers, fRadius, values, queryStarts);
+
+    EZ_TEST_INT(queryStarts.GetCount(), centers.GetCount());
+
+    ezDynamicArray<ezUInt32> expected;
+    for (ezUInt32 q = 0; q < centers.GetCount(); ++q)
+    {
+      expected.Clear();
+      FindInRadiusBruteForce(points, centers[q], fRadius, expected);
+
+      const ezUInt32 uiEnd = q + 1 < queryStarts.GetCount() ? queryStarts[q + 1] : values.GetCount();
+      EZ_TEST_INT(uiEnd - queryStarts[q], expected.GetCount());
+
+      for (ezUInt32 i = queryStarts[q]; i < uiEnd; ++i)
+      {
+        EZ_TEST_BOOL(expected.Contains(values[i]));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindNearest")
+  {
+    constexpr ezUInt32 uiMaxCount = 5;
+    const float fMaxRadius = 12.0f;
+
+    ezDynamicArray<ezUInt32> values;
+    ezDynamicArray<ezUInt32> queryStarts;
+    hash.FindNearest(centers, uiMaxCount, fMaxRadius, values, queryStarts);
+
+    EZ_TEST_INT(queryStarts.GetCount(), centers.GetCount());
+
+    ezDynamicArray<ezUInt32> inRadius;
+    ezDynamicArray<ezUInt32> nearest;
+    for (ezUInt32 q = 0; q < centers.GetCount(); ++q)
+    {
+      const ezVec3 vCenter = centers[q];
+
+      inRadius.Clear();
+      FindInRadiusBruteForce(points, vCenter, fMaxRadius, inRadius);
+
+      nearest.Clear();
+      hash.FindNearest(vCenter, uiMaxCount, fMaxRadius, nearest);
+
+      const ezUInt32 uiEnd = q + 1 < queryStarts.GetCount() ? queryStarts[q + 1] : values.GetCount();
+      EZ_TEST_INT(nearest.GetCount(), ezMath::Min(uiMaxCount, inRadius.GetCount()));
+      EZ_TEST_INT(uiEnd - queryStarts[q], nearest.GetCount());
+
+      float fLastDistance = 0.0f;
+      for (ezUInt32 i = 0; i < nearest.GetCount(); ++i)
+      {
+        EZ_TEST_INT(values[queryStarts[q] + i], nearest[i]);
+
+        // sorted by distance and no point in range is closer than the farthest result
+        const float fDistance = (points[nearest[i]] - vCenter).GetLengthSquared();
+        EZ_TEST_BOOL(fDistance >= fLastDistance);
+        fLastDistance = fDistance;
+      }
+
+      if (nearest.GetCount() == uiMaxCount)
+      {
+        for (ezUInt32 uiPoint : inRadius)
+        {
+          EZ_TEST_BOOL(nearest.Contains(uiPoint) || (points[uiPoint] - vCenter).GetLengthSquared() >= fLastDistance);
+        }
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindNearest Without Radius")
+  {
+    // without a radius the search only stops once no unvisited cell can contain a closer point
+    ezDynamicArray<ezUInt32> nearest;
+    for (ezUInt32 uiMaxCount : {1u, 7u, 100u})
+    {
+      for (const ezVec3& vCenter : centers)
+      {
+        nearest.Clear();
+        hash.FindNearest(vCenter, uiMaxCount, ezMath::Infinity<float>(), nearest);
+
+        EZ_TEST_BOOL(IsNearest(points, vCenter, uiMaxCount, nearest));
+      }
+    }
+
+    // few points that are far apart, the rings soon contain more cells than the hash
+    ezDynamicArray<ezVec3> sparsePoints;
+    ezSpatialHash<ezUInt32> sparseHash;
+    sparseHash.Initialize(1.0f);
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      sparsePoints.PushBack(ezVec3(rng.FloatMinMax(-1000.0f, 1000.0f), rng.FloatMinMax(-1000.0f, 1000.0f), rng.FloatMinMax(-1000.0f, 1000.0f)));
+      sparseHash.Insert(sparsePoints.PeekBack(), i);
+    }
+
+    for (ezUInt32 uiMaxCount : {1u, 3u, 20u})
+    {
+      for (const ezVec3& vCenter : centers)
+      {
+        nearest.Clear();
+        sparseHash.FindNearest(vCenter, uiMaxCount, ezMath::Infinity<float>(), nearest);
+
+        EZ_TEST_BOOL(IsNearest(sparsePoints, vCenter, uiMaxCount, nearest));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Infinite Radius")
+  {
+    // the unused slots of partially filled chunks must not be reported, even though an infinite radius includes them
+    ezDynamicArray<ezUInt32> result;
+    for (float fRadius : {ezMath::Infinity<float>(), ezMath::MaxValue<float>()})
+    {
+      result.Clear();
+      hash.FindInRadius(centers[0], fRadius, result);
+      result.Sort();
+
+      if (EZ_TEST_INT(result.GetCount(), uiNumPoints).Succeeded())
+      {
+        for (ezUInt32 i = 0; i < uiNumPoints; ++i)
+        {
+          EZ_TEST_INT(result[i], i);
+        }
+      }
+
+      result.Clear();
+      hash.FindNearest(centers[0], uiNumPoints + 10, fRadius, result);
+      EZ_TEST_INT(result.GetCount(), uiNumPoints);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove")
+  {
+    EZ_TEST_BOOL(!hash.Remove(points[0] + ezVec3(0.5f), 0));
+    EZ_TEST_BOOL(!hash.Remove(points[0], 1));
+
+    for (ezUInt32 i = 0; i < uiNumPoints; i += 2)
+    {
+      EZ_TEST_BOOL(hash.Remove(points[i], i));
+    }
+
+    EZ_TEST_BOOL(!hash.Remove(points[0], 0));
+    EZ_TEST_INT(hash.GetCount(), uiNumPoints / 2);
+
+    ezDynamicArray<ezUInt32> result;
+    hash.FindInRadius(ezVec3::ZeroVector(), 1000.0f, result);
+    EZ_TEST_INT(result.GetCount(), uiNumPoints / 2);
+
+    for (ezUInt32 uiValue : result)
+    {
+      EZ_TEST_BOOL(uiValue % 2 == 1);
+    }
+
+    // removed points can be inserted again, which reuses the freed chunks
+    for (ezUInt32 i = 0; i < uiNumPoints; i += 2)
+    {
+      hash.Insert(points[i], i);
+    }
+
+    EZ_TEST_INT(hash.GetCount(), uiNumPoints);
+
+    result.Clear();
+    hash.FindInRadius(ezVec3::ZeroVector(), 1000.0f, result);
+    EZ_TEST_INT(result.GetCount(), uiNumPoints);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    hash.Clear();
+    EZ_TEST_BOOL(hash.IsEmpty());
+
+    ezDynamicArray<ezUInt32> result;
+    hash.FindInRadius(ezVec3::ZeroVector(), 1000.0f, result);
+    EZ_TEST_BOOL(result.IsEmpty());
+  }
+}
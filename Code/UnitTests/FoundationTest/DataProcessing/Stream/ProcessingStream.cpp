@@ -157,3 +157,26 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamPadding)
+{
+  EZ_TEST_INT(ezProcessingStream::GetPaddedElementCount(0), 0);
+  EZ_TEST_INT(ezProcessingStream::GetPaddedElementCount(1), ezProcessingStream::ElementPadding);
+  EZ_TEST_INT(ezProcessingStream::GetPaddedElementCount(ezProcessingStream::ElementPadding), ezProcessingStream::ElementPadding);
+  EZ_TEST_INT(ezProcessingStream::GetPaddedElementCount(13), 16);
+
+  ezProcessingStreamGroup Group;
+  ezProcessingStream* pStream = Group.AddStream("Stream", ezProcessingStream::DataType::Float3);
+
+  Group.SetSize(13);
+  Group.Process();
+
+  EZ_TEST_INT(Group.GetNumElements(), 13);
+
+  // the padding elements are accessible and zero initialized
+  const ezVec3* pData = pStream->GetData<ezVec3>();
+  for (ezUInt32 i = 13; i < 16; ++i)
+  {
+    EZ_TEST_VEC3(pData[i], ezVec3::ZeroVector(), 0.0f);
+  }
+}
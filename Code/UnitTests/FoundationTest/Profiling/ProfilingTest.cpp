@@ -0,0 +1,592 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Profiling/Implementation/ProtobufWriter.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Thread.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+  /// \brief Decodes the fields of one protobuf message, just enough to verify what ezProtobufWriter produced.
+  class ProtobufReader
+  {
+  public:
+    struct Field
+    {
+      ezUInt32 m_uiField = 0;
+      ezUInt32 m_uiWireType = 0;
+      ezUInt64 m_uiValue = 0;          // varint and 64 bit fields
+      ezArrayPtr<const ezUInt8> m_Data; // length-delimited fields
+    };
+
+    explicit ProtobufReader(ezArrayPtr<const ezUInt8> data)
+      : m_Data(data)
+    {
+    }
+
+    /// \brief Returns false at the end of the message or when it is malformed, which sets m_bError.
+    bool Next(Field& out_Field)
+    {
+      if (m_uiPos >= m_Data.GetCount())
+        return false;
+
+      ezUInt64 uiKey = 0;
+      if (!ReadVarint(uiKey))
+        return false;
+
+      out_Field.m_uiField = static_cast<ezUInt32>(uiKey >> 3);
+      out_Field.m_uiWireType = static_cast<ezUInt32>(uiKey & 7);
+
+      switch (out_Field.m_uiWireType)
+      {
+        case 0:
+          return ReadVarint(out_Field.m_uiValue);
+
+        case 1:
+          if (m_uiPos + 8 > m_Data.GetCount())
+            return Fail();
+
+          ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&out_Field.m_uiValue), m_Data.GetPtr() + m_uiPos, 8);
+          m_uiPos += 8;
+          return true;
+
+        case 2:
+        {
+          ezUInt64 uiLength = 0;
+          if (!ReadVarint(uiLength) || m_uiPos + uiLength > m_Data.GetCount())
+            return Fail();
+
+          out_Field.m_Data = m_Data.GetSubArray(m_uiPos, static_cast<ezUInt32>(uiLength));
+          m_uiPos += static_cast<ezUInt32>(uiLength);
+          return true;
+        }
+      }
+
+      return Fail();
+    }
+
+    bool ReadVarint(ezUInt64& out_uiValue)
+    {
+      out_uiValue = 0;
+
+      for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+      {
+        if (m_uiPos >= m_Data.GetCount())
+          return Fail();
+
+        const ezUInt8 uiByte = m_Data[m_uiPos++];
+        out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+        if ((uiByte & 0x80) == 0)
+          return true;
+      }
+
+      return Fail();
+    }
+
+    bool m_bError = false;
+
+  private:
+    bool Fail()
+    {
+      m_bError = true;
+      return false;
+    }
+
+    ezArrayPtr<const ezUInt8> m_Data;
+    ezUInt32 m_uiPos = 0;
+  };
+
+  bool ArePtrsEqual(ezArrayPtr<const ezUInt8> a, ezArrayPtr<const ezUInt8> b)
+  {
+    return a.GetCount() == b.GetCount() && ezMemoryUtils::IsEqual(a.GetPtr(), b.GetPtr(), a.GetCount());
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  class StreamingTestThread : public ezThread
+  {
+  public:
+    StreamingTestThread(const char* szName, ezUInt32 uiNumScopes)
+      : ezThread(szName)
+      , m_uiNumScopes(uiNumScopes)
+    {
+    }
+
+    ezUInt32 m_uiNumScopes = 0;
+    ezUInt32 m_uiSystemThreadId = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+      m_uiSystemThreadId = static_cast<ezUInt32>(syscall(SYS_gettid));
+#  endif
+
+      for (ezUInt32 i = 0; i < m_uiNumScopes; ++i)
+      {
+        EZ_PROFILE_SCOPE("StreamingTestOuter");
+
+        {
+          EZ_PROFILE_SCOPE("StreamingTestInner");
+        }
+
+        {
+          EZ_PROFILE_SCOPE("StreamingTestInner");
+        }
+      }
+
+      return 0;
+    }
+  };
+
+  /// \brief What the test needs to know about the events of one thread in a streamed trace.
+  struct StreamedTrack
+  {
+    ezUInt64 m_uiSystemThreadId = 0;
+    ezDynamicArray<ezUInt64> m_Events; // name iid for begins, 0 for ends
+  };
+
+  // field numbers as written by the profiling stream
+  enum
+  {
+    Trace_Packet = 1,
+    TracePacket_TrackEvent = 11,
+    TracePacket_InternedData = 12,
+    TracePacket_TrackDescriptor = 60,
+    TrackDescriptor_Uuid = 1,
+    TrackDescriptor_Thread = 4,
+    ThreadDescriptor_Tid = 2,
+    ThreadDescriptor_ThreadName = 5,
+    TrackEvent_Type = 9,
+    TrackEvent_NameIid = 10,
+    TrackEvent_TrackUuid = 11,
+    TrackEventType_SliceBegin = 1,
+    TrackEventType_SliceEnd = 2,
+    InternedData_EventNames = 2,
+    EventName_Iid = 1,
+    EventName_Name = 2,
+  };
+
+  bool ParseTrace(ezArrayPtr<const ezUInt8> trace, ezMap<ezString, StreamedTrack>& out_ThreadTracks, ezMap<ezString, ezUInt64>& out_InternedNames)
+  {
+    ezHashTable<ezUInt64, ezString> trackNames;
+    ezMap<ezUInt64, StreamedTrack> tracks;
+
+    ProtobufReader traceReader(trace);
+    ProtobufReader::Field packet;
+    while (traceReader.Next(packet))
+    {
+      if (packet.m_uiField != Trace_Packet)
+        continue;
+
+      ProtobufReader packetReader(packet.m_Data);
+      ProtobufReader::Field field;
+      while (packetReader.Next(field))
+      {
+        ProtobufReader::Field sub;
+        ProtobufReader subReader(field.m_Data);
+
+        if (field.m_uiField == TracePacket_TrackDescriptor)
+        {
+          ezUInt64 uiUuid = 0;
+          ezString sThreadName;
+          ezUInt64 uiTid = 0;
+
+          while (subReader.Next(sub))
+          {
+            if (sub.m_uiField == TrackDescriptor_Uuid)
+              uiUuid = sub.m_uiValue;
+
+            if (sub.m_uiField == TrackDescriptor_Thread)
+            {
+              ProtobufReader threadReader(sub.m_Data);
+              ProtobufReader::Field threadField;
+              while (threadReader.Next(threadField))
+              {
+                if (threadField.m_uiField == ThreadDescriptor_Tid)
+                  uiTid = threadField.m_uiValue;
+
+                if (threadField.m_uiField == ThreadDescriptor_ThreadName)
+                  sThreadName = ezStringView(reinterpret_cast<const char*>(threadField.m_Data.GetPtr()),
+                    reinterpret_cast<const char*>(threadField.m_Data.GetPtr() + threadField.m_Data.GetCount()));
+              }
+
+              if (threadReader.m_bError)
+                return false;
+            }
+          }
+
+          if (!sThreadName.IsEmpty())
+          {
+            trackNames[uiUuid] = sThreadName;
+            tracks[uiUuid].m_uiSystemThreadId = uiTid;
+          }
+        }
+        else if (field.m_uiField == TracePacket_InternedData)
+        {
+          while (subReader.Next(sub))
+          {
+            if (sub.m_uiField != InternedData_EventNames)
+              continue;
+
+            ezUInt64 uiIid = 0;
+            ezStringBuilder sName;
+
+            ProtobufReader nameReader(sub.m_Data);
+            ProtobufReader::Field nameField;
+            while (nameReader.Next(nameField))
+            {
+              if (nameField.m_uiField == EventName_Iid)
+                uiIid = nameField.m_uiValue;
+
+              if (nameField.m_uiField == EventName_Name)
+                sName.SetSubString_FromTo(reinterpret_cast<const char*>(nameField.m_Data.GetPtr()),
+                  reinterpret_cast<const char*>(nameField.m_Data.GetPtr() + nameField.m_Data.GetCount()));
+            }
+
+            out_InternedNames[sName] = uiIid;
+          }
+        }
+        else if (field.m_uiField == TracePacket_TrackEvent)
+        {
+          ezUInt64 uiType = 0;
+          ezUInt64 uiTrackUuid = 0;
+          ezUInt64 uiNameIid = 0;
+
+          while (subReader.Next(sub))
+          {
+            if (sub.m_uiField == TrackEvent_Type)
+              uiType = sub.m_uiValue;
+            if (sub.m_uiField == TrackEvent_TrackUuid)
+              uiTrackUuid = sub.m_uiValue;
+            if (sub.m_uiField == TrackEvent_NameIid)
+              uiNameIid = sub.m_uiValue;
+          }
+
+          auto it = tracks.Find(uiTrackUuid);
+          if (it.IsValid() && (uiType == TrackEventType_SliceBegin || uiType == TrackEventType_SliceEnd))
+          {
+            it.Value().m_Events.PushBack(uiType == TrackEventType_SliceBegin ? uiNameIid : 0);
+          }
+        }
+
+        if (subReader.m_bError)
+          return false;
+      }
+
+      if (packetReader.m_bError)
+        return false;
+    }
+
+    if (traceReader.m_bError)
+      return false;
+
+    for (auto it = tracks.GetIterator(); it.IsValid(); ++it)
+    {
+      out_ThreadTracks[trackNames[it.Key()]] = std::move(it.Value());
+    }
+
+    return true;
+  }
+#endif
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Profiling);
+
+EZ_CREATE_SIMPLE_TEST(Profiling, ProtobufWriter)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Wire Format")
+  {
+    // the examples from the protobuf encoding documentation
+    ezProtobufWriter writer;
+    writer.UInt(1, 150);
+    writer.String(2, "testing");
+
+    const ezUInt8 expected[] = {0x08, 0x96, 0x01, 0x12, 0x07, 't', 'e', 's', 't', 'i', 'n', 'g'};
+    EZ_TEST_BOOL(ArePtrsEqual(writer.m_Data, ezMakeArrayPtr(expected)));
+
+    writer.m_Data.Clear();
+    writer.EndNested(writer.BeginNested(3));
+
+    const ezUInt8 expectedEmpty[] = {0x1a, 0x00};
+    EZ_TEST_BOOL(ArePtrsEqual(writer.m_Data, ezMakeArrayPtr(expectedEmpty)));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Varint")
+  {
+    const ezUInt64 values[] = {0, 1, 127, 128, 300, 16383, 16384, 0xFFFFFFFFull, 0x100000000ull, 0xFFFFFFFFFFFFFFFFull};
+
+    ezProtobufWriter writer;
+    for (ezUInt64 uiValue : values)
+    {
+      writer.Varint(uiValue);
+    }
+
+    ProtobufReader reader(writer.m_Data);
+    for (ezUInt64 uiValue : values)
+    {
+      ezUInt64 uiRead = 0;
+      EZ_TEST_BOOL(reader.ReadVarint(uiRead));
+      EZ_TEST_BOOL(uiRead == uiValue);
+    }
+
+    EZ_TEST_BOOL(!reader.m_bError);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Fields")
+  {
+    ezProtobufWriter writer;
+    writer.UInt(5, 12345678901ull);
+    writer.Double(44, 2.5);
+    writer.String(23, "");
+    writer.String(23, "Name");
+
+    ProtobufReader reader(writer.m_Data);
+    ProtobufReader::Field field;
+
+    EZ_TEST_BOOL(reader.Next(field));
+    EZ_TEST_INT(field.m_uiField, 5);
+    EZ_TEST_INT(field.m_uiWireType, 0);
+    EZ_TEST_BOOL(field.m_uiValue == 12345678901ull);
+
+    EZ_TEST_BOOL(reader.Next(field));
+    EZ_TEST_INT(field.m_uiField, 44);
+    EZ_TEST_INT(field.m_uiWireType, 1);
+    double fValue = 0.0;
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&fValue), reinterpret_cast<const ezUInt8*>(&field.m_uiValue), sizeof(double));
+    EZ_TEST_DOUBLE(fValue, 2.5, 0.0);
+
+    EZ_TEST_BOOL(reader.Next(field));
+    EZ_TEST_INT(field.m_uiField, 23);
+    EZ_TEST_INT(field.m_Data.GetCount(), 0);
+
+    EZ_TEST_BOOL(reader.Next(field));
+    EZ_TEST_INT(field.m_uiField, 23);
+    EZ_TEST_BOOL(ArePtrsEqual(field.m_Data, ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>("Name"), 4)));
+
+    EZ_TEST_BOOL(!reader.Next(field));
+    EZ_TEST_BOOL(!reader.m_bError);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Nested")
+  {
+    // the reserved length is shrunk to 1, 2 and 3 bytes
+    for (ezUInt32 uiPayloadSize : {0u, 1u, 127u, 128u, 16383u, 16384u, 100000u})
+    {
+      ezDynamicArray<ezUInt8> payload;
+      payload.SetCountUninitialized(uiPayloadSize);
+      for (ezUInt32 i = 0; i < uiPayloadSize; ++i)
+      {
+        payload[i] = static_cast<ezUInt8>(i * 7);
+      }
+
+      ezProtobufWriter writer;
+      const ezUInt32 uiOuter = writer.BeginNested(1);
+      writer.UInt(2, uiPayloadSize);
+      const ezUInt32 uiInner = writer.BeginNested(3);
+      writer.m_Data.PushBackRange(payload);
+      writer.EndNested(uiInner);
+      writer.EndNested(uiOuter);
+      writer.UInt(4, 42);
+
+      ProtobufReader reader(writer.m_Data);
+      ProtobufReader::Field outer;
+      EZ_TEST_BOOL(reader.Next(outer));
+      EZ_TEST_INT(outer.m_uiField, 1);
+
+      ProtobufReader outerReader(outer.m_Data);
+      ProtobufReader::Field field;
+      EZ_TEST_BOOL(outerReader.Next(field));
+      EZ_TEST_INT(field.m_uiField, 2);
+      EZ_TEST_BOOL(field.m_uiValue == uiPayloadSize);
+
+      EZ_TEST_BOOL(outerReader.Next(field));
+      EZ_TEST_INT(field.m_uiField, 3);
+      EZ_TEST_BOOL(ArePtrsEqual(field.m_Data, payload));
+      EZ_TEST_BOOL(!outerReader.Next(field));
+
+      // whatever follows the nested message is intact
+      EZ_TEST_BOOL(reader.Next(field));
+      EZ_TEST_INT(field.m_uiField, 4);
+      EZ_TEST_BOOL(field.m_uiValue == 42);
+
+      EZ_TEST_BOOL(!reader.m_bError && !outerReader.m_bError);
+    }
+  }
+}
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+EZ_CREATE_SIMPLE_TEST(Profiling, Streaming)
+{
+  ezStringBuilder sOutputFile = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFile.MakeCleanPath();
+  sOutputFile.AppendPath("Profiling");
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutputFile).Succeeded());
+  sOutputFile.AppendPath("Stream.pftrace");
+
+  // one thread stays well within the stream buffer, the other one produces far more than it can hold between two flushes
+  constexpr ezUInt32 uiNumSmallScopes = 100;
+  constexpr ezUInt32 uiNumLargeScopes = 50000;
+
+  StreamingTestThread smallThread("Profiling Streaming Small", uiNumSmallScopes);
+  StreamingTestThread largeThread("Profiling Streaming Large", uiNumLargeScopes);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stream")
+  {
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreaming());
+    EZ_TEST_BOOL(ezProfilingSystem::StartStreaming(sOutputFile, ezTime::Milliseconds(10)).Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsStreaming());
+
+    smallThread.Start();
+    smallThread.Join();
+
+    largeThread.Start();
+    largeThread.Join();
+
+    ezProfilingSystem::StopStreaming();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreaming());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse Trace")
+  {
+    ezDynamicArray<ezUInt8> trace;
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sOutputFile, ezFileOpenMode::Read).Succeeded());
+      trace.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+      EZ_TEST_INT(file.Read(trace.GetData(), trace.GetCount()), trace.GetCount());
+    }
+
+    EZ_TEST_BOOL(!trace.IsEmpty());
+
+    ezMap<ezString, StreamedTrack> threadTracks;
+    ezMap<ezString, ezUInt64> internedNames;
+    if (EZ_TEST_BOOL(ParseTrace(trace, threadTracks, internedNames)).Failed())
+      return;
+
+    const ezUInt64 uiOuterIid = internedNames["StreamingTestOuter"];
+    const ezUInt64 uiInnerIid = internedNames["StreamingTestInner"];
+    EZ_TEST_BOOL(uiOuterIid != 0 && uiInnerIid != 0 && uiOuterIid != uiInnerIid);
+
+    for (const StreamingTestThread* pThread : {&smallThread, &largeThread})
+    {
+      auto it = threadTracks.Find(pThread->GetThreadName());
+      if (EZ_TEST_BOOL(it.IsValid()).Failed())
+        continue;
+
+      const StreamedTrack& track = it.Value();
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+      // the OS thread id, not a truncated pthread id
+      EZ_TEST_INT(track.m_uiSystemThreadId, pThread->m_uiSystemThreadId);
+#  endif
+
+      // even with dropped events, every scope is closed and inner scopes are only streamed together with their outer scope
+      ezInt32 iDepth = 0;
+      ezUInt32 uiNumOuter = 0;
+      ezUInt32 uiNumInner = 0;
+
+      for (ezUInt64 uiEvent : track.m_Events)
+      {
+        if (uiEvent == 0)
+        {
+          --iDepth;
+          EZ_TEST_BOOL(iDepth >= 0);
+          continue;
+        }
+
+        EZ_TEST_INT(iDepth, uiEvent == uiOuterIid ? 0 : 1);
+        uiNumOuter += (uiEvent == uiOuterIid) ? 1 : 0;
+        uiNumInner += (uiEvent == uiInnerIid) ? 1 : 0;
+        ++iDepth;
+      }
+
+      EZ_TEST_INT(iDepth, 0);
+      EZ_TEST_BOOL(uiNumOuter <= pThread->m_uiNumScopes);
+      EZ_TEST_BOOL(uiNumInner <= uiNumOuter * 2);
+
+      if (pThread == &smallThread)
+      {
+        EZ_TEST_INT(uiNumOuter, uiNumSmallScopes);
+        EZ_TEST_INT(uiNumInner, uiNumSmallScopes * 2);
+      }
+    }
+  }
+}
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+EZ_CREATE_SIMPLE_TEST(Profiling, Sampling)
+{
+  ezCVarInt* pSampleInterval = static_cast<ezCVarInt*>(ezCVar::FindCVarByName("prof_SampleInterval"));
+  if (EZ_TEST_BOOL(pSampleInterval != nullptr).Failed())
+    return;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Enable through CVar")
+  {
+    EZ_TEST_BOOL(!ezProfilingSystem::IsSampling());
+
+    *pSampleInterval = 1;
+    EZ_TEST_BOOL(ezProfilingSystem::IsSampling());
+
+    *pSampleInterval = 0;
+    EZ_TEST_BOOL(!ezProfilingSystem::IsSampling());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Attribute Samples")
+  {
+    EZ_TEST_BOOL(ezProfilingSystem::StartSampling(ezTime::Milliseconds(1)).Succeeded());
+
+    {
+      EZ_PROFILE_SCOPE("SamplingTestScope");
+
+      // the timer measures CPU time, so this has to actually keep the CPU busy
+      volatile ezUInt64 uiCounter = 0;
+      const ezTime tStart = ezTime::Now();
+      while (ezTime::Now() - tStart < ezTime::Milliseconds(200))
+      {
+        uiCounter = uiCounter + 1;
+      }
+    }
+
+    ezProfilingSystem::StopSampling();
+
+    const ezProfilingSystem::ProfilingData profilingData = ezProfilingSystem::Capture();
+    EZ_TEST_BOOL(!profilingData.m_CPUSamples.IsEmpty());
+
+    ezUInt32 uiNumSamplesInScope = 0;
+    for (const auto& samples : profilingData.m_CPUSamples)
+    {
+      for (const auto& sample : samples.m_Samples)
+      {
+        // the root of each call stack is the scope the sample was taken in
+        ezUInt32 uiFrame = sample.m_uiStackFrame;
+        while (profilingData.m_StackFrames[uiFrame].m_uiParent != ezInvalidIndex)
+        {
+          uiFrame = profilingData.m_StackFrames[uiFrame].m_uiParent;
+        }
+
+        if (profilingData.m_StackFrames[uiFrame].m_sName == "SamplingTestScope")
+        {
+          ++uiNumSamplesInScope;
+
+          // with the walked call stack below the scope
+          EZ_TEST_BOOL(sample.m_uiStackFrame != uiFrame);
+        }
+      }
+    }
+
+    EZ_TEST_BOOL(uiNumSamplesInScope > 0);
+  }
+}
+
+#  endif
+
+#endif
@@ -0,0 +1,200 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+#include <Foundation/Serialization/BinarySerializer.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  /// Builds a graph that resembles a scene document: game objects with a few components each, linked through guid properties.
+  void CreateSceneGraph(ezAbstractObjectGraph& graph, ezUInt32 uiNumObjects)
+  {
+    ezUuid rootGuid;
+    rootGuid.CreateNewUuid();
+    ezAbstractObjectNode* pRoot = graph.AddNode(rootGuid, "ezDocumentRoot", 1, "ObjectTree");
+
+    ezVariantArray rootChildren;
+    ezStringBuilder sName;
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezUuid objectGuid;
+      objectGuid.CreateNewUuid();
+      rootChildren.PushBack(objectGuid);
+
+      ezAbstractObjectNode* pObject = graph.AddNode(objectGuid, "ezGameObject", 1);
+      sName.Format("Object{0}", i);
+      pObject->AddProperty("Name", ezString(sName));
+      pObject->AddProperty("LocalPosition", ezVec3((float)i, 0.0f, 1.0f));
+      pObject->AddProperty("LocalRotation", ezQuat::IdentityQuaternion());
+      pObject->AddProperty("LocalScaling", ezVec3(1.0f));
+      pObject->AddProperty("LocalUniformScaling", 1.0f);
+      pObject->AddProperty("Active", true);
+
+      ezVariantArray components;
+      for (ezUInt32 c = 0; c < 3; ++c)
+      {
+        ezUuid componentGuid;
+        componentGuid.CreateNewUuid();
+        components.PushBack(componentGuid);
+
+        ezAbstractObjectNode* pComponent = graph.AddNode(componentGuid, c == 0 ? "ezMeshComponent" : "ezPointLightComponent", 2);
+        pComponent->AddProperty("Active", true);
+        pComponent->AddProperty("Color", ezColor::White);
+        pComponent->AddProperty("Intensity", 10.0f);
+        pComponent->AddProperty("Mesh", "{ 618ee743-ed04-4fac-bf5f-572939db2f1d }");
+      }
+
+      pObject->AddProperty("Components", components);
+      pObject->AddProperty("Children", ezVariantArray());
+    }
+
+    pRoot->AddProperty("Children", rootChildren);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Serialization, AbstractObjectGraph)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddNode / RemoveNode")
+  {
+    ezAbstractObjectGraph graph;
+
+    ezUuid guids[8];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(guids); ++i)
+    {
+      guids[i].CreateNewUuid();
+      ezAbstractObjectNode* pNode = graph.AddNode(guids[i], "Type", i, i == 0 ? "Root" : nullptr);
+      pNode->AddProperty("Value", i);
+    }
+
+    EZ_TEST_INT(graph.GetAllNodes().GetCount(), 8);
+    EZ_TEST_BOOL(graph.GetNodeByName("Root") == graph.GetNode(guids[0]));
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(guids); ++i)
+    {
+      const ezAbstractObjectNode* pNode = graph.GetNode(guids[i]);
+      EZ_TEST_BOOL(pNode != nullptr);
+      EZ_TEST_BOOL(pNode->GetGuid() == guids[i]);
+      EZ_TEST_INT(pNode->FindProperty("Value")->m_Value.Get<ezUInt32>(), i);
+    }
+
+    graph.RemoveNode(guids[0]);
+    graph.RemoveNode(guids[3]);
+    EZ_TEST_BOOL(graph.GetNode(guids[0]) == nullptr);
+    EZ_TEST_BOOL(graph.GetNode(guids[3]) == nullptr);
+    EZ_TEST_BOOL(graph.GetNodeByName("Root") == nullptr);
+    EZ_TEST_INT(graph.GetAllNodes().GetCount(), 6);
+
+    // removed nodes are recycled and must come back without any stale data
+    ezAbstractObjectNode* pNode = graph.AddNode(guids[0], "OtherType", 5);
+    EZ_TEST_BOOL(graph.GetNode(guids[0]) == pNode);
+    EZ_TEST_STRING(pNode->GetType(), "OtherType");
+    EZ_TEST_BOOL(pNode->GetNodeName() == nullptr);
+    EZ_TEST_INT(pNode->GetProperties().GetCount(), 0);
+
+    ezUuid seed;
+    seed.CreateNewUuid();
+    graph.ReMapNodeGuids(seed);
+
+    for (auto it = graph.GetAllNodes().GetIterator(); it.IsValid(); ++it)
+    {
+      EZ_TEST_BOOL(graph.GetNode(it.Key()) == it.Value());
+      EZ_TEST_BOOL(it.Value()->GetGuid() == it.Key());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RegisterString")
+  {
+    ezAbstractObjectGraph graph;
+
+    ezStringBuilder sLong;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+      sLong.Append("LongString");
+
+    const char* szA = graph.RegisterString("A");
+    const char* szLong = graph.RegisterString(sLong);
+
+    EZ_TEST_BOOL(graph.RegisterString("A") == szA);
+    EZ_TEST_BOOL(graph.RegisterString(ezStringBuilder("A")) == szA);
+    EZ_TEST_BOOL(graph.RegisterString(sLong) == szLong);
+    EZ_TEST_STRING(szLong, sLong);
+
+    // fill a few string blocks, previously returned strings have to stay valid
+    ezStringBuilder sTemp;
+    for (ezUInt32 i = 0; i < 10000; ++i)
+    {
+      sTemp.Format("String{0}", i);
+      EZ_TEST_STRING(graph.RegisterString(sTemp), sTemp);
+    }
+
+    EZ_TEST_STRING(szA, "A");
+    EZ_TEST_BOOL(graph.RegisterString("String42") == graph.RegisterString(ezStringBuilder("String42")));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Binary Round Trip")
+  {
+    ezAbstractObjectGraph graph;
+    CreateSceneGraph(graph, 100);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+
+    ezAbstractGraphBinarySerializer::Write(writer, &graph);
+
+    ezAbstractObjectGraph graph2;
+    ezAbstractGraphBinarySerializer::Read(reader, &graph2);
+
+    ezDeque<ezAbstractGraphDiffOperation> diff;
+    graph2.CreateDiffWithBaseGraph(graph, diff);
+    EZ_TEST_INT(diff.GetCount(), 0);
+    EZ_TEST_INT(graph2.GetAllNodes().GetCount(), graph.GetAllNodes().GetCount());
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Binary Read Performance")
+  {
+    const ezUInt32 uiNumObjects = 25000;
+
+    ezAbstractObjectGraph graph;
+    CreateSceneGraph(graph, uiNumObjects);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezAbstractGraphBinarySerializer::Write(writer, &graph);
+
+    const ezUInt32 uiNumRuns = 10;
+    ezTime tRead;
+    ezTime tLookup;
+
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      ezMemoryStreamReader reader(&storage);
+      ezAbstractObjectGraph graph2;
+
+      ezTime t0 = ezTime::Now();
+      ezAbstractGraphBinarySerializer::Read(reader, &graph2);
+      ezTime t1 = ezTime::Now();
+
+      ezUInt32 uiFound = 0;
+      for (auto it = graph.GetAllNodes().GetIterator(); it.IsValid(); ++it)
+      {
+        uiFound += graph2.GetNode(it.Key()) != nullptr ? 1 : 0;
+      }
+      ezTime t2 = ezTime::Now();
+
+      EZ_TEST_INT(uiFound, graph.GetAllNodes().GetCount());
+
+      tRead += t1 - t0;
+      tLookup += t2 - t1;
+    }
+
+    ezLog::Info("[test]Abstract graph binary read ({0} nodes): {1}ms", graph.GetAllNodes().GetCount(),
+                ezArgF(tRead.GetMilliseconds() / uiNumRuns, 2));
+    ezLog::Info("[test]Abstract graph node lookup ({0} nodes): {1}ms", graph.GetAllNodes().GetCount(),
+                ezArgF(tLookup.GetMilliseconds() / uiNumRuns, 2));
+  }
+}
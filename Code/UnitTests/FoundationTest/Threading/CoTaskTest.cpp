@@ -0,0 +1,85 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/CoTask.h>
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+
+#  include <Foundation/Threading/DelegateTask.h>
+
+namespace
+{
+  ezCoTask<ezInt32> ComputeOnLongRunningThread(ezInt32 iValue)
+  {
+    co_await ezCoSwitchTo(ezTaskPriority::LongRunning);
+
+    EZ_TEST_BOOL(ezTaskSystem::GetCurrentThreadWorkerType() == ezWorkerThreadType::LongTasks);
+    co_return iValue * 2;
+  }
+
+  ezCoTask<ezInt32> AwaitGroup(ezAtomicInteger32* pCounter)
+  {
+    ezDelegateTask<void> task("CoTaskTest", [pCounter]() {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+      pCounter->Increment();
+    });
+
+    ezTaskGroupID group = ezTaskSystem::StartSingleTask(&task, ezTaskPriority::ThisFrame);
+
+    co_await ezCoWaitForGroup(group);
+
+    EZ_TEST_INT(*pCounter, 1);
+
+    const ezInt32 iResult = co_await ComputeOnLongRunningThread(21);
+    co_return iResult;
+  }
+
+  ezCoTask<void> IncrementDetached(ezAtomicInteger32* pCounter)
+  {
+    co_await ezCoSwitchTo(ezTaskPriority::ThisFrame);
+    pCounter->Increment();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Threading, CoTask)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WaitForResult")
+  {
+    ezAtomicInteger32 counter;
+
+    EZ_TEST_INT(AwaitGroup(&counter).WaitForResult(), 42);
+    EZ_TEST_INT(counter, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Lazy Start")
+  {
+    ezAtomicInteger32 counter;
+
+    {
+      // never started, destroying it is fine
+      ezCoTask<void> task = IncrementDetached(&counter);
+      EZ_TEST_BOOL(!task.IsFinished());
+    }
+
+    EZ_TEST_INT(counter, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StartDetached")
+  {
+    ezAtomicInteger32 counter;
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      IncrementDetached(&counter).StartDetached();
+    }
+
+    const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(10);
+    while (counter < 100 && ezTime::Now() < tTimeout)
+    {
+      ezTaskSystem::FinishFrameTasks();
+    }
+
+    EZ_TEST_INT(counter, 100);
+  }
+}
+
+#endif
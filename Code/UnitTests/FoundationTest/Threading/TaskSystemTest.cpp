@@ -5,6 +5,8 @@
 #include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Utilities/DGMLWriter.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
 
 class ezTestTask : public ezTask
 {
@@ -430,6 +432,71 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2].IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Statistics")
+  {
+    ezTaskSystem::SetInstrumentationEnabled(true);
+
+    // counters report their total, histograms only what was recorded since the last snapshot
+    ezMetrics::Snapshot();
+    const ezVariant prevExecutions = ezStats::GetStat("TaskSystem/Tasks/StatisticsTask (ThisFrame)/Executions");
+    const ezInt64 iPrevExecutions = prevExecutions.IsValid() ? prevExecutions.ConvertTo<ezInt64>() : 0;
+
+    ezTestTask t[4];
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(t); ++i)
+    {
+      t[i].m_uiIterations = 2;
+      t[i].SetTaskName("StatisticsTask");
+      ezTaskSystem::StartSingleTask(&t[i], ezTaskPriority::ThisFrame);
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(t); ++i)
+    {
+      ezTaskSystem::WaitForTask(&t[i]);
+    }
+
+    ezTaskSystem::SetInstrumentationEnabled(false);
+
+    ezMetrics::Snapshot();
+
+    EZ_TEST_INT(ezStats::GetStat("TaskSystem/Tasks/StatisticsTask (ThisFrame)/Executions").ConvertTo<ezInt64>() - iPrevExecutions, 4);
+    EZ_TEST_INT(ezStats::GetStat("TaskSystem/Tasks/StatisticsTask (ThisFrame)/RunTimeUS/Count").ConvertTo<ezInt64>(), 4);
+    EZ_TEST_INT(ezStats::GetStat("TaskSystem/Tasks/StatisticsTask (ThisFrame)/LatencyUS/Count").ConvertTo<ezInt64>(), 4);
+    EZ_TEST_BOOL(ezStats::GetStat("TaskSystem/Tasks/StatisticsTask (ThisFrame)/RunTimeUS/Max").ConvertTo<ezInt64>() >= 2000);
+    EZ_TEST_BOOL(ezStats::GetStat("TaskSystem/Queues/ThisFrame/Depth/Max").ConvertTo<ezInt64>() >= 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Frame Pacing")
+  {
+    ezTaskSystem::SetFramePacingEnabled(true);
+
+    ezTestTask t[8];
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(t); ++i)
+    {
+      // takes longer than the whole target frame time, so usually only one task fits into a frame
+      t[i].m_uiIterations = 30;
+      t[i].SetTaskName("PacedTask");
+      ezTaskSystem::StartSingleTask(&t[i], ezTaskPriority::SomeFrameMainThread);
+    }
+
+    // the frames never have time left for another task, but the scheduler still has to make progress
+    for (ezUInt32 uiFrame = 0; uiFrame < 200; ++uiFrame)
+    {
+      ezTaskSystem::FinishFrameTasks();
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(t); ++i)
+    {
+      EZ_TEST_BOOL(t[i].IsDone());
+    }
+
+    EZ_TEST_BOOL(ezTaskSystem::GetEstimatedTaskCost("PacedTask") >= ezTime::Milliseconds(30));
+    EZ_TEST_BOOL(ezTaskSystem::GetEstimatedTaskCost("UnknownTask").IsZero());
+
+    ezTaskSystem::SetFramePacingEnabled(false);
+  }
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 
@@ -0,0 +1,101 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+namespace
+{
+  class MetricsTestThread : public ezThread
+  {
+  public:
+    ezMetricHandle m_hCounter;
+    ezMetricHandle m_hHistogram;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        ezMetrics::Increment(m_hCounter);
+        ezMetrics::Record(m_hHistogram, 100);
+      }
+
+      return 0;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Utility, Metrics)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Register")
+  {
+    ezMetricHandle hCounter = ezMetrics::RegisterCounter("MetricsTest/Register");
+    EZ_TEST_BOOL(hCounter.IsValid());
+
+    ezMetricHandle hCounter2 = ezMetrics::RegisterCounter("MetricsTest/Register");
+    EZ_TEST_BOOL(hCounter2.IsValid());
+
+    ezMetrics::Increment(hCounter, 2);
+    ezMetrics::Increment(hCounter2, 3);
+    ezMetrics::Snapshot();
+
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Register").ConvertTo<ezInt64>(), 5);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Gauge")
+  {
+    ezMetricHandle hGauge = ezMetrics::RegisterGauge("MetricsTest/Gauge");
+
+    ezMetrics::SetGauge(hGauge, 1.5);
+    ezMetrics::SetGauge(hGauge, 2.5);
+    ezMetrics::Snapshot();
+
+    EZ_TEST_DOUBLE(ezStats::GetStat("MetricsTest/Gauge").ConvertTo<double>(), 2.5, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram")
+  {
+    ezMetricHandle hHistogram = ezMetrics::RegisterHistogram("MetricsTest/Histogram");
+
+    for (ezUInt32 i = 1; i <= 100; ++i)
+    {
+      ezMetrics::Record(hHistogram, i);
+    }
+
+    ezMetrics::Snapshot();
+
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Count").ConvertTo<ezInt64>(), 100);
+    EZ_TEST_DOUBLE(ezStats::GetStat("MetricsTest/Histogram/Mean").ConvertTo<double>(), 50.5, 0.0);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Max").ConvertTo<ezInt64>(), 100);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/P50").ConvertTo<ezInt64>(), 63);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/P99").ConvertTo<ezInt64>(), 100);
+
+    // histograms only report the last interval
+    ezMetrics::Snapshot();
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Count").ConvertTo<ezInt64>(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    MetricsTestThread threads[4];
+
+    for (MetricsTestThread& thread : threads)
+    {
+      thread.m_hCounter = ezMetrics::RegisterCounter("MetricsTest/Threads");
+      thread.m_hHistogram = ezMetrics::RegisterHistogram("MetricsTest/ThreadsHistogram");
+      thread.Start();
+    }
+
+    for (MetricsTestThread& thread : threads)
+    {
+      thread.Join();
+    }
+
+    ezMetrics::Snapshot();
+
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Threads").ConvertTo<ezInt64>(), 4000);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/ThreadsHistogram/Count").ConvertTo<ezInt64>(), 4000);
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/ThreadsHistogram/Max").ConvertTo<ezInt64>(), 100);
+  }
+}
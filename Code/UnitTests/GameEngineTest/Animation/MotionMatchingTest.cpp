@@ -0,0 +1,273 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/Animation/Skeletal/MotionMatchingDatabase.h>
+
+namespace
+{
+  ezVec3 RandomVec3(ezRandom& rng, float fExtents)
+  {
+    return ezVec3(rng.FloatMinMax(-fExtents, fExtents), rng.FloatMinMax(-fExtents, fExtents), rng.FloatMinMax(-fExtents, fExtents));
+  }
+
+  void FillDatabase(ezMotionMatchingDatabase& db, ezRandom& rng, ezUInt32 uiNumClips, ezUInt32 uiKeyframesPerClip)
+  {
+    ezDynamicArray<ezMotionMatchingDatabase::Frame> frames;
+
+    for (ezUInt32 uiClip = 0; uiClip < uiNumClips; ++uiClip)
+    {
+      for (ezUInt32 uiKey = 0; uiKey < uiKeyframesPerClip; ++uiKey)
+      {
+        auto& frame = frames.ExpandAndGetRef();
+        frame.m_uiAnimClipIndex = static_cast<ezUInt16>(uiClip);
+        frame.m_uiKeyframeIndex = static_cast<ezUInt16>(uiKey);
+        frame.m_vLeftFootPosition = RandomVec3(rng, 1.0f);
+        frame.m_vLeftFootVelocity = RandomVec3(rng, 2.0f);
+        frame.m_vRightFootPosition = RandomVec3(rng, 1.0f);
+        frame.m_vRightFootVelocity = RandomVec3(rng, 2.0f);
+        frame.m_vRootVelocity = RandomVec3(rng, 3.0f);
+      }
+    }
+
+    db.Clear();
+    db.AddFrames(frames);
+    db.Build();
+  }
+
+  void CreateQueries(ezRandom& rng, ezUInt32 uiNumClips, ezUInt32 uiKeyframesPerClip, ezUInt32 uiNumQueries,
+    ezDynamicArray<ezMotionMatchingDatabase::Query>& out_Queries)
+  {
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      auto& query = out_Queries.ExpandAndGetRef();
+      query.m_uiCurrentAnimClip = static_cast<ezUInt16>(rng.UIntInRange(uiNumClips));
+      query.m_uiCurrentKeyframe = static_cast<ezUInt16>(rng.UIntInRange(uiKeyframesPerClip));
+      query.m_vLeftFootPosition = RandomVec3(rng, 1.0f);
+      query.m_vRightFootPosition = RandomVec3(rng, 1.0f);
+      query.m_vTargetDirection = RandomVec3(rng, 3.0f);
+    }
+  }
+
+  // same formula as in the database, written out plainly
+  float ComputeScore(const ezMotionMatchingDatabase::Frame& frame, const ezMotionMatchingDatabase::Query& query)
+  {
+    float fPenaltyMul = 1.1f;
+    float fPenaltyAdd = 100.0f;
+
+    if (frame.m_uiAnimClipIndex == query.m_uiCurrentAnimClip)
+    {
+      if (frame.m_uiKeyframeIndex < query.m_uiCurrentKeyframe && frame.m_uiKeyframeIndex + 10 > query.m_uiCurrentKeyframe)
+        return ezMath::MaxValue<float>();
+
+      fPenaltyMul = frame.m_uiKeyframeIndex == query.m_uiCurrentKeyframe ? 0.9f : 1.0f;
+      fPenaltyAdd = 0.0f;
+    }
+
+    const float fDirDist = ezMath::Pow((frame.m_vRootVelocity - query.m_vTargetDirection).GetLength(), 3.0f);
+    const float fFootDist = (frame.m_vLeftFootPosition - query.m_vLeftFootPosition).GetLengthSquared() +
+                            (frame.m_vRightFootPosition - query.m_vRightFootPosition).GetLengthSquared();
+
+    return fDirDist + fFootDist * fPenaltyMul + fPenaltyAdd;
+  }
+
+  // the tree search computes the distances with SIMD instructions, so it may pick a different frame when two scores are practically tied
+  bool IsEquallyGood(const ezMotionMatchingDatabase& db, const ezMotionMatchingDatabase::Query& query, ezUInt32 uiFrame, ezUInt32 uiExpected)
+  {
+    if (uiFrame == uiExpected)
+      return true;
+
+    if (uiFrame == ezInvalidIndex || uiExpected == ezInvalidIndex)
+      return false;
+
+    const float fScore = ComputeScore(db.GetFrame(uiFrame), query);
+    const float fExpected = ComputeScore(db.GetFrame(uiExpected), query);
+    return ezMath::IsEqual(fScore, fExpected, ezMath::Max(1.0f, fExpected) * 0.0001f);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Animation);
+
+EZ_CREATE_SIMPLE_TEST(Animation, MotionMatchingDatabase)
+{
+  constexpr ezUInt32 uiNumClips = 20;
+  constexpr ezUInt32 uiKeyframesPerClip = 50;
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  ezMotionMatchingDatabase db;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty")
+  {
+    db.Build();
+    EZ_TEST_BOOL(db.IsBuilt());
+    EZ_TEST_INT(db.GetFrameCount(), 0);
+    EZ_TEST_INT(db.FindBestFrame(ezMotionMatchingDatabase::Query()), ezInvalidIndex);
+    EZ_TEST_INT(db.FindBestFrameBruteForce(ezMotionMatchingDatabase::Query()), ezInvalidIndex);
+  }
+
+  FillDatabase(db, rng, uiNumClips, uiKeyframesPerClip);
+
+  ezDynamicArray<ezMotionMatchingDatabase::Query> queries;
+  CreateQueries(rng, uiNumClips, uiKeyframesPerClip, 500, queries);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build")
+  {
+    EZ_TEST_BOOL(db.IsBuilt());
+    EZ_TEST_INT(db.GetFrameCount(), uiNumClips * uiKeyframesPerClip);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrame")
+  {
+    for (const auto& query : queries)
+    {
+      const ezUInt32 uiExpected = db.FindBestFrameBruteForce(query);
+      const ezUInt32 uiFrame = db.FindBestFrame(query);
+
+      EZ_TEST_BOOL(uiExpected != ezInvalidIndex);
+      EZ_TEST_BOOL(IsEquallyGood(db, query, uiFrame, uiExpected));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrame Current Frame")
+  {
+    // a query that matches the current frame exactly has to pick it, because the same frame has the smallest penalty
+    for (ezUInt32 i = 0; i < db.GetFrameCount(); i += 37)
+    {
+      const auto& frame = db.GetFrame(i);
+
+      ezMotionMatchingDatabase::Query query;
+      query.m_uiCurrentAnimClip = frame.m_uiAnimClipIndex;
+      query.m_uiCurrentKeyframe = frame.m_uiKeyframeIndex;
+      query.m_vLeftFootPosition = frame.m_vLeftFootPosition;
+      query.m_vRightFootPosition = frame.m_vRightFootPosition;
+      query.m_vTargetDirection = frame.m_vRootVelocity;
+
+      EZ_TEST_INT(db.FindBestFrameBruteForce(query), i);
+      EZ_TEST_INT(db.FindBestFrame(query), i);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrame No Backwards Transition")
+  {
+    // only the keyframes of the current clip are eligible, apart from the ones shortly before the current keyframe
+    ezMotionMatchingDatabase single;
+    FillDatabase(single, rng, 1, uiKeyframesPerClip);
+
+    ezDynamicArray<ezMotionMatchingDatabase::Query> singleQueries;
+    CreateQueries(rng, 1, uiKeyframesPerClip, 100, singleQueries);
+
+    for (const auto& query : singleQueries)
+    {
+      const ezUInt32 uiExpected = single.FindBestFrameBruteForce(query);
+      const ezUInt32 uiFrame = single.FindBestFrame(query);
+
+      EZ_TEST_BOOL(IsEquallyGood(single, query, uiFrame, uiExpected));
+
+      if (EZ_TEST_BOOL(uiFrame != ezInvalidIndex).Failed())
+        continue;
+
+      const auto& frame = single.GetFrame(uiFrame);
+      EZ_TEST_BOOL(frame.m_uiKeyframeIndex >= query.m_uiCurrentKeyframe || frame.m_uiKeyframeIndex + 10 <= query.m_uiCurrentKeyframe);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrames")
+  {
+    ezDynamicArray<ezUInt32> results;
+    results.SetCount(queries.GetCount());
+
+    db.FindBestFrames(queries, results);
+
+    for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+    {
+      EZ_TEST_INT(results[i], db.FindBestFrame(queries[i]));
+    }
+  }
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Animation, Profile_MotionMatching)
+{
+  // roughly ten times the keyframes of a typical motion matching setup
+  constexpr ezUInt32 uiNumClips = 100;
+  constexpr ezUInt32 uiKeyframesPerClip = 500;
+  constexpr ezUInt32 uiNumQueries = 1000;
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  ezMotionMatchingDatabase db;
+  ezDynamicArray<ezMotionMatchingDatabase::Query> queries;
+  ezDynamicArray<ezUInt32> results;
+  results.SetCount(uiNumQueries);
+
+  EZ_TEST_BLOCK(EnableInRelease, "Build")
+  {
+    ezStopwatch sw;
+
+    FillDatabase(db, rng, uiNumClips, uiKeyframesPerClip);
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Building database with %u frames: %.2fms", db.GetFrameCount(), tDiff.GetMilliseconds());
+
+    CreateQueries(rng, uiNumClips, uiKeyframesPerClip, uiNumQueries, queries);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "FindBestFrameBruteForce")
+  {
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      results[i] = db.FindBestFrameBruteForce(queries[i]);
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Brute force search, %u queries: %.2fms (%.1fus per query)", uiNumQueries,
+      tDiff.GetMilliseconds(), tDiff.GetMicroseconds() / uiNumQueries);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "FindBestFrame")
+  {
+    ezDynamicArray<ezUInt32> treeResults;
+    treeResults.SetCount(uiNumQueries);
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      treeResults[i] = db.FindBestFrame(queries[i]);
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Tree search, %u queries: %.2fms (%.1fus per query)", uiNumQueries,
+      tDiff.GetMilliseconds(), tDiff.GetMicroseconds() / uiNumQueries);
+
+    ezUInt32 uiNumMismatches = 0;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      if (!IsEquallyGood(db, queries[i], treeResults[i], results[i]))
+        ++uiNumMismatches;
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "FindBestFrames")
+  {
+    ezStopwatch sw;
+
+    db.FindBestFrames(queries, results);
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Batched tree search, %u queries: %.2fms (%.1fus per query)", uiNumQueries,
+      tDiff.GetMilliseconds(), tDiff.GetMicroseconds() / uiNumQueries);
+  }
+}
@@ -0,0 +1,246 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <ParticlePlugin/Streams/ParticleStreamSimd.h>
+
+namespace
+{
+  void SetSimdEnabled(bool bEnabled)
+  {
+    ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("pfx_Simd"));
+    *pCVar = bEnabled;
+  }
+
+  ezVec3 RandomVec3(ezRandom& rng)
+  {
+    return ezVec3(rng.FloatMinMax(-10.0f, 10.0f), rng.FloatMinMax(-10.0f, 10.0f), rng.FloatMinMax(-10.0f, 10.0f));
+  }
+
+  /// Holds a position and a velocity stream like a particle system does, allocated and padded by the stream group.
+  struct TestStreams
+  {
+    void Setup(ezUInt64 uiNumElements, ezUInt32 uiSeed)
+    {
+      m_pPosition = m_Group.AddStream("Position", ezProcessingStream::DataType::Float4);
+      m_pVelocity = m_Group.AddStream("Velocity", ezProcessingStream::DataType::Float3);
+
+      m_Group.SetSize(uiNumElements);
+      m_Group.InitializeElements(uiNumElements);
+      m_Group.Process();
+
+      ezRandom rng;
+      rng.Initialize(uiSeed);
+
+      ezSimdVec4f* pPosition = GetPositions();
+      ezVec3* pVelocity = GetVelocities();
+
+      for (ezUInt64 i = 0; i < uiNumElements; ++i)
+      {
+        const ezVec3 vPos = RandomVec3(rng);
+        pPosition[i].Set(vPos.x, vPos.y, vPos.z, rng.FloatMinMax(0.0f, 1.0f));
+        pVelocity[i] = RandomVec3(rng);
+      }
+    }
+
+    ezSimdVec4f* GetPositions() const { return m_pPosition->GetWritableData<ezSimdVec4f>(); }
+    ezVec3* GetVelocities() const { return m_pVelocity->GetWritableData<ezVec3>(); }
+
+    ezProcessingStreamGroup m_Group;
+    ezProcessingStream* m_pPosition = nullptr;
+    ezProcessingStream* m_pVelocity = nullptr;
+  };
+
+  void CompareStreams(const TestStreams& scalar, const TestStreams& simd, ezUInt64 uiNumElements)
+  {
+    for (ezUInt64 i = 0; i < uiNumElements; ++i)
+    {
+      // the vectorized code uses fused multiply-add, so the results may differ in the last bits
+      EZ_TEST_VEC3(simd.GetVelocities()[i], scalar.GetVelocities()[i], 0.0001f);
+
+      ezVec4 vScalarPos, vSimdPos;
+      scalar.GetPositions()[i].Store<4>(&vScalarPos.x);
+      simd.GetPositions()[i].Store<4>(&vSimdPos.x);
+
+      EZ_TEST_VEC3(vSimdPos.GetAsVec3(), vScalarPos.GetAsVec3(), 0.0001f);
+      EZ_TEST_FLOAT(vSimdPos.w, vScalarPos.w, 0.0f);
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Particles);
+
+EZ_CREATE_SIMPLE_TEST(Particles, StreamSimd)
+{
+  const bool bWasEnabled = ezParticleStreamSimd::IsEnabled();
+
+  // none of these are a multiple of the SIMD width or the stream padding
+  const ezUInt64 counts[] = {1, 3, 5, 7, 9, 15, 33, 1001};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddToFloat3")
+  {
+    const ezVec3 vAdd(1.5f, -2.0f, 0.25f);
+
+    for (ezUInt64 uiCount : counts)
+    {
+      TestStreams scalar, simd;
+      scalar.Setup(uiCount, 1);
+      simd.Setup(uiCount, 1);
+
+      SetSimdEnabled(false);
+      ezParticleStreamSimd::AddToFloat3(scalar.GetVelocities(), uiCount, vAdd);
+
+      SetSimdEnabled(true);
+      ezParticleStreamSimd::AddToFloat3(simd.GetVelocities(), uiCount, vAdd);
+
+      CompareStreams(scalar, simd, uiCount);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MulFloat3")
+  {
+    for (ezUInt64 uiCount : counts)
+    {
+      TestStreams scalar, simd;
+      scalar.Setup(uiCount, 2);
+      simd.Setup(uiCount, 2);
+
+      SetSimdEnabled(false);
+      ezParticleStreamSimd::MulFloat3(scalar.GetVelocities(), uiCount, 0.75f);
+
+      SetSimdEnabled(true);
+      ezParticleStreamSimd::MulFloat3(simd.GetVelocities(), uiCount, 0.75f);
+
+      CompareStreams(scalar, simd, uiCount);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddScaledFloat3ToFloat4")
+  {
+    for (ezUInt64 uiCount : counts)
+    {
+      TestStreams scalar, simd;
+      scalar.Setup(uiCount, 3);
+      simd.Setup(uiCount, 3);
+
+      SetSimdEnabled(false);
+      ezParticleStreamSimd::AddScaledFloat3ToFloat4(scalar.GetPositions(), scalar.GetVelocities(), uiCount, 1.0f / 60.0f);
+
+      SetSimdEnabled(true);
+      ezParticleStreamSimd::AddScaledFloat3ToFloat4(simd.GetPositions(), simd.GetVelocities(), uiCount, 1.0f / 60.0f);
+
+      CompareStreams(scalar, simd, uiCount);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetRandomPositionsInBox")
+  {
+    // the two code paths use different random numbers, so only the resulting box can be compared
+    const ezVec3 vSize(2.0f, 4.0f, 6.0f);
+    const ezVec3 vOffset(1.0f, 0.0f, -1.0f);
+
+    ezSimdTransform transform;
+    transform.SetIdentity();
+    transform.m_Position = ezSimdVec4f(10.0f, 20.0f, 30.0f);
+
+    const ezVec3 vExpectedMin = ezVec3(10.0f, 20.0f, 30.0f) + vOffset - vSize * 0.5f;
+    const ezVec3 vExpectedMax = ezVec3(10.0f, 20.0f, 30.0f) + vOffset + vSize * 0.5f;
+
+    for (bool bSimd : {false, true})
+    {
+      SetSimdEnabled(bSimd);
+
+      for (ezUInt64 uiCount : counts)
+      {
+        TestStreams streams;
+        streams.Setup(uiCount, 4);
+
+        ezRandom rng;
+        rng.Initialize(5);
+
+        ezParticleStreamSimd::SetRandomPositionsInBox(streams.GetPositions(), uiCount, rng, vSize, vOffset, transform);
+
+        ezVec3 vMin(ezMath::MaxValue<float>()), vMax(-ezMath::MaxValue<float>());
+
+        for (ezUInt64 i = 0; i < uiCount; ++i)
+        {
+          ezVec4 vPos;
+          streams.GetPositions()[i].Store<4>(&vPos.x);
+
+          const ezVec3 vClamped = vPos.GetAsVec3().CompMax(vExpectedMin).CompMin(vExpectedMax);
+          EZ_TEST_VEC3(vPos.GetAsVec3(), vClamped, 0.001f);
+          EZ_TEST_FLOAT(vPos.w, 0.0f, 0.0f);
+
+          vMin = vMin.CompMin(vPos.GetAsVec3());
+          vMax = vMax.CompMax(vPos.GetAsVec3());
+        }
+
+        // with enough particles the box is covered almost entirely
+        if (uiCount >= 1000)
+        {
+          EZ_TEST_VEC3(vMin, vExpectedMin, 0.1f);
+          EZ_TEST_VEC3(vMax, vExpectedMax, 0.1f);
+        }
+      }
+    }
+  }
+
+  SetSimdEnabled(bWasEnabled);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Particles, Profile_StreamSimd)
+{
+  constexpr ezUInt64 uiNumParticles = 1000000;
+  constexpr ezUInt32 uiNumFrames = 10;
+
+  const bool bWasEnabled = ezParticleStreamSimd::IsEnabled();
+
+  TestStreams streams;
+  streams.Setup(uiNumParticles, 1);
+
+  ezSimdTransform transform;
+  transform.SetIdentity();
+
+  ezRandom rng;
+  rng.Initialize(1);
+
+  for (bool bSimd : {false, true})
+  {
+    SetSimdEnabled(bSimd);
+    const char* szMode = bSimd ? "SIMD" : "scalar";
+
+    EZ_TEST_BLOCK(EnableInRelease, bSimd ? "SIMD" : "Scalar")
+    {
+      ezStopwatch sw;
+
+      for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        // gravity, friction and the velocity finalizer, like a typical particle system
+        ezParticleStreamSimd::AddToFloat3(streams.GetVelocities(), uiNumParticles, ezVec3(0, 0, -9.81f / 60.0f));
+        ezParticleStreamSimd::MulFloat3(streams.GetVelocities(), uiNumParticles, 0.99f);
+        ezParticleStreamSimd::AddScaledFloat3ToFloat4(streams.GetPositions(), streams.GetVelocities(), uiNumParticles, 1.0f / 60.0f);
+      }
+
+      const ezTime tUpdate = sw.Checkpoint();
+
+      ezParticleStreamSimd::SetRandomPositionsInBox(streams.GetPositions(), uiNumParticles, rng, ezVec3(10.0f), ezVec3::ZeroVector(), transform);
+
+      const ezTime tInit = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u particles %u times (%s): %.2fms", (ezUInt32)uiNumParticles, uiNumFrames, szMode,
+        tUpdate.GetMilliseconds());
+      ezTestFramework::Output(
+        ezTestOutput::Duration, "Initializing %u box positions (%s): %.2fms", (ezUInt32)uiNumParticles, szMode, tInit.GetMilliseconds());
+    }
+  }
+
+  SetSimdEnabled(bWasEnabled);
+}
@@ -0,0 +1,116 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/Animation/RotorComponent.h>
+#include <GameEngine/Animation/SliderComponent.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumDebrisPieces = 4;
+
+  // A root object with a rotor and a few child objects with sliders, roughly what a debris prefab looks like
+  void WriteDebrisPrefab(ezMemoryStreamStorage& storage)
+  {
+    ezWorldDesc worldDesc("PrefabSource");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+
+    ezGameObject* pRoot = nullptr;
+    const ezGameObjectHandle hRoot = world.CreateObject(desc, pRoot);
+
+    ezRotorComponent* pRotor = nullptr;
+    world.GetOrCreateComponentManager<ezRotorComponentManager>()->CreateComponent(pRoot, pRotor);
+    pRotor->m_iDegreeToRotate = 90;
+
+    for (ezUInt32 i = 0; i < s_uiNumDebrisPieces; ++i)
+    {
+      desc.m_hParent = hRoot;
+      desc.m_LocalPosition.Set(static_cast<float>(i), 0, 0);
+
+      ezGameObject* pChild = nullptr;
+      world.CreateObject(desc, pChild);
+
+      ezSliderComponent* pSlider = nullptr;
+      world.GetOrCreateComponentManager<ezSliderComponentManager>()->CreateComponent(pChild, pSlider);
+      pSlider->m_fDistanceToTravel = 2.0f;
+    }
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezMemoryStreamWriter memWriter(&storage);
+    ezWorldWriter writer;
+    writer.WriteObjects(memWriter, rootObjects);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Prefabs);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Prefabs, Profile_Spawn)
+{
+  constexpr ezUInt32 uiNumInstances = 10000;
+
+  ezMemoryStreamStorage storage;
+  WriteDebrisPrefab(storage);
+
+  ezWorldReader reader;
+  {
+    ezMemoryStreamReader memReader(&storage);
+    reader.ReadWorldDescription(memReader);
+  }
+
+  ezDynamicArray<ezTransform> transforms;
+  transforms.SetCountUninitialized(uiNumInstances);
+  for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+  {
+    transforms[i].SetIdentity();
+    transforms[i].m_vPosition.Set(static_cast<float>(i), 0, 0);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "InstantiatePrefab")
+  {
+    ezWorldDesc worldDesc("Spawn");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      reader.InstantiatePrefab(world, transforms[i], ezGameObjectHandle(), nullptr, nullptr, nullptr, false);
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Spawning %u prefabs one by one: %.2fms (%.1fus per prefab)", uiNumInstances,
+      tDiff.GetMilliseconds(), tDiff.GetMicroseconds() / uiNumInstances);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "InstantiatePrefabs")
+  {
+    ezWorldDesc worldDesc("Spawn");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+
+    ezStopwatch sw;
+
+    reader.InstantiatePrefabs(world, transforms, ezGameObjectHandle(), &rootObjects, &childObjects, nullptr, false);
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Spawning %u prefabs in one batch: %.2fms (%.1fus per prefab)", uiNumInstances,
+      tDiff.GetMilliseconds(), tDiff.GetMicroseconds() / uiNumInstances);
+  }
+}
@@ -0,0 +1,289 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Assets/AssetFileHeader.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/ResourceManager/ResourceTypeLoader.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <GameEngine/Animation/RotorComponent.h>
+#include <GameEngine/Animation/SliderComponent.h>
+#include <GameEngine/Prefabs/PrefabResource.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumPieces = 3;
+
+  // A root object with a rotor and a few child objects with sliders
+  void WriteObjects(ezStreamWriter& stream)
+  {
+    ezWorldDesc worldDesc("PrefabSource");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+
+    ezGameObject* pRoot = nullptr;
+    const ezGameObjectHandle hRoot = world.CreateObject(desc, pRoot);
+
+    ezRotorComponent* pRotor = nullptr;
+    world.GetOrCreateComponentManager<ezRotorComponentManager>()->CreateComponent(pRoot, pRotor);
+    pRotor->m_iDegreeToRotate = 90;
+
+    for (ezUInt32 i = 0; i < s_uiNumPieces; ++i)
+    {
+      desc.m_hParent = hRoot;
+      desc.m_LocalPosition.Set(static_cast<float>(i + 1), 0, 0);
+
+      ezGameObject* pChild = nullptr;
+      world.CreateObject(desc, pChild);
+
+      ezSliderComponent* pSlider = nullptr;
+      world.GetOrCreateComponentManager<ezSliderComponentManager>()->CreateComponent(pChild, pSlider);
+      pSlider->m_fDistanceToTravel = 2.0f;
+    }
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezWorldWriter writer;
+    writer.WriteObjects(stream, rootObjects);
+  }
+
+  // Same layout as a transformed prefab asset, with the rotor angle and the distance of the first slider exposed as parameters
+  ezPrefabResourceHandle CreatePrefabResource()
+  {
+    ezUniquePtr<ezResourceLoaderFromMemory> loader(EZ_DEFAULT_NEW(ezResourceLoaderFromMemory));
+    loader->m_sResourceDescription = "PrefabTest";
+    loader->m_ModificationTimestamp = ezTimestamp::CurrentTimestamp();
+
+    {
+      ezMemoryStreamWriter stream(&loader->m_CustomData);
+
+      stream << ezString("PrefabTest");
+
+      ezAssetFileHeader header;
+      header.SetFileHashAndVersion(1, 4);
+      header.Write(stream);
+
+      stream.WriteBytes("[ezBinaryScene]", 16);
+
+      WriteObjects(stream);
+
+      ezExposedPrefabParameterDesc params[2];
+      params[0].m_sExposeName.Assign("Angle");
+      params[0].m_uiWorldReaderChildObject = 0;
+      params[0].m_uiWorldReaderObjectIndex = 0;
+      params[0].m_uiComponentTypeHash = ezGetStaticRTTI<ezRotorComponent>()->GetTypeNameHash();
+      params[0].m_sProperty.Assign("DegreesToRotate");
+
+      params[1].m_sExposeName.Assign("Distance");
+      params[1].m_uiWorldReaderChildObject = 1;
+      params[1].m_uiWorldReaderObjectIndex = 0;
+      params[1].m_uiComponentTypeHash = ezGetStaticRTTI<ezSliderComponent>()->GetTypeNameHash();
+      params[1].m_sProperty.Assign("Distance");
+
+      stream << static_cast<ezUInt32>(EZ_ARRAY_SIZE(params));
+      for (const auto& param : params)
+      {
+        param.Save(stream);
+      }
+    }
+
+    ezPrefabResourceHandle hPrefab = ezResourceManager::LoadResource<ezPrefabResource>("PrefabTest");
+    ezResourceManager::UpdateResourceWithCustomLoader(hPrefab, std::move(loader));
+    ezResourceManager::ForceLoadResourceNow(hPrefab);
+
+    return hPrefab;
+  }
+
+  ezUInt32 CountSlidersWithDistance(const ezGameObject* pRoot, float fDistance)
+  {
+    ezUInt32 uiCount = 0;
+
+    for (auto it = pRoot->GetChildren(); it.IsValid(); ++it)
+    {
+      const ezSliderComponent* pSlider = nullptr;
+      if (it->TryGetComponentOfBaseType(pSlider) && pSlider->m_fDistanceToTravel == fDistance)
+      {
+        ++uiCount;
+      }
+    }
+
+    return uiCount;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Prefabs, InstantiatePrefabs)
+{
+  constexpr ezUInt32 uiNumInstances = 40;
+  constexpr ezUInt32 uiNumObjectsPerInstance = 1 + s_uiNumPieces;
+
+  ezMemoryStreamStorage storage;
+  {
+    ezMemoryStreamWriter memWriter(&storage);
+    WriteObjects(memWriter);
+  }
+
+  ezWorldReader reader;
+  {
+    ezMemoryStreamReader memReader(&storage);
+    reader.ReadWorldDescription(memReader);
+  }
+
+  EZ_TEST_INT(reader.GetRootObjectCount(), 1);
+  EZ_TEST_INT(reader.GetChildObjectCount(), s_uiNumPieces);
+
+  ezDynamicArray<ezTransform> transforms;
+  transforms.SetCountUninitialized(uiNumInstances);
+  for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+  {
+    transforms[i].SetIdentity();
+    transforms[i].m_vPosition.Set(0, static_cast<float>(i), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezWorldReader")
+  {
+    ezWorldDesc worldDesc("InstantiatePrefabs");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObject* pParent = nullptr;
+    const ezGameObjectHandle hParent = world.CreateObject(ezGameObjectDesc(), pParent);
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+
+    reader.InstantiatePrefabs(world, transforms, hParent, &rootObjects, &childObjects, nullptr, false);
+
+    EZ_TEST_INT(world.GetObjectCount(), 1 + uiNumInstances * uiNumObjectsPerInstance);
+    EZ_TEST_INT(rootObjects.GetCount(), uiNumInstances);
+    EZ_TEST_INT(childObjects.GetCount(), uiNumInstances * s_uiNumPieces);
+    EZ_TEST_INT(pParent->GetChildCount(), uiNumInstances);
+
+    EZ_TEST_INT(world.GetOrCreateComponentManager<ezRotorComponentManager>()->GetComponentCount(), uiNumInstances);
+    EZ_TEST_INT(world.GetOrCreateComponentManager<ezSliderComponentManager>()->GetComponentCount(), uiNumInstances * s_uiNumPieces);
+
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      ezGameObject* pRoot = rootObjects[i];
+
+      EZ_TEST_BOOL(pRoot->GetParent() == pParent);
+      EZ_TEST_VEC3(pRoot->GetLocalPosition(), transforms[i].m_vPosition, 0.0f);
+      EZ_TEST_INT(pRoot->GetChildCount(), s_uiNumPieces);
+      EZ_TEST_INT(pRoot->GetComponents().GetCount(), 1);
+
+      ezRotorComponent* pRotor = nullptr;
+      if (EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRotor)).Succeeded())
+      {
+        EZ_TEST_INT(pRotor->m_iDegreeToRotate, 90);
+      }
+
+      // the child objects of each instance are stored consecutively and belong to that instance's root
+      for (ezUInt32 c = 0; c < s_uiNumPieces; ++c)
+      {
+        ezGameObject* pChild = childObjects[i * s_uiNumPieces + c];
+        EZ_TEST_BOOL(pChild->GetParent() == pRoot);
+        EZ_TEST_INT(pChild->GetComponents().GetCount(), 1);
+
+        const ezSliderComponent* pSlider = nullptr;
+        if (EZ_TEST_BOOL(pChild->TryGetComponentOfBaseType(pSlider)).Succeeded())
+        {
+          EZ_TEST_FLOAT(pSlider->m_fDistanceToTravel, 2.0f, 0.0f);
+        }
+      }
+    }
+
+    // every instance has its own components
+    ezRotorComponent* pFirstRotor = nullptr;
+    rootObjects[0]->TryGetComponentOfBaseType(pFirstRotor);
+    pFirstRotor->m_iDegreeToRotate = 10;
+
+    const ezRotorComponent* pLastRotor = nullptr;
+    rootObjects.PeekBack()->TryGetComponentOfBaseType(pLastRotor);
+    EZ_TEST_INT(pLastRotor->m_iDegreeToRotate, 90);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezWorldReader - Same As InstantiatePrefab")
+  {
+    ezWorldDesc worldDesc("InstantiatePrefabs");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezHybridArray<ezGameObject*, 8> rootObjects;
+    ezHybridArray<ezGameObject*, 8> childObjects;
+    reader.InstantiatePrefab(world, transforms[1], ezGameObjectHandle(), &rootObjects, &childObjects, nullptr, false);
+
+    ezDynamicArray<ezGameObject*> batchRootObjects;
+    ezDynamicArray<ezGameObject*> batchChildObjects;
+    reader.InstantiatePrefabs(world, transforms.GetArrayPtr().GetSubArray(1, 1), ezGameObjectHandle(), &batchRootObjects, &batchChildObjects,
+      nullptr, false);
+
+    if (EZ_TEST_INT(batchRootObjects.GetCount(), rootObjects.GetCount()).Succeeded() &&
+        EZ_TEST_INT(batchChildObjects.GetCount(), childObjects.GetCount()).Succeeded())
+    {
+      EZ_TEST_VEC3(batchRootObjects[0]->GetGlobalPosition(), rootObjects[0]->GetGlobalPosition(), 0.0f);
+
+      for (ezUInt32 c = 0; c < childObjects.GetCount(); ++c)
+      {
+        EZ_TEST_VEC3(batchChildObjects[c]->GetLocalPosition(), childObjects[c]->GetLocalPosition(), 0.0f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezPrefabResource - Exposed Parameters")
+  {
+    ezPrefabResourceHandle hPrefab = CreatePrefabResource();
+    ezResourceLock<ezPrefabResource> pPrefab(hPrefab, ezResourceAcquireMode::BlockTillLoaded);
+
+    if (EZ_TEST_BOOL(pPrefab.GetAcquireResult() == ezResourceAcquireResult::Final).Failed())
+      return;
+
+    ezWorldDesc worldDesc("InstantiatePrefabs");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezArrayMap<ezHashedString, ezVariant> paramValues;
+    paramValues[ezMakeHashedString("Angle")] = ezInt32(45);
+    paramValues[ezMakeHashedString("Distance")] = 5.0f;
+
+    // the output array already has an entry, the instances are appended to it
+    ezDynamicArray<ezGameObject*> rootObjects;
+    rootObjects.PushBack(nullptr);
+
+    pPrefab->InstantiatePrefabs(world, transforms, ezGameObjectHandle(), &rootObjects, nullptr, &paramValues, false);
+
+    EZ_TEST_INT(world.GetObjectCount(), uiNumInstances * uiNumObjectsPerInstance);
+
+    if (EZ_TEST_INT(rootObjects.GetCount(), 1 + uiNumInstances).Failed())
+      return;
+
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      const ezGameObject* pRoot = rootObjects[1 + i];
+      EZ_TEST_VEC3(pRoot->GetLocalPosition(), transforms[i].m_vPosition, 0.0f);
+
+      // every instance gets the parameters applied to its own objects, not only the first one
+      const ezRotorComponent* pRotor = nullptr;
+      if (EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRotor)).Succeeded())
+      {
+        EZ_TEST_INT(pRotor->m_iDegreeToRotate, 45);
+      }
+
+      EZ_TEST_INT(CountSlidersWithDistance(pRoot, 5.0f), 1);
+      EZ_TEST_INT(CountSlidersWithDistance(pRoot, 2.0f), s_uiNumPieces - 1);
+    }
+
+    // without parameter values the prefab keeps its own values
+    ezDynamicArray<ezGameObject*> plainRootObjects;
+    pPrefab->InstantiatePrefabs(world, transforms.GetArrayPtr().GetSubArray(0, 2), ezGameObjectHandle(), &plainRootObjects, nullptr, nullptr, false);
+
+    if (EZ_TEST_INT(plainRootObjects.GetCount(), 2).Succeeded())
+    {
+      const ezRotorComponent* pRotor = nullptr;
+      plainRootObjects[1]->TryGetComponentOfBaseType(pRotor);
+      EZ_TEST_INT(pRotor->m_iDegreeToRotate, 90);
+      EZ_TEST_INT(CountSlidersWithDistance(plainRootObjects[1], 2.0f), s_uiNumPieces);
+    }
+  }
+}
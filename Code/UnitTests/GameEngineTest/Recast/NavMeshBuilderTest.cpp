@@ -0,0 +1,141 @@
+#include <GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_RECAST_SUPPORT
+
+#  include <Core/ResourceManager/ResourceManager.h>
+#  include <Foundation/Utilities/Progress.h>
+#  include <RecastPlugin/NavMeshBuilder/NavMeshBuilder.h>
+#  include <RecastPlugin/Resources/RecastNavMeshResource.h>
+
+namespace
+{
+  void AddBox(ezWorldGeoExtractionUtil::Geometry& geo, const ezVec3& vCenter, const ezVec3& vHalfExtents)
+  {
+    auto& box = geo.m_BoxShapes.ExpandAndGetRef();
+    box.m_vPosition = vCenter;
+    box.m_qRotation.SetIdentity();
+    box.m_vHalfExtents = vHalfExtents;
+  }
+
+  ezRecastConfig CreateTiledConfig()
+  {
+    ezRecastConfig config;
+    config.m_fTileSize = 8.0f;
+    return config;
+  }
+
+  ezResult BuildNavMesh(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& geo, ezRecastNavMeshResourceDescriptor& out_Desc,
+    const ezRecastNavMeshResourceDescriptor* pTileCache = nullptr)
+  {
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+    return builder.Build(config, geo, out_Desc, progress, pTileCache);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Recast);
+
+EZ_CREATE_SIMPLE_TEST(Recast, NavMeshBuilder)
+{
+  // a 40m x 40m floor around the origin, which covers 6 x 6 tiles
+  ezWorldGeoExtractionUtil::Geometry geo;
+  AddBox(geo, ezVec3(0, 0, -0.5f), ezVec3(20, 20, 0.5f));
+
+  const ezRecastConfig config = CreateTiledConfig();
+
+  ezRecastNavMeshResourceDescriptor desc;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build Tiled")
+  {
+    EZ_TEST_BOOL(BuildNavMesh(config, geo, desc).Succeeded());
+
+    EZ_TEST_BOOL(desc.IsTiled());
+    EZ_TEST_FLOAT(desc.m_fTileSize, 8.0f, 0.001f);
+    EZ_TEST_INT(desc.m_Tiles.GetCount(), 36);
+
+    for (const ezRecastNavMeshTile& tile : desc.m_Tiles)
+    {
+      EZ_TEST_BOOL(tile.m_uiGeometryHash != 0);
+      EZ_TEST_BOOL(!tile.m_DetourTileData.IsEmpty());
+      EZ_TEST_BOOL(desc.FindTile(tile.m_iTileX, tile.m_iTileY) == &tile);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deterministic Hashes")
+  {
+    ezRecastNavMeshResourceDescriptor desc2;
+    EZ_TEST_BOOL(BuildNavMesh(config, geo, desc2).Succeeded());
+
+    EZ_TEST_INT(desc2.m_Tiles.GetCount(), desc.m_Tiles.GetCount());
+
+    for (const ezRecastNavMeshTile& tile : desc2.m_Tiles)
+    {
+      const ezRecastNavMeshTile* pPrevTile = desc.FindTile(tile.m_iTileX, tile.m_iTileY);
+
+      if (EZ_TEST_BOOL(pPrevTile != nullptr).Succeeded())
+      {
+        EZ_TEST_BOOL(tile.m_uiGeometryHash == pPrevTile->m_uiGeometryHash);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tile Cache")
+  {
+    // an obstacle in one corner only invalidates the tiles that it touches
+    ezWorldGeoExtractionUtil::Geometry geo2 = geo;
+    AddBox(geo2, ezVec3(16, 16, 1), ezVec3(1, 1, 1));
+
+    ezRecastNavMeshResourceDescriptor desc2;
+    EZ_TEST_BOOL(BuildNavMesh(config, geo2, desc2, &desc).Succeeded());
+
+    EZ_TEST_INT(desc2.m_Tiles.GetCount(), desc.m_Tiles.GetCount());
+
+    const ezRecastNavMeshTile* pFarTile = desc2.FindTile(-3, -3);
+    const ezRecastNavMeshTile* pPrevFarTile = desc.FindTile(-3, -3);
+    if (EZ_TEST_BOOL(pFarTile != nullptr && pPrevFarTile != nullptr).Succeeded())
+    {
+      EZ_TEST_BOOL(pFarTile->m_uiGeometryHash == pPrevFarTile->m_uiGeometryHash);
+      EZ_TEST_BOOL(pFarTile->m_DetourTileData == pPrevFarTile->m_DetourTileData);
+    }
+
+    const ezRecastNavMeshTile* pObstacleTile = desc2.FindTile(2, 2);
+    const ezRecastNavMeshTile* pPrevObstacleTile = desc.FindTile(2, 2);
+    if (EZ_TEST_BOOL(pObstacleTile != nullptr && pPrevObstacleTile != nullptr).Succeeded())
+    {
+      EZ_TEST_BOOL(pObstacleTile->m_uiGeometryHash != pPrevObstacleTile->m_uiGeometryHash);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Config Changes Invalidate Tiles")
+  {
+    ezRecastConfig config2 = config;
+    config2.m_fAgentRadius += 0.1f;
+
+    ezRecastNavMeshResourceDescriptor desc2;
+    EZ_TEST_BOOL(BuildNavMesh(config2, geo, desc2, &desc).Succeeded());
+
+    for (const ezRecastNavMeshTile& tile : desc2.m_Tiles)
+    {
+      const ezRecastNavMeshTile* pPrevTile = desc.FindTile(tile.m_iTileX, tile.m_iTileY);
+
+      if (pPrevTile != nullptr)
+      {
+        EZ_TEST_BOOL(tile.m_uiGeometryHash != pPrevTile->m_uiGeometryHash);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Create Resource")
+  {
+    const ezUInt32 uiNumTiles = desc.m_Tiles.GetCount();
+
+    ezRecastNavMeshResourceHandle hNavMesh = ezResourceManager::CreateResource<ezRecastNavMeshResource>("NavMeshBuilderTest", std::move(desc));
+
+    ezResourceLock<ezRecastNavMeshResource> pNavMesh(hNavMesh, ezResourceAcquireMode::BlockTillLoaded);
+    EZ_TEST_BOOL(pNavMesh->GetNavMesh() != nullptr);
+    EZ_TEST_INT(pNavMesh->GetNumTiles(), uiNumTiles);
+    EZ_TEST_BOOL(pNavMesh->GetNavMeshPolygons() != nullptr);
+  }
+}
+
+#endif
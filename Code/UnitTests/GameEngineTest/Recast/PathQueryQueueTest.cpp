@@ -0,0 +1,178 @@
+#include <GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_RECAST_SUPPORT
+
+#  include <Core/ResourceManager/ResourceManager.h>
+#  include <Foundation/Threading/TaskSystem.h>
+#  include <Foundation/Utilities/Progress.h>
+#  include <RecastPlugin/NavMeshBuilder/NavMeshBuilder.h>
+#  include <RecastPlugin/Resources/RecastNavMeshResource.h>
+#  include <RecastPlugin/WorldModule/RecastPathQueryQueue.h>
+
+namespace
+{
+  ezRecastNavMeshResourceHandle CreateTestNavMesh()
+  {
+    ezWorldGeoExtractionUtil::Geometry geo;
+
+    auto AddBox = [&](const ezVec3& vCenter, const ezVec3& vHalfExtents) {
+      auto& box = geo.m_BoxShapes.ExpandAndGetRef();
+      box.m_vPosition = vCenter;
+      box.m_qRotation.SetIdentity();
+      box.m_vHalfExtents = vHalfExtents;
+    };
+
+    // a floor with a wall in the middle that has to be walked around, and an island that cannot be reached
+    AddBox(ezVec3(0, 0, -0.5f), ezVec3(10, 10, 0.5f));
+    AddBox(ezVec3(0, -2, 1), ezVec3(0.5f, 8, 1));
+    AddBox(ezVec3(30, 0, -0.5f), ezVec3(5, 5, 0.5f));
+
+    ezRecastConfig config;
+    ezRecastNavMeshResourceDescriptor desc;
+    ezProgress progress;
+    ezRecastNavMeshBuilder builder;
+    EZ_TEST_BOOL(builder.Build(config, geo, desc, progress).Succeeded());
+
+    return ezResourceManager::CreateResource<ezRecastNavMeshResource>("PathQueryQueueTest", std::move(desc));
+  }
+
+  dtPolyRef FindPoly(const dtNavMeshQuery& query, const ezVec3& vPosition)
+  {
+    const ezRcPos rcPos = vPosition;
+    const float extents[3] = {0.5f, 1.0f, 0.5f};
+    const dtQueryFilter filter;
+
+    dtPolyRef poly = 0;
+    ezRcPos nearest;
+    query.findNearestPoly(rcPos, extents, &filter, &poly, nearest);
+    return poly;
+  }
+
+  /// Runs the queue like a world does, until the request is finished.
+  ezRecastPathQueryState::Enum WaitForResult(
+    ezRecastPathQueryQueue& queue, const dtNavMesh* pNavMesh, ezUInt32 uiRequestID, ezDynamicArray<dtPolyRef>& out_Corridor)
+  {
+    for (ezUInt32 uiFrame = 0; uiFrame < 100; ++uiFrame)
+    {
+      const ezRecastPathQueryState::Enum state = queue.FetchResult(uiRequestID, out_Corridor);
+      if (state != ezRecastPathQueryState::Pending)
+        return state;
+
+      queue.BeginUpdate(pNavMesh);
+      ezTaskSystem::FinishFrameTasks();
+      queue.FinishUpdate();
+    }
+
+    return ezRecastPathQueryState::Pending;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Recast, PathQueryQueue)
+{
+  ezRecastNavMeshResourceHandle hNavMesh = CreateTestNavMesh();
+  ezResourceLock<ezRecastNavMeshResource> pNavMesh(hNavMesh, ezResourceAcquireMode::BlockTillLoaded);
+
+  const dtNavMesh* pDetourNavMesh = pNavMesh->GetNavMesh();
+  if (EZ_TEST_BOOL(pDetourNavMesh != nullptr).Failed())
+    return;
+
+  dtNavMeshQuery navQuery;
+  navQuery.init(pDetourNavMesh, 512);
+
+  const ezVec3 vStart(-5, -5, 0);
+  const ezVec3 vEnd(5, -5, 0);
+  const ezVec3 vIsland(30, 0, 0);
+
+  const dtPolyRef startPoly = FindPoly(navQuery, vStart);
+  const dtPolyRef endPoly = FindPoly(navQuery, vEnd);
+  const dtPolyRef islandPoly = FindPoly(navQuery, vIsland);
+
+  EZ_TEST_BOOL(startPoly != 0 && endPoly != 0 && islandPoly != 0);
+
+  ezRecastPathQueryQueue queue;
+  ezDynamicArray<dtPolyRef> corridor;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Succeeded")
+  {
+    const ezUInt32 uiRequestID = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+    EZ_TEST_BOOL(uiRequestID != 0);
+    EZ_TEST_INT(queue.FetchResult(uiRequestID, corridor), ezRecastPathQueryState::Pending);
+
+    EZ_TEST_INT(WaitForResult(queue, pDetourNavMesh, uiRequestID, corridor), ezRecastPathQueryState::Succeeded);
+
+    if (EZ_TEST_BOOL(!corridor.IsEmpty()).Succeeded())
+    {
+      EZ_TEST_BOOL(corridor[0] == startPoly);
+      EZ_TEST_BOOL(corridor.PeekBack() == endPoly);
+    }
+
+    // the result is handed out only once
+    EZ_TEST_INT(queue.FetchResult(uiRequestID, corridor), ezRecastPathQueryState::Invalid);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Coalesced Requests")
+  {
+    ezUInt32 requestIDs[5];
+    for (ezUInt32& uiRequestID : requestIDs)
+    {
+      uiRequestID = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+    }
+
+    ezDynamicArray<dtPolyRef> firstCorridor;
+    EZ_TEST_INT(WaitForResult(queue, pDetourNavMesh, requestIDs[0], firstCorridor), ezRecastPathQueryState::Succeeded);
+
+    for (ezUInt32 i = 1; i < EZ_ARRAY_SIZE(requestIDs); ++i)
+    {
+      EZ_TEST_INT(queue.FetchResult(requestIDs[i], corridor), ezRecastPathQueryState::Succeeded);
+      EZ_TEST_BOOL(corridor == firstCorridor);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PartialPath")
+  {
+    const ezUInt32 uiRequestID = queue.RequestPath(startPoly, vStart, islandPoly, vIsland);
+
+    EZ_TEST_INT(WaitForResult(queue, pDetourNavMesh, uiRequestID, corridor), ezRecastPathQueryState::PartialPath);
+    EZ_TEST_BOOL(!corridor.IsEmpty() && corridor.PeekBack() != islandPoly);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CancelRequest")
+  {
+    const ezUInt32 uiCanceledID = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+    const ezUInt32 uiRequestID = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+
+    queue.CancelRequest(uiCanceledID);
+    EZ_TEST_INT(queue.FetchResult(uiCanceledID, corridor), ezRecastPathQueryState::Invalid);
+
+    // the other request of the shared query is not affected
+    EZ_TEST_INT(WaitForResult(queue, pDetourNavMesh, uiRequestID, corridor), ezRecastPathQueryState::Succeeded);
+    EZ_TEST_INT(queue.FetchResult(uiCanceledID, corridor), ezRecastPathQueryState::Invalid);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "NavMeshChanged")
+  {
+    // outstanding requests are not reported as failed paths when the navmesh goes away, but have to be made again
+    const ezUInt32 uiRequestID = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+    queue.Clear();
+    EZ_TEST_INT(queue.FetchResult(uiRequestID, corridor), ezRecastPathQueryState::NavMeshChanged);
+    EZ_TEST_INT(queue.FetchResult(uiRequestID, corridor), ezRecastPathQueryState::Invalid);
+
+    // the same happens when the queue is updated with a different navmesh
+    queue.BeginUpdate(pDetourNavMesh);
+    ezTaskSystem::FinishFrameTasks();
+    queue.FinishUpdate();
+
+    const ezUInt32 uiRequestID2 = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+    queue.BeginUpdate(nullptr);
+    queue.FinishUpdate();
+    EZ_TEST_INT(queue.FetchResult(uiRequestID2, corridor), ezRecastPathQueryState::NavMeshChanged);
+
+    // requesting the path again works
+    const ezUInt32 uiRequestID3 = queue.RequestPath(startPoly, vStart, endPoly, vEnd);
+    EZ_TEST_INT(WaitForResult(queue, pDetourNavMesh, uiRequestID3, corridor), ezRecastPathQueryState::Succeeded);
+  }
+
+  queue.Clear();
+}
+
+#endif
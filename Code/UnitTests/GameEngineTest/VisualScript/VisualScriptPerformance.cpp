@@ -0,0 +1,135 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Messages/EventMessage.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMathNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptVariableNodes.h>
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+
+namespace
+{
+  // On every user event: Counter = Counter * 1 + 1 * 1
+  ezVisualScriptResourceHandle CreateCounterScript()
+  {
+    ezVisualScriptResourceDescriptor desc;
+
+    auto AddNode = [&](const ezRTTI* pType) {
+      auto& node = desc.m_Nodes.ExpandAndGetRef();
+      node.m_pType = pType;
+      node.m_sTypeName = pType->GetTypeName();
+      node.m_uiFirstProperty = static_cast<ezUInt16>(desc.m_Properties.GetCount());
+      return static_cast<ezUInt16>(desc.m_Nodes.GetCount() - 1);
+    };
+
+    auto AddProperty = [&](const char* szName, const ezVariant& value) {
+      auto& prop = desc.m_Properties.ExpandAndGetRef();
+      prop.m_sName = szName;
+      prop.m_Value = value;
+      desc.m_Nodes.PeekBack().m_uiNumProperties++;
+    };
+
+    auto AddExecPath = [&](ezUInt16 uiSource, ezUInt16 uiTarget) {
+      auto& con = desc.m_ExecutionPaths.ExpandAndGetRef();
+      con.m_uiSourceNode = uiSource;
+      con.m_uiOutputPin = 0;
+      con.m_uiTargetNode = uiTarget;
+      con.m_uiInputPin = 0;
+    };
+
+    auto AddDataPath = [&](ezUInt16 uiSource, ezUInt16 uiTarget, ezUInt8 uiTargetPin) {
+      auto& con = desc.m_DataPaths.ExpandAndGetRef();
+      con.m_uiSourceNode = uiSource;
+      con.m_uiOutputPin = 0;
+      con.m_uiOutputPinType = ezVisualScriptDataPinType::Number;
+      con.m_uiTargetNode = uiTarget;
+      con.m_uiInputPin = uiTargetPin;
+      con.m_uiInputPinType = ezVisualScriptDataPinType::Number;
+    };
+
+    const ezUInt16 uiEvent = AddNode(ezGetStaticRTTI<ezVisualScriptNode_SimpleUserEvent>());
+
+    const ezUInt16 uiStore = AddNode(ezGetStaticRTTI<ezVisualScriptNode_StoreNumber>());
+    AddProperty("Name", "Counter");
+
+    const ezUInt16 uiMultiplyAdd = AddNode(ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+    AddProperty("b1", 1.0);
+
+    const ezUInt16 uiNumber = AddNode(ezGetStaticRTTI<ezVisualScriptNode_Number>());
+    AddProperty("Name", "Counter");
+
+    AddExecPath(uiEvent, uiStore);
+    AddDataPath(uiNumber, uiMultiplyAdd, 0);
+    AddDataPath(uiMultiplyAdd, uiStore, 0);
+
+    auto& counter = desc.m_NumberParameters.ExpandAndGetRef();
+    counter.m_sName.Assign("Counter");
+
+    desc.PrecomputeMessageHandlers();
+
+    return ezResourceManager::CreateResource<ezVisualScriptResource>("VisualScriptPerformance", std::move(desc));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScript);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, Profile_Execute)
+{
+  constexpr ezUInt32 uiNumInstances = 10000;
+  constexpr ezUInt32 uiNumFrames = 100;
+
+  ezVisualScriptResourceHandle hScript = CreateCounterScript();
+  ezDeque<ezVisualScriptInstance> instances;
+
+  EZ_TEST_BLOCK(EnableInRelease, "Configure")
+  {
+    ezStopwatch sw;
+
+    instances.SetCount(uiNumInstances);
+    for (auto& instance : instances)
+    {
+      instance.Configure(hScript, nullptr);
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(
+      ezTestOutput::Duration, "Configuring %u script instances: %.2fms", uiNumInstances, tDiff.GetMilliseconds());
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Execute")
+  {
+    ezMsgGenericEvent msg;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      for (auto& instance : instances)
+      {
+        instance.HandleMessage(msg);
+        instance.ExecuteScript();
+      }
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Executing %u script instances %u times: %.2fms (%.1fns per execution)",
+      uiNumInstances, uiNumFrames, tDiff.GetMilliseconds(), tDiff.GetNanoseconds() / (uiNumInstances * uiNumFrames));
+
+    for (ezUInt32 i : {0u, uiNumInstances - 1})
+    {
+      double fCounter = 0;
+      instances[i].GetLocalVariables().RetrieveDouble(ezTempHashedString("Counter"), fCounter);
+      EZ_TEST_DOUBLE(fCounter, static_cast<double>(uiNumFrames), 0.0);
+    }
+  }
+
+  instances.Clear();
+}
@@ -0,0 +1,270 @@
+#include <GameEngineTestPCH.h>
+
+#include <GameEngine/VisualScript/Nodes/VisualScriptLogicNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMathNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptVariableNodes.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  ezUInt16 AddNode(ezVisualScriptResourceDescriptor& desc, const ezRTTI* pType)
+  {
+    auto& node = desc.m_Nodes.ExpandAndGetRef();
+    node.m_pType = pType;
+    node.m_sTypeName = pType->GetTypeName();
+    node.m_uiFirstProperty = static_cast<ezUInt16>(desc.m_Properties.GetCount());
+    return static_cast<ezUInt16>(desc.m_Nodes.GetCount() - 1);
+  }
+
+  void AddExecPath(ezVisualScriptResourceDescriptor& desc, ezUInt16 uiSource, ezUInt8 uiOutputPin, ezUInt16 uiTarget)
+  {
+    auto& con = desc.m_ExecutionPaths.ExpandAndGetRef();
+    con.m_uiSourceNode = uiSource;
+    con.m_uiOutputPin = uiOutputPin;
+    con.m_uiTargetNode = uiTarget;
+    con.m_uiInputPin = 0;
+  }
+
+  void AddDataPath(ezVisualScriptResourceDescriptor& desc, ezUInt16 uiSource, ezUInt8 uiOutputPin, ezUInt16 uiTarget, ezUInt8 uiInputPin,
+    ezVisualScriptDataPinType::Enum type)
+  {
+    auto& con = desc.m_DataPaths.ExpandAndGetRef();
+    con.m_uiSourceNode = uiSource;
+    con.m_uiOutputPin = uiOutputPin;
+    con.m_uiOutputPinType = type;
+    con.m_uiTargetNode = uiTarget;
+    con.m_uiInputPin = uiInputPin;
+    con.m_uiInputPinType = type;
+  }
+
+  ezArrayPtr<const ezUInt16> GetDependencies(const ezVisualScriptProgram& program, ezUInt16 uiNode)
+  {
+    const ezVisualScriptProgram::Node& node = program.m_Nodes[uiNode];
+    return program.m_DependencyStream.GetArrayPtr().GetSubArray(node.m_uiFirstDependency, node.m_uiNumDependencies);
+  }
+
+  bool IsSame(ezArrayPtr<const ezUInt16> actual, std::initializer_list<ezUInt16> expected)
+  {
+    return actual == ezArrayPtr<const ezUInt16>(expected.begin(), static_cast<ezUInt32>(expected.size()));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, Compile)
+{
+  const auto Number = ezVisualScriptDataPinType::Number;
+  const auto Boolean = ezVisualScriptDataPinType::Boolean;
+
+  // On a user event, a sequence stores two values computed from one shared number and then runs a compare node. The compare node is
+  // manually stepped, so the logic nodes behind it must not pull it in as a dependency.
+  ezVisualScriptResourceDescriptor desc;
+  const ezUInt16 uiEvent = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_SimpleUserEvent>());
+  const ezUInt16 uiSequence = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_Sequence>());
+  const ezUInt16 uiStoreA = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_StoreNumber>());
+  const ezUInt16 uiStoreB = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_StoreNumber>());
+  const ezUInt16 uiNumber = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_Number>());
+  const ezUInt16 uiMultiplyAddA = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+  const ezUInt16 uiMultiplyAddB = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+  const ezUInt16 uiCompare = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_CompareExec>());
+  const ezUInt16 uiLogicA = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_Logic>());
+  const ezUInt16 uiLogicB = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_Logic>());
+
+  AddExecPath(desc, uiEvent, 0, uiSequence);
+  AddExecPath(desc, uiSequence, 0, uiStoreA);
+  AddExecPath(desc, uiSequence, 2, uiStoreB);
+  AddExecPath(desc, uiSequence, 3, uiCompare);
+
+  AddDataPath(desc, uiNumber, 0, uiMultiplyAddA, 0, Number);
+  AddDataPath(desc, uiNumber, 0, uiMultiplyAddB, 2, Number);
+  AddDataPath(desc, uiMultiplyAddA, 0, uiStoreA, 0, Number);
+  AddDataPath(desc, uiMultiplyAddB, 0, uiStoreB, 0, Number);
+  AddDataPath(desc, uiCompare, 0, uiLogicA, 0, Boolean);
+  AddDataPath(desc, uiLogicA, 3, uiLogicB, 1, Boolean);
+
+  ezVisualScriptProgram program;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compile")
+  {
+    EZ_TEST_BOOL(program.Compile(desc).Succeeded());
+    EZ_TEST_BOOL(!program.IsEmpty());
+    EZ_TEST_INT(program.m_Nodes.GetCount(), desc.m_Nodes.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execution Outputs")
+  {
+    // one for the event, four for the sequence, the other nodes have no connected execution outputs
+    EZ_TEST_INT(program.m_ExecTargets.GetCount(), 5);
+
+    const ezVisualScriptProgram::Node& event = program.m_Nodes[uiEvent];
+    EZ_TEST_INT(event.m_uiNumExecOutputs, 1);
+    EZ_TEST_INT(program.m_ExecTargets[event.m_uiFirstExecOutput].m_uiTargetNode, uiSequence);
+
+    // unconnected pins in between are kept, so the pin index can be used directly
+    const ezVisualScriptProgram::Node& sequence = program.m_Nodes[uiSequence];
+    EZ_TEST_INT(sequence.m_uiNumExecOutputs, 4);
+
+    const ezVisualScriptProgram::ExecTarget* pTargets = &program.m_ExecTargets[sequence.m_uiFirstExecOutput];
+    EZ_TEST_INT(pTargets[0].m_uiTargetNode, uiStoreA);
+    EZ_TEST_INT(pTargets[1].m_uiTargetNode, ezVisualScriptProgram::InvalidNode);
+    EZ_TEST_INT(pTargets[2].m_uiTargetNode, uiStoreB);
+    EZ_TEST_INT(pTargets[3].m_uiTargetNode, uiCompare);
+    EZ_TEST_INT(pTargets[3].m_uiTargetPin, 0);
+
+    EZ_TEST_INT(program.m_Nodes[uiStoreA].m_uiNumExecOutputs, 0);
+    EZ_TEST_INT(program.m_Nodes[uiCompare].m_uiNumExecOutputs, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Data Outputs")
+  {
+    EZ_TEST_INT(program.m_DataTargets.GetCount(), desc.m_DataPaths.GetCount());
+
+    // fan-out, both targets of the same pin are stored next to each other
+    const ezVisualScriptProgram::Node& number = program.m_Nodes[uiNumber];
+    EZ_TEST_INT(number.m_uiNumDataOutputs, 1);
+
+    const ezVisualScriptProgram::DataOutput& numberOutput = program.m_DataOutputs[number.m_uiFirstDataOutput];
+    if (EZ_TEST_INT(numberOutput.m_uiNumTargets, 2).Succeeded())
+    {
+      const ezVisualScriptProgram::DataTarget& target0 = program.m_DataTargets[numberOutput.m_uiFirstTarget];
+      const ezVisualScriptProgram::DataTarget& target1 = program.m_DataTargets[numberOutput.m_uiFirstTarget + 1];
+
+      EZ_TEST_INT(target0.m_uiTargetNode, uiMultiplyAddA);
+      EZ_TEST_INT(target0.m_uiTargetPin, 0);
+      EZ_TEST_INT(target1.m_uiTargetNode, uiMultiplyAddB);
+      EZ_TEST_INT(target1.m_uiTargetPin, 2);
+      EZ_TEST_BOOL(target0.m_AssignFunc != nullptr && target1.m_AssignFunc != nullptr);
+    }
+
+    // only the highest connected pin determines the number of outputs, the pins below it have no targets
+    const ezVisualScriptProgram::Node& logic = program.m_Nodes[uiLogicA];
+    EZ_TEST_INT(logic.m_uiNumDataOutputs, 4);
+
+    for (ezUInt32 uiPin = 0; uiPin < 3; ++uiPin)
+    {
+      EZ_TEST_INT(program.m_DataOutputs[logic.m_uiFirstDataOutput + uiPin].m_uiNumTargets, 0);
+    }
+
+    const ezVisualScriptProgram::DataOutput& notOutput = program.m_DataOutputs[logic.m_uiFirstDataOutput + 3];
+    if (EZ_TEST_INT(notOutput.m_uiNumTargets, 1).Succeeded())
+    {
+      EZ_TEST_INT(program.m_DataTargets[notOutput.m_uiFirstTarget].m_uiTargetNode, uiLogicB);
+      EZ_TEST_INT(program.m_DataTargets[notOutput.m_uiFirstTarget].m_uiTargetPin, 1);
+    }
+
+    EZ_TEST_INT(program.m_Nodes[uiStoreA].m_uiNumDataOutputs, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dependencies")
+  {
+    // the most dependent nodes come first
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiStoreA), {uiNumber, uiMultiplyAddA}));
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiStoreB), {uiNumber, uiMultiplyAddB}));
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiMultiplyAddA), {uiNumber}));
+    EZ_TEST_BOOL(GetDependencies(program, uiNumber).IsEmpty());
+
+    // manually stepped nodes are never executed on demand
+    EZ_TEST_BOOL(GetDependencies(program, uiLogicA).IsEmpty());
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiLogicB), {uiLogicA}));
+    EZ_TEST_BOOL(GetDependencies(program, uiSequence).IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Diamond")
+  {
+    // both inputs depend on the same node, it is still only executed once
+    ezVisualScriptResourceDescriptor diamondDesc;
+    const ezUInt16 uiTop = AddNode(diamondDesc, ezGetStaticRTTI<ezVisualScriptNode_Number>());
+    const ezUInt16 uiLeft = AddNode(diamondDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+    const ezUInt16 uiRight = AddNode(diamondDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+    const ezUInt16 uiBottom = AddNode(diamondDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+
+    AddDataPath(diamondDesc, uiTop, 0, uiLeft, 0, Number);
+    AddDataPath(diamondDesc, uiTop, 0, uiRight, 0, Number);
+    AddDataPath(diamondDesc, uiLeft, 0, uiBottom, 0, Number);
+    AddDataPath(diamondDesc, uiRight, 0, uiBottom, 1, Number);
+
+    EZ_TEST_BOOL(program.Compile(diamondDesc).Succeeded());
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiBottom), {uiTop, uiLeft, uiRight}));
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiLeft), {uiTop}));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Diamond Chain")
+  {
+    // 20 diamonds in a row, every path through them would be 2^20 entries
+    const ezUInt32 uiNumDiamonds = 20;
+
+    ezVisualScriptResourceDescriptor chainDesc;
+    ezUInt16 uiTop = AddNode(chainDesc, ezGetStaticRTTI<ezVisualScriptNode_Number>());
+
+    for (ezUInt32 i = 0; i < uiNumDiamonds; ++i)
+    {
+      const ezUInt16 uiLeft = AddNode(chainDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+      const ezUInt16 uiRight = AddNode(chainDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+      const ezUInt16 uiBottom = AddNode(chainDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+
+      AddDataPath(chainDesc, uiTop, 0, uiLeft, 0, Number);
+      AddDataPath(chainDesc, uiTop, 0, uiRight, 0, Number);
+      AddDataPath(chainDesc, uiLeft, 0, uiBottom, 0, Number);
+      AddDataPath(chainDesc, uiRight, 0, uiBottom, 1, Number);
+
+      uiTop = uiBottom;
+    }
+
+    EZ_TEST_BOOL(program.Compile(chainDesc).Succeeded());
+
+    // every other node exactly once, each one after all of its own dependencies
+    ezArrayPtr<const ezUInt16> dependencies = GetDependencies(program, uiTop);
+    if (EZ_TEST_INT(dependencies.GetCount(), 3 * uiNumDiamonds).Succeeded())
+    {
+      ezDynamicArray<bool> executed;
+      executed.SetCount(chainDesc.m_Nodes.GetCount(), false);
+
+      for (ezUInt16 uiNode : dependencies)
+      {
+        EZ_TEST_BOOL(!executed[uiNode]);
+
+        for (ezUInt16 uiDependency : GetDependencies(program, uiNode))
+        {
+          EZ_TEST_BOOL(executed[uiDependency]);
+        }
+
+        executed[uiNode] = true;
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cycle")
+  {
+    ezVisualScriptResourceDescriptor cycleDesc;
+    const ezUInt16 uiNode0 = AddNode(cycleDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+    const ezUInt16 uiNode1 = AddNode(cycleDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+
+    AddDataPath(cycleDesc, uiNode0, 0, uiNode1, 0, Number);
+    AddDataPath(cycleDesc, uiNode1, 0, uiNode0, 0, Number);
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Visual script has a cycle in its data connections", ezLogMsgType::ErrorMsg);
+
+    EZ_TEST_BOOL(program.Compile(cycleDesc).Failed());
+    EZ_TEST_BOOL(program.IsEmpty());
+    EZ_TEST_INT(program.m_DependencyStream.GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cycle Through Manually Stepped Node")
+  {
+    // a manually stepped node breaks the cycle, because it does not run on demand
+    ezVisualScriptResourceDescriptor cycleDesc;
+    const ezUInt16 uiCompare = AddNode(cycleDesc, ezGetStaticRTTI<ezVisualScriptNode_CompareExec>());
+    const ezUInt16 uiMultiplyAdd = AddNode(cycleDesc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+
+    AddDataPath(cycleDesc, uiMultiplyAdd, 0, uiCompare, 0, Number);
+    AddDataPath(cycleDesc, uiCompare, 0, uiMultiplyAdd, 0, Boolean);
+    cycleDesc.m_DataPaths.PeekBack().m_uiInputPinType = Number;
+
+    EZ_TEST_BOOL(program.Compile(cycleDesc).Succeeded());
+    EZ_TEST_BOOL(IsSame(GetDependencies(program, uiCompare), {uiMultiplyAdd}));
+    EZ_TEST_BOOL(GetDependencies(program, uiMultiplyAdd).IsEmpty());
+  }
+}